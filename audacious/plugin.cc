@@ -16,6 +16,7 @@
 
 extern "C" {
 #include "../src/vgmstream.h"
+#include "../src/plugins.h"
 }
 #include "plugin.h"
 #include "vfs.h"
@@ -188,18 +189,29 @@ bool VgmstreamPlugin::play(const char *filename, VFSFile &file) {
         return false;
     }
 
-    short buffer[MIN_BUFFER_SIZE * vgmstream->channels];
-    int max_buffer_samples = sizeof(buffer) / sizeof(buffer[0]) / vgmstream->channels;
+    // save decoder states while playing, so seeking back doesn't need to decode from the start
+    vgmstream_set_seek_index(vgmstream, vgmstream->sample_rate, 0);
 
     int stream_samples_amount = get_vgmstream_play_samples(
             vgmstream_cfg.loop_count, vgmstream_cfg.fade_length,
             vgmstream_cfg.fade_delay, vgmstream);
     rate = get_vgmstream_average_bitrate(vgmstream);
 
+    // fade is done by the mixer, so it must be set before enabling it
+    int fade_samples = vgmstream_cfg.fade_length * vgmstream->sample_rate;
+    if (vgmstream->loop_flag && !vgmstream_cfg.loop_forever)
+        vgmstream_mixing_fadeout(vgmstream, stream_samples_amount - fade_samples, fade_samples);
+
+    int input_channels, output_channels;
+    vgmstream_mixing_enable(vgmstream, MIN_BUFFER_SIZE, &input_channels, &output_channels);
+
+    // buffer must hold all channels before mixing, output may have less
+    short buffer[MIN_BUFFER_SIZE * input_channels];
+    int max_buffer_samples = MIN_BUFFER_SIZE;
+
     set_stream_bitrate(rate);
-    open_audio(FMT_S16_LE, vgmstream->sample_rate, vgmstream->channels);
+    open_audio(FMT_S16_LE, vgmstream->sample_rate, output_channels);
 
-    int fade_samples = vgmstream_cfg.fade_length * vgmstream->sample_rate;
     while (!check_stop()) {
         int toget = max_buffer_samples;
 
@@ -218,23 +230,7 @@ bool VgmstreamPlugin::play(const char *filename, VFSFile &file) {
 
         render_vgmstream(buffer, toget, vgmstream);
 
-        if (vgmstream->loop_flag && fade_samples > 0 &&
-                !vgmstream_cfg.loop_forever) {
-            int samples_into_fade =
-                    current_sample_pos - (stream_samples_amount - fade_samples);
-            if (samples_into_fade + toget > 0) {
-                for (int j = 0; j < toget; j++, samples_into_fade++) {
-                    if (samples_into_fade > 0) {
-                        double fadedness =
-                                (double)(fade_samples - samples_into_fade) / fade_samples;
-                        for (int k = 0; k < vgmstream->channels; k++)
-                            buffer[j * vgmstream->channels + k] *= fadedness;
-                    }
-                }
-            }
-        }
-
-        write_audio(buffer, toget * sizeof(short) * vgmstream->channels);
+        write_audio(buffer, toget * sizeof(short) * output_channels);
         current_sample_pos += toget;
     }
 
@@ -250,34 +246,12 @@ void VgmstreamPlugin::seek(int seek_value, int &current_sample_pos) {
 
     // compute from ms to samples
     int seek_needed_samples = (long long)seek_value * vgmstream->sample_rate / 1000L;
-    short buffer[MIN_BUFFER_SIZE * vgmstream->channels];
-    int max_buffer_samples = sizeof(buffer) / sizeof(buffer[0]) / vgmstream->channels;
-
-    int samples_to_do = 0;
-    if (seek_needed_samples < current_sample_pos) {
-        // go back in time, reopen file
-        debugMessage("reopen file to seek backward");
-        reset_vgmstream(vgmstream);
-        current_sample_pos = 0;
-        samples_to_do = seek_needed_samples;
-    } else if (current_sample_pos < seek_needed_samples) {
-        // go forward in time
-        samples_to_do = seek_needed_samples - current_sample_pos;
-    }
 
-    // do the actual seeking
-    if (samples_to_do >= 0) {
-        debugMessage("render forward");
+    // library handles going back/forward (positions directly when possible)
+    vgmstream_seek(vgmstream, seek_needed_samples);
+    current_sample_pos = seek_needed_samples;
 
-        // render till seeked sample
-        while (samples_to_do > 0) {
-            int seek_samples = std::min(max_buffer_samples, samples_to_do);
-            current_sample_pos += seek_samples;
-            samples_to_do -= seek_samples;
-            render_vgmstream(buffer, seek_samples, vgmstream);
-        }
-        debugMessage("after render vgmstream");
-    }
+    debugMessage("after seek vgmstream");
 }
 
 void debugMessage(const char *str) {
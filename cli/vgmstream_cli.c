@@ -3,9 +3,11 @@
 #include "../src/vgmstream.h"
 #include "../src/plugins.h"
 #include "../src/util.h"
+#include <time.h>
 #ifdef WIN32
 #include <io.h>
 #include <fcntl.h>
+#include <windows.h>
 #else
 #include <unistd.h>
 #endif
@@ -22,6 +24,8 @@
 #endif
 
 #define SAMPLE_BUFFER_SIZE 0x8000
+#define BENCHMARK_RENDER_BUFFER 0x800
+#define SPEED_MIN_TIME 1.0 /* seconds */
 
 /* getopt globals (the horror...) */
 extern char * optarg;
@@ -46,6 +50,7 @@ static void usage(const char * name) {
             "    -m: print metadata only, don't decode\n"
             "    -L: append a smpl chunk and create a looping wav\n"
             "    -2 N: only output the Nth (first is 0) set of stereo channels\n"
+            "    -M N: downmix to N channels if the stream has more\n"
             "    -p: output to stdout (for piping into another program)\n"
             "    -P: output to stdout even if stdout is a terminal\n"
             "    -c: loop forever (continuously) to stdout\n"
@@ -53,14 +58,23 @@ static void usage(const char * name) {
             "    -g: decode and print oggenc command line to encode as OGG\n"
             "    -b: decode and print batch variable commands\n"
             "    -r: output a second file after resetting (for testing)\n"
+            "    -T N: render layers of layered streams in N threads\n"
+            "    -S N: prepare next segment of segmented streams in a thread, decoding N samples\n"
             "    -k N: seeks to N samples before decoding (for testing)\n"
             "    -t file: print if tags are found in file (for testing)\n"
+            "    -B: print render time per call for buffer sizes 32 to 8192 (for testing)\n"
+            "    -D: print decoding speed (samples per CPU second) of one or more files (for testing)\n"
+            "    -A: read the file through a streamfile that prefetches ahead in a thread\n"
+            "    -w N: wait N microseconds per buffered file read to simulate slow IO (for testing)\n"
+            "    -K N: read the file through a buffer of N blocks and print read counters (for testing)\n"
             , name);
 }
 
 
 typedef struct {
     char * infilename;
+    char ** infilenames;
+    int infilename_count;
     char * outfilename;
     char * tag_filename;
     int ignore_loop;
@@ -76,12 +90,20 @@ typedef struct {
     int test_reset;
     int write_lwav;
     int only_stereo;
+    int downmix_channels;
     int stream_index;
     double loop_count;
     double fade_time;
     double fade_delay;
     int ignore_fade;
     int seek_samples;
+    int print_benchmark;
+    int print_speed;
+    int layer_threads;
+    int segment_prefetch;
+    int async_read;
+    int read_delay;
+    int buffer_blocks;
 
     /* not quite config but eh */
     int lwav_loop_start;
@@ -101,7 +123,7 @@ static int parse_config(cli_config *cfg, int argc, char ** argv) {
     opterr = 0;
 
     /* read config */
-    while ((opt = getopt(argc, argv, "o:l:f:d:ipPcmxeLEFrgb2:s:t:k:")) != -1) {
+    while ((opt = getopt(argc, argv, "o:l:f:d:ipPcmxeLEFrgb2:M:s:t:k:BDT:S:Aw:K:")) != -1) {
         switch (opt) {
             case 'o':
                 cfg->outfilename = optarg;
@@ -155,6 +177,9 @@ static int parse_config(cli_config *cfg, int argc, char ** argv) {
             case '2':
                 cfg->only_stereo = atoi(optarg);
                 break;
+            case 'M':
+                cfg->downmix_channels = atoi(optarg);
+                break;
             case 'F':
                 cfg->ignore_fade = 1;
                 break;
@@ -167,6 +192,27 @@ static int parse_config(cli_config *cfg, int argc, char ** argv) {
             case 'k':
                 cfg->seek_samples = atoi(optarg);
                 break;
+            case 'B':
+                cfg->print_benchmark = 1;
+                break;
+            case 'D':
+                cfg->print_speed = 1;
+                break;
+            case 'T':
+                cfg->layer_threads = atoi(optarg);
+                break;
+            case 'S':
+                cfg->segment_prefetch = atoi(optarg);
+                break;
+            case 'A':
+                cfg->async_read = 1;
+                break;
+            case 'w':
+                cfg->read_delay = atoi(optarg);
+                break;
+            case 'K':
+                cfg->buffer_blocks = atoi(optarg);
+                break;
             case '?':
                 fprintf(stderr, "Unknown option -%c found\n", optopt);
                 goto fail;
@@ -176,12 +222,14 @@ static int parse_config(cli_config *cfg, int argc, char ** argv) {
         }
     }
 
-    /* filename goes last */
-    if (optind != argc - 1) {
+    /* filename goes last (several are only allowed in some modes) */
+    if (optind > argc - 1) {
         usage(argv[0]);
         goto fail;
     }
     cfg->infilename = argv[optind];
+    cfg->infilenames = &argv[optind];
+    cfg->infilename_count = argc - optind;
 
 
     return 1;
@@ -214,6 +262,22 @@ static int validate_config(cli_config *cfg) {
         fprintf(stderr,"either -p or -o, make up your mind\n");
         goto fail;
     }
+    if (cfg->print_benchmark && (cfg->play_sdtout || cfg->print_metaonly)) {
+        fprintf(stderr,"-B can't be used with -p/-P/-m\n");
+        goto fail;
+    }
+    if (cfg->print_speed && (cfg->play_sdtout || cfg->print_metaonly || cfg->print_benchmark)) {
+        fprintf(stderr,"-D can't be used with -p/-P/-m/-B\n");
+        goto fail;
+    }
+    if (cfg->infilename_count > 1 && !cfg->print_speed) {
+        fprintf(stderr,"several input files can only be used with -D\n");
+        goto fail;
+    }
+    if (cfg->async_read && cfg->buffer_blocks > 0) {
+        fprintf(stderr,"-A and -K are incompatible\n");
+        goto fail;
+    }
 
     return 1;
 fail:
@@ -318,40 +382,230 @@ static void apply_config(VGMSTREAM * vgmstream, cli_config *cfg) {
     }
 }
 
-void apply_fade(sample_t * buf, VGMSTREAM * vgmstream, int to_get, int i, int len_samples, int fade_samples, int channels) {
-    int is_fade_on = vgmstream->loop_flag;
-
-    if (is_fade_on && fade_samples > 0) {
-        int samples_into_fade = i - (len_samples - fade_samples);
-        if (samples_into_fade + to_get > 0) {
-            int j, k;
-            for (j = 0; j < to_get; j++, samples_into_fade++) {
-                if (samples_into_fade > 0) {
-                    double fadedness = (double)(fade_samples - samples_into_fade) / fade_samples;
-                    for (k = 0; k < channels; k++) {
-                        buf[j*channels + k] = (sample_t)buf[j*channels + k] * fadedness;
-                    }
-                }
+/* Renders the stream at several buffer sizes, as players would, then with a render buffer, to check
+ * fixed costs per call (small sizes should cost about the same per sample as big ones). */
+static void print_benchmark(VGMSTREAM * vgmstream, cli_config *cfg, int32_t len_samples, int input_channels) {
+    static const int32_t sizes[] = {32, 64, 128, 256, 512, 1024, 2048, 4096, 8192};
+    sample_t * buf = NULL;
+    int i, pass;
+    int32_t j;
+
+    buf = malloc(8192 * sizeof(sample_t) * input_channels);
+    if (!buf) {
+        fprintf(stderr,"failed allocating output buffer\n");
+        return;
+    }
+
+    printf("buffer: ns/call (ns/sample), with render buffer: ns/call (ns/sample)\n");
+    for (i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i++) {
+        int32_t size = sizes[i];
+        int32_t calls = (len_samples + size - 1) / size;
+        double time_call[2];
+
+        for (pass = 0; pass < 2; pass++) {
+            clock_t start;
+
+            reset_vgmstream(vgmstream);
+            apply_config(vgmstream, cfg); /* vgmstream manipulations are undone by reset */
+            vgmstream_set_render_buffer(vgmstream, pass == 0 ? 0 : BENCHMARK_RENDER_BUFFER);
+
+            start = clock();
+            for (j = 0; j < len_samples; j += size) {
+                int32_t to_get = size;
+                if (j + size > len_samples)
+                    to_get = len_samples - j;
+
+                render_vgmstream(buf, to_get, vgmstream);
             }
+            time_call[pass] = (double)(clock() - start) / CLOCKS_PER_SEC * 1000000000.0 / calls;
         }
+
+        printf("%6i: %10.1f (%5.2f), %10.1f (%5.2f)\n", size,
+                time_call[0], time_call[0] / size, time_call[1], time_call[1] / size);
     }
+
+    vgmstream_set_render_buffer(vgmstream, 0);
+    free(buf);
 }
 
-void apply_seek(sample_t * buf, VGMSTREAM * vgmstream, int len_samples) {
-    int i;
+/* Renders the stream (repeated until enough time has passed) and prints samples per second
+ * of CPU time, to compare decoders and mixing between versions. */
+static void print_speed(VGMSTREAM * vgmstream, cli_config *cfg, int32_t len_samples, int input_channels) {
+    sample_t * buf = NULL;
+    double elapsed, samples_done = 0;
+    clock_t start;
+    int32_t j;
 
-    for (i = 0; i < len_samples; i += SAMPLE_BUFFER_SIZE) {
-        int to_get = SAMPLE_BUFFER_SIZE;
-        if (i + SAMPLE_BUFFER_SIZE > len_samples)
-            to_get = len_samples - i;
+    buf = malloc(SAMPLE_BUFFER_SIZE * sizeof(sample_t) * input_channels);
+    if (!buf) {
+        fprintf(stderr,"failed allocating output buffer\n");
+        return;
+    }
 
-        render_vgmstream(buf, to_get, vgmstream);
+    start = clock();
+    do {
+        if (samples_done > 0) {
+            reset_vgmstream(vgmstream);
+            apply_config(vgmstream, cfg); /* vgmstream manipulations are undone by reset */
+        }
+
+        for (j = 0; j < len_samples; j += SAMPLE_BUFFER_SIZE) {
+            int32_t to_get = SAMPLE_BUFFER_SIZE;
+            if (j + SAMPLE_BUFFER_SIZE > len_samples)
+                to_get = len_samples - j;
+
+            render_vgmstream(buf, to_get, vgmstream);
+        }
+        samples_done += len_samples;
+
+        elapsed = (double)(clock() - start) / CLOCKS_PER_SEC;
+    } while (elapsed < SPEED_MIN_TIME && len_samples > 0);
+
+    if (elapsed <= 0)
+        elapsed = 1.0 / CLOCKS_PER_SEC;
+    printf("speed: %.2f Msamples/s, %.1fx realtime (%.0f samples in %.3f s)\n",
+            samples_done / elapsed / 1000000.0, samples_done / vgmstream->sample_rate / elapsed,
+            samples_done, elapsed);
+
+    free(buf);
+}
+
+/* STREAMFILE stand-in for slow IO (like network mounts), waiting before every read (for testing) */
+typedef struct {
+    STREAMFILE sf;
+
+    STREAMFILE *inner_sf;
+    int read_delay; /* in microseconds */
+} SLOW_STREAMFILE;
+
+static STREAMFILE *open_slow_streamfile(STREAMFILE *streamfile, int read_delay);
+
+static size_t slow_read(SLOW_STREAMFILE *streamfile, uint8_t * dest, off_t offset, size_t length) {
+#ifdef WIN32
+    Sleep((streamfile->read_delay + 999) / 1000);
+#else
+    usleep(streamfile->read_delay);
+#endif
+    return streamfile->inner_sf->read(streamfile->inner_sf, dest, offset, length);
+}
+static void slow_get_stats(SLOW_STREAMFILE *streamfile, streamfile_stats_t * stats) {
+    streamfile->inner_sf->get_stats(streamfile->inner_sf, stats);
+}
+static size_t slow_get_size(SLOW_STREAMFILE * streamfile) {
+    return streamfile->inner_sf->get_size(streamfile->inner_sf);
+}
+static off_t slow_get_offset(SLOW_STREAMFILE * streamfile) {
+    return streamfile->inner_sf->get_offset(streamfile->inner_sf);
+}
+static void slow_get_name(SLOW_STREAMFILE *streamfile, char *buffer, size_t length) {
+    streamfile->inner_sf->get_name(streamfile->inner_sf, buffer, length);
+}
+static STREAMFILE *slow_open(SLOW_STREAMFILE *streamfile, const char * const filename, size_t buffersize) {
+    STREAMFILE *new_inner_sf, *new_sf;
+
+    new_inner_sf = streamfile->inner_sf->open(streamfile->inner_sf, filename, buffersize);
+    if (!new_inner_sf) return NULL;
+
+    new_sf = open_slow_streamfile(new_inner_sf, streamfile->read_delay);
+    if (!new_sf) {
+        close_streamfile(new_inner_sf);
+        return NULL;
     }
+    return new_sf;
+}
+static void slow_close(SLOW_STREAMFILE *streamfile) {
+    streamfile->inner_sf->close(streamfile->inner_sf);
+    free(streamfile);
+}
+
+static STREAMFILE *open_slow_streamfile(STREAMFILE *streamfile, int read_delay) {
+    SLOW_STREAMFILE *this_sf;
+
+    if (!streamfile) return NULL;
+
+    this_sf = calloc(1,sizeof(SLOW_STREAMFILE));
+    if (!this_sf) return NULL;
+
+    /* set callbacks and internals (no get_data, so all reads go through the delay) */
+    this_sf->sf.read = (void*)slow_read;
+    this_sf->sf.get_size = (void*)slow_get_size;
+    this_sf->sf.get_offset = (void*)slow_get_offset;
+    this_sf->sf.get_name = (void*)slow_get_name;
+    this_sf->sf.open = (void*)slow_open;
+    this_sf->sf.close = (void*)slow_close;
+    if (streamfile->get_stats)
+        this_sf->sf.get_stats = (void*)slow_get_stats;
+    this_sf->sf.stream_index = streamfile->stream_index;
+
+    this_sf->inner_sf = streamfile;
+    this_sf->read_delay = read_delay;
+
+    return &this_sf->sf;
+}
+
+/* Prints read counters of the channels' files (shared by channels in small interleaves). */
+static void print_read_stats(VGMSTREAM * vgmstream) {
+    streamfile_stats_t stats, total = {0};
+    int ch, prev;
+
+    for (ch = 0; ch < vgmstream->channels; ch++) {
+        STREAMFILE *sf = vgmstream->ch[ch].streamfile;
+        if (!sf || !sf->get_stats)
+            continue;
+
+        for (prev = 0; prev < ch; prev++) {
+            if (vgmstream->ch[prev].streamfile == sf)
+                break;
+        }
+        if (prev < ch)
+            continue;
+
+        sf->get_stats(sf, &stats);
+        total.refills += stats.refills;
+        total.hits += stats.hits;
+        total.bytes_read += stats.bytes_read;
+    }
+
+    printf("file reads: %u hits, %u refills (%lu bytes)\n",
+            total.hits, total.refills, (unsigned long)total.bytes_read);
+}
+
+/* opens the input file, wrapped as requested by test options */
+static STREAMFILE *open_input_streamfile(cli_config *cfg) {
+    STREAMFILE *sf, *new_sf;
+
+    sf = open_mmap_streamfile(cfg->infilename);
+    if (!sf) return NULL;
+
+    if (cfg->read_delay > 0) {
+        new_sf = open_slow_streamfile(sf, cfg->read_delay);
+        if (!new_sf) goto fail;
+        sf = new_sf;
+    }
+
+    if (cfg->async_read) {
+        new_sf = open_async_streamfile(sf, 0);
+        if (!new_sf) goto fail;
+        sf = new_sf;
+    }
+    else if (cfg->read_delay > 0 || cfg->buffer_blocks > 0) {
+        /* like regular file reads (slow reads shouldn't be done byte by byte) */
+        new_sf = open_buffer_streamfile_blocks(sf, 0, cfg->buffer_blocks);
+        if (!new_sf) goto fail;
+        sf = new_sf;
+    }
+
+    return sf;
+fail:
+    close_streamfile(sf);
+    return NULL;
 }
 
 /* ************************************************************ */
 
-int main(int argc, char ** argv) {
+/* Decodes cfg->infilename as configured. Uses its own copy of the config, as options are
+ * modified per file (see apply_config). */
+static int process_file(cli_config *input_cfg) {
     VGMSTREAM * vgmstream = NULL;
     FILE * outfile = NULL;
     char outfilename_temp[PATH_LIMIT];
@@ -362,29 +616,13 @@ int main(int argc, char ** argv) {
     int32_t fade_samples;
     int i, j;
 
-    cli_config cfg = {0};
-    int res;
-
-
-    /* read args */
-    res = parse_config(&cfg, argc, argv);
-    if (!res) goto fail;
-
-#ifdef WIN32
-    /* make stdout output work with windows */
-    if (cfg.play_sdtout) {
-        _setmode(fileno(stdout),_O_BINARY);
-    }
-#endif
-
-    res = validate_config(&cfg);
-    if (!res) goto fail;
+    cli_config cfg = *input_cfg;
 
 
     /* open streamfile and pass subsong */
     {
         //s = init_vgmstream(infilename);
-        STREAMFILE *streamFile = open_stdio_streamfile(cfg.infilename);
+        STREAMFILE *streamFile = open_input_streamfile(&cfg);
         if (!streamFile) {
             fprintf(stderr,"file %s not found\n",cfg.infilename);
             goto fail;
@@ -400,14 +638,33 @@ int main(int argc, char ** argv) {
         }
     }
 
+    if (cfg.layer_threads > 1) {
+        if (!vgmstream_set_layer_threads(vgmstream, cfg.layer_threads))
+            fprintf(stderr,"-T ignored: no layers or no thread support\n");
+    }
+    if (cfg.segment_prefetch > 0) {
+        if (!vgmstream_set_segment_prefetch(vgmstream, cfg.segment_prefetch))
+            fprintf(stderr,"-S ignored: no segments or no thread support\n");
+    }
+
 
     /* modify the VGMSTREAM if needed (before printing file info) */
     apply_config(vgmstream, &cfg);
 
+    /* get final play config */
+    len_samples = get_vgmstream_play_samples(cfg.loop_count,cfg.fade_time,cfg.fade_delay,vgmstream);
+    fade_samples = (int32_t)(cfg.fade_time < 0 ? 0 : cfg.fade_time * vgmstream->sample_rate);
+
+    /* fade near the end (done by the mixer, so must be set before it's enabled) */
+    if (vgmstream->loop_flag && !cfg.play_forever) {
+        vgmstream_mixing_fadeout(vgmstream, len_samples - fade_samples, fade_samples);
+    }
+
     channels = vgmstream->channels;
     input_channels = vgmstream->channels;
 
     /* enable after config but before outbuf */
+    vgmstream_mixing_autodownmix(vgmstream, cfg.downmix_channels);
     vgmstream_mixing_enable(vgmstream, SAMPLE_BUFFER_SIZE, &input_channels, &channels);
 
     if (cfg.play_forever && (!vgmstream->loop_flag || vgmstream->loop_target > 0)) {
@@ -420,7 +677,7 @@ int main(int argc, char ** argv) {
     if (cfg.play_sdtout) {
         outfile = stdout;
     }
-    else if (!cfg.print_metaonly) {
+    else if (!cfg.print_metaonly && !cfg.print_benchmark && !cfg.print_speed) {
         if (!cfg.outfilename) {
             /* note that outfilename_temp must persist outside this block, hence the external array */
             strcpy(outfilename_temp, cfg.infilename);
@@ -474,10 +731,18 @@ int main(int argc, char ** argv) {
         return EXIT_SUCCESS;
     }
 
+    if (cfg.print_benchmark) {
+        print_benchmark(vgmstream, &cfg, len_samples, input_channels);
+        close_vgmstream(vgmstream);
+        return EXIT_SUCCESS;
+    }
+
+    if (cfg.print_speed) {
+        print_speed(vgmstream, &cfg, len_samples, input_channels);
+        close_vgmstream(vgmstream);
+        return EXIT_SUCCESS;
+    }
 
-    /* get final play config */
-    len_samples = get_vgmstream_play_samples(cfg.loop_count,cfg.fade_time,cfg.fade_delay,vgmstream);
-    fade_samples = (int32_t)(cfg.fade_time < 0 ? 0 : cfg.fade_time * vgmstream->sample_rate);
 
     if (cfg.seek_samples >= len_samples)
         cfg.seek_samples = 0;
@@ -532,7 +797,7 @@ int main(int argc, char ** argv) {
     }
 
 
-    apply_seek(buf, vgmstream, cfg.seek_samples);
+    vgmstream_seek(vgmstream, cfg.seek_samples);
 
     /* decode */
     for (i = 0; i < len_samples; i += SAMPLE_BUFFER_SIZE) {
@@ -542,8 +807,6 @@ int main(int argc, char ** argv) {
 
         render_vgmstream(buf, to_get, vgmstream);
 
-        apply_fade(buf, vgmstream, to_get, i, len_samples, fade_samples, channels);
-
         swap_samples_le(buf, channels * to_get); /* write PC endian */
         if (cfg.only_stereo != -1) {
             for (j = 0; j < to_get; j++) {
@@ -557,6 +820,10 @@ int main(int argc, char ** argv) {
     fclose(outfile);
     outfile = NULL;
 
+    if (cfg.buffer_blocks > 0) {
+        print_read_stats(vgmstream);
+    }
+
 
     /* try again with (for testing reset_vgmstream, simulates a seek to 0) */
     if (cfg.test_reset) {
@@ -575,7 +842,7 @@ int main(int argc, char ** argv) {
         /* vgmstream manipulations are undone by reset */
         apply_config(vgmstream, &cfg);
 
-        apply_seek(buf, vgmstream, cfg.seek_samples);
+        vgmstream_seek(vgmstream, cfg.seek_samples);
 
         /* slap on a .wav header */
         {
@@ -598,8 +865,6 @@ int main(int argc, char ** argv) {
 
             render_vgmstream(buf, to_get, vgmstream);
 
-            apply_fade(buf, vgmstream, to_get, i, len_samples, fade_samples, channels);
-
             swap_samples_le(buf, channels * to_get); /* write PC endian */
             if (cfg.only_stereo != -1) {
                 for (j = 0; j < to_get; j++) {
@@ -628,6 +893,38 @@ fail:
     return EXIT_FAILURE;
 }
 
+int main(int argc, char ** argv) {
+    cli_config cfg = {0};
+    int res, i;
+
+
+    /* read args */
+    res = parse_config(&cfg, argc, argv);
+    if (!res) goto fail;
+
+#ifdef WIN32
+    /* make stdout output work with windows */
+    if (cfg.play_sdtout) {
+        _setmode(fileno(stdout),_O_BINARY);
+    }
+#endif
+
+    res = validate_config(&cfg);
+    if (!res) goto fail;
+
+    for (i = 0; i < cfg.infilename_count; i++) {
+        cfg.infilename = cfg.infilenames[i];
+
+        res = process_file(&cfg);
+        if (res != EXIT_SUCCESS)
+            return res;
+    }
+
+    return EXIT_SUCCESS;
+fail:
+    return EXIT_FAILURE;
+}
+
 
 
 static void make_smpl_chunk(uint8_t * buf, int32_t loop_start, int32_t loop_end) {
@@ -23,6 +23,13 @@ macro(setup_target TARGET)
 		target_link_libraries(${TARGET} m)
 	endif()
 
+	if(NOT WIN32 AND CMAKE_USE_PTHREADS_INIT)
+		target_compile_definitions(${TARGET} PRIVATE VGM_USE_PTHREADS)
+		if(LINK)
+			target_link_libraries(${TARGET} Threads::Threads)
+		endif()
+	endif()
+
 	if(USE_FDKAAC)
 		target_compile_definitions(${TARGET} PRIVATE
 			VGM_USE_MP4V2
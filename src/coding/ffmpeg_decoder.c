@@ -28,9 +28,9 @@ static void g_init_ffmpeg() {
     }
 }
 
-static void remap_audio(sample_t *outbuf, int sample_count, int channels, int channel_mappings[]) {
+/* remaps channels of outbuf (PCM16) or outbuf_f32 (float), depending on which is set */
+static void remap_audio(sample_t *outbuf, float *outbuf_f32, int sample_count, int channels, int channel_mappings[]) {
     int ch_from,ch_to,s;
-    sample_t temp;
     for (s = 0; s < sample_count; s++) {
         for (ch_from = 0; ch_from < channels; ch_from++) {
             if (ch_from > 32)
@@ -40,9 +40,16 @@ static void remap_audio(sample_t *outbuf, int sample_count, int channels, int ch
             if (ch_to < 1 || ch_to > 32 || ch_to > channels-1 || ch_from == ch_to)
                 continue;
 
-            temp = outbuf[s*channels + ch_from];
-            outbuf[s*channels + ch_from] = outbuf[s*channels + ch_to];
-            outbuf[s*channels + ch_to] = temp;
+            if (outbuf_f32) {
+                float temp = outbuf_f32[s*channels + ch_from];
+                outbuf_f32[s*channels + ch_from] = outbuf_f32[s*channels + ch_to];
+                outbuf_f32[s*channels + ch_to] = temp;
+            }
+            else {
+                sample_t temp = outbuf[s*channels + ch_from];
+                outbuf[s*channels + ch_from] = outbuf[s*channels + ch_to];
+                outbuf[s*channels + ch_to] = temp;
+            }
         }
     }
 }
@@ -101,6 +108,50 @@ static void convert_audio_pcm16(sample_t *outbuf, const uint8_t *inbuf, int full
     }
 }
 
+/* converts codec's samples to float (-1.0..1.0, unclamped for float codecs) */
+static void convert_audio_f32(float *outbuf, const uint8_t *inbuf, int fullSampleCount, int bitsPerSample, int floatingPoint) {
+    int s;
+    switch (bitsPerSample) {
+        case 8: {
+            for (s = 0; s < fullSampleCount; s++) {
+                *outbuf++ = ((int)(*(inbuf++))-0x80) * (1.0f / 128.0f);
+            }
+            break;
+        }
+        case 16: {
+            int16_t *s16 = (int16_t *)inbuf;
+            for (s = 0; s < fullSampleCount; s++) {
+                *outbuf++ = *(s16++) * (1.0f / 32768.0f);
+            }
+            break;
+        }
+        case 32: {
+            if (!floatingPoint) {
+                int32_t *s32 = (int32_t *)inbuf;
+                for (s = 0; s < fullSampleCount; s++) {
+                    *outbuf++ = *(s32++) * (1.0f / 2147483648.0f);
+                }
+            }
+            else {
+                float *s32 = (float *)inbuf;
+                for (s = 0; s < fullSampleCount; s++) {
+                    *outbuf++ = *(s32++);
+                }
+            }
+            break;
+        }
+        case 64: {
+            if (floatingPoint) {
+                double *s64 = (double *)inbuf;
+                for (s = 0; s < fullSampleCount; s++) {
+                    *outbuf++ = (float)*(s64++);
+                }
+            }
+            break;
+        }
+    }
+}
+
 /**
  * Special patching for FFmpeg's buggy seek code.
  *
@@ -513,8 +564,8 @@ fail:
     return NULL;
 }
 
-/* decode samples of any kind of FFmpeg format */
-void decode_ffmpeg(VGMSTREAM *vgmstream, sample_t * outbuf, int32_t samples_to_do, int channels) {
+/* decode samples of any kind of FFmpeg format, into outbuf (PCM16) or outbuf_f32 (float) depending on which is set */
+static void decode_ffmpeg_internal(VGMSTREAM *vgmstream, sample_t * outbuf, float * outbuf_f32, int32_t samples_to_do, int channels) {
     ffmpeg_codec_data *data = vgmstream->codec_data;
     int samplesReadNow;
     //todo use either channels / data->channels / codecCtx->channels
@@ -537,7 +588,10 @@ void decode_ffmpeg(VGMSTREAM *vgmstream, sample_t * outbuf, int32_t samples_to_d
     /* ignore once file is done (but not at endOfStream as FFmpeg can still output samples until endOfAudio) */
     if (/*endOfStream ||*/ endOfAudio) {
         VGM_LOG("FFMPEG: decode after end of audio\n");
-        memset(outbuf, 0, samples_to_do * channels * sizeof(sample));
+        if (outbuf_f32)
+            memset(outbuf_f32, 0, samples_to_do * channels * sizeof(float));
+        else
+            memset(outbuf, 0, samples_to_do * channels * sizeof(sample));
         return;
     }
 
@@ -672,16 +726,22 @@ void decode_ffmpeg(VGMSTREAM *vgmstream, sample_t * outbuf, int32_t samples_to_d
 
 
 end:
-    /* convert native sample format into PCM16 outbuf */
+    /* convert native sample format into PCM16 or float outbuf */
     samplesReadNow = bytesRead / (bytesPerSample * channels);
-    convert_audio_pcm16(outbuf, data->sampleBuffer, samplesReadNow * channels, data->bitsPerSample, data->floatingPoint);
+    if (outbuf_f32)
+        convert_audio_f32(outbuf_f32, data->sampleBuffer, samplesReadNow * channels, data->bitsPerSample, data->floatingPoint);
+    else
+        convert_audio_pcm16(outbuf, data->sampleBuffer, samplesReadNow * channels, data->bitsPerSample, data->floatingPoint);
     if (data->channel_remap_set)
-        remap_audio(outbuf, samplesReadNow, data->channels, data->channel_remap);
+        remap_audio(outbuf, outbuf_f32, samplesReadNow, data->channels, data->channel_remap);
 
     /* clean buffer when requested more samples than possible */
     if (endOfAudio && samplesReadNow < samples_to_do) {
         VGM_LOG("FFMPEG: decode after end of audio %i samples\n", (samples_to_do - samplesReadNow));
-        memset(outbuf + (samplesReadNow * channels), 0, (samples_to_do - samplesReadNow) * channels * sizeof(sample));
+        if (outbuf_f32)
+            memset(outbuf_f32 + (samplesReadNow * channels), 0, (samples_to_do - samplesReadNow) * channels * sizeof(float));
+        else
+            memset(outbuf + (samplesReadNow * channels), 0, (samples_to_do - samplesReadNow) * channels * sizeof(sample));
     }
 
     /* copy state back */
@@ -691,6 +751,15 @@ end:
     data->bytesConsumedFromDecodedFrame = bytesConsumedFromDecodedFrame;
 }
 
+void decode_ffmpeg(VGMSTREAM *vgmstream, sample_t * outbuf, int32_t samples_to_do, int channels) {
+    decode_ffmpeg_internal(vgmstream, outbuf, NULL, samples_to_do, channels);
+}
+
+/* same as decode_ffmpeg, but keeps the codec's precision (float codecs aren't quantized to PCM16) */
+void decode_ffmpeg_f32(VGMSTREAM *vgmstream, float * outbuf, int32_t samples_to_do, int channels) {
+    decode_ffmpeg_internal(vgmstream, NULL, outbuf, samples_to_do, channels);
+}
+
 
 /* ******************************************** */
 /* UTILS                                        */
@@ -9,6 +9,9 @@
  * - interleave: blocks and channels are handled externally (layouts) or internally (mixed channels)
  * - block header: none (external), normal (4 bytes of history 16b + step 8b + reserved 8b) or others; per channel/global
  * - expand type: IMA style or variations; low or high nibble first
+ *
+ * Since expansions only depend on the current step_index and nibble, they are precalculated into tables
+ * (one per variation), and decoders read their block's nibbles at once rather than one byte at a time.
  */
 
 static const int ADPCMTable[89] = {
@@ -31,187 +34,219 @@ static const int IMA_IndexTable[16] = {
     -1, -1, -1, -1, 2, 4, 6, 8 
 };
 
-
-/* Original IMA expansion, using shift+ADDs to avoid MULs (slow back then) */
-static void std_ima_expand_nibble(VGMSTREAMCHANNEL * stream, off_t byte_offset, int nibble_shift, int32_t * hist1, int32_t * step_index) {
-    int sample_nibble, sample_decoded, step, delta;
-
-    /* simplified through math from:
-     *  - diff = (code + 1/2) * (step / 4)
-     *   > diff = ((step * nibble) + (step / 2)) / 4
-     *    > diff = (step * nibble / 4) + (step / 8)
-     * final diff = [signed] (step / 8) + (step / 4) + (step / 2) + (step) [when code = 4+2+1] */
-
-    sample_nibble = (read_8bit(byte_offset,stream->streamfile) >> nibble_shift)&0xf; /* ADPCM code */
-    sample_decoded = *hist1; /* predictor value */
-    step = ADPCMTable[*step_index]; /* current step */
-
-    delta = step >> 3;
-    if (sample_nibble & 1) delta += step >> 2;
-    if (sample_nibble & 2) delta += step >> 1;
-    if (sample_nibble & 4) delta += step;
-    if (sample_nibble & 8) delta = -delta;
-    sample_decoded += delta;
-
-    *hist1 = clamp16(sample_decoded);
-    *step_index += IMA_IndexTable[sample_nibble];
-    if (*step_index < 0) *step_index=0;
-    if (*step_index > 88) *step_index=88;
-}
-
-/* Apple's IMA variation. Exactly the same except it uses 16b history (probably more sensitive to overflow/sign extend?) */
-static void std_ima_expand_nibble_16(VGMSTREAMCHANNEL * stream, off_t byte_offset, int nibble_shift, int16_t * hist1, int32_t * step_index) {
-    int sample_nibble, sample_decoded, step, delta;
-
-    sample_nibble = (read_8bit(byte_offset,stream->streamfile) >> nibble_shift)&0xf;
-    sample_decoded = *hist1;
-    step = ADPCMTable[*step_index];
-
-    delta = step >> 3;
-    if (sample_nibble & 1) delta += step >> 2;
-    if (sample_nibble & 2) delta += step >> 1;
-    if (sample_nibble & 4) delta += step;
-    if (sample_nibble & 8) delta = -delta;
-    sample_decoded += delta;
-
-    *hist1 = clamp16(sample_decoded); /* no need for this, actually */
-    *step_index += IMA_IndexTable[sample_nibble];
-    if (*step_index < 0) *step_index=0;
-    if (*step_index > 88) *step_index=88;
-}
-
-/* Original IMA expansion, but using MULs rather than shift+ADDs (faster for newer processors).
- * There is minor rounding difference between ADD and MUL expansions, noticeable/propagated in non-headered IMAs. */
-static void std_ima_expand_nibble_mul(VGMSTREAMCHANNEL * stream, off_t byte_offset, int nibble_shift, int32_t * hist1, int32_t * step_index) {
-    int sample_nibble, sample_decoded, step, delta;
-
-    /* simplified through math from:
-     *  - diff = (code + 1/2) * (step / 4)
-     *   > diff = (code + 1/2) * step) / 4) * (2 / 2)
-     *    > diff = (code + 1/2) * 2 * step / 8
-     * final diff = [signed] ((code * 2 + 1) * step) / 8 */
-
-    sample_nibble = (read_8bit(byte_offset,stream->streamfile) >> nibble_shift)&0xf;
-    sample_decoded = *hist1;
-    step = ADPCMTable[*step_index];
-
-    delta = (sample_nibble & 0x7);
-    delta = ((delta * 2 + 1) * step) >> 3;
-    if (sample_nibble & 8) delta = -delta;
-    sample_decoded += delta;
-
-    *hist1 = clamp16(sample_decoded);
-    *step_index += IMA_IndexTable[sample_nibble];
-    if (*step_index < 0) *step_index=0;
-    if (*step_index > 88) *step_index=88;
-}
-
-/* 3DS IMA (Mario Golf, Mario Tennis; maybe other Camelot games) */
-static void n3ds_ima_expand_nibble(VGMSTREAMCHANNEL * stream, off_t byte_offset, int nibble_shift, int32_t * hist1, int32_t * step_index) {
-    int sample_nibble, sample_decoded, step, delta;
-
-    sample_nibble = (read_8bit(byte_offset,stream->streamfile) >> nibble_shift)&0xf;
-    sample_decoded = *hist1;
-    step = ADPCMTable[*step_index];
-
-    sample_decoded = sample_decoded << 3;
-    delta = (sample_nibble & 0x07);
-    delta = step * delta * 2 + step; /* custom */
-    if (sample_nibble & 8) delta = -delta;
-    sample_decoded += delta;
-    sample_decoded = sample_decoded >> 3;
-
-    *hist1 = clamp16(sample_decoded);
-    *step_index += IMA_IndexTable[sample_nibble];
-    if (*step_index < 0) *step_index=0;
-    if (*step_index > 88) *step_index=88;
-}
-
-/* The Incredibles PC, updates step_index before doing current sample */
-static void snds_ima_expand_nibble(VGMSTREAMCHANNEL * stream, off_t byte_offset, int nibble_shift, int32_t * hist1, int32_t * step_index) {
-    int sample_nibble, sample_decoded, step, delta;
-
-    sample_nibble = (read_8bit(byte_offset,stream->streamfile) >> nibble_shift)&0xf;
-    sample_decoded = *hist1;
-
-    *step_index += IMA_IndexTable[sample_nibble];
-    if (*step_index < 0) *step_index=0;
-    if (*step_index > 88) *step_index=88;
-
-    step = ADPCMTable[*step_index];
-
-    delta = (sample_nibble & 7) * step / 4 + step / 8; /* standard IMA */
-    if (sample_nibble & 8) delta = -delta;
-    sample_decoded += delta;
-
-    *hist1 = clamp16(sample_decoded);
+#define IMA_READ_SIZE 0x400 /* bytes read at once when data can't be accessed directly */
+
+/* nibble expansions, all as "hist1 + delta" of current step_index and nibble */
+typedef enum {
+    IMA_EXPAND_STD,     /* original IMA */
+    IMA_EXPAND_MUL,     /* original IMA using MULs */
+    IMA_EXPAND_N3DS,
+    IMA_EXPAND_SNDS,
+    IMA_EXPAND_ALP,     /* also OTNS */
+    IMA_EXPAND_WV6,
+    IMA_EXPAND_BLITZ,
+    IMA_EXPAND_COUNT
+} ima_expand_t;
+
+/* per expansion, step_index*16 + nibble = delta << 8 | next step_index (const, so decoders in
+ * different threads can share them) */
+#include "ima_decoder_data.h"
+
+
+#if 0
+/* Reference expansions the tables are generated from, each entry being:
+ *   (get_ima_delta(expand, step_index, nibble) * 256) | clamp(step_index + IMA_IndexTable[nibble], 0, 88)
+ * New variations should be added here and the tables regenerated. */
+static int32_t get_ima_delta(ima_expand_t expand, int step_index, int sample_nibble) {
+    int step = ADPCMTable[step_index]; /* current step */
+    int delta;
+
+    switch(expand) {
+        /* Original IMA expansion, using shift+ADDs to avoid MULs (slow back then) */
+        case IMA_EXPAND_STD:
+            /* simplified through math from:
+             *  - diff = (code + 1/2) * (step / 4)
+             *   > diff = ((step * nibble) + (step / 2)) / 4
+             *    > diff = (step * nibble / 4) + (step / 8)
+             * final diff = [signed] (step / 8) + (step / 4) + (step / 2) + (step) [when code = 4+2+1] */
+            delta = step >> 3;
+            if (sample_nibble & 1) delta += step >> 2;
+            if (sample_nibble & 2) delta += step >> 1;
+            if (sample_nibble & 4) delta += step;
+            if (sample_nibble & 8) delta = -delta;
+            return delta;
+
+        /* Original IMA expansion, but using MULs rather than shift+ADDs (faster for newer processors).
+         * There is minor rounding difference between ADD and MUL expansions, noticeable/propagated in non-headered IMAs. */
+        case IMA_EXPAND_MUL:
+            /* simplified through math from:
+             *  - diff = (code + 1/2) * (step / 4)
+             *   > diff = (code + 1/2) * step) / 4) * (2 / 2)
+             *    > diff = (code + 1/2) * 2 * step / 8
+             * final diff = [signed] ((code * 2 + 1) * step) / 8 */
+            delta = (sample_nibble & 0x7);
+            delta = ((delta * 2 + 1) * step) >> 3;
+            if (sample_nibble & 8) delta = -delta;
+            return delta;
+
+        /* 3DS IMA (Mario Golf, Mario Tennis; maybe other Camelot games), originally done as
+         * ((hist1 << 3) + delta) >> 3, same as hist1 + (delta >> 3) */
+        case IMA_EXPAND_N3DS:
+            delta = (sample_nibble & 0x07);
+            delta = step * delta * 2 + step; /* custom */
+            if (sample_nibble & 8) delta = -delta;
+            return delta >> 3;
+
+        /* The Incredibles PC, updates step_index before doing current sample */
+        case IMA_EXPAND_SNDS:
+            step_index += IMA_IndexTable[sample_nibble];
+            if (step_index < 0) step_index=0;
+            if (step_index > 88) step_index=88;
+            step = ADPCMTable[step_index];
+
+            delta = (sample_nibble & 7) * step / 4 + step / 8; /* standard IMA */
+            if (sample_nibble & 8) delta = -delta;
+            return delta;
+
+        /* Lego Racers (PC) .TUN variation, reverse engineered from the .exe. Omikron: The Nomad Soul
+         * (from the .exe) does step*4 + step*2 + step per bit then >> 2, which is the same. */
+        case IMA_EXPAND_ALP:
+            delta = (sample_nibble & 0x7);
+            delta = (delta * step) >> 2;
+            if (sample_nibble & 8) delta = -delta;
+            return delta;
+
+        /* Fairly OddParents (PC) .WV6: minor variation, reverse engineered from the .exe */
+        case IMA_EXPAND_WV6:
+            delta = (sample_nibble & 0x7);
+            delta = ((delta * step) >> 3) + ((delta * step) >> 2);
+            if (sample_nibble & 8) delta = -delta;
+            return delta;
+
+        /* Yet another IMA expansion, from the exe (hist isn't clamped, see decoder) */
+        case IMA_EXPAND_BLITZ:
+            /* table has 2 different values, not enough to bother adding the full table */
+            if (step == 22385)
+                step = 22358;
+            else if (step == 24623)
+                step = 24633;
+
+            delta = (sample_nibble & 0x07);
+            if (sample_nibble & 8) delta = -delta;
+            delta = (step >> 1) + delta * step; /* custom */
+            return delta;
+
+        default:
+            return 0;
+    }
 }
-
-/* Omikron: The Nomad Soul, algorithm from the .exe */
-static void otns_ima_expand_nibble(VGMSTREAMCHANNEL * stream, off_t byte_offset, int nibble_shift, int32_t * hist1, int32_t * step_index) {
-    int sample_nibble, sample_decoded, step, delta;
-
-    sample_nibble = (read_8bit(byte_offset,stream->streamfile) >> nibble_shift)&0xf;
-    sample_decoded = *hist1;
-    step = ADPCMTable[*step_index];
-
-    delta = 0;
-    if(sample_nibble & 4) delta = step * 4;
-    if(sample_nibble & 2) delta += step * 2;
-    if(sample_nibble & 1) delta += step;
-    delta >>= 2;
-    if (sample_nibble & 8) delta = -delta;
-    sample_decoded += delta;
-
-    *hist1 = clamp16(sample_decoded);
-    *step_index += IMA_IndexTable[sample_nibble];
-    if (*step_index < 0) *step_index=0;
-    if (*step_index > 88) *step_index=88;
+#endif
+
+
+/* where a channel's nibbles are found */
+typedef struct {
+    off_t offset;           /* first byte of the channel's nibbles */
+    int chunk_size;         /* bytes of this channel before other channels' (0 = all bytes are from this channel) */
+    int chunk_skip;         /* bytes of other channels after each chunk */
+    int is_high_first;      /* high nibble decodes first */
+    int is_byte_nibble;     /* one nibble per byte (stereo IMA), at nibble_shift */
+    int nibble_shift;
+} ima_layout_t;
+
+/* byte of a nibble number within the layout */
+static off_t get_ima_nibble_pos(const ima_layout_t * layout, int nibble) {
+    if (layout->is_byte_nibble)
+        return nibble;
+    if (layout->chunk_size)
+        return (nibble / (layout->chunk_size*2)) * (layout->chunk_size + layout->chunk_skip) + (nibble % (layout->chunk_size*2)) / 2;
+    return nibble / 2;
 }
 
-/* Fairly OddParents (PC) .WV6: minor variation, reverse engineered from the .exe */
-static void wv6_ima_expand_nibble(VGMSTREAMCHANNEL * stream, off_t byte_offset, int nibble_shift, int32_t * hist1, int32_t * step_index) {
-    int sample_nibble, sample_decoded, step, delta;
-
-    sample_nibble = (read_8bit(byte_offset,stream->streamfile) >> nibble_shift)&0xf;
-    sample_decoded = *hist1;
-    step = ADPCMTable[*step_index];
-
-    delta = (sample_nibble & 0x7);
-    delta = ((delta * step) >> 3) + ((delta * step) >> 2);
-    if (sample_nibble & 8) delta = -delta;
-    sample_decoded += delta;
-
-    *hist1 = clamp16(sample_decoded);
-    *step_index += IMA_IndexTable[sample_nibble];
-    if (*step_index < 0) *step_index=0;
-    if (*step_index > 88) *step_index=88;
+/* reads bytes, leaving unread bytes (past EOF) as -1 like read_8bit */
+static void read_ima_bytes(uint8_t * buf, off_t offset, size_t length, STREAMFILE *streamFile) {
+    size_t bytes = read_streamfile(buf, offset, length, streamFile);
+    if (bytes < length)
+        memset(buf + bytes, 0xFF, length - bytes);
 }
 
-/* Lego Racers (PC) .TUN variation, reverse engineered from the .exe */
-static void alp_ima_expand_nibble(VGMSTREAMCHANNEL * stream, off_t byte_offset, int nibble_shift, int32_t * hist1, int32_t * step_index) {
-    int sample_nibble, sample_decoded, step, delta;
+/* Decodes nibbles (first_nibble is relative to the layout's offset) with one of the expand tables,
+ * reading all needed bytes at once when possible. Samples aren't written if outbuf is NULL. */
+static void decode_ima_nibbles(VGMSTREAMCHANNEL * stream, const ima_layout_t * layout, ima_expand_t expand,
+        int first_nibble, int nibbles_to_do, sample_t * outbuf, int channelspacing, int32_t * hist1, int * step_index) {
+    uint8_t buf[IMA_READ_SIZE];
+    const uint8_t * data = NULL;
+    const int32_t * table;
+    off_t pos, last_pos, data_pos = 0, data_end = 0;
+    int i, chunk_left, sample_count = 0;
+    int32_t hist = *hist1;
+    int index = *step_index;
+    int is_clamped = (expand != IMA_EXPAND_BLITZ); /* somehow Blitz's exe tries to clamp hist, but actually doesn't (bug?) */
+
+    if (nibbles_to_do <= 0)
+        return;
+
+    table = ima_expand_tables[expand];
+
+    /* table only has valid indexes (decoders clamp headers, but some streams may be wrong) */
+    if (index < 0) index=0;
+    if (index > 88) index=88;
+
+    pos = get_ima_nibble_pos(layout, first_nibble);
+    last_pos = get_ima_nibble_pos(layout, first_nibble + nibbles_to_do - 1);
+    chunk_left = layout->chunk_size ? layout->chunk_size*2 - first_nibble % (layout->chunk_size*2) : 0;
+
+    for (i = first_nibble; i < first_nibble + nibbles_to_do; i++) {
+        int sample_nibble, entry;
+
+        /* get next bytes when needed */
+        if (pos < data_pos || pos >= data_end) {
+            data_pos = pos;
+            data_end = last_pos + 1;
+            data = get_streamfile_data(layout->offset + data_pos, data_end - data_pos, stream->streamfile);
+            if (!data) {
+                if (data_end - data_pos > IMA_READ_SIZE)
+                    data_end = data_pos + IMA_READ_SIZE;
+                read_ima_bytes(buf, layout->offset + data_pos, data_end - data_pos, stream->streamfile);
+                data = buf;
+            }
+        }
 
-    sample_nibble = (read_8bit(byte_offset,stream->streamfile) >> nibble_shift)&0xf;
-    sample_decoded = *hist1;
-    step = ADPCMTable[*step_index];
+        if (layout->is_byte_nibble)
+            sample_nibble = (data[pos - data_pos] >> layout->nibble_shift) & 0xf;
+        else
+            sample_nibble = ((i & 1) ^ layout->is_high_first) ? /* even = first */
+                    (data[pos - data_pos] >> 4) & 0xf :
+                    (data[pos - data_pos] >> 0) & 0xf;
+
+        entry = table[index*16 + sample_nibble];
+        hist += (entry >> 8);
+        if (is_clamped)
+            hist = clamp16(hist);
+        index = entry & 0xFF;
+
+        if (outbuf) {
+            outbuf[sample_count] = (short)(hist);
+            sample_count += channelspacing;
+        }
 
-    delta = (sample_nibble & 0x7);
-    delta = (delta * step) >> 2;
-    if (sample_nibble & 8) delta = -delta;
-    sample_decoded += delta;
+        /* move to next nibble's byte */
+        if (layout->is_byte_nibble || (i & 1))
+            pos++;
+        if (chunk_left && --chunk_left == 0) {
+            pos += layout->chunk_skip;
+            chunk_left = layout->chunk_size*2;
+        }
+    }
 
-    *hist1 = clamp16(sample_decoded);
-    *step_index += IMA_IndexTable[sample_nibble];
-    if (*step_index < 0) *step_index=0;
-    if (*step_index > 88) *step_index=88;
+    *hist1 = hist;
+    *step_index = index;
 }
 
 /* FFTA2 IMA, different hist and sample rounding, reverse engineered from the ROM */
-static void ffta2_ima_expand_nibble(VGMSTREAMCHANNEL * stream, off_t byte_offset, int nibble_shift, int32_t * hist1, int32_t * step_index, int16_t *out_sample) {
+static void ffta2_ima_expand_nibble(uint8_t byte, int nibble_shift, int32_t * hist1, int32_t * step_index, int16_t *out_sample) {
     int sample_nibble, sample_decoded, step, delta;
 
-    sample_nibble = (read_8bit(byte_offset,stream->streamfile) >> nibble_shift)&0xf; /* ADPCM code */
+    sample_nibble = (byte >> nibble_shift)&0xf; /* ADPCM code */
     sample_decoded = *hist1; /* predictor value */
     step = ADPCMTable[*step_index] * 0x100; /* current step (table in ROM is pre-multiplied though) */
 
@@ -236,33 +271,6 @@ static void ffta2_ima_expand_nibble(VGMSTREAMCHANNEL * stream, off_t byte_offset
     if (*step_index > 88) *step_index=88;
 }
 
-/* Yet another IMA expansion, from the exe */
-static void blitz_ima_expand_nibble(VGMSTREAMCHANNEL * stream, off_t byte_offset, int nibble_shift, int32_t * hist1, int32_t * step_index) {
-    int sample_nibble, sample_decoded, step, delta;
-
-    sample_nibble = (read_8bit(byte_offset,stream->streamfile) >> nibble_shift)&0xf; /* ADPCM code */
-    sample_decoded = *hist1; /* predictor value */
-    step = ADPCMTable[*step_index]; /* current step */
-
-    /* table has 2 different values, not enough to bother adding the full table */
-    if (step == 22385)
-        step = 22358;
-    else if (step == 24623)
-        step = 24633;
-
-    delta = (sample_nibble & 0x07);
-    if (sample_nibble & 8) delta = -delta;
-    delta = (step >> 1) + delta * step; /* custom */
-    sample_decoded += delta;
-
-    /* somehow the exe tries to clamp hist, but actually doesn't (bug?),
-     * not sure if pcm buffer would be clamped outside though */
-    *hist1 = sample_decoded;//clamp16(sample_decoded);
-    *step_index += IMA_IndexTable[sample_nibble];
-    if (*step_index < 0) *step_index=0;
-    if (*step_index > 88) *step_index=88;
-}
-
 /* ************************************ */
 /* DVI/IMA                              */
 /* ************************************ */
@@ -271,7 +279,7 @@ static void blitz_ima_expand_nibble(VGMSTREAMCHANNEL * stream, off_t byte_offset
  * Configurable: stereo or mono/interleave nibbles, and high or low nibble first.
  * For vgmstream, low nibble is called "IMA ADPCM" and high nibble is "DVI IMA ADPCM" (same thing though). */
 void decode_standard_ima(VGMSTREAMCHANNEL * stream, sample_t * outbuf, int channelspacing, int32_t first_sample, int32_t samples_to_do, int channel, int is_stereo, int is_high_first) {
-    int i, sample_count = 0;
+    ima_layout_t layout = {0};
     int32_t hist1 = stream->adpcm_history1_32;
     int step_index = stream->adpcm_step_index;
 
@@ -282,24 +290,25 @@ void decode_standard_ima(VGMSTREAMCHANNEL * stream, sample_t * outbuf, int chann
     if (step_index > 88) step_index=88;
 
     /* decode nibbles (layout: varies) */
-    for (i = first_sample; i < first_sample + samples_to_do; i++, sample_count += channelspacing) {
-        off_t byte_offset = is_stereo ?
-                stream->offset + i :    /* stereo: one nibble per channel */
-                stream->offset + i/2;   /* mono: consecutive nibbles */
-        int nibble_shift = is_high_first ?
-                is_stereo ? (!(channel&1) ? 4:0) : (!(i&1) ? 4:0) : /* even = high, odd = low */
-                is_stereo ? (!(channel&1) ? 0:4) : (!(i&1) ? 0:4);  /* even = low, odd = high */
-
-        std_ima_expand_nibble(stream, byte_offset,nibble_shift, &hist1, &step_index);
-        outbuf[sample_count] = (short)(hist1);
+    layout.offset = stream->offset;
+    if (is_stereo) { /* stereo: one nibble per channel */
+        layout.is_byte_nibble = 1;
+        layout.nibble_shift = is_high_first ?
+                (!(channel&1) ? 4:0) :  /* even = high, odd = low */
+                (!(channel&1) ? 0:4);   /* even = low, odd = high */
+    }
+    else { /* mono: consecutive nibbles */
+        layout.is_high_first = is_high_first;
     }
 
+    decode_ima_nibbles(stream, &layout, IMA_EXPAND_STD, first_sample, samples_to_do, outbuf, channelspacing, &hist1, &step_index);
+
     stream->adpcm_history1_32 = hist1;
     stream->adpcm_step_index = step_index;
 }
 
 void decode_3ds_ima(VGMSTREAMCHANNEL * stream, sample_t * outbuf, int channelspacing, int32_t first_sample, int32_t samples_to_do) {
-    int i, sample_count;
+    ima_layout_t layout = {0};
     int32_t hist1 = stream->adpcm_history1_32;
     int step_index = stream->adpcm_step_index;
 
@@ -307,20 +316,15 @@ void decode_3ds_ima(VGMSTREAMCHANNEL * stream, sample_t * outbuf, int channelspa
 
     //no header
 
-    for (i=first_sample,sample_count=0; i<first_sample+samples_to_do; i++,sample_count+=channelspacing) {
-        off_t byte_offset = stream->offset + i/2;
-        int nibble_shift = (i&1?4:0); //low nibble order
-
-        n3ds_ima_expand_nibble(stream, byte_offset,nibble_shift, &hist1, &step_index);
-        outbuf[sample_count] = (short)(hist1);
-    }
+    layout.offset = stream->offset; //low nibble order
+    decode_ima_nibbles(stream, &layout, IMA_EXPAND_N3DS, first_sample, samples_to_do, outbuf, channelspacing, &hist1, &step_index);
 
     stream->adpcm_history1_32 = hist1;
     stream->adpcm_step_index = step_index;
 }
 
 void decode_snds_ima(VGMSTREAMCHANNEL * stream, sample_t * outbuf, int channelspacing, int32_t first_sample, int32_t samples_to_do, int channel) {
-    int i, sample_count;
+    ima_layout_t layout = {0};
     int32_t hist1 = stream->adpcm_history1_32;
     int step_index = stream->adpcm_step_index;
 
@@ -328,20 +332,17 @@ void decode_snds_ima(VGMSTREAMCHANNEL * stream, sample_t * outbuf, int channelsp
 
     //no header
 
-    for (i=first_sample,sample_count=0; i<first_sample+samples_to_do; i++,sample_count+=channelspacing) {
-        off_t byte_offset = stream->offset + i;//one nibble per channel
-        int nibble_shift = (channel==0?0:4); //high nibble first, based on channel
-
-        snds_ima_expand_nibble(stream, byte_offset,nibble_shift, &hist1, &step_index);
-        outbuf[sample_count] = (short)(hist1);
-    }
+    layout.offset = stream->offset;
+    layout.is_byte_nibble = 1; //one nibble per channel
+    layout.nibble_shift = (channel==0?0:4); //high nibble first, based on channel
+    decode_ima_nibbles(stream, &layout, IMA_EXPAND_SNDS, first_sample, samples_to_do, outbuf, channelspacing, &hist1, &step_index);
 
     stream->adpcm_history1_32 = hist1;
     stream->adpcm_step_index = step_index;
 }
 
 void decode_otns_ima(VGMSTREAM * vgmstream, VGMSTREAMCHANNEL * stream, sample_t * outbuf, int channelspacing, int32_t first_sample, int32_t samples_to_do, int channel) {
-    int i, sample_count;
+    ima_layout_t layout = {0};
     int32_t hist1 = stream->adpcm_history1_32;
     int step_index = stream->adpcm_step_index;
 
@@ -349,15 +350,15 @@ void decode_otns_ima(VGMSTREAM * vgmstream, VGMSTREAMCHANNEL * stream, sample_t
 
     //no header
 
-    for (i=first_sample,sample_count=0; i<first_sample+samples_to_do; i++,sample_count+=channelspacing) {
-        off_t byte_offset = stream->offset + (vgmstream->channels==1 ? i/2 : i); //one nibble per channel if stereo
-        int nibble_shift = (vgmstream->channels==1) ? //todo simplify
-                    (i&1?0:4) : //high nibble first(?)
-                    (channel==0?4:0); //low=ch0, high=ch1 (this is correct compared to vids)
-
-        otns_ima_expand_nibble(stream, byte_offset,nibble_shift, &hist1, &step_index);
-        outbuf[sample_count] = (short)(hist1);
+    layout.offset = stream->offset;
+    if (vgmstream->channels==1) {
+        layout.is_high_first = 1; //high nibble first(?)
+    }
+    else {
+        layout.is_byte_nibble = 1; //one nibble per channel if stereo
+        layout.nibble_shift = (channel==0?4:0); //low=ch0, high=ch1 (this is correct compared to vids)
     }
+    decode_ima_nibbles(stream, &layout, IMA_EXPAND_ALP, first_sample, samples_to_do, outbuf, channelspacing, &hist1, &step_index);
 
     stream->adpcm_history1_32 = hist1;
     stream->adpcm_step_index = step_index;
@@ -365,7 +366,7 @@ void decode_otns_ima(VGMSTREAM * vgmstream, VGMSTREAMCHANNEL * stream, sample_t
 
 /* WV6 IMA, DVI IMA with custom nibble expand */
 void decode_wv6_ima(VGMSTREAMCHANNEL * stream, sample_t * outbuf, int channelspacing, int32_t first_sample, int32_t samples_to_do) {
-    int i, sample_count;
+    ima_layout_t layout = {0};
     int32_t hist1 = stream->adpcm_history1_32;
     int step_index = stream->adpcm_step_index;
 
@@ -373,13 +374,9 @@ void decode_wv6_ima(VGMSTREAMCHANNEL * stream, sample_t * outbuf, int channelspa
 
     //no header
 
-    for (i=first_sample,sample_count=0; i<first_sample+samples_to_do; i++,sample_count+=channelspacing) {
-        off_t byte_offset = stream->offset + i/2;
-        int nibble_shift = (i&1?0:4); //high nibble first
-
-        wv6_ima_expand_nibble(stream, byte_offset,nibble_shift, &hist1, &step_index);
-        outbuf[sample_count] = (short)(hist1);
-    }
+    layout.offset = stream->offset;
+    layout.is_high_first = 1; //high nibble first
+    decode_ima_nibbles(stream, &layout, IMA_EXPAND_WV6, first_sample, samples_to_do, outbuf, channelspacing, &hist1, &step_index);
 
     stream->adpcm_history1_32 = hist1;
     stream->adpcm_step_index = step_index;
@@ -387,7 +384,7 @@ void decode_wv6_ima(VGMSTREAMCHANNEL * stream, sample_t * outbuf, int channelspa
 
 /* ALT IMA, DVI IMA with custom nibble expand */
 void decode_alp_ima(VGMSTREAMCHANNEL * stream, sample_t * outbuf, int channelspacing, int32_t first_sample, int32_t samples_to_do) {
-    int i, sample_count;
+    ima_layout_t layout = {0};
     int32_t hist1 = stream->adpcm_history1_32;
     int step_index = stream->adpcm_step_index;
 
@@ -395,13 +392,9 @@ void decode_alp_ima(VGMSTREAMCHANNEL * stream, sample_t * outbuf, int channelspa
 
     //no header
 
-    for (i=first_sample,sample_count=0; i<first_sample+samples_to_do; i++,sample_count+=channelspacing) {
-        off_t byte_offset = stream->offset + i/2;
-        int nibble_shift = (i&1?0:4); //high nibble first
-
-        alp_ima_expand_nibble(stream, byte_offset,nibble_shift, &hist1, &step_index);
-        outbuf[sample_count] = (short)(hist1);
-    }
+    layout.offset = stream->offset;
+    layout.is_high_first = 1; //high nibble first
+    decode_ima_nibbles(stream, &layout, IMA_EXPAND_ALP, first_sample, samples_to_do, outbuf, channelspacing, &hist1, &step_index);
 
     stream->adpcm_history1_32 = hist1;
     stream->adpcm_step_index = step_index;
@@ -409,20 +402,30 @@ void decode_alp_ima(VGMSTREAMCHANNEL * stream, sample_t * outbuf, int channelspa
 
 /* FFTA2 IMA, DVI IMA with custom nibble expand/rounding */
 void decode_ffta2_ima(VGMSTREAMCHANNEL * stream, sample_t * outbuf, int channelspacing, int32_t first_sample, int32_t samples_to_do) {
+    uint8_t buf[IMA_READ_SIZE];
     int i, sample_count;
     int32_t hist1 = stream->adpcm_history1_32;
     int step_index = stream->adpcm_step_index;
     int16_t out_sample;
+    off_t data_pos = 0, data_end = 0;
 
     //external interleave
 
     //no header
 
     for (i=first_sample,sample_count=0; i<first_sample+samples_to_do; i++,sample_count+=channelspacing) {
-        off_t byte_offset = stream->offset + i/2;
+        off_t byte_pos = i/2;
         int nibble_shift = (i&1?0:4); //high nibble first
 
-        ffta2_ima_expand_nibble(stream, byte_offset,nibble_shift, &hist1, &step_index, &out_sample);
+        if (byte_pos < data_pos || byte_pos >= data_end) {
+            data_pos = byte_pos;
+            data_end = (first_sample + samples_to_do - 1)/2 + 1;
+            if (data_end - data_pos > IMA_READ_SIZE)
+                data_end = data_pos + IMA_READ_SIZE;
+            read_ima_bytes(buf, stream->offset + data_pos, data_end - data_pos, stream->streamfile);
+        }
+
+        ffta2_ima_expand_nibble(buf[byte_pos - data_pos], nibble_shift, &hist1, &step_index, &out_sample);
         outbuf[sample_count] = out_sample;
     }
 
@@ -432,7 +435,7 @@ void decode_ffta2_ima(VGMSTREAMCHANNEL * stream, sample_t * outbuf, int channels
 
 /* Blitz IMA, IMA with custom nibble expand */
 void decode_blitz_ima(VGMSTREAMCHANNEL * stream, sample_t * outbuf, int channelspacing, int32_t first_sample, int32_t samples_to_do) {
-    int i, sample_count;
+    ima_layout_t layout = {0};
     int32_t hist1 = stream->adpcm_history1_32;
     int step_index = stream->adpcm_step_index;
 
@@ -440,13 +443,8 @@ void decode_blitz_ima(VGMSTREAMCHANNEL * stream, sample_t * outbuf, int channels
 
     //no header
 
-    for (i=first_sample,sample_count=0; i<first_sample+samples_to_do; i++,sample_count+=channelspacing) {
-        off_t byte_offset = stream->offset + i/2;
-        int nibble_shift = (i&1?4:0); //low nibble first
-
-        blitz_ima_expand_nibble(stream, byte_offset,nibble_shift, &hist1, &step_index);
-        outbuf[sample_count] = (short)(hist1);
-    }
+    layout.offset = stream->offset; //low nibble first
+    decode_ima_nibbles(stream, &layout, IMA_EXPAND_BLITZ, first_sample, samples_to_do, outbuf, channelspacing, &hist1, &step_index);
 
     stream->adpcm_history1_32 = hist1;
     stream->adpcm_step_index = step_index;
@@ -460,7 +458,8 @@ void decode_blitz_ima(VGMSTREAMCHANNEL * stream, sample_t * outbuf, int channels
  * so to simplify calcs this decodes full frames, thus hist doesn't need to be mantained.
  * Officially defined in "Microsoft Multimedia Standards Update" doc (RIFFNEW.pdf). */
 void decode_ms_ima(VGMSTREAM * vgmstream, VGMSTREAMCHANNEL * stream, sample_t * outbuf, int channelspacing, int32_t first_sample, int32_t samples_to_do, int channel) {
-    int i, samples_read = 0, samples_done = 0, max_samples;
+    ima_layout_t layout = {0};
+    int samples_read = 0, samples_done = 0, max_samples, skip_samples;
     int32_t hist1;// = stream->adpcm_history1_32;
     int step_index;// = stream->adpcm_step_index;
 
@@ -490,18 +489,22 @@ void decode_ms_ima(VGMSTREAM * vgmstream, VGMSTREAMCHANNEL * stream, sample_t *
         max_samples = samples_to_do + first_sample - samples_done; /* for smaller last block */
 
     /* decode nibbles (layout: alternates 4 bytes/4*2 nibbles per channel) */
-    for (i = 0; i < max_samples; i++) {
-        off_t byte_offset = stream->offset + 0x04*vgmstream->channels + 0x04*channel + 0x04*vgmstream->channels*(i/8) + (i%8)/2;
-        int nibble_shift = (i&1?4:0); /* low nibble first */
-
-        std_ima_expand_nibble(stream, byte_offset,nibble_shift, &hist1, &step_index); /* original expand */
-
-        if (samples_read >= first_sample && samples_done < samples_to_do) {
-            outbuf[samples_done * channelspacing] = (short)(hist1);
-            samples_done++;
-        }
-        samples_read++;
-    }
+    layout.offset = stream->offset + 0x04*vgmstream->channels + 0x04*channel;
+    layout.chunk_size = 0x04;
+    layout.chunk_skip = 0x04*(vgmstream->channels - 1); /* low nibble first */
+
+    skip_samples = first_sample - samples_read; /* decoded from block start but not written */
+    if (skip_samples < 0)
+        skip_samples = 0;
+    if (skip_samples > max_samples)
+        skip_samples = max_samples;
+    decode_ima_nibbles(stream, &layout, IMA_EXPAND_STD, 0, skip_samples, NULL, channelspacing, &hist1, &step_index); /* original expand */
+
+    max_samples -= skip_samples;
+    if (max_samples > samples_to_do - samples_done)
+        max_samples = samples_to_do - samples_done;
+    decode_ima_nibbles(stream, &layout, IMA_EXPAND_STD, skip_samples, max_samples, outbuf + samples_done * channelspacing, channelspacing, &hist1, &step_index);
+    samples_done += max_samples;
 
     /* internal interleave: increment offset on complete frame */
     if (first_sample + samples_done == block_samples)  {
@@ -514,7 +517,8 @@ void decode_ms_ima(VGMSTREAM * vgmstream, VGMSTREAMCHANNEL * stream, sample_t *
 
 /* Reflection's MS-IMA with custom nibble layout (some info from XA2WAV by Deniz Oezmen) */
 void decode_ref_ima(VGMSTREAM * vgmstream, VGMSTREAMCHANNEL * stream, sample_t * outbuf, int channelspacing, int32_t first_sample, int32_t samples_to_do, int channel) {
-    int i, samples_read = 0, samples_done = 0, max_samples;
+    ima_layout_t layout = {0};
+    int samples_read = 0, samples_done = 0, max_samples, skip_samples;
     int32_t hist1;// = stream->adpcm_history1_32;
     int step_index;// = stream->adpcm_step_index;
 
@@ -545,18 +549,20 @@ void decode_ref_ima(VGMSTREAM * vgmstream, VGMSTREAMCHANNEL * stream, sample_t *
         max_samples = samples_to_do + first_sample - samples_done; /* for smaller last block */
 
     /* decode nibbles (layout: all nibbles from one channel, then other channels) */
-    for (i = 0; i < max_samples; i++) {
-        off_t byte_offset = stream->offset + 0x04*vgmstream->channels + block_channel_size*channel + i/2;
-        int nibble_shift = (i&1?4:0); /* low nibble first */
+    layout.offset = stream->offset + 0x04*vgmstream->channels + block_channel_size*channel; /* low nibble first */
 
-        std_ima_expand_nibble(stream, byte_offset,nibble_shift, &hist1, &step_index);
+    skip_samples = first_sample - samples_read; /* decoded from block start but not written */
+    if (skip_samples < 0)
+        skip_samples = 0;
+    if (skip_samples > max_samples)
+        skip_samples = max_samples;
+    decode_ima_nibbles(stream, &layout, IMA_EXPAND_STD, 0, skip_samples, NULL, channelspacing, &hist1, &step_index);
 
-        if (samples_read >= first_sample && samples_done < samples_to_do) {
-            outbuf[samples_done * channelspacing] = (short)(hist1);
-            samples_done++;
-        }
-        samples_read++;
-    }
+    max_samples -= skip_samples;
+    if (max_samples > samples_to_do - samples_done)
+        max_samples = samples_to_do - samples_done;
+    decode_ima_nibbles(stream, &layout, IMA_EXPAND_STD, skip_samples, max_samples, outbuf + samples_done * channelspacing, channelspacing, &hist1, &step_index);
+    samples_done += max_samples;
 
     /* internal interleave: increment offset on complete frame */
     if (first_sample + samples_done == block_samples)  {
@@ -574,7 +580,8 @@ void decode_ref_ima(VGMSTREAM * vgmstream, VGMSTREAMCHANNEL * stream, sample_t *
 /* MS-IMA with fixed frame size, and outputs an even number of samples per frame (skips last nibble).
  * Defined in Xbox's SDK. Usable in mono or stereo modes (both suitable for interleaved multichannel). */
 void decode_xbox_ima(VGMSTREAMCHANNEL * stream, sample_t * outbuf, int channelspacing, int32_t first_sample, int32_t samples_to_do, int channel, int is_stereo) {
-    int i, frames_in, sample_pos = 0, block_samples, frame_size;
+    ima_layout_t layout = {0};
+    int frames_in, sample_pos = 0, block_samples, frame_size;
     int32_t hist1 = stream->adpcm_history1_32;
     int step_index = stream->adpcm_step_index;
     off_t frame_offset;
@@ -606,27 +613,28 @@ void decode_xbox_ima(VGMSTREAMCHANNEL * stream, sample_t * outbuf, int channelsp
     }
 
     /* decode nibbles (layout: straight in mono or 4 bytes per channel in stereo) */
-    for (i = first_sample; i < first_sample + samples_to_do; i++) {
-        off_t byte_offset = is_stereo ?
-                frame_offset + 0x04*2 + 0x04*(channel % 2) + 0x04*2*((i-1)/8) + ((i-1)%8)/2 :
-                frame_offset + 0x04   + (i-1)/2;
-        int nibble_shift = (!((i-1)&1)   ? 0:4);   /* low first */
-
-        /* must skip last nibble per spec, rarely needed though (ex. Gauntlet Dark Legacy) */
-        if (i < block_samples) {
-            std_ima_expand_nibble(stream, byte_offset,nibble_shift, &hist1, &step_index);
-            outbuf[sample_pos] = (short)(hist1);
-            sample_pos += channelspacing;
-        }
+    if (is_stereo) {
+        layout.offset = frame_offset + 0x04*2 + 0x04*(channel % 2);
+        layout.chunk_size = 0x04;
+        layout.chunk_skip = 0x04;
+    }
+    else {
+        layout.offset = frame_offset + 0x04; /* low first */
     }
 
+    /* must skip last nibble per spec, rarely needed though (ex. Gauntlet Dark Legacy) */
+    if (first_sample + samples_to_do > block_samples)
+        samples_to_do = block_samples - first_sample;
+    decode_ima_nibbles(stream, &layout, IMA_EXPAND_STD, first_sample - 1, samples_to_do, outbuf + sample_pos, channelspacing, &hist1, &step_index);
+
     stream->adpcm_history1_32 = hist1;
     stream->adpcm_step_index = step_index;
 }
 
 /* Multichannel XBOX-IMA ADPCM, with all channels mixed in the same block (equivalent to multichannel MS-IMA; seen in .rsd XADP). */
 void decode_xbox_ima_mch(VGMSTREAMCHANNEL * stream, sample_t * outbuf, int channelspacing, int32_t first_sample, int32_t samples_to_do, int channel) {
-    int i, sample_count = 0, num_frame;
+    ima_layout_t layout = {0};
+    int sample_count = 0, num_frame;
     int32_t hist1 = stream->adpcm_history1_32;
     int step_index = stream->adpcm_step_index;
 
@@ -652,17 +660,14 @@ void decode_xbox_ima_mch(VGMSTREAMCHANNEL * stream, sample_t * outbuf, int chann
     }
 
     /* decode nibbles (layout: alternates 4 bytes/4*2 nibbles per channel) */
-    for (i = first_sample; i < first_sample + samples_to_do; i++) {
-        off_t byte_offset = (stream->offset + 0x24*channelspacing*num_frame + 0x04*channelspacing) + 0x04*channel + 0x04*channelspacing*((i-1)/8) + ((i-1)%8)/2;
-        int nibble_shift = ((i-1)&1?4:0); /* low nibble first */
-
-        /* must skip last nibble per spec, rarely needed though */
-        if (i < block_samples) {
-            std_ima_expand_nibble(stream, byte_offset,nibble_shift, &hist1, &step_index);
-            outbuf[sample_count] = (short)(hist1);
-            sample_count += channelspacing;
-        }
-    }
+    layout.offset = (stream->offset + 0x24*channelspacing*num_frame + 0x04*channelspacing) + 0x04*channel;
+    layout.chunk_size = 0x04;
+    layout.chunk_skip = 0x04*(channelspacing - 1); /* low nibble first */
+
+    /* must skip last nibble per spec, rarely needed though */
+    if (first_sample + samples_to_do > block_samples)
+        samples_to_do = block_samples - first_sample;
+    decode_ima_nibbles(stream, &layout, IMA_EXPAND_STD, first_sample - 1, samples_to_do, outbuf + sample_count, channelspacing, &hist1, &step_index);
 
     stream->adpcm_history1_32 = hist1;
     stream->adpcm_step_index = step_index;
@@ -672,7 +677,7 @@ void decode_xbox_ima_mch(VGMSTREAMCHANNEL * stream, sample_t * outbuf, int chann
  * Apparently clamps to -32767 unlike standard's -32768 (probably not noticeable).
  * Info here: http://problemkaputt.de/gbatek.htm#dssoundnotes */
 void decode_nds_ima(VGMSTREAMCHANNEL * stream, sample_t * outbuf, int channelspacing, int32_t first_sample, int32_t samples_to_do) {
-    int i, sample_count;
+    ima_layout_t layout = {0};
     int32_t hist1 = stream->adpcm_history1_32;
     int step_index = stream->adpcm_step_index;
 
@@ -689,21 +694,17 @@ void decode_nds_ima(VGMSTREAMCHANNEL * stream, sample_t * outbuf, int channelspa
     }
 
     /* decode nibbles (layout: all nibbles from the channel) */
-    for (i=first_sample,sample_count=0; i<first_sample+samples_to_do; i++,sample_count+=channelspacing) {
-        off_t byte_offset = stream->offset + 0x04 + i/2;
-        int nibble_shift = (i&1?4:0); /* low nibble first */
+    layout.offset = stream->offset + 0x04; /* low nibble first */
 
-        //todo waveform has minor deviations using known expands
-        std_ima_expand_nibble(stream, byte_offset,nibble_shift, &hist1, &step_index);
-        outbuf[sample_count] = (short)(hist1);
-    }
+    //todo waveform has minor deviations using known expands
+    decode_ima_nibbles(stream, &layout, IMA_EXPAND_STD, first_sample, samples_to_do, outbuf, channelspacing, &hist1, &step_index);
 
     stream->adpcm_history1_32 = hist1;
     stream->adpcm_step_index = step_index;
 }
 
 void decode_dat4_ima(VGMSTREAMCHANNEL * stream, sample_t * outbuf, int channelspacing, int32_t first_sample, int32_t samples_to_do) {
-    int i, sample_count;
+    ima_layout_t layout = {0};
     int32_t hist1 = stream->adpcm_history1_16;//todo unneeded 16?
     int step_index = stream->adpcm_step_index;
 
@@ -716,23 +717,19 @@ void decode_dat4_ima(VGMSTREAMCHANNEL * stream, sample_t * outbuf, int channelsp
         hist1 = read_16bitLE(header_offset,stream->streamfile);
         step_index = read_8bit(header_offset+2,stream->streamfile);
 
-        //todo clip step_index?
+        //todo clip step_index? (clamped when decoding nibbles)
     }
 
-    for (i=first_sample,sample_count=0; i<first_sample+samples_to_do; i++,sample_count+=channelspacing) {
-        off_t byte_offset = stream->offset + 4 + i/2;
-        int nibble_shift = (i&1?0:4); //high nibble first
-
-        std_ima_expand_nibble(stream, byte_offset,nibble_shift, &hist1, &step_index);
-        outbuf[sample_count] = (short)(hist1);
-    }
+    layout.offset = stream->offset + 4;
+    layout.is_high_first = 1; //high nibble first
+    decode_ima_nibbles(stream, &layout, IMA_EXPAND_STD, first_sample, samples_to_do, outbuf, channelspacing, &hist1, &step_index);
 
     stream->adpcm_history1_16 = hist1;
     stream->adpcm_step_index = step_index;
 }
 
 void decode_rad_ima(VGMSTREAM * vgmstream,VGMSTREAMCHANNEL * stream, sample_t * outbuf, int channelspacing, int32_t first_sample, int32_t samples_to_do,int channel) {
-    int i, sample_count;
+    ima_layout_t layout = {0};
     int32_t hist1 = stream->adpcm_history1_32;
     int step_index = stream->adpcm_step_index;
 
@@ -750,23 +747,20 @@ void decode_rad_ima(VGMSTREAM * vgmstream,VGMSTREAMCHANNEL * stream, sample_t *
         if (step_index > 88) step_index=88;
     }
 
-    for (i=first_sample,sample_count=0; i<first_sample+samples_to_do; i++,sample_count+=channelspacing) {
-        off_t byte_offset = stream->offset + 4*vgmstream->channels + channel + i/2*vgmstream->channels;
-        int nibble_shift = (i&1?4:0); //low nibble first
-
-        std_ima_expand_nibble(stream, byte_offset,nibble_shift, &hist1, &step_index);
-        outbuf[sample_count] = (short)(hist1);
-    }
+    layout.offset = stream->offset + 4*vgmstream->channels + channel;
+    layout.chunk_size = 1;
+    layout.chunk_skip = vgmstream->channels - 1; //low nibble first
+    decode_ima_nibbles(stream, &layout, IMA_EXPAND_STD, first_sample, samples_to_do, outbuf, channelspacing, &hist1, &step_index);
 
     //internal interleave: increment offset on complete frame
-    if (i == block_samples) stream->offset += vgmstream->interleave_block_size;
+    if (first_sample + samples_to_do == block_samples) stream->offset += vgmstream->interleave_block_size;
 
     stream->adpcm_history1_32 = hist1;
     stream->adpcm_step_index = step_index;
 }
 
 void decode_rad_ima_mono(VGMSTREAMCHANNEL * stream, sample_t * outbuf, int channelspacing, int32_t first_sample, int32_t samples_to_do) {
-    int i, sample_count;
+    ima_layout_t layout = {0};
     int32_t hist1 = stream->adpcm_history1_32;
     int step_index = stream->adpcm_step_index;
 
@@ -784,22 +778,19 @@ void decode_rad_ima_mono(VGMSTREAMCHANNEL * stream, sample_t * outbuf, int chann
         if (step_index > 88) step_index=88;
     }
 
-    for (i=first_sample,sample_count=0; i<first_sample+samples_to_do; i++,sample_count+=channelspacing) {
-        off_t byte_offset = stream->offset + 4 + i/2;
-        int nibble_shift = (i&1?4:0); //low nibble first
-
-        std_ima_expand_nibble(stream, byte_offset,nibble_shift, &hist1, &step_index);
-        outbuf[sample_count] = (short)(hist1);
-    }
+    layout.offset = stream->offset + 4; //low nibble first
+    decode_ima_nibbles(stream, &layout, IMA_EXPAND_STD, first_sample, samples_to_do, outbuf, channelspacing, &hist1, &step_index);
 
     stream->adpcm_history1_32 = hist1;
     stream->adpcm_step_index = step_index;
 }
 
-/* Apple's IMA4, a.k.a QuickTime IMA. 2 byte header and header sample is not written (setup only). */
+/* Apple's IMA4, a.k.a QuickTime IMA. 2 byte header and header sample is not written (setup only).
+ * Uses 16b history, but clamps the same as standard IMA (probably more sensitive to overflow/sign extend?) */
 void decode_apple_ima4(VGMSTREAMCHANNEL * stream, sample_t * outbuf, int channelspacing, int32_t first_sample, int32_t samples_to_do) {
-    int i, sample_count, num_frame;
-    int16_t hist1 = stream->adpcm_history1_16;//todo unneeded 16?
+    ima_layout_t layout = {0};
+    int num_frame;
+    int32_t hist1 = stream->adpcm_history1_16;//todo unneeded 16?
     int step_index = stream->adpcm_step_index;
 
     //external interleave
@@ -817,13 +808,8 @@ void decode_apple_ima4(VGMSTREAMCHANNEL * stream, sample_t * outbuf, int channel
         if (step_index > 88) step_index=88;
     }
 
-    for (i=first_sample,sample_count=0; i<first_sample+samples_to_do; i++,sample_count+=channelspacing) {
-        off_t byte_offset = (stream->offset + 0x22*num_frame + 0x2) + i/2;
-        int nibble_shift = (i&1?4:0); //low nibble first
-
-        std_ima_expand_nibble_16(stream, byte_offset,nibble_shift, &hist1, &step_index);
-        outbuf[sample_count] = (short)(hist1);
-    }
+    layout.offset = (stream->offset + 0x22*num_frame + 0x2); //low nibble first
+    decode_ima_nibbles(stream, &layout, IMA_EXPAND_STD, first_sample, samples_to_do, outbuf, channelspacing, &hist1, &step_index);
 
     stream->adpcm_history1_16 = hist1;
     stream->adpcm_step_index = step_index;
@@ -831,7 +817,8 @@ void decode_apple_ima4(VGMSTREAMCHANNEL * stream, sample_t * outbuf, int channel
 
 /* XBOX-IMA with modified data layout */
 void decode_fsb_ima(VGMSTREAM * vgmstream, VGMSTREAMCHANNEL * stream, sample_t * outbuf, int channelspacing, int32_t first_sample, int32_t samples_to_do,int channel) {
-    int i, sample_count = 0;
+    ima_layout_t layout = {0};
+    int sample_count = 0;
     int32_t hist1 = stream->adpcm_history1_32;
     int step_index = stream->adpcm_step_index;
 
@@ -857,20 +844,17 @@ void decode_fsb_ima(VGMSTREAM * vgmstream, VGMSTREAMCHANNEL * stream, sample_t *
     }
 
     /* decode nibbles (layout: 2 bytes/2*2 nibbles per channel) */
-    for (i = first_sample; i < first_sample + samples_to_do; i++) {
-        off_t byte_offset = stream->offset + 0x04*vgmstream->channels + 0x02*channel + (i-1)/4*2*vgmstream->channels + ((i-1)%4)/2;
-        int nibble_shift = ((i-1)&1?4:0); /* low nibble first */
-
-        /* must skip last nibble per official decoder, probably not needed though */
-        if (i < block_samples) {
-            std_ima_expand_nibble(stream, byte_offset,nibble_shift, &hist1, &step_index);
-            outbuf[sample_count] = (short)(hist1);
-            sample_count += channelspacing;
-        }
-    }
+    layout.offset = stream->offset + 0x04*vgmstream->channels + 0x02*channel;
+    layout.chunk_size = 0x02;
+    layout.chunk_skip = 0x02*(vgmstream->channels - 1); /* low nibble first */
+
+    /* must skip last nibble per official decoder, probably not needed though */
+    decode_ima_nibbles(stream, &layout, IMA_EXPAND_STD, first_sample - 1,
+            (first_sample + samples_to_do > block_samples) ? block_samples - first_sample : samples_to_do,
+            outbuf + sample_count, channelspacing, &hist1, &step_index);
 
     /* internal interleave: increment offset on complete frame */
-    if (i == block_samples) {
+    if (first_sample + samples_to_do == block_samples) {
         stream->offset += 0x24*vgmstream->channels;
     }
 
@@ -880,7 +864,8 @@ void decode_fsb_ima(VGMSTREAM * vgmstream, VGMSTREAMCHANNEL * stream, sample_t *
 
 /* mono XBOX-IMA with header endianness and alt nibble expand (per hcs's decompilation) */
 void decode_wwise_ima(VGMSTREAM * vgmstream, VGMSTREAMCHANNEL * stream, sample_t * outbuf, int channelspacing, int32_t first_sample, int32_t samples_to_do, int channel) {
-    int i, sample_count = 0, num_frame;
+    ima_layout_t layout = {0};
+    int sample_count = 0, num_frame;
     int32_t hist1 = stream->adpcm_history1_32;
     int step_index = stream->adpcm_step_index;
 
@@ -907,17 +892,12 @@ void decode_wwise_ima(VGMSTREAM * vgmstream, VGMSTREAMCHANNEL * stream, sample_t
     }
 
     /* decode nibbles (layout: all nibbles from one channel) */
-    for (i = first_sample; i < first_sample + samples_to_do; i++) {
-        off_t byte_offset = (stream->offset + 0x24*num_frame + 0x4) + (i-1)/2;
-        int nibble_shift = ((i-1)&1?4:0); /* low nibble first */
-
-        /* must skip last nibble like other XBOX-IMAs, often needed (ex. Bayonetta 2 sfx) */
-        if (i < block_samples) {
-            std_ima_expand_nibble_mul(stream, byte_offset,nibble_shift, &hist1, &step_index);
-            outbuf[sample_count] = (short)(hist1);
-            sample_count += channelspacing;
-        }
-    }
+    layout.offset = (stream->offset + 0x24*num_frame + 0x4); /* low nibble first */
+
+    /* must skip last nibble like other XBOX-IMAs, often needed (ex. Bayonetta 2 sfx) */
+    if (first_sample + samples_to_do > block_samples)
+        samples_to_do = block_samples - first_sample;
+    decode_ima_nibbles(stream, &layout, IMA_EXPAND_MUL, first_sample - 1, samples_to_do, outbuf + sample_count, channelspacing, &hist1, &step_index);
 
     stream->adpcm_history1_32 = hist1;
     stream->adpcm_step_index = step_index;
@@ -936,7 +916,7 @@ void decode_wwise_ima(VGMSTREAM * vgmstream, VGMSTREAMCHANNEL * stream, sample_t
 
 /* MS-IMA with possibly the XBOX-IMA model of even number of samples per block (more tests are needed) */
 void decode_awc_ima(VGMSTREAMCHANNEL * stream, sample_t * outbuf, int channelspacing, int32_t first_sample, int32_t samples_to_do) {
-    int i, sample_count;
+    ima_layout_t layout = {0};
 
     int32_t hist1 = stream->adpcm_history1_32;
     int step_index = stream->adpcm_step_index;
@@ -955,16 +935,11 @@ void decode_awc_ima(VGMSTREAMCHANNEL * stream, sample_t * outbuf, int channelspa
         if (step_index > 88) step_index=88;
     }
 
-    for (i=first_sample,sample_count=0; i<first_sample+samples_to_do; i++,sample_count+=channelspacing) {
-        off_t byte_offset = stream->offset + 4 + i/2;
-        int nibble_shift = (i&1?4:0); //low nibble first
-
-        std_ima_expand_nibble(stream, byte_offset,nibble_shift, &hist1, &step_index);
-        outbuf[sample_count] = (short)(hist1);
-    }
+    layout.offset = stream->offset + 4; //low nibble first
+    decode_ima_nibbles(stream, &layout, IMA_EXPAND_STD, first_sample, samples_to_do, outbuf, channelspacing, &hist1, &step_index);
 
     //internal interleave: increment offset on complete frame
-    if (i == block_samples) stream->offset += 0x800;
+    if (first_sample + samples_to_do == block_samples) stream->offset += 0x800;
 
     stream->adpcm_history1_32 = hist1;
     stream->adpcm_step_index = step_index;
@@ -973,6 +948,7 @@ void decode_awc_ima(VGMSTREAMCHANNEL * stream, sample_t * outbuf, int channelspa
 
 /* DVI stereo/mono with some mini header and sample output */
 void decode_ubi_ima(VGMSTREAMCHANNEL * stream, sample_t * outbuf, int channelspacing, int32_t first_sample, int32_t samples_to_do, int channel) {
+    ima_layout_t layout = {0};
     int i, sample_count = 0;
 
     int32_t hist1 = stream->adpcm_history1_32;
@@ -1017,18 +993,18 @@ void decode_ubi_ima(VGMSTREAMCHANNEL * stream, sample_t * outbuf, int channelspa
 
     first_sample -= 10; //todo fix hack (needed to adjust nibble offset below)
 
-    for (i = first_sample; i < first_sample + samples_to_do; i++, sample_count += channelspacing) {
-        off_t byte_offset = channelspacing == 1 ?
-                stream->offset + i/2 :  /* mono mode */
-                stream->offset + i;     /* stereo mode */
-        int nibble_shift = channelspacing == 1 ?
-                (!(i%2) ? 4:0) :        /* mono mode (high first) */
-                (channel==0 ? 4:0);     /* stereo mode (high=L,low=R) */
-
-        std_ima_expand_nibble_mul(stream, byte_offset,nibble_shift, &hist1, &step_index);
-        outbuf[sample_count] = (short)(hist1); /* all samples are written */
+    layout.offset = stream->offset;
+    if (channelspacing == 1) {
+        layout.is_high_first = 1;       /* mono mode (high first) */
+    }
+    else {
+        layout.is_byte_nibble = 1;      /* stereo mode (high=L,low=R) */
+        layout.nibble_shift = (channel==0 ? 4:0);
     }
 
+    /* all samples are written */
+    decode_ima_nibbles(stream, &layout, IMA_EXPAND_MUL, first_sample, samples_to_do, outbuf + sample_count, channelspacing, &hist1, &step_index);
+
     //external interleave
 
     stream->adpcm_history1_32 = hist1;
@@ -1039,7 +1015,8 @@ void decode_ubi_ima(VGMSTREAMCHANNEL * stream, sample_t * outbuf, int channelspa
  * tables mapping all standard IMA combinations (to optimize calculations), but decodes the same.
  * Based on HCS's and Nisto's reverse engineering in h4m_audio_decode. */
 void decode_h4m_ima(VGMSTREAMCHANNEL * stream, sample_t * outbuf, int channelspacing, int32_t first_sample, int32_t samples_to_do, int channel, uint16_t frame_format) {
-    int i, samples_done = 0;
+    ima_layout_t layout = {0};
+    int samples_done = 0;
     int32_t hist1 = stream->adpcm_history1_32;
     int step_index = stream->adpcm_step_index;
     size_t header_size;
@@ -1090,19 +1067,14 @@ void decode_h4m_ima(VGMSTREAMCHANNEL * stream, sample_t * outbuf, int channelspa
     }
 
     /* decode block nibbles */
-    for (i = first_sample; i < first_sample + samples_to_do; i++) {
-        off_t byte_offset = is_stereo ?
-                stream->offset + header_size + i :      /* stereo: one nibble per channel */
-                stream->offset + header_size + i/2;     /* mono: consecutive nibbles */
-        int nibble_shift = is_stereo ?
-                (!(channel&1) ? 0:4) :                  /* stereo: L=low, R=high */
-                (!(i&1) ? 0:4);                         /* mono: low first */
-
-        std_ima_expand_nibble(stream, byte_offset,nibble_shift, &hist1, &step_index);
-
-        outbuf[samples_done * channelspacing] = (short)(hist1);
-        samples_done++;
+    layout.offset = stream->offset + header_size;
+    if (is_stereo) {
+        layout.is_byte_nibble = 1;                      /* stereo: one nibble per channel */
+        layout.nibble_shift = (!(channel&1) ? 0:4);     /* stereo: L=low, R=high */
     }
+    /* mono: consecutive nibbles, low first */
+
+    decode_ima_nibbles(stream, &layout, IMA_EXPAND_STD, first_sample, samples_to_do, outbuf + samples_done * channelspacing, channelspacing, &hist1, &step_index);
 
     stream->adpcm_history1_32 = hist1;
     stream->adpcm_step_index = step_index;
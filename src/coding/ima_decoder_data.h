@@ -0,0 +1,653 @@
+#ifndef _IMA_DECODER_DATA_H_
+#define _IMA_DECODER_DATA_H_
+
+/**
+ * IMA expansion tables, per expansion type (see ima_expand_t). Each entry is
+ * step_index*16 + nibble = delta << 8 | next step_index, with delta as get_ima_delta.
+ */
+
+/* ******************************************** */
+/* autogenerated                                */
+/* ******************************************** */
+
+static const int32_t ima_expand_tables[IMA_EXPAND_COUNT][89*16] = {
+    { /* IMA_EXPAND_STD */
+        0, 256, 768, 1024, 1794, 2052, 2566, 2824, 0, -256, -768, -1024, -1790, -2044, -2554, -2808,
+        256, 768, 1280, 1792, 2307, 2821, 3335, 3849, -256, -768, -1280, -1792, -2301, -2811, -3321, -3831,
+        257, 769, 1281, 1793, 2564, 3078, 3592, 4106, -255, -767, -1279, -1791, -2556, -3066, -3576, -4086,
+        258, 770, 1538, 2050, 2821, 3335, 4105, 4619, -254, -766, -1534, -2046, -2811, -3321, -4087, -4597,
+        259, 771, 1539, 2051, 3078, 3592, 4362, 4876, -253, -765, -1533, -2045, -3066, -3576, -4342, -4852,
+        260, 1028, 1796, 2564, 3335, 4105, 4875, 5645, -252, -1020, -1788, -2556, -3321, -4087, -4853, -5619,
+        261, 1029, 1797, 2565, 3592, 4362, 5132, 5902, -251, -1019, -1787, -2555, -3576, -4342, -5108, -5874,
+        262, 1030, 2054, 2822, 3849, 4619, 5645, 6415, -250, -1018, -2042, -2810, -3831, -4597, -5619, -6385,
+        519, 1543, 2567, 3591, 4618, 5644, 6670, 7696, -505, -1529, -2553, -3577, -4598, -5620, -6642, -7664,
+        520, 1544, 2568, 3592, 4875, 5901, 6927, 7953, -504, -1528, -2552, -3576, -4853, -5875, -6897, -7919,
+        521, 1545, 2825, 3849, 5388, 6414, 7696, 8722, -503, -1527, -2807, -3831, -5364, -6386, -7664, -8686,
+        522, 1802, 3082, 4362, 5901, 7183, 8465, 9747, -502, -1782, -3062, -4342, -5875, -7153, -8431, -9709,
+        523, 1803, 3339, 4619, 6414, 7696, 9234, 10516, -501, -1781, -3317, -4597, -6386, -7664, -9198, -10476,
+        780, 2316, 3852, 5388, 7183, 8721, 10259, 11797, -756, -2292, -3828, -5364, -7153, -8687, -10221, -11755,
+        781, 2573, 4365, 6157, 7952, 9746, 11540, 13334, -755, -2547, -4339, -6131, -7920, -9710, -11500, -13290,
+        782, 2574, 4622, 6414, 8721, 10515, 12565, 14359, -754, -2546, -4594, -6386, -8687, -10477, -12523, -14313,
+        1039, 3087, 5391, 7439, 9746, 11796, 14102, 16152, -1009, -3057, -5361, -7409, -9710, -11756, -14058, -16104,
+        1040, 3344, 5648, 7952, 10515, 12821, 15127, 17433, -1008, -3312, -5616, -7920, -10477, -12779, -15081, -17383,
+        1297, 3857, 6417, 8977, 11796, 14358, 16920, 19482, -1263, -3823, -6383, -8943, -11756, -14314, -16872, -19430,
+        1298, 4114, 6930, 9746, 12821, 15639, 18457, 21275, -1262, -4078, -6894, -9710, -12779, -15593, -18407, -21221,
+        1555, 4627, 7955, 11027, 14358, 17432, 20762, 23836, -1517, -4589, -7917, -10989, -14314, -17384, -20710, -23780,
+        1556, 4884, 8468, 11796, 15639, 18969, 22555, 25885, -1516, -4844, -8428, -11756, -15593, -18919, -22501, -25827,
+        1813, 5653, 9493, 13333, 17176, 21018, 24860, 28702, -1771, -5611, -9451, -13291, -17128, -20966, -24804, -28642,
+        2070, 6166, 10518, 14614, 18969, 23067, 27421, 31519, -2026, -6122, -10474, -14570, -18919, -23013, -27363, -31457,
+        2327, 6935, 11543, 16151, 21018, 25628, 30238, 34848, -2281, -6889, -11497, -16105, -20966, -25572, -30178, -34784,
+        2584, 7704, 12824, 17944, 23067, 28189, 33311, 38433, -2536, -7656, -12776, -17896, -23013, -28131, -33249, -38367,
+        2841, 8473, 14105, 19737, 25372, 31006, 36640, 42274, -2791, -8423, -14055, -19687, -25316, -30946, -36576, -42206,
+        3098, 9242, 15386, 21530, 27933, 34079, 40225, 46371, -3046, -9190, -15334, -21478, -27875, -34017, -40159, -46301,
+        3355, 10011, 16923, 23579, 30750, 37408, 44322, 50980, -3301, -9957, -16869, -23525, -30690, -37344, -44254, -50908,
+        3612, 11036, 18716, 26140, 33823, 41249, 48931, 56357, -3556, -10980, -18660, -26084, -33761, -41183, -48861, -56283,
+        4125, 12317, 20765, 28957, 37408, 45602, 54052, 62246, -4067, -12259, -20707, -28899, -37344, -45534, -53980, -62170,
+        4382, 13342, 22558, 31518, 40993, 49955, 59173, 68135, -4322, -13282, -22498, -31458, -40927, -49885, -59099, -68057,
+        4895, 14879, 24863, 34847, 45090, 55076, 65062, 75048, -4833, -14817, -24801, -34785, -45022, -55004, -64986, -74968,
+        5408, 16416, 27424, 38432, 49699, 60709, 71719, 82729, -5344, -16352, -27360, -38368, -49629, -60635, -71641, -82647,
+        5921, 17953, 30241, 42273, 54564, 66598, 78888, 90922, -5855, -17887, -30175, -42207, -54492, -66522, -78808, -90838,
+        6690, 20002, 33314, 46626, 60197, 73511, 86825, 100139, -6622, -19934, -33246, -46558, -60123, -73433, -86743, -100053,
+        7203, 21795, 36643, 51235, 66086, 80680, 95530, 110124, -7133, -21725, -36573, -51165, -66010, -80600, -95446, -110036,
+        7972, 24100, 40228, 56356, 72743, 88873, 105003, 121133, -7900, -24028, -40156, -56284, -72665, -88791, -104917, -121043,
+        8741, 26405, 44325, 61989, 80168, 97834, 115756, 133422, -8667, -26331, -44251, -61915, -80088, -97750, -115668, -133330,
+        9766, 29222, 48934, 68390, 88361, 107819, 127533, 146991, -9690, -29146, -48858, -68314, -88279, -107733, -127443, -146897,
+        10791, 32295, 53799, 75303, 97066, 118572, 140078, 161584, -10713, -32217, -53721, -75225, -96982, -118484, -139986, -161488,
+        11816, 35368, 59176, 82728, 106795, 130349, 154159, 177713, -11736, -35288, -59096, -82648, -106709, -130259, -154065, -177615,
+        13097, 39209, 65321, 91433, 117548, 143662, 169776, 195890, -13015, -39127, -65239, -91351, -117460, -143570, -169680, -195790,
+        14378, 43050, 71722, 100394, 129325, 157999, 186673, 215347, -14294, -42966, -71638, -100310, -129235, -157905, -186575, -215245,
+        15659, 47147, 78891, 110379, 142126, 173616, 205362, 236852, -15573, -47061, -78805, -110293, -142034, -173520, -205262, -236748,
+        17452, 52268, 87084, 121900, 156719, 191537, 226355, 261173, -17364, -52180, -86996, -121812, -156625, -191439, -226253, -261067,
+        18989, 57133, 95533, 133677, 172080, 210226, 248628, 286774, -18899, -57043, -95443, -133587, -171984, -210126, -248524, -286666,
+        21038, 63022, 105262, 147246, 189489, 231475, 273717, 315703, -20946, -62930, -105170, -147154, -189391, -231373, -273611, -315593,
+        23087, 69423, 115759, 162095, 208434, 254772, 301110, 347448, -22993, -69329, -115665, -162001, -208334, -254668, -301002, -347336,
+        25392, 76336, 127280, 178224, 229171, 280117, 331063, 382009, -25296, -76240, -127184, -178128, -229069, -280011, -330953, -381895,
+        27953, 84017, 140081, 196145, 252212, 308278, 364344, 420410, -27855, -83919, -139983, -196047, -252108, -308170, -364232, -420294,
+        30770, 92210, 153906, 215346, 277301, 338743, 400441, 461883, -30670, -92110, -153806, -215246, -277195, -338633, -400327, -461765,
+        33843, 101683, 169523, 237363, 305206, 373048, 440890, 508732, -33741, -101581, -169421, -237261, -305098, -372936, -440774, -508612,
+        37172, 111668, 186420, 260916, 335671, 410169, 484923, 559421, -37068, -111564, -186316, -260812, -335561, -410055, -484805, -559299,
+        41013, 122933, 205109, 287029, 369208, 451130, 533308, 615230, -40907, -122827, -205003, -286923, -369096, -451014, -533188, -615106,
+        45110, 135222, 225590, 315702, 406329, 496443, 586813, 676927, -45002, -135114, -225482, -315594, -406215, -496325, -586691, -676801,
+        49719, 149047, 248375, 347703, 447034, 546364, 645694, 745024, -49609, -148937, -248265, -347593, -446918, -546244, -645570, -744896,
+        54584, 163640, 272952, 382008, 491579, 600637, 709951, 819009, -54472, -163528, -272840, -381896, -491461, -600515, -709825, -818879,
+        59961, 180025, 300345, 420409, 540732, 660798, 781120, 901186, -59847, -179911, -300231, -420295, -540612, -660674, -780992, -901054,
+        66106, 198202, 330554, 462650, 595005, 727103, 859457, 991555, -65990, -198086, -330438, -462534, -594883, -726977, -859327, -991421,
+        72763, 218171, 363579, 508987, 654398, 799808, 945218, 1090628, -72645, -218053, -363461, -508869, -654274, -799680, -945086, -1090492,
+        79932, 239676, 399676, 559420, 719679, 879425, 1039427, 1199173, -79812, -239556, -399556, -559300, -719553, -879295, -1039293, -1199035,
+        87869, 263741, 439613, 615485, 791616, 967490, 1143364, 1319238, -87747, -263619, -439491, -615363, -791488, -967358, -1143228, -1319098,
+        96830, 290366, 483902, 677438, 870977, 1064515, 1258053, 1451591, -96706, -290242, -483778, -677314, -870847, -1064381, -1257915, -1451449,
+        106303, 319039, 532031, 744767, 958018, 1170756, 1383750, 1596488, -106177, -318913, -531905, -744641, -957886, -1170620, -1383610, -1596344,
+        117056, 351296, 585536, 819776, 1054019, 1288261, 1522503, 1756745, -116928, -351168, -585408, -819648, -1053885, -1288123, -1522361, -1756599,
+        128833, 386369, 644161, 901697, 1159492, 1417030, 1674824, 1932362, -128703, -386239, -644031, -901567, -1159356, -1416890, -1674680, -1932214,
+        141634, 425026, 708418, 991810, 1275205, 1558599, 1841993, 2125387, -141502, -424894, -708286, -991678, -1275067, -1558457, -1841847, -2125237,
+        155715, 467267, 779075, 1090627, 1402694, 1714248, 2026058, 2337612, -155581, -467133, -778941, -1090493, -1402554, -1714104, -2025910, -2337460,
+        171332, 514116, 857156, 1199940, 1542983, 1885769, 2228811, 2571597, -171196, -513980, -857020, -1199804, -1542841, -1885623, -2228661, -2571443,
+        188485, 565573, 942917, 1320005, 1697352, 2074442, 2451788, 2828878, -188347, -565435, -942779, -1319867, -1697208, -2074294, -2451636, -2828722,
+        207430, 622406, 1037382, 1452358, 1867337, 2282315, 2697293, 3112271, -207290, -622266, -1037242, -1452218, -1867191, -2282165, -2697139, -3112113,
+        228167, 684615, 1141063, 1597511, 2053962, 2510412, 2966862, 3423312, -228025, -684473, -1140921, -1597369, -2053814, -2510260, -2966706, -3423152,
+        250952, 752968, 1254984, 1757000, 2259275, 2761293, 3263311, 3765329, -250808, -752824, -1254840, -1756856, -2259125, -2761139, -3263153, -3765167,
+        276041, 828233, 1380681, 1932873, 2485324, 3037518, 3589968, 4142162, -275895, -828087, -1380535, -1932727, -2485172, -3037362, -3589808, -4141998,
+        303690, 911178, 1518666, 2126154, 2733901, 3341391, 3948881, 4556371, -303542, -911030, -1518518, -2126006, -2733747, -3341233, -3948719, -4556205,
+        334155, 1002315, 1670731, 2338891, 3007310, 3675472, 4343890, 5012052, -334005, -1002165, -1670581, -2338741, -3007154, -3675312, -4343726, -5011884,
+        367436, 1102412, 1837644, 2572620, 3308111, 4043089, 4778323, 5513301, -367284, -1102260, -1837492, -2572468, -3307953, -4042927, -4778157, -5513131,
+        404301, 1212749, 2021453, 2829901, 3638864, 4447314, 5256020, 6064470, -404147, -1212595, -2021299, -2829747, -3638704, -4447150, -5255852, -6064298,
+        444750, 1334094, 2223694, 3113038, 4002897, 4892243, 5781845, 6671191, -444594, -1333938, -2223538, -3112882, -4002735, -4892077, -5781675, -6671017,
+        489295, 1467727, 2446159, 3424591, 4403282, 5381716, 6360150, 7338584, -489137, -1467569, -2446001, -3424433, -4403118, -5381548, -6359978, -7338408,
+        538192, 1614416, 2690896, 3767120, 4843603, 5919829, 6996311, 8072536, -538032, -1614256, -2690736, -3766960, -4843437, -5919659, -6996137, -8072360,
+        591953, 1775953, 2959953, 4143953, 5327956, 6511958, 7695960, 8879960, -591791, -1775791, -2959791, -4143791, -5327788, -6511786, -7695784, -8879784,
+        651090, 1953362, 3255890, 4558162, 5860693, 7162967, 8465496, 9767768, -650926, -1953198, -3255726, -4557998, -5860523, -7162793, -8465320, -9767592,
+        716371, 2148947, 3581523, 5014099, 6446934, 7879512, 9312088, 10744664, -716205, -2148781, -3581357, -5013933, -6446762, -7879336, -9311912, -10744488,
+        787796, 2363476, 3939412, 5515092, 7091287, 8666968, 10242904, 11818584, -787628, -2363308, -3939244, -5514924, -7091113, -8666792, -10242728, -11818408,
+        866645, 2600021, 4333653, 6067029, 7800664, 9534040, 11267672, 13001048, -866475, -2599851, -4333483, -6066859, -7800488, -9533864, -11267496, -13000872,
+        953430, 2860118, 4767062, 6673750, 8580696, 10487384, 12394328, 14301016, -953258, -2859946, -4766890, -6673578, -8580520, -10487208, -12394152, -14300840,
+        1048407, 3145303, 5242455, 7339351, 9436760, 11533656, 13630808, 15727704, -1048233, -3145129, -5242281, -7339177, -9436584, -11533480, -13630632, -15727528,
+    },
+    { /* IMA_EXPAND_MUL */
+        0, 512, 1024, 1536, 1794, 2308, 2822, 3336, 0, -512, -1024, -1536, -1790, -2300, -2810, -3320,
+        256, 768, 1280, 1792, 2307, 2821, 3335, 3849, -256, -768, -1280, -1792, -2301, -2811, -3321, -3831,
+        257, 769, 1281, 1793, 2564, 3078, 3592, 4106, -255, -767, -1279, -1791, -2556, -3066, -3576, -4086,
+        258, 770, 1538, 2050, 2821, 3335, 4105, 4619, -254, -766, -1534, -2046, -2811, -3321, -4087, -4597,
+        259, 1027, 1539, 2307, 3078, 3848, 4362, 5132, -253, -1021, -1533, -2301, -3066, -3832, -4342, -5108,
+        260, 1028, 1796, 2564, 3335, 4105, 4875, 5645, -252, -1020, -1788, -2556, -3321, -4087, -4853, -5619,
+        261, 1029, 2053, 2821, 3592, 4362, 5388, 6158, -251, -1019, -2043, -2811, -3576, -4342, -5364, -6130,
+        262, 1286, 2054, 3078, 3849, 4875, 5645, 6671, -250, -1274, -2042, -3066, -3831, -4853, -5619, -6641,
+        519, 1543, 2567, 3591, 4618, 5644, 6670, 7696, -505, -1529, -2553, -3577, -4598, -5620, -6642, -7664,
+        520, 1544, 2568, 3592, 4875, 5901, 6927, 7953, -504, -1528, -2552, -3576, -4853, -5875, -6897, -7919,
+        521, 1801, 2825, 4105, 5388, 6670, 7696, 8978, -503, -1783, -2807, -4087, -5364, -6642, -7664, -8942,
+        522, 1802, 3338, 4618, 5901, 7183, 8721, 10003, -502, -1782, -3318, -4598, -5875, -7153, -8687, -9965,
+        523, 2059, 3595, 5131, 6414, 7952, 9490, 11028, -501, -2037, -3573, -5109, -6386, -7920, -9454, -10988,
+        780, 2316, 3852, 5388, 7183, 8721, 10259, 11797, -756, -2292, -3828, -5364, -7153, -8687, -10221, -11755,
+        781, 2573, 4365, 6157, 7952, 9746, 11540, 13334, -755, -2547, -4339, -6131, -7920, -9710, -11500, -13290,
+        782, 2830, 4878, 6926, 8721, 10771, 12821, 14871, -754, -2802, -4850, -6898, -8687, -10733, -12779, -14825,
+        1039, 3087, 5391, 7439, 9746, 11796, 14102, 16152, -1009, -3057, -5361, -7409, -9710, -11756, -14058, -16104,
+        1040, 3344, 5904, 8208, 10515, 12821, 15383, 17689, -1008, -3312, -5872, -8176, -10477, -12779, -15337, -17639,
+        1297, 3857, 6417, 8977, 11796, 14358, 16920, 19482, -1263, -3823, -6383, -8943, -11756, -14314, -16872, -19430,
+        1298, 4114, 7186, 10002, 12821, 15639, 18713, 21531, -1262, -4078, -7150, -9966, -12779, -15593, -18663, -21477,
+        1555, 4627, 7955, 11027, 14358, 17432, 20762, 23836, -1517, -4589, -7917, -10989, -14314, -17384, -20710, -23780,
+        1556, 5140, 8724, 12308, 15639, 19225, 22811, 26397, -1516, -5100, -8684, -12268, -15593, -19175, -22757, -26339,
+        1813, 5653, 9493, 13333, 17176, 21018, 24860, 28702, -1771, -5611, -9451, -13291, -17128, -20966, -24804, -28642,
+        2070, 6166, 10518, 14614, 18969, 23067, 27421, 31519, -2026, -6122, -10474, -14570, -18919, -23013, -27363, -31457,
+        2327, 6935, 11543, 16151, 21018, 25628, 30238, 34848, -2281, -6889, -11497, -16105, -20966, -25572, -30178, -34784,
+        2584, 7704, 12824, 17944, 23067, 28189, 33311, 38433, -2536, -7656, -12776, -17896, -23013, -28131, -33249, -38367,
+        2841, 8473, 14105, 19737, 25372, 31006, 36640, 42274, -2791, -8423, -14055, -19687, -25316, -30946, -36576, -42206,
+        3098, 9242, 15386, 21530, 27933, 34079, 40225, 46371, -3046, -9190, -15334, -21478, -27875, -34017, -40159, -46301,
+        3355, 10267, 16923, 23835, 30750, 37664, 44322, 51236, -3301, -10213, -16869, -23781, -30690, -37600, -44254, -51164,
+        3612, 11292, 18716, 26396, 33823, 41505, 48931, 56613, -3556, -11236, -18660, -26340, -33761, -41439, -48861, -56539,
+        4125, 12317, 20765, 28957, 37408, 45602, 54052, 62246, -4067, -12259, -20707, -28899, -37344, -45534, -53980, -62170,
+        4382, 13598, 22814, 32030, 40993, 50211, 59429, 68647, -4322, -13538, -22754, -31970, -40927, -50141, -59355, -68569,
+        4895, 14879, 25119, 35103, 45090, 55076, 65318, 75304, -4833, -14817, -25057, -35041, -45022, -55004, -65242, -75224,
+        5408, 16416, 27680, 38688, 49699, 60709, 71975, 82985, -5344, -16352, -27616, -38624, -49629, -60635, -71897, -82903,
+        5921, 18209, 30241, 42529, 54564, 66854, 78888, 91178, -5855, -18143, -30175, -42463, -54492, -66778, -78808, -91094,
+        6690, 20002, 33314, 46626, 60197, 73511, 86825, 100139, -6622, -19934, -33246, -46558, -60123, -73433, -86743, -100053,
+        7203, 22051, 36643, 51491, 66086, 80936, 95530, 110380, -7133, -21981, -36573, -51421, -66010, -80856, -95446, -110292,
+        7972, 24100, 40484, 56612, 72743, 88873, 105259, 121389, -7900, -24028, -40412, -56540, -72665, -88791, -105173, -121299,
+        8741, 26661, 44581, 62501, 80168, 98090, 116012, 133934, -8667, -26587, -44507, -62427, -80088, -98006, -115924, -133842,
+        9766, 29478, 48934, 68646, 88361, 108075, 127533, 147247, -9690, -29402, -48858, -68570, -88279, -107989, -127443, -147153,
+        10791, 32295, 53799, 75303, 97066, 118572, 140078, 161584, -10713, -32217, -53721, -75225, -96982, -118484, -139986, -161488,
+        11816, 35624, 59176, 82984, 106795, 130605, 154159, 177969, -11736, -35544, -59096, -82904, -106709, -130515, -154065, -177871,
+        13097, 39209, 65321, 91433, 117548, 143662, 169776, 195890, -13015, -39127, -65239, -91351, -117460, -143570, -169680, -195790,
+        14378, 43050, 71722, 100394, 129325, 157999, 186673, 215347, -14294, -42966, -71638, -100310, -129235, -157905, -186575, -215245,
+        15659, 47403, 78891, 110635, 142126, 173872, 205362, 237108, -15573, -47317, -78805, -110549, -142034, -173776, -205262, -237004,
+        17452, 52268, 87084, 121900, 156719, 191537, 226355, 261173, -17364, -52180, -86996, -121812, -156625, -191439, -226253, -261067,
+        18989, 57389, 95533, 133933, 172080, 210482, 248628, 287030, -18899, -57299, -95443, -133843, -171984, -210382, -248524, -286922,
+        21038, 63022, 105262, 147246, 189489, 231475, 273717, 315703, -20946, -62930, -105170, -147154, -189391, -231373, -273611, -315593,
+        23087, 69423, 115759, 162095, 208434, 254772, 301110, 347448, -22993, -69329, -115665, -162001, -208334, -254668, -301002, -347336,
+        25392, 76336, 127280, 178224, 229171, 280117, 331063, 382009, -25296, -76240, -127184, -178128, -229069, -280011, -330953, -381895,
+        27953, 84017, 140081, 196145, 252212, 308278, 364344, 420410, -27855, -83919, -139983, -196047, -252108, -308170, -364232, -420294,
+        30770, 92466, 153906, 215602, 277301, 338999, 400441, 462139, -30670, -92366, -153806, -215502, -277195, -338889, -400327, -462021,
+        33843, 101683, 169523, 237363, 305206, 373048, 440890, 508732, -33741, -101581, -169421, -237261, -305098, -372936, -440774, -508612,
+        37172, 111924, 186420, 261172, 335671, 410425, 484923, 559677, -37068, -111820, -186316, -261068, -335561, -410311, -484805, -559555,
+        41013, 122933, 205109, 287029, 369208, 451130, 533308, 615230, -40907, -122827, -205003, -286923, -369096, -451014, -533188, -615106,
+        45110, 135478, 225590, 315958, 406329, 496699, 586813, 677183, -45002, -135370, -225482, -315850, -406215, -496581, -586691, -677057,
+        49719, 149047, 248375, 347703, 447034, 546364, 645694, 745024, -49609, -148937, -248265, -347593, -446918, -546244, -645570, -744896,
+        54584, 163896, 272952, 382264, 491579, 600893, 709951, 819265, -54472, -163784, -272840, -382152, -491461, -600771, -709825, -819135,
+        59961, 180281, 300345, 420665, 540732, 661054, 781120, 901442, -59847, -180167, -300231, -420551, -540612, -660930, -780992, -901310,
+        66106, 198202, 330554, 462650, 595005, 727103, 859457, 991555, -65990, -198086, -330438, -462534, -594883, -726977, -859327, -991421,
+        72763, 218171, 363579, 508987, 654398, 799808, 945218, 1090628, -72645, -218053, -363461, -508869, -654274, -799680, -945086, -1090492,
+        79932, 239932, 399676, 559676, 719679, 879681, 1039427, 1199429, -79812, -239812, -399556, -559556, -719553, -879551, -1039293, -1199291,
+        87869, 263741, 439869, 615741, 791616, 967490, 1143620, 1319494, -87747, -263619, -439747, -615619, -791488, -967358, -1143484, -1319354,
+        96830, 290366, 483902, 677438, 870977, 1064515, 1258053, 1451591, -96706, -290242, -483778, -677314, -870847, -1064381, -1257915, -1451449,
+        106303, 319295, 532287, 745279, 958018, 1171012, 1384006, 1597000, -106177, -319169, -532161, -745153, -957886, -1170876, -1383866, -1596856,
+        117056, 351296, 585536, 819776, 1054019, 1288261, 1522503, 1756745, -116928, -351168, -585408, -819648, -1053885, -1288123, -1522361, -1756599,
+        128833, 386369, 644161, 901697, 1159492, 1417030, 1674824, 1932362, -128703, -386239, -644031, -901567, -1159356, -1416890, -1674680, -1932214,
+        141634, 425026, 708418, 991810, 1275205, 1558599, 1841993, 2125387, -141502, -424894, -708286, -991678, -1275067, -1558457, -1841847, -2125237,
+        155715, 467523, 779331, 1091139, 1402694, 1714504, 2026314, 2338124, -155581, -467389, -779197, -1091005, -1402554, -1714360, -2026166, -2337972,
+        171332, 514372, 857156, 1200196, 1542983, 1886025, 2228811, 2571853, -171196, -514236, -857020, -1200060, -1542841, -1885879, -2228661, -2571699,
+        188485, 565829, 942917, 1320261, 1697352, 2074698, 2451788, 2829134, -188347, -565691, -942779, -1320123, -1697208, -2074550, -2451636, -2828978,
+        207430, 622406, 1037382, 1452358, 1867337, 2282315, 2697293, 3112271, -207290, -622266, -1037242, -1452218, -1867191, -2282165, -2697139, -3112113,
+        228167, 684615, 1141063, 1597511, 2053962, 2510412, 2966862, 3423312, -228025, -684473, -1140921, -1597369, -2053814, -2510260, -2966706, -3423152,
+        250952, 752968, 1255240, 1757256, 2259275, 2761293, 3263567, 3765585, -250808, -752824, -1255096, -1757112, -2259125, -2761139, -3263409, -3765423,
+        276041, 828489, 1380681, 1933129, 2485324, 3037774, 3589968, 4142418, -275895, -828343, -1380535, -1932983, -2485172, -3037618, -3589808, -4142254,
+        303690, 911178, 1518922, 2126410, 2733901, 3341391, 3949137, 4556627, -303542, -911030, -1518774, -2126262, -2733747, -3341233, -3948975, -4556461,
+        334155, 1002315, 1670731, 2338891, 3007310, 3675472, 4343890, 5012052, -334005, -1002165, -1670581, -2338741, -3007154, -3675312, -4343726, -5011884,
+        367436, 1102668, 1837900, 2573132, 3308111, 4043345, 4778579, 5513813, -367284, -1102516, -1837748, -2572980, -3307953, -4043183, -4778413, -5513643,
+        404301, 1213005, 2021453, 2830157, 3638864, 4447570, 5256020, 6064726, -404147, -1212851, -2021299, -2830003, -3638704, -4447406, -5255852, -6064554,
+        444750, 1334350, 2223694, 3113294, 4002897, 4892499, 5781845, 6671447, -444594, -1334194, -2223538, -3113138, -4002735, -4892333, -5781675, -6671273,
+        489295, 1467727, 2446159, 3424591, 4403282, 5381716, 6360150, 7338584, -489137, -1467569, -2446001, -3424433, -4403118, -5381548, -6359978, -7338408,
+        538192, 1614416, 2690896, 3767120, 4843603, 5919829, 6996311, 8072536, -538032, -1614256, -2690736, -3766960, -4843437, -5919659, -6996137, -8072360,
+        591953, 1775953, 2959953, 4143953, 5327956, 6511958, 7695960, 8879960, -591791, -1775791, -2959791, -4143791, -5327788, -6511786, -7695784, -8879784,
+        651090, 1953618, 3255890, 4558418, 5860693, 7163223, 8465496, 9768024, -650926, -1953454, -3255726, -4558254, -5860523, -7163049, -8465320, -9767848,
+        716371, 2148947, 3581523, 5014099, 6446934, 7879512, 9312088, 10744664, -716205, -2148781, -3581357, -5013933, -6446762, -7879336, -9311912, -10744488,
+        787796, 2363732, 3939668, 5515604, 7091287, 8667224, 10243160, 11819096, -787628, -2363564, -3939500, -5515436, -7091113, -8667048, -10242984, -11818920,
+        866645, 2600277, 4333653, 6067285, 7800664, 9534296, 11267672, 13001304, -866475, -2600107, -4333483, -6067115, -7800488, -9534120, -11267496, -13001128,
+        953430, 2860118, 4767062, 6673750, 8580696, 10487384, 12394328, 14301016, -953258, -2859946, -4766890, -6673578, -8580520, -10487208, -12394152, -14300840,
+        1048407, 3145559, 5242711, 7339863, 9436760, 11533912, 13631064, 15728216, -1048233, -3145385, -5242537, -7339689, -9436584, -11533736, -13630888, -15728040,
+    },
+    { /* IMA_EXPAND_N3DS */
+        0, 512, 1024, 1536, 1794, 2308, 2822, 3336, -256, -768, -1280, -1792, -2046, -2556, -3066, -3576,
+        256, 768, 1280, 1792, 2307, 2821, 3335, 3849, -256, -768, -1280, -1792, -2301, -2811, -3321, -3831,
+        257, 769, 1281, 1793, 2564, 3078, 3592, 4106, -511, -1023, -1535, -2047, -2812, -3322, -3832, -4342,
+        258, 770, 1538, 2050, 2821, 3335, 4105, 4619, -510, -1022, -1790, -2302, -3067, -3577, -4343, -4853,
+        259, 1027, 1539, 2307, 3078, 3848, 4362, 5132, -509, -1277, -1789, -2557, -3322, -4088, -4598, -5364,
+        260, 1028, 1796, 2564, 3335, 4105, 4875, 5645, -508, -1276, -2044, -2812, -3577, -4343, -5109, -5875,
+        261, 1029, 2053, 2821, 3592, 4362, 5388, 6158, -507, -1275, -2299, -3067, -3832, -4598, -5620, -6386,
+        262, 1286, 2054, 3078, 3849, 4875, 5645, 6671, -506, -1530, -2298, -3322, -4087, -5109, -5875, -6897,
+        519, 1543, 2567, 3591, 4618, 5644, 6670, 7696, -505, -1529, -2553, -3577, -4598, -5620, -6642, -7664,
+        520, 1544, 2568, 3592, 4875, 5901, 6927, 7953, -760, -1784, -2808, -3832, -5109, -6131, -7153, -8175,
+        521, 1801, 2825, 4105, 5388, 6670, 7696, 8978, -759, -2039, -3063, -4343, -5620, -6898, -7920, -9198,
+        522, 1802, 3338, 4618, 5901, 7183, 8721, 10003, -758, -2038, -3574, -4854, -6131, -7409, -8943, -10221,
+        523, 2059, 3595, 5131, 6414, 7952, 9490, 11028, -757, -2293, -3829, -5365, -6642, -8176, -9710, -11244,
+        780, 2316, 3852, 5388, 7183, 8721, 10259, 11797, -1012, -2548, -4084, -5620, -7409, -8943, -10477, -12011,
+        781, 2573, 4365, 6157, 7952, 9746, 11540, 13334, -1011, -2803, -4595, -6387, -8176, -9966, -11756, -13546,
+        782, 2830, 4878, 6926, 8721, 10771, 12821, 14871, -1010, -3058, -5106, -7154, -8943, -10989, -13035, -15081,
+        1039, 3087, 5391, 7439, 9746, 11796, 14102, 16152, -1265, -3313, -5617, -7665, -9966, -12012, -14314, -16360,
+        1040, 3344, 5904, 8208, 10515, 12821, 15383, 17689, -1264, -3568, -6128, -8432, -10733, -13035, -15593, -17895,
+        1297, 3857, 6417, 8977, 11796, 14358, 16920, 19482, -1519, -4079, -6639, -9199, -12012, -14570, -17128, -19686,
+        1298, 4114, 7186, 10002, 12821, 15639, 18713, 21531, -1518, -4334, -7406, -10222, -13035, -15849, -18919, -21733,
+        1555, 4627, 7955, 11027, 14358, 17432, 20762, 23836, -1773, -4845, -8173, -11245, -14570, -17640, -20966, -24036,
+        1556, 5140, 8724, 12308, 15639, 19225, 22811, 26397, -1772, -5356, -8940, -12524, -15849, -19431, -23013, -26595,
+        1813, 5653, 9493, 13333, 17176, 21018, 24860, 28702, -2027, -5867, -9707, -13547, -17384, -21222, -25060, -28898,
+        2070, 6166, 10518, 14614, 18969, 23067, 27421, 31519, -2282, -6378, -10730, -14826, -19175, -23269, -27619, -31713,
+        2327, 6935, 11543, 16151, 21018, 25628, 30238, 34848, -2537, -7145, -11753, -16361, -21222, -25828, -30434, -35040,
+        2584, 7704, 12824, 17944, 23067, 28189, 33311, 38433, -2536, -7656, -12776, -17896, -23013, -28131, -33249, -38367,
+        2841, 8473, 14105, 19737, 25372, 31006, 36640, 42274, -2791, -8423, -14055, -19687, -25316, -30946, -36576, -42206,
+        3098, 9242, 15386, 21530, 27933, 34079, 40225, 46371, -3302, -9446, -15590, -21734, -28131, -34273, -40415, -46557,
+        3355, 10267, 16923, 23835, 30750, 37664, 44322, 51236, -3557, -10469, -17125, -24037, -30946, -37856, -44510, -51420,
+        3612, 11292, 18716, 26396, 33823, 41505, 48931, 56613, -3812, -11492, -18916, -26596, -34017, -41695, -49117, -56795,
+        4125, 12317, 20765, 28957, 37408, 45602, 54052, 62246, -4323, -12515, -20963, -29155, -37600, -45790, -54236, -62426,
+        4382, 13598, 22814, 32030, 40993, 50211, 59429, 68647, -4578, -13794, -23010, -32226, -41183, -50397, -59611, -68825,
+        4895, 14879, 25119, 35103, 45090, 55076, 65318, 75304, -5089, -15073, -25313, -35297, -45278, -55260, -65498, -75480,
+        5408, 16416, 27680, 38688, 49699, 60709, 71975, 82985, -5600, -16608, -27872, -38880, -49885, -60891, -72153, -83159,
+        5921, 18209, 30241, 42529, 54564, 66854, 78888, 91178, -6111, -18399, -30431, -42719, -54748, -67034, -79064, -91350,
+        6690, 20002, 33314, 46626, 60197, 73511, 86825, 100139, -6878, -20190, -33502, -46814, -60379, -73689, -86999, -100309,
+        7203, 22051, 36643, 51491, 66086, 80936, 95530, 110380, -7389, -22237, -36829, -51677, -66266, -81112, -95702, -110548,
+        7972, 24100, 40484, 56612, 72743, 88873, 105259, 121389, -8156, -24284, -40668, -56796, -72921, -89047, -105429, -121555,
+        8741, 26661, 44581, 62501, 80168, 98090, 116012, 133934, -8923, -26843, -44763, -62683, -80344, -98262, -116180, -134098,
+        9766, 29478, 48934, 68646, 88361, 108075, 127533, 147247, -9946, -29658, -49114, -68826, -88535, -108245, -127699, -147409,
+        10791, 32295, 53799, 75303, 97066, 118572, 140078, 161584, -10969, -32473, -53977, -75481, -97238, -118740, -140242, -161744,
+        11816, 35624, 59176, 82984, 106795, 130605, 154159, 177969, -11992, -35800, -59352, -83160, -106965, -130771, -154321, -178127,
+        13097, 39209, 65321, 91433, 117548, 143662, 169776, 195890, -13015, -39127, -65239, -91351, -117460, -143570, -169680, -195790,
+        14378, 43050, 71722, 100394, 129325, 157999, 186673, 215347, -14550, -43222, -71894, -100566, -129491, -158161, -186831, -215501,
+        15659, 47403, 78891, 110635, 142126, 173872, 205362, 237108, -15829, -47573, -79061, -110805, -142290, -174032, -205518, -237260,
+        17452, 52268, 87084, 121900, 156719, 191537, 226355, 261173, -17364, -52180, -86996, -121812, -156625, -191439, -226253, -261067,
+        18989, 57389, 95533, 133933, 172080, 210482, 248628, 287030, -19155, -57555, -95699, -134099, -172240, -210638, -248780, -287178,
+        21038, 63022, 105262, 147246, 189489, 231475, 273717, 315703, -21202, -63186, -105426, -147410, -189647, -231629, -273867, -315849,
+        23087, 69423, 115759, 162095, 208434, 254772, 301110, 347448, -23249, -69585, -115921, -162257, -208590, -254924, -301258, -347592,
+        25392, 76336, 127280, 178224, 229171, 280117, 331063, 382009, -25552, -76496, -127440, -178384, -229325, -280267, -331209, -382151,
+        27953, 84017, 140081, 196145, 252212, 308278, 364344, 420410, -28111, -84175, -140239, -196303, -252364, -308426, -364488, -420550,
+        30770, 92466, 153906, 215602, 277301, 338999, 400441, 462139, -30926, -92622, -154062, -215758, -277451, -339145, -400583, -462277,
+        33843, 101683, 169523, 237363, 305206, 373048, 440890, 508732, -33997, -101837, -169677, -237517, -305354, -373192, -441030, -508868,
+        37172, 111924, 186420, 261172, 335671, 410425, 484923, 559677, -37324, -112076, -186572, -261324, -335817, -410567, -485061, -559811,
+        41013, 122933, 205109, 287029, 369208, 451130, 533308, 615230, -41163, -123083, -205259, -287179, -369352, -451270, -533444, -615362,
+        45110, 135478, 225590, 315958, 406329, 496699, 586813, 677183, -45258, -135626, -225738, -316106, -406471, -496837, -586947, -677313,
+        49719, 149047, 248375, 347703, 447034, 546364, 645694, 745024, -49609, -148937, -248265, -347593, -446918, -546244, -645570, -744896,
+        54584, 163896, 272952, 382264, 491579, 600893, 709951, 819265, -54728, -164040, -273096, -382408, -491717, -601027, -710081, -819391,
+        59961, 180281, 300345, 420665, 540732, 661054, 781120, 901442, -60103, -180423, -300487, -420807, -540868, -661186, -781248, -901566,
+        66106, 198202, 330554, 462650, 595005, 727103, 859457, 991555, -66246, -198342, -330694, -462790, -595139, -727233, -859583, -991677,
+        72763, 218171, 363579, 508987, 654398, 799808, 945218, 1090628, -72645, -218053, -363461, -508869, -654274, -799680, -945086, -1090492,
+        79932, 239932, 399676, 559676, 719679, 879681, 1039427, 1199429, -80068, -240068, -399812, -559812, -719809, -879807, -1039549, -1199547,
+        87869, 263741, 439869, 615741, 791616, 967490, 1143620, 1319494, -88003, -263875, -440003, -615875, -791744, -967614, -1143740, -1319610,
+        96830, 290366, 483902, 677438, 870977, 1064515, 1258053, 1451591, -96706, -290242, -483778, -677314, -870847, -1064381, -1257915, -1451449,
+        106303, 319295, 532287, 745279, 958018, 1171012, 1384006, 1597000, -106433, -319425, -532417, -745409, -958142, -1171132, -1384122, -1597112,
+        117056, 351296, 585536, 819776, 1054019, 1288261, 1522503, 1756745, -117184, -351424, -585664, -819904, -1054141, -1288379, -1522617, -1756855,
+        128833, 386369, 644161, 901697, 1159492, 1417030, 1674824, 1932362, -128959, -386495, -644287, -901823, -1159612, -1417146, -1674936, -1932470,
+        141634, 425026, 708418, 991810, 1275205, 1558599, 1841993, 2125387, -141758, -425150, -708542, -991934, -1275323, -1558713, -1842103, -2125493,
+        155715, 467523, 779331, 1091139, 1402694, 1714504, 2026314, 2338124, -155837, -467645, -779453, -1091261, -1402810, -1714616, -2026422, -2338228,
+        171332, 514372, 857156, 1200196, 1542983, 1886025, 2228811, 2571853, -171452, -514492, -857276, -1200316, -1543097, -1886135, -2228917, -2571955,
+        188485, 565829, 942917, 1320261, 1697352, 2074698, 2451788, 2829134, -188603, -565947, -943035, -1320379, -1697464, -2074806, -2451892, -2829234,
+        207430, 622406, 1037382, 1452358, 1867337, 2282315, 2697293, 3112271, -207546, -622522, -1037498, -1452474, -1867447, -2282421, -2697395, -3112369,
+        228167, 684615, 1141063, 1597511, 2053962, 2510412, 2966862, 3423312, -228281, -684729, -1141177, -1597625, -2054070, -2510516, -2966962, -3423408,
+        250952, 752968, 1255240, 1757256, 2259275, 2761293, 3263567, 3765585, -251064, -753080, -1255352, -1757368, -2259381, -2761395, -3263665, -3765679,
+        276041, 828489, 1380681, 1933129, 2485324, 3037774, 3589968, 4142418, -276151, -828599, -1380791, -1933239, -2485428, -3037874, -3590064, -4142510,
+        303690, 911178, 1518922, 2126410, 2733901, 3341391, 3949137, 4556627, -303798, -911286, -1519030, -2126518, -2734003, -3341489, -3949231, -4556717,
+        334155, 1002315, 1670731, 2338891, 3007310, 3675472, 4343890, 5012052, -334261, -1002421, -1670837, -2338997, -3007410, -3675568, -4343982, -5012140,
+        367436, 1102668, 1837900, 2573132, 3308111, 4043345, 4778579, 5513813, -367540, -1102772, -1838004, -2573236, -3308209, -4043439, -4778669, -5513899,
+        404301, 1213005, 2021453, 2830157, 3638864, 4447570, 5256020, 6064726, -404403, -1213107, -2021555, -2830259, -3638960, -4447662, -5256108, -6064810,
+        444750, 1334350, 2223694, 3113294, 4002897, 4892499, 5781845, 6671447, -444850, -1334450, -2223794, -3113394, -4002991, -4892589, -5781931, -6671529,
+        489295, 1467727, 2446159, 3424591, 4403282, 5381716, 6360150, 7338584, -489393, -1467825, -2446257, -3424689, -4403374, -5381804, -6360234, -7338664,
+        538192, 1614416, 2690896, 3767120, 4843603, 5919829, 6996311, 8072536, -538288, -1614512, -2690992, -3767216, -4843693, -5919915, -6996393, -8072616,
+        591953, 1775953, 2959953, 4143953, 5327956, 6511958, 7695960, 8879960, -592047, -1776047, -2960047, -4144047, -5328044, -6512042, -7696040, -8880040,
+        651090, 1953618, 3255890, 4558418, 5860693, 7163223, 8465496, 9768024, -651182, -1953710, -3255982, -4558510, -5860779, -7163305, -8465576, -9768104,
+        716371, 2148947, 3581523, 5014099, 6446934, 7879512, 9312088, 10744664, -716461, -2149037, -3581613, -5014189, -6447018, -7879592, -9312168, -10744744,
+        787796, 2363732, 3939668, 5515604, 7091287, 8667224, 10243160, 11819096, -787884, -2363820, -3939756, -5515692, -7091369, -8667304, -10243240, -11819176,
+        866645, 2600277, 4333653, 6067285, 7800664, 9534296, 11267672, 13001304, -866731, -2600363, -4333739, -6067371, -7800744, -9534376, -11267752, -13001384,
+        953430, 2860118, 4767062, 6673750, 8580696, 10487384, 12394328, 14301016, -953514, -2860202, -4767146, -6673834, -8580776, -10487464, -12394408, -14301096,
+        1048407, 3145559, 5242711, 7339863, 9436760, 11533912, 13631064, 15728216, -1048489, -3145641, -5242793, -7339945, -9436840, -11533992, -13631144, -15728296,
+    },
+    { /* IMA_EXPAND_SNDS */
+        0, 256, 768, 1280, 2562, 3588, 5126, 7688, 0, -256, -768, -1280, -2558, -3580, -5114, -7672,
+        0, 256, 768, 1280, 2819, 4101, 5639, 7945, 0, -256, -768, -1280, -2813, -4091, -5625, -7927,
+        257, 769, 1281, 1793, 3076, 4358, 6664, 8970, -255, -767, -1279, -1791, -3068, -4346, -6648, -8950,
+        258, 770, 1282, 1794, 3333, 4615, 6921, 9739, -254, -766, -1278, -1790, -3323, -4601, -6903, -9717,
+        259, 771, 1539, 2051, 3590, 5640, 7690, 10764, -253, -765, -1533, -2045, -3578, -5624, -7670, -10740,
+        260, 772, 1540, 2308, 3847, 5897, 8459, 11789, -252, -764, -1532, -2300, -3833, -5879, -8437, -11763,
+        261, 1029, 1797, 2565, 4616, 6410, 9228, 13326, -251, -1019, -1787, -2555, -4600, -6390, -9204, -13298,
+        262, 1030, 1798, 2566, 4873, 7179, 10253, 14607, -250, -1018, -1786, -2554, -4855, -7157, -10227, -14577,
+        263, 1031, 2055, 2823, 5386, 7692, 11534, 16144, -249, -1017, -2041, -2809, -5366, -7668, -11506, -16112,
+        520, 1544, 2568, 3592, 5899, 8717, 12559, 17425, -504, -1528, -2552, -3576, -5877, -8691, -12529, -17391,
+        521, 1545, 2569, 3593, 6412, 9742, 14096, 19474, -503, -1527, -2551, -3575, -6388, -9714, -14064, -19438,
+        522, 1546, 2826, 4106, 7181, 10511, 15121, 21267, -502, -1526, -2806, -4086, -7155, -10481, -15087, -21229,
+        523, 1803, 3083, 4363, 7950, 11792, 16914, 23828, -501, -1781, -3061, -4341, -7922, -11760, -16878, -23788,
+        524, 1804, 3340, 4876, 8719, 12817, 18451, 26133, -500, -1780, -3316, -4852, -8689, -12783, -18413, -26091,
+        781, 2317, 3853, 5389, 9744, 14354, 20756, 28694, -755, -2291, -3827, -5363, -9712, -14318, -20716, -28650,
+        782, 2574, 4366, 6158, 10513, 15635, 22549, 31511, -754, -2546, -4338, -6130, -10479, -15597, -22507, -31465,
+        783, 2575, 4623, 6671, 11794, 17428, 24854, 34840, -753, -2545, -4593, -6641, -11758, -17388, -24810, -34792,
+        1040, 3088, 5392, 7440, 12819, 18965, 27415, 38425, -1008, -3056, -5360, -7408, -12781, -18923, -27369, -38375,
+        1041, 3345, 5649, 7953, 14356, 21014, 30232, 42266, -1007, -3311, -5615, -7919, -14316, -20970, -30184, -42214,
+        1298, 3858, 6418, 8978, 15637, 23063, 33305, 46363, -1262, -3822, -6382, -8942, -15595, -23017, -33255, -46309,
+        1299, 4115, 6931, 9747, 17174, 25624, 36634, 51228, -1261, -4077, -6893, -9709, -17130, -25576, -36582, -51172,
+        1556, 4628, 7956, 11028, 18967, 28185, 40219, 56349, -1516, -4588, -7916, -10988, -18921, -28135, -40165, -56291,
+        1557, 4885, 8469, 12053, 21016, 31002, 44316, 62238, -1515, -4843, -8427, -12011, -20968, -30950, -44260, -62178,
+        1814, 5654, 9494, 13334, 23065, 34075, 48925, 68383, -1770, -5610, -9450, -13290, -23015, -34021, -48867, -68321,
+        2071, 6167, 10519, 14615, 25370, 37404, 54046, 75040, -2025, -6121, -10473, -14569, -25318, -37348, -53986, -74976,
+        2328, 6936, 11544, 16152, 27931, 41245, 59167, 82721, -2280, -6888, -11496, -16104, -27877, -41187, -59105, -82655,
+        2585, 7705, 12825, 17945, 30748, 45598, 65056, 90914, -2535, -7655, -12775, -17895, -30692, -45538, -64992, -90846,
+        2842, 8474, 14106, 19738, 33821, 49951, 71713, 100131, -2790, -8422, -14054, -19686, -33763, -49889, -71647, -100061,
+        3099, 9243, 15387, 21531, 37406, 55072, 78882, 110116, -3045, -9189, -15333, -21477, -37346, -55008, -78814, -110044,
+        3356, 10012, 16924, 23836, 40991, 60705, 86819, 121125, -3300, -9956, -16868, -23780, -40929, -60639, -86749, -121051,
+        3613, 11037, 18717, 26141, 45088, 66594, 95524, 133670, -3555, -10979, -18659, -26083, -45024, -66526, -95452, -133594,
+        4126, 12318, 20766, 28958, 49697, 73507, 104997, 147239, -4066, -12258, -20706, -28898, -49631, -73437, -104923, -147161,
+        4383, 13343, 22559, 31775, 54562, 80676, 115750, 161576, -4321, -13281, -22497, -31713, -54494, -80604, -115674, -161496,
+        4896, 14880, 24864, 34848, 60195, 88869, 127527, 177961, -4832, -14816, -24800, -34784, -60125, -88795, -127449, -177879,
+        5409, 16417, 27425, 38433, 66084, 97830, 140072, 195882, -5343, -16351, -27359, -38367, -66012, -97754, -139992, -195798,
+        5922, 17954, 30242, 42274, 72741, 107815, 154153, 215339, -5854, -17886, -30174, -42206, -72667, -107737, -154071, -215253,
+        6691, 20003, 33315, 46627, 80166, 118568, 169770, 236844, -6621, -19933, -33245, -46557, -80090, -118488, -169686, -236756,
+        7204, 21796, 36644, 51236, 88359, 130345, 186667, 261165, -7132, -21724, -36572, -51164, -88281, -130263, -186581, -261075,
+        7973, 24101, 40229, 56357, 97064, 143658, 205356, 286766, -7899, -24027, -40155, -56283, -96984, -143574, -205268, -286674,
+        8742, 26406, 44326, 62246, 106793, 157995, 226349, 315695, -8666, -26330, -44250, -62170, -106711, -157909, -226259, -315601,
+        9767, 29223, 48935, 68647, 117546, 173612, 248622, 347440, -9689, -29145, -48857, -68569, -117462, -173524, -248530, -347344,
+        10792, 32296, 53800, 75304, 129323, 191533, 273711, 382001, -10712, -32216, -53720, -75224, -129237, -191443, -273617, -381903,
+        11817, 35369, 59177, 82985, 142124, 210222, 301104, 420402, -11735, -35287, -59095, -82903, -142036, -210130, -301008, -420302,
+        13098, 39210, 65322, 91434, 156717, 231471, 331057, 462131, -13014, -39126, -65238, -91350, -156627, -231377, -330959, -462029,
+        14379, 43051, 71723, 100395, 172078, 254768, 364338, 508724, -14293, -42965, -71637, -100309, -171986, -254672, -364238, -508620,
+        15660, 47148, 78892, 110380, 189487, 280113, 400435, 559413, -15572, -47060, -78804, -110292, -189393, -280015, -400333, -559307,
+        17453, 52269, 87085, 121901, 208432, 308274, 440884, 615222, -17363, -52179, -86995, -121811, -208336, -308174, -440780, -615114,
+        18990, 57134, 95534, 133678, 229169, 338739, 484917, 677175, -18898, -57042, -95442, -133586, -229071, -338637, -484811, -677065,
+        21039, 63023, 105263, 147247, 252210, 373044, 533302, 745016, -20945, -62929, -105169, -147153, -252110, -372940, -533194, -744904,
+        23088, 69424, 115760, 162096, 277299, 410165, 586807, 819257, -22992, -69328, -115664, -162000, -277197, -410059, -586697, -819143,
+        25393, 76337, 127281, 178225, 305204, 451126, 645688, 901178, -25295, -76239, -127183, -178127, -305100, -451018, -645576, -901062,
+        27954, 84018, 140082, 196146, 335669, 496439, 709945, 991547, -27854, -83918, -139982, -196046, -335563, -496329, -709831, -991429,
+        30771, 92211, 153907, 215603, 369206, 546360, 781114, 1090620, -30669, -92109, -153805, -215501, -369098, -546248, -780998, -1090500,
+        33844, 101684, 169524, 237364, 406327, 600633, 859451, 1199421, -33740, -101580, -169420, -237260, -406217, -600519, -859333, -1199299,
+        37173, 111669, 186421, 260917, 447032, 660794, 945212, 1319230, -37067, -111563, -186315, -260811, -446920, -660678, -945092, -1319106,
+        41014, 122934, 205110, 287030, 491577, 727099, 1039421, 1451583, -40906, -122826, -205002, -286922, -491463, -726981, -1039299, -1451457,
+        45111, 135223, 225591, 315959, 540730, 799804, 1143358, 1596736, -45001, -135113, -225481, -315849, -540614, -799684, -1143234, -1596608,
+        49720, 149048, 248376, 347704, 595003, 879421, 1258047, 1756737, -49608, -148936, -248264, -347592, -594885, -879299, -1257921, -1756607,
+        54585, 163641, 272953, 382265, 654396, 967486, 1383744, 1932354, -54471, -163527, -272839, -382151, -654276, -967362, -1383616, -1932222,
+        59962, 180026, 300346, 420410, 719677, 1064511, 1522497, 2125379, -59846, -179910, -300230, -420294, -719555, -1064385, -1522367, -2125245,
+        66107, 198203, 330555, 462651, 791614, 1170752, 1674818, 2337860, -65989, -198085, -330437, -462533, -791490, -1170624, -1674686, -2337724,
+        72764, 218172, 363580, 508988, 870975, 1288257, 1841987, 2571589, -72644, -218052, -363460, -508868, -870849, -1288127, -1841853, -2571451,
+        79933, 239677, 399677, 559677, 958016, 1417026, 2026052, 2828870, -79811, -239555, -399555, -559555, -957888, -1416894, -2025916, -2828730,
+        87870, 263742, 439614, 615486, 1054017, 1558595, 2228805, 3112263, -87746, -263618, -439490, -615362, -1053887, -1558461, -2228667, -3112121,
+        96831, 290367, 483903, 677439, 1159490, 1714244, 2451782, 3423304, -96705, -290241, -483777, -677313, -1159358, -1714108, -2451642, -3423160,
+        106304, 319040, 532032, 745024, 1275203, 1885765, 2697287, 3765321, -106176, -318912, -531904, -744896, -1275069, -1885627, -2697145, -3765175,
+        117057, 351297, 585537, 819777, 1402692, 2074438, 2966856, 4142154, -116927, -351167, -585407, -819647, -1402556, -2074298, -2966712, -4142006,
+        128834, 386370, 644162, 901698, 1542981, 2282311, 3263305, 4556363, -128702, -386238, -644030, -901566, -1542843, -2282169, -3263159, -4556213,
+        141635, 425027, 708419, 991811, 1697350, 2510408, 3589962, 5012044, -141501, -424893, -708285, -991677, -1697210, -2510264, -3589814, -5011892,
+        155716, 467268, 779076, 1090884, 1867335, 2761289, 3948875, 5513549, -155580, -467132, -778940, -1090748, -1867193, -2761143, -3948725, -5513395,
+        171333, 514117, 857157, 1199941, 2053960, 3037514, 4343884, 6064718, -171195, -513979, -857019, -1199803, -2053816, -3037366, -4343732, -6064562,
+        188486, 565574, 942918, 1320006, 2259273, 3341387, 4778317, 6671439, -188346, -565434, -942778, -1319866, -2259127, -3341237, -4778163, -6671281,
+        207431, 622407, 1037383, 1452359, 2485322, 3675468, 5256014, 7338576, -207289, -622265, -1037241, -1452217, -2485174, -3675316, -5255858, -7338416,
+        228168, 684616, 1141064, 1597512, 2733899, 4043085, 5781839, 8072529, -228024, -684472, -1140920, -1597368, -2733749, -4042931, -5781681, -8072367,
+        250953, 752969, 1254985, 1757001, 3007308, 4447310, 6360144, 8879954, -250807, -752823, -1254839, -1756855, -3007156, -4447154, -6359984, -8879790,
+        276042, 828234, 1380682, 1932874, 3308109, 4892239, 6996305, 9767763, -275894, -828086, -1380534, -1932726, -3307955, -4892081, -6996143, -9767597,
+        303691, 911179, 1518667, 2126155, 3638862, 5381712, 7695954, 10744660, -303541, -911029, -1518517, -2126005, -3638706, -5381552, -7695790, -10744492,
+        334156, 1002316, 1670732, 2338892, 4002895, 5919825, 8465491, 11818837, -334004, -1002164, -1670580, -2338740, -4002737, -5919663, -8465325, -11818667,
+        367437, 1102413, 1837645, 2572877, 4403280, 6511954, 9312084, 13001046, -367283, -1102259, -1837491, -2572723, -4403120, -6511790, -9311916, -13000874,
+        404302, 1212750, 2021454, 2830158, 4843601, 7162963, 10242901, 14301015, -404146, -1212594, -2021298, -2830002, -4843439, -7162797, -10242731, -14300841,
+        444751, 1334095, 2223695, 3113295, 5327954, 7879508, 11267670, 15727960, -444593, -1333937, -2223537, -3113137, -5327790, -7879340, -11267498, -15727784,
+        489296, 1467728, 2446160, 3424592, 5860691, 8666965, 12394327, 15727960, -489136, -1467568, -2446000, -3424432, -5860525, -8666795, -12394153, -15727784,
+        538193, 1614417, 2690897, 3767121, 6446932, 9534038, 13630808, 15727960, -538031, -1614255, -2690735, -3766959, -6446764, -9533866, -13630632, -15727784,
+        591954, 1775954, 2959954, 4143954, 7091285, 10487383, 13630808, 15727960, -591790, -1775790, -2959790, -4143790, -7091115, -10487209, -13630632, -15727784,
+        651091, 1953363, 3255891, 4558163, 7800662, 11533656, 13630808, 15727960, -650925, -1953197, -3255725, -4557997, -7800490, -11533480, -13630632, -15727784,
+        716372, 2148948, 3581524, 5014100, 8580695, 11533656, 13630808, 15727960, -716204, -2148780, -3581356, -5013932, -8580521, -11533480, -13630632, -15727784,
+        787797, 2363477, 3939413, 5515349, 9436760, 11533656, 13630808, 15727960, -787627, -2363307, -3939243, -5515179, -9436584, -11533480, -13630632, -15727784,
+        866646, 2600022, 4333654, 6067030, 9436760, 11533656, 13630808, 15727960, -866474, -2599850, -4333482, -6066858, -9436584, -11533480, -13630632, -15727784,
+        953431, 2860119, 4767063, 6673751, 9436760, 11533656, 13630808, 15727960, -953257, -2859945, -4766889, -6673577, -9436584, -11533480, -13630632, -15727784,
+    },
+    { /* IMA_EXPAND_ALP */
+        0, 256, 768, 1280, 1794, 2052, 2566, 3080, 0, -256, -768, -1280, -1790, -2044, -2554, -3064,
+        0, 512, 1024, 1536, 2051, 2565, 3079, 3593, 0, -512, -1024, -1536, -2045, -2555, -3065, -3575,
+        1, 513, 1025, 1537, 2308, 2822, 3336, 3850, 1, -511, -1023, -1535, -2300, -2810, -3320, -3830,
+        2, 514, 1282, 1794, 2565, 3079, 3849, 4363, 2, -510, -1278, -1790, -2555, -3065, -3831, -4341,
+        3, 515, 1283, 2051, 2822, 3336, 4106, 4876, 3, -509, -1277, -2045, -2810, -3320, -4086, -4852,
+        4, 772, 1540, 2308, 3079, 3849, 4619, 5389, 4, -764, -1532, -2300, -3065, -3831, -4597, -5363,
+        5, 773, 1541, 2309, 3336, 4106, 4876, 5646, 5, -763, -1531, -2299, -3320, -4086, -4852, -5618,
+        6, 774, 1798, 2566, 3593, 4363, 5389, 6159, 6, -762, -1786, -2554, -3575, -4341, -5363, -6129,
+        7, 1031, 2055, 3079, 4106, 5132, 6158, 7184, 7, -1017, -2041, -3065, -4086, -5108, -6130, -7152,
+        8, 1032, 2056, 3080, 4363, 5389, 6415, 7441, 8, -1016, -2040, -3064, -4341, -5363, -6385, -7407,
+        9, 1033, 2313, 3593, 4876, 5902, 7184, 8466, 9, -1015, -2295, -3575, -4852, -5874, -7152, -8430,
+        10, 1290, 2570, 3850, 5389, 6671, 7953, 9235, 10, -1270, -2550, -3830, -5363, -6641, -7919, -9197,
+        11, 1291, 2827, 4363, 5902, 7184, 8722, 10260, 11, -1269, -2805, -4341, -5874, -7152, -8686, -10220,
+        12, 1548, 3084, 4620, 6415, 7953, 9491, 11029, 12, -1524, -3060, -4596, -6385, -7919, -9453, -10987,
+        13, 1805, 3597, 5389, 7184, 8978, 10772, 12566, 13, -1779, -3571, -5363, -7152, -8942, -10732, -12522,
+        14, 1806, 3854, 5902, 7953, 9747, 11797, 13847, 14, -1778, -3826, -5874, -7919, -9709, -11755, -13801,
+        15, 2063, 4367, 6415, 8722, 10772, 13078, 15128, 15, -2033, -4337, -6385, -8686, -10732, -13034, -15080,
+        16, 2320, 4624, 6928, 9491, 11797, 14103, 16409, 16, -2288, -4592, -6896, -9453, -11755, -14057, -16359,
+        17, 2577, 5137, 7697, 10516, 13078, 15640, 18202, 17, -2543, -5103, -7663, -10476, -13034, -15592, -18150,
+        18, 2834, 5650, 8466, 11541, 14359, 17177, 19995, 18, -2798, -5614, -8430, -11499, -14313, -17127, -19941,
+        19, 3091, 6419, 9491, 12822, 15896, 19226, 22300, 19, -3053, -6381, -9453, -12778, -15848, -19174, -22244,
+        20, 3348, 6932, 10516, 14103, 17433, 21019, 24605, 20, -3308, -6892, -10476, -14057, -17383, -20965, -24547,
+        21, 3861, 7701, 11541, 15384, 19226, 23068, 26910, 21, -3819, -7659, -11499, -15336, -19174, -23012, -26850,
+        22, 4118, 8470, 12566, 16921, 21019, 25373, 29471, 22, -4074, -8426, -12522, -16871, -20965, -25315, -29409,
+        23, 4631, 9239, 13847, 18714, 23324, 27934, 32544, 23, -4585, -9193, -13801, -18662, -23268, -27874, -32480,
+        24, 5144, 10264, 15384, 20507, 25629, 30751, 35873, 24, -5096, -10216, -15336, -20453, -25571, -30689, -35807,
+        25, 5657, 11289, 16921, 22556, 28190, 33824, 39458, 25, -5607, -11239, -16871, -22500, -28130, -33760, -39390,
+        26, 6170, 12314, 18458, 24861, 31007, 37153, 43299, 26, -6118, -12262, -18406, -24803, -30945, -37087, -43229,
+        27, 6683, 13595, 20507, 27422, 34080, 40994, 47908, 27, -6629, -13541, -20453, -27362, -34016, -40926, -47836,
+        28, 7452, 15132, 22556, 30239, 37665, 45347, 52773, 28, -7396, -15076, -22500, -30177, -37599, -45277, -52699,
+        29, 8221, 16669, 24861, 33312, 41506, 49956, 58150, 29, -8163, -16611, -24803, -33248, -41438, -49884, -58074,
+        30, 8990, 18206, 27422, 36641, 45603, 54821, 64039, 30, -8930, -18146, -27362, -36575, -45533, -54747, -63961,
+        31, 10015, 19999, 29983, 40226, 50212, 60198, 70184, 31, -9953, -19937, -29921, -40158, -50140, -60122, -70104,
+        32, 11040, 22048, 33056, 44323, 55333, 66343, 77353, 32, -10976, -21984, -32992, -44253, -55259, -66265, -77271,
+        33, 12065, 24353, 36385, 48676, 60710, 73000, 85034, 33, -11999, -24287, -36319, -48604, -60634, -72920, -84950,
+        34, 13346, 26658, 39970, 53541, 66855, 80169, 93483, 34, -13278, -26590, -39902, -53467, -66777, -80087, -93397,
+        35, 14627, 29475, 44067, 58918, 73512, 88362, 102956, 35, -14557, -29405, -43997, -58842, -73432, -88278, -102868,
+        36, 16164, 32292, 48420, 64807, 80937, 97067, 113197, 36, -16092, -32220, -48348, -64729, -80855, -96981, -113107,
+        37, 17701, 35621, 53541, 71464, 89130, 107052, 124974, 37, -17627, -35547, -53467, -71384, -89046, -106964, -124882,
+        38, 19494, 39206, 58918, 78633, 98091, 117805, 137519, 38, -19418, -39130, -58842, -78551, -98005, -117715, -137425,
+        39, 21543, 43047, 64551, 86314, 107820, 129326, 150832, 39, -21465, -42969, -64473, -86230, -107732, -129234, -150736,
+        40, 23592, 47400, 71208, 95019, 118573, 142383, 166193, 40, -23512, -47320, -71128, -94933, -118483, -142289, -166095,
+        41, 26153, 52265, 78377, 104492, 130606, 156720, 182834, 41, -26071, -52183, -78295, -104404, -130514, -156624, -182734,
+        42, 28714, 57386, 86058, 114989, 143663, 172337, 201011, 42, -28630, -57302, -85974, -114899, -143569, -172239, -200909,
+        43, 31531, 63275, 94763, 126510, 158000, 189746, 221236, 43, -31445, -63189, -94677, -126418, -157904, -189646, -221132,
+        44, 34860, 69676, 104492, 139311, 174129, 208947, 243765, 44, -34772, -69588, -104404, -139217, -174031, -208845, -243659,
+        45, 38189, 76589, 114733, 153136, 191282, 229684, 267830, 45, -38099, -76499, -114643, -153040, -191182, -229580, -267722,
+        46, 42030, 84270, 126254, 168497, 210483, 252725, 294711, 46, -41938, -84178, -126162, -168399, -210381, -252619, -294601,
+        47, 46383, 92719, 139055, 185394, 231732, 278070, 324408, 47, -46289, -92625, -138961, -185294, -231628, -277962, -324296,
+        48, 50992, 101936, 152880, 203827, 254773, 305719, 356665, 48, -50896, -101840, -152784, -203725, -254667, -305609, -356551,
+        49, 56113, 112177, 168241, 224308, 280374, 336440, 392506, 49, -56015, -112079, -168143, -224204, -280266, -336328, -392390,
+        50, 61490, 123186, 184882, 246581, 308023, 369721, 431419, 50, -61390, -123086, -184782, -246475, -307913, -369607, -431301,
+        51, 67891, 135731, 203571, 271414, 339256, 407098, 474940, 51, -67789, -135629, -203469, -271306, -339144, -406982, -474820,
+        52, 74548, 149300, 223796, 298551, 373049, 447803, 522301, 52, -74444, -149196, -223692, -298441, -372935, -447685, -522179,
+        53, 81973, 164149, 246069, 328248, 410170, 492348, 574270, 53, -81867, -164043, -245963, -328136, -410054, -492228, -574146,
+        54, 90166, 180534, 270902, 361273, 451387, 541757, 632127, 54, -90058, -180426, -270794, -361159, -451269, -541635, -632001,
+        55, 99383, 198711, 298039, 397370, 496700, 596030, 695360, 55, -99273, -198601, -297929, -397254, -496580, -595906, -695232,
+        56, 109112, 218424, 327736, 437051, 546109, 655423, 764737, 56, -109000, -218312, -327624, -436933, -545987, -655297, -764607,
+        57, 120121, 240441, 360505, 480828, 600894, 721216, 841282, 57, -120007, -240327, -360391, -480708, -600770, -721088, -841150,
+        58, 132154, 264506, 396602, 528957, 661055, 793409, 925507, 58, -132038, -264390, -396486, -528835, -660929, -793279, -925373,
+        59, 145467, 290875, 436283, 581694, 727104, 872514, 1017924, 59, -145349, -290757, -436165, -581570, -726976, -872382, -1017788,
+        60, 159804, 319804, 479804, 639807, 799553, 959555, 1119557, 60, -159684, -319684, -479684, -639681, -799423, -959421, -1119419,
+        61, 175933, 351805, 527677, 703808, 879682, 1055556, 1231430, 61, -175811, -351683, -527555, -703680, -879550, -1055420, -1231290,
+        62, 193598, 387134, 580670, 774209, 967747, 1161285, 1354823, 62, -193474, -387010, -580546, -774079, -967613, -1161147, -1354681,
+        63, 212799, 425791, 638783, 851778, 1064516, 1277510, 1490504, 63, -212673, -425665, -638657, -851646, -1064380, -1277370, -1490360,
+        64, 234304, 468544, 702784, 937027, 1171269, 1405511, 1639753, 64, -234176, -468416, -702656, -936893, -1171131, -1405369, -1639607,
+        65, 257601, 515393, 772929, 1030724, 1288262, 1546056, 1803594, 65, -257471, -515263, -772799, -1030588, -1288122, -1545912, -1803446,
+        66, 283458, 566850, 850242, 1133637, 1417031, 1700425, 1983819, 66, -283326, -566718, -850110, -1133499, -1416889, -1700279, -1983669,
+        67, 311619, 623427, 935235, 1247046, 1558600, 1870410, 2182220, 67, -311485, -623293, -935101, -1246906, -1558456, -1870262, -2182068,
+        68, 342852, 685892, 1028676, 1371719, 1714505, 2057547, 2400333, 68, -342716, -685756, -1028540, -1371577, -1714359, -2057397, -2400179,
+        69, 377157, 754501, 1131589, 1508936, 1886026, 2263372, 2640462, 69, -377019, -754363, -1131451, -1508792, -1885878, -2263220, -2640306,
+        70, 415046, 830022, 1244998, 1659977, 2074955, 2489933, 2904911, 70, -414906, -829882, -1244858, -1659831, -2074805, -2489779, -2904753,
+        71, 456519, 912967, 1369415, 1825866, 2282316, 2738766, 3195216, 71, -456377, -912825, -1369273, -1825718, -2282164, -2738610, -3195056,
+        72, 502088, 1004104, 1506120, 2008395, 2510413, 3012431, 3514449, 72, -501944, -1003960, -1505976, -2008245, -2510259, -3012273, -3514287,
+        73, 552265, 1104713, 1656905, 2209356, 2761550, 3314000, 3866194, 73, -552119, -1104567, -1656759, -2209204, -2761394, -3313840, -3866030,
+        74, 607562, 1215050, 1822538, 2430285, 3037775, 3645265, 4252755, 74, -607414, -1214902, -1822390, -2430131, -3037617, -3645103, -4252589,
+        75, 668235, 1336651, 2004811, 2673230, 3341392, 4009810, 4677972, 75, -668085, -1336501, -2004661, -2673074, -3341232, -4009646, -4677804,
+        76, 735052, 1470284, 2205516, 2940751, 3675729, 4410963, 5146197, 76, -734900, -1470132, -2205364, -2940593, -3675567, -4410797, -5146027,
+        77, 808525, 1617229, 2425933, 3234640, 4043090, 4851796, 5660502, 77, -808371, -1617075, -2425779, -3234480, -4042926, -4851628, -5660330,
+        78, 889422, 1779022, 2668622, 3558225, 4447571, 5337173, 6226775, 78, -889266, -1778866, -2668466, -3558063, -4447405, -5337003, -6226601,
+        79, 978511, 1956943, 2935375, 3914066, 4892500, 5870934, 6849368, 79, -978353, -1956785, -2935217, -3913902, -4892332, -5870762, -6849192,
+        80, 1076304, 2152784, 3229008, 4305491, 5381717, 6458199, 7534424, 80, -1076144, -2152624, -3228848, -4305325, -5381547, -6458025, -7534248,
+        81, 1184081, 2368081, 3552081, 4736084, 5920086, 7104088, 8288088, 81, -1183919, -2367919, -3551919, -4735916, -5919914, -7103912, -8287912,
+        82, 1302354, 2604882, 3907154, 5209685, 6511959, 7814488, 9116760, 82, -1302190, -2604718, -3906990, -5209515, -6511785, -7814312, -9116584,
+        83, 1432659, 2865235, 4297811, 5730646, 7163224, 8595800, 10028376, 83, -1432493, -2865069, -4297645, -5730474, -7163048, -8595624, -10028200,
+        84, 1575764, 3151700, 4727636, 6303575, 7879256, 9455192, 11031128, 84, -1575596, -3151532, -4727468, -6303401, -7879080, -9455016, -11030952,
+        85, 1733461, 3467093, 5200469, 6934104, 8667480, 10401112, 12134488, 85, -1733291, -3466923, -5200299, -6933928, -8667304, -10400936, -12134312,
+        86, 1906774, 3813718, 5720406, 7627352, 9534040, 11440984, 13347672, 86, -1906602, -3813546, -5720234, -7627176, -9533864, -11440808, -13347496,
+        87, 2096983, 4194135, 6291287, 8388440, 10485336, 12582488, 14679640, 87, -2096809, -4193961, -6291113, -8388264, -10485160, -12582312, -14679464,
+    },
+    { /* IMA_EXPAND_WV6 */
+        0, 256, 1024, 1792, 2562, 3076, 3846, 4616, 0, -256, -1024, -1792, -2558, -3068, -3834, -4600,
+        0, 768, 1536, 2304, 3075, 3845, 4615, 5385, 0, -768, -1536, -2304, -3069, -3835, -4601, -5367,
+        1, 769, 1537, 2305, 3332, 4102, 4872, 5642, 1, -767, -1535, -2303, -3324, -4090, -4856, -5622,
+        2, 770, 1794, 2562, 3845, 4615, 5641, 6411, 2, -766, -1790, -2558, -3835, -4601, -5623, -6389,
+        3, 771, 1795, 3075, 4102, 4872, 6154, 7180, 3, -765, -1789, -3069, -4090, -4856, -6134, -7156,
+        4, 1028, 2308, 3332, 4615, 5641, 6923, 7949, 4, -1020, -2300, -3324, -4601, -5623, -6901, -7923,
+        5, 1029, 2309, 3333, 4872, 6154, 7180, 8462, 5, -1019, -2299, -3323, -4856, -6134, -7156, -8434,
+        6, 1030, 2566, 3846, 5385, 6411, 7949, 9231, 6, -1018, -2554, -3834, -5367, -6389, -7923, -9201,
+        7, 1543, 3079, 4615, 6154, 7692, 9230, 10768, 7, -1529, -3065, -4601, -6134, -7668, -9202, -10736,
+        8, 1544, 3080, 4616, 6411, 7949, 9487, 11025, 8, -1528, -3064, -4600, -6389, -7923, -9457, -10991,
+        9, 1545, 3337, 5385, 7180, 8718, 10768, 12562, 9, -1527, -3319, -5367, -7156, -8690, -10736, -12526,
+        10, 1802, 3850, 5642, 7949, 9999, 11793, 13843, 10, -1782, -3830, -5622, -7923, -9969, -11759, -13805,
+        11, 1803, 4107, 6411, 8718, 10768, 13074, 15380, 11, -1781, -4085, -6389, -8690, -10736, -13038, -15340,
+        12, 2316, 4620, 6924, 9487, 11793, 14099, 16405, 12, -2292, -4596, -6900, -9457, -11759, -14061, -16363,
+        13, 2573, 5389, 7949, 10768, 13330, 16148, 18710, 13, -2547, -5363, -7923, -10736, -13294, -16108, -18666,
+        14, 2574, 5646, 8718, 11793, 14611, 17685, 20759, 14, -2546, -5618, -8690, -11759, -14573, -17643, -20713,
+        15, 3087, 6415, 9487, 13074, 16148, 19478, 22552, 15, -3057, -6385, -9457, -13038, -16108, -19434, -22504,
+        16, 3344, 6928, 10256, 14099, 17685, 21015, 24601, 16, -3312, -6896, -10224, -14061, -17643, -20969, -24551,
+        17, 3857, 7697, 11537, 15636, 19478, 23320, 27162, 17, -3823, -7663, -11503, -15596, -19434, -23272, -27110,
+        18, 4114, 8466, 12562, 17173, 21527, 25625, 29979, 18, -4078, -8430, -12526, -17131, -21481, -25575, -29925,
+        19, 4627, 9491, 14099, 19222, 23832, 28698, 33308, 19, -4589, -9453, -14061, -19178, -23784, -28646, -33252,
+        20, 4884, 10260, 15636, 21015, 26137, 31515, 36893, 20, -4844, -10220, -15596, -20969, -26087, -31461, -36835,
+        21, 5653, 11541, 17173, 23064, 28698, 34588, 40222, 21, -5611, -11499, -17131, -23016, -28646, -34532, -40162,
+        22, 6166, 12566, 18710, 25369, 31515, 37917, 44063, 22, -6122, -12522, -18666, -25319, -31461, -37859, -44001,
+        23, 6935, 13847, 20759, 27930, 34844, 41758, 48672, 23, -6889, -13801, -20713, -27878, -34788, -41698, -48608,
+        24, 7704, 15384, 23064, 30747, 38429, 46111, 53793, 24, -7656, -15336, -23016, -30693, -38371, -46049, -53727,
+        25, 8473, 16921, 25369, 33820, 42270, 50720, 59170, 25, -8423, -16871, -25319, -33764, -42210, -50656, -59102,
+        26, 9242, 18458, 27674, 37149, 46367, 55585, 64803, 26, -9190, -18406, -27622, -37091, -46305, -55519, -64733,
+        27, 10011, 20251, 30747, 40990, 50976, 61474, 71716, 27, -9957, -20197, -30693, -40930, -50912, -61406, -71644,
+        28, 11036, 22556, 33820, 45343, 56353, 67875, 79141, 28, -10980, -22500, -33764, -45281, -56287, -67805, -79067,
+        29, 12317, 24861, 37149, 49952, 62242, 74788, 87078, 29, -12259, -24803, -37091, -49888, -62174, -74716, -87002,
+        30, 13342, 27166, 40990, 54817, 68387, 82213, 96039, 30, -13282, -27106, -40930, -54751, -68317, -82139, -95961,
+        31, 14879, 29983, 44831, 60194, 75300, 90150, 105256, 31, -14817, -29921, -44769, -60126, -75228, -90074, -105176,
+        32, 16416, 33056, 49440, 66339, 82981, 99367, 116009, 32, -16352, -32992, -49376, -66269, -82907, -99289, -115927,
+        33, 17953, 36385, 54561, 72996, 90918, 109352, 127530, 33, -17887, -36319, -54495, -72924, -90842, -109272, -127446,
+        34, 20002, 39970, 59938, 80165, 100135, 120105, 140075, 34, -19934, -39902, -59870, -80091, -100057, -120023, -139989,
+        35, 21795, 44067, 66083, 88358, 110120, 132394, 154412, 35, -21725, -43997, -66013, -88282, -110040, -132310, -154324,
+        36, 24100, 48420, 72484, 97063, 121385, 145451, 169773, 36, -24028, -48348, -72412, -96985, -121303, -145365, -169683,
+        37, 26405, 53285, 80165, 107048, 133674, 160556, 187438, 37, -26331, -53211, -80091, -106968, -133590, -160468, -187346,
+        38, 29222, 58662, 88358, 117801, 146987, 176685, 206127, 38, -29146, -58586, -88282, -117719, -146901, -176595, -206033,
+        39, 32295, 64551, 96807, 129322, 161580, 193838, 226096, 39, -32217, -64473, -96729, -129238, -161492, -193746, -226000,
+        40, 35368, 70952, 106792, 142379, 177709, 213551, 249137, 40, -35288, -70872, -106712, -142293, -177619, -213457, -249039,
+        41, 39209, 78377, 117545, 156716, 195886, 235056, 274226, 41, -39127, -78295, -117463, -156628, -195794, -234960, -274126,
+        42, 43050, 86058, 129066, 172333, 215343, 258353, 301363, 42, -42966, -85974, -128982, -172243, -215249, -258255, -301261,
+        43, 47147, 94763, 142123, 189742, 236848, 284466, 331828, 43, -47061, -94677, -142037, -189650, -236752, -284366, -331724,
+        44, 52268, 104492, 156716, 208943, 261169, 313395, 365621, 44, -52180, -104404, -156628, -208849, -261071, -313293, -365515,
+        45, 57133, 114733, 172077, 229680, 286770, 344372, 401718, 45, -57043, -114643, -171987, -229584, -286670, -344268, -401610,
+        46, 63022, 126254, 189230, 252721, 315699, 378933, 441911, 46, -62930, -126162, -189138, -252623, -315597, -378827, -441801,
+        47, 69423, 139055, 208431, 278066, 347444, 417078, 486456, 47, -69329, -138961, -208337, -277966, -347340, -416970, -486344,
+        48, 76336, 152880, 229168, 305715, 382005, 458551, 534841, 48, -76240, -152784, -229072, -305613, -381899, -458441, -534727,
+        49, 84017, 168241, 252209, 336436, 420406, 504632, 588602, 49, -83919, -168143, -252111, -336332, -420298, -504520, -588486,
+        50, 92210, 184626, 277298, 369717, 461879, 554553, 646971, 50, -92110, -184526, -277198, -369611, -461769, -554439, -646853,
+        51, 101683, 203571, 305203, 407094, 508728, 610618, 712252, 51, -101581, -203469, -305101, -406986, -508616, -610502, -712132,
+        52, 111668, 223796, 335668, 447799, 559417, 671547, 783421, 52, -111564, -223692, -335564, -447689, -559303, -671429, -783299,
+        53, 122933, 246069, 368949, 492344, 615226, 738364, 861246, 53, -122827, -245963, -368843, -492232, -615110, -738244, -861122,
+        54, 135222, 270646, 406326, 541753, 676923, 812605, 948031, 54, -135114, -270538, -406218, -541639, -676805, -812483, -947905,
+        55, 149047, 298039, 447031, 596026, 745020, 894014, 1043008, 55, -148937, -297929, -446921, -595910, -744900, -893890, -1042880,
+        56, 163640, 327480, 491576, 655419, 819005, 983103, 1146945, 56, -163528, -327368, -491464, -655301, -818883, -982977, -1146815,
+        57, 180025, 360505, 540729, 721212, 901182, 1081664, 1261890, 57, -179911, -360391, -540615, -721092, -901058, -1081536, -1261758,
+        58, 198202, 396602, 594746, 793405, 991551, 1189953, 1388099, 58, -198086, -396486, -594630, -793283, -991425, -1189823, -1387965,
+        59, 218171, 436283, 654395, 872510, 1090624, 1308738, 1526852, 59, -218053, -436165, -654277, -872386, -1090496, -1308606, -1526716,
+        60, 239676, 479548, 719676, 959551, 1199169, 1439299, 1679173, 60, -239556, -479428, -719556, -959425, -1199039, -1439165, -1679035,
+        61, 263741, 527677, 791357, 1055552, 1319490, 1583172, 1847110, 61, -263619, -527555, -791235, -1055424, -1319358, -1583036, -1846970,
+        62, 290366, 580670, 870974, 1161281, 1451587, 1741893, 2032199, 62, -290242, -580546, -870850, -1161151, -1451453, -1741755, -2032057,
+        63, 319039, 638527, 958015, 1277506, 1596740, 1916230, 2235720, 63, -318913, -638401, -957889, -1277374, -1596604, -1916090, -2235576,
+        64, 351296, 702784, 1054016, 1405507, 1756741, 2108231, 2459465, 64, -351168, -702656, -1053888, -1405373, -1756603, -2108089, -2459319,
+        65, 386369, 772929, 1159233, 1546052, 1932358, 2318920, 2705226, 65, -386239, -772799, -1159103, -1545916, -1932218, -2318776, -2705078,
+        66, 425026, 850242, 1275202, 1700421, 2125383, 2550601, 2975563, 66, -424894, -850110, -1275070, -1700283, -2125241, -2550455, -2975413,
+        67, 467267, 934979, 1402691, 1870406, 2337864, 2805578, 3273292, 67, -467133, -934845, -1402557, -1870266, -2337720, -2805430, -3273140,
+        68, 514116, 1028676, 1542980, 2057543, 2571593, 3086155, 3600461, 68, -513980, -1028540, -1542844, -2057401, -2571447, -3086005, -3600307,
+        69, 565573, 1131589, 1697349, 2263368, 2828874, 3394892, 3960654, 69, -565435, -1131451, -1697211, -2263224, -2828726, -3394740, -3960498,
+        70, 622406, 1244998, 1867334, 2489929, 3112267, 3734861, 4357199, 70, -622266, -1244858, -1867194, -2489783, -3112117, -3734707, -4357041,
+        71, 684615, 1369415, 2053959, 2738762, 3423308, 4108110, 4792656, 71, -684473, -1369273, -2053817, -2738614, -3423156, -4107954, -4792496,
+        72, 752968, 1506120, 2259016, 3012427, 3765581, 4518479, 5271633, 72, -752824, -1505976, -2258872, -3012277, -3765427, -4518321, -5271471,
+        73, 828233, 1656905, 2485321, 3313996, 4142158, 4970832, 5799250, 73, -828087, -1656759, -2485175, -3313844, -4142002, -4970672, -5799086,
+        74, 911178, 1822538, 2733642, 3645261, 4556623, 5467729, 6379091, 74, -911030, -1822390, -2733494, -3645107, -4556465, -5467567, -6378925,
+        75, 1002315, 2004811, 3007051, 4009806, 5012048, 6014546, 7016788, 75, -1002165, -2004661, -3006901, -4009650, -5011888, -6014382, -7016620,
+        76, 1102412, 2205260, 3308108, 4410959, 5513553, 6616403, 7719253, 76, -1102260, -2205108, -3307956, -4410801, -5513391, -6616237, -7719083,
+        77, 1212749, 2425677, 3638861, 4851792, 6064466, 7277652, 8490582, 77, -1212595, -2425523, -3638707, -4851632, -6064302, -7277484, -8490410,
+        78, 1334094, 2668366, 4002894, 5337169, 6671187, 8005717, 9339991, 78, -1333938, -2668210, -4002738, -5337007, -6671021, -8005547, -9339817,
+        79, 1467727, 2935375, 4403023, 5870930, 7338580, 8806230, 10273880, 79, -1467569, -2935217, -4402865, -5870766, -7338412, -8806058, -10273704,
+        80, 1614416, 3229008, 4843344, 6458195, 8072533, 9687127, 11301464, 80, -1614256, -3228848, -4843184, -6458029, -8072363, -9686953, -11301288,
+        81, 1775953, 3552081, 5327953, 7104084, 8879958, 10656088, 12431960, 81, -1775791, -3551919, -5327791, -7103916, -8879786, -10655912, -12431784,
+        82, 1953362, 3907154, 5860690, 7814485, 9767767, 11721560, 13675096, 82, -1953198, -3906990, -5860526, -7814315, -9767593, -11721384, -13674920,
+        83, 2148947, 4297811, 6446675, 8595798, 10744664, 12893528, 15042392, 83, -2148781, -4297645, -6446509, -8595626, -10744488, -12893352, -15042216,
+        84, 2363476, 4727380, 7091284, 9455191, 11818840, 14182744, 16546648, 84, -2363308, -4727212, -7091116, -9455017, -11818664, -14182568, -16546472,
+        85, 2600021, 5200469, 7800661, 10401112, 13001048, 15601496, 18201688, 85, -2599851, -5200299, -7800491, -10400936, -13000872, -15601320, -18201512,
+        86, 2860118, 5720406, 8580438, 11440984, 14301016, 17161304, 20021336, 86, -2859946, -5720234, -8580266, -11440808, -14300840, -17161128, -20021160,
+        87, 3145303, 6291031, 9436759, 12582488, 15727960, 18873688, 22019416, 87, -3145129, -6290857, -9436585, -12582312, -15727784, -18873512, -22019240,
+    },
+    { /* IMA_EXPAND_BLITZ */
+        768, 2560, 4352, 6144, 7938, 9732, 11526, 13320, 768, -1024, -2816, -4608, -6398, -8188, -9978, -11768,
+        1024, 3072, 5120, 7168, 9219, 11269, 13319, 15369, 1024, -1024, -3072, -5120, -7165, -9211, -11257, -13303,
+        1025, 3329, 5633, 7937, 10244, 12550, 14856, 17162, 1025, -1279, -3583, -5887, -8188, -10490, -12792, -15094,
+        1282, 3842, 6402, 8962, 11525, 14087, 16649, 19211, 1282, -1278, -3838, -6398, -8955, -11513, -14071, -16629,
+        1283, 4099, 6915, 9731, 12550, 15368, 18186, 21004, 1283, -1533, -4349, -7165, -9978, -12792, -15606, -18420,
+        1540, 4612, 7684, 10756, 13831, 16905, 19979, 23053, 1540, -1532, -4604, -7676, -10745, -13815, -16885, -19955,
+        1541, 4869, 8197, 11525, 14856, 18186, 21516, 24846, 1541, -1787, -5115, -8443, -11768, -15094, -18420, -21746,
+        1798, 5382, 8966, 12550, 16137, 19723, 23309, 26895, 1798, -1786, -5370, -8954, -12535, -16117, -19699, -23281,
+        2055, 6151, 10247, 14343, 18442, 22540, 26638, 30736, 2055, -2041, -6137, -10233, -14326, -18420, -22514, -26608,
+        2056, 6408, 10760, 15112, 19467, 23821, 28175, 32529, 2056, -2296, -6648, -11000, -15349, -19699, -24049, -28399,
+        2313, 7177, 12041, 16905, 21772, 26638, 31504, 36370, 2313, -2551, -7415, -12279, -17140, -22002, -26864, -31726,
+        2570, 7946, 13322, 18698, 24077, 29455, 34833, 40211, 2570, -2806, -8182, -13558, -18931, -24305, -29679, -35053,
+        2827, 8715, 14603, 20491, 26382, 32272, 38162, 44052, 2827, -3061, -8949, -14837, -20722, -26608, -32494, -38380,
+        3084, 9484, 15884, 22284, 28687, 35089, 41491, 47893, 3084, -3316, -9716, -16116, -22513, -28911, -35309, -41707,
+        3597, 10765, 17933, 25101, 32272, 39442, 46612, 53782, 3597, -3571, -10739, -17907, -25072, -32238, -39404, -46570,
+        3854, 11790, 19726, 27662, 35601, 43539, 51477, 59415, 3854, -4082, -12018, -19954, -27887, -35821, -43755, -51689,
+        4367, 13071, 21775, 30479, 39186, 47892, 56598, 65304, 4367, -4337, -13041, -21745, -30446, -39148, -47850, -56552,
+        4624, 14096, 23568, 33040, 42515, 51989, 61463, 70937, 4624, -4848, -14320, -23792, -33261, -42731, -52201, -61671,
+        5137, 15633, 26129, 36625, 47124, 57622, 68120, 78618, 5137, -5359, -15855, -26351, -36844, -47338, -57832, -68326,
+        5650, 17170, 28690, 40210, 51733, 63255, 74777, 86299, 5650, -5870, -17390, -28910, -40427, -51945, -63463, -74981,
+        6419, 19219, 32019, 44819, 57622, 70424, 83226, 96028, 6419, -6381, -19181, -31981, -44778, -57576, -70374, -83172,
+        6932, 21012, 35092, 49172, 63255, 77337, 91419, 105501, 6932, -7148, -21228, -35308, -49385, -63463, -77541, -91619,
+        7701, 23061, 38421, 53781, 69144, 84506, 99868, 115230, 7701, -7659, -23019, -38379, -53736, -69094, -84452, -99810,
+        8470, 25366, 42262, 59158, 76057, 92955, 109853, 126751, 8470, -8426, -25322, -42218, -59111, -76005, -92899, -109793,
+        9239, 27927, 46615, 65303, 83994, 102684, 121374, 140064, 9239, -9449, -28137, -46825, -65510, -84196, -102882, -121568,
+        10264, 30744, 51224, 71704, 92187, 112669, 133151, 153633, 10264, -10216, -30696, -51176, -71653, -92131, -112609, -133087,
+        11289, 33817, 56345, 78873, 101404, 123934, 146464, 168994, 11289, -11239, -33767, -56295, -78820, -101346, -123872, -146398,
+        12314, 37146, 61978, 86810, 111645, 136479, 161313, 186147, 12314, -12518, -37350, -62182, -87011, -111841, -136671, -161501,
+        13595, 40987, 68379, 95771, 123166, 150560, 177954, 205348, 13595, -13797, -41189, -68581, -95970, -123360, -150750, -178140,
+        15132, 45340, 75548, 105756, 135967, 166177, 196387, 226597, 15132, -15076, -45284, -75492, -105697, -135903, -166109, -196315,
+        16669, 49949, 83229, 116509, 149792, 183074, 216356, 249638, 16669, -16611, -49891, -83171, -116448, -149726, -183004, -216282,
+        18206, 54814, 91422, 128030, 164641, 201251, 237861, 274471, 18206, -18402, -55010, -91618, -128223, -164829, -201435, -238041,
+        19999, 60191, 100383, 140575, 180770, 220964, 261158, 301352, 19999, -20193, -60385, -100577, -140766, -180956, -221146, -261336,
+        22048, 66336, 110624, 154912, 199203, 243493, 287783, 332073, 22048, -22240, -66528, -110816, -155101, -199387, -243673, -287959,
+        24353, 72993, 121633, 170273, 218916, 267558, 316200, 364842, 24353, -24287, -72927, -121567, -170204, -218842, -267480, -316118,
+        26658, 80162, 133666, 187170, 240677, 294183, 347689, 401195, 26658, -26846, -80350, -133854, -187355, -240857, -294359, -347861,
+        29475, 88355, 147235, 206115, 264998, 323880, 382762, 441644, 29475, -29405, -88285, -147165, -206042, -264920, -323798, -382676,
+        32292, 97060, 161828, 226596, 291367, 356137, 420907, 485677, 32292, -32476, -97244, -162012, -226777, -291543, -356309, -421075,
+        35621, 107045, 178469, 249893, 321320, 392746, 464172, 535598, 35621, -35803, -107227, -178651, -250072, -321494, -392916, -464338,
+        39206, 117798, 196390, 274982, 353577, 432171, 510765, 589359, 39206, -39386, -117978, -196570, -275159, -353749, -432339, -510929,
+        43047, 129319, 215591, 301863, 388138, 474412, 560686, 646960, 43047, -43225, -129497, -215769, -302038, -388308, -474578, -560848,
+        47400, 142376, 237352, 332328, 427307, 522285, 617263, 712241, 47400, -47576, -142552, -237528, -332501, -427475, -522449, -617423,
+        52265, 156713, 261161, 365609, 470060, 574510, 678960, 783410, 52265, -52183, -156631, -261079, -365524, -469970, -574416, -678862,
+        57386, 172330, 287274, 402218, 517165, 632111, 747057, 862003, 57386, -57558, -172502, -287446, -402387, -517329, -632271, -747213,
+        63275, 189739, 316203, 442667, 569134, 695600, 822066, 948532, 63275, -63189, -189653, -316117, -442578, -569040, -695502, -821964,
+        69676, 208940, 348204, 487468, 626735, 766001, 905267, 1044533, 69676, -69588, -208852, -348116, -487377, -626639, -765901, -905163,
+        76589, 229677, 382765, 535853, 688944, 842034, 995124, 1148214, 76589, -76499, -229587, -382675, -535760, -688846, -841932, -995018,
+        84270, 252718, 421166, 589614, 758065, 926515, 1094965, 1263415, 84270, -84178, -252626, -421074, -589519, -757965, -926411, -1094857,
+        92719, 278063, 463407, 648751, 834098, 1019444, 1204790, 1390136, 92719, -92625, -277969, -463313, -648654, -833996, -1019338, -1204680,
+        101936, 305712, 509488, 713264, 917043, 1120821, 1324599, 1528377, 101936, -101840, -305616, -509392, -713165, -916939, -1120713, -1324487,
+        112177, 336433, 560689, 784945, 1009204, 1233462, 1457720, 1681978, 112177, -112079, -336335, -560591, -784844, -1009098, -1233352, -1457606,
+        123186, 369714, 616242, 862770, 1109301, 1355831, 1602361, 1848891, 123186, -123342, -369870, -616398, -862923, -1109449, -1355975, -1602501,
+        135731, 407091, 678451, 949811, 1221174, 1492536, 1763898, 2035260, 135731, -135629, -406989, -678349, -949706, -1221064, -1492422, -1763780,
+        149300, 447796, 746292, 1044788, 1343287, 1641785, 1940283, 2238781, 149300, -149196, -447692, -746188, -1044681, -1343175, -1641669, -1940163,
+        164149, 492341, 820533, 1148725, 1476920, 1805114, 2133308, 2461502, 164149, -164043, -492235, -820427, -1148616, -1476806, -1804996, -2133186,
+        180534, 541750, 902966, 1264182, 1625401, 1986619, 2347837, 2709055, 180534, -180682, -541898, -903114, -1264327, -1625541, -1986755, -2347969,
+        198711, 596023, 993335, 1390647, 1787962, 2185276, 2582590, 2979904, 198711, -198601, -595913, -993225, -1390534, -1787844, -2185154, -2582464,
+        218424, 655416, 1092408, 1529400, 1966395, 2403389, 2840383, 3277377, 218424, -218568, -655560, -1092552, -1529541, -1966531, -2403521, -2840511,
+        240441, 721209, 1201977, 1682745, 2163516, 2644286, 3125056, 3605826, 240441, -240327, -721095, -1201863, -1682628, -2163394, -2644160, -3124926,
+        264506, 793402, 1322298, 1851194, 2380093, 2908991, 3437889, 3966787, 264506, -264390, -793286, -1322182, -1851075, -2379969, -2908863, -3437757,
+        290875, 872507, 1454139, 2035771, 2617406, 3199040, 3780674, 4362308, 290875, -290757, -872389, -1454021, -2035650, -2617280, -3198910, -3780540,
+        319804, 959548, 1599292, 2239036, 2878783, 3518529, 4158275, 4798021, 319804, -319940, -959684, -1599428, -2239169, -2878911, -3518653, -4158395,
+        351805, 1055549, 1759293, 2463037, 3166784, 3870530, 4574276, 5278022, 351805, -351939, -1055683, -1759427, -2463168, -3166910, -3870652, -4574394,
+        387134, 1161278, 1935422, 2709566, 3483713, 4257859, 5032005, 5806151, 387134, -387010, -1161154, -1935298, -2709439, -3483581, -4257723, -5031865,
+        425791, 1277503, 2129215, 2980927, 3832642, 4684356, 5536070, 6387784, 425791, -425921, -1277633, -2129345, -2981054, -3832764, -4684474, -5536184,
+        468544, 1405504, 2342464, 3279424, 4216387, 5153349, 6090311, 7027273, 468544, -468416, -1405376, -2342336, -3279293, -4216251, -5153209, -6090167,
+        515393, 1546049, 2576705, 3607361, 4638020, 5668678, 6699336, 7729994, 515393, -515263, -1545919, -2576575, -3607228, -4637882, -5668536, -6699190,
+        566850, 1700418, 2833986, 3967554, 5101125, 6234695, 7368265, 8501835, 566850, -566718, -1700286, -2833854, -3967419, -5100985, -6234551, -7368117,
+        623427, 1870403, 3117379, 4364355, 5611334, 6858312, 8105290, 9352268, 623427, -623549, -1870525, -3117501, -4364474, -5611448, -6858422, -8105396,
+        685892, 2057540, 3429188, 4800836, 6172487, 7544137, 8915787, 10287437, 685892, -685756, -2057404, -3429052, -4800697, -6172343, -7543989, -8915635,
+        754501, 2263365, 3772229, 5281093, 6789960, 8298826, 9807692, 11316558, 754501, -754363, -2263227, -3772091, -5280952, -6789814, -8298676, -9807538,
+        830022, 2489926, 4149830, 5809734, 7469641, 9129547, 10789453, 12449359, 830022, -829882, -2489786, -4149690, -5809591, -7469493, -9129395, -10789297,
+        912967, 2738759, 4564551, 6390343, 8216138, 10041932, 11867726, 13693520, 912967, -912825, -2738617, -4564409, -6390198, -8215988, -10041778, -11867568,
+        1004104, 3012424, 5020744, 7029064, 9037387, 11045709, 13054031, 15062353, 1004104, -1004216, -3012536, -5020856, -7029173, -9037491, -11045809, -13054127,
+        1104713, 3313993, 5523273, 7732553, 9941836, 12151118, 14360400, 16569682, 1104713, -1104567, -3313847, -5523127, -7732404, -9941682, -12150960, -14360238,
+        1215050, 3645258, 6075466, 8505674, 10935885, 13366095, 15796305, 18226515, 1215050, -1215158, -3645366, -6075574, -8505779, -10935985, -13366191, -15796397,
+        1336651, 4009803, 6682955, 9356107, 12029262, 14702416, 17375570, 20048724, 1336651, -1336501, -4009653, -6682805, -9355954, -12029104, -14702254, -17375404,
+        1470284, 4410956, 7351628, 10292300, 13232975, 16173649, 19114323, 22054997, 1470284, -1470388, -4411060, -7351732, -10292401, -13233071, -16173741, -19114411,
+        1617229, 4851789, 8086349, 11320909, 14555472, 17790034, 21024596, 24259158, 1617229, -1617331, -4851891, -8086451, -11321008, -14555566, -17790124, -21024682,
+        1779022, 5337166, 8895310, 12453454, 16011601, 19569747, 23127893, 26686039, 1779022, -1779122, -5337266, -8895410, -12453551, -16011693, -19569835, -23127977,
+        1956943, 5870927, 9784911, 13698895, 17612882, 21526868, 25440854, 29354840, 1956943, -1957041, -5871025, -9785009, -13698990, -17612972, -21526954, -25440936,
+        2152784, 6458192, 10763600, 15069008, 19374419, 23679829, 27985239, 32290648, 2152784, -2152624, -6458032, -10763440, -15068845, -19374251, -23679657, -27985064,
+        2368081, 7104081, 11840081, 16576081, 21312084, 26048086, 30784088, 35520088, 2368081, -2367919, -7103919, -11839919, -16575916, -21311914, -26047912, -30783912,
+        2604882, 7814482, 13024082, 18233682, 23443285, 28652887, 33862488, 39072088, 2604882, -2604718, -7814318, -13023918, -18233515, -23443113, -28652712, -33862312,
+        2861907, 8585555, 14309203, 20032851, 25756502, 31480152, 37203800, 42927448, 2861907, -2861741, -8585389, -14309037, -20032682, -25756328, -31479976, -37203624,
+        3152980, 9459028, 15765076, 22071124, 28377175, 34683224, 40989272, 47295320, 3152980, -3153068, -9459116, -15765164, -22071209, -28377256, -34683304, -40989352,
+        3467093, 10401109, 17335125, 24269141, 31203160, 38137176, 45071192, 52005208, 3467093, -3466923, -10400939, -17334955, -24268968, -31202984, -38137000, -45071016,
+        3813718, 11440982, 19068246, 26695510, 34322776, 41950040, 49577304, 57204568, 3813718, -3813546, -11440810, -19068074, -26695336, -34322600, -41949864, -49577128,
+        4194135, 12582487, 20970839, 29359191, 37747544, 46135896, 54524248, 62912600, 4194135, -4194217, -12582569, -20970921, -29359272, -37747624, -46135976, -54524328,
+    },
+};
+
+#endif /* _IMA_DECODER_DATA_H_ */
@@ -1,93 +1,138 @@
 #include "coding.h"
 #include "../util.h"
 
-void decode_ngc_dsp(VGMSTREAMCHANNEL * stream, sample_t * outbuf, int channelspacing, int32_t first_sample, int32_t samples_to_do) {
-    int i=first_sample;
-    int32_t sample_count;
+#define DSP_FRAME_SIZE 0x08
+#define DSP_FRAME_SAMPLES 14
+#define DSP_READ_FRAMES 0x20 /* frames read at once when data can't be accessed directly */
 
-    int framesin = first_sample/14;
 
-    int8_t header = read_8bit(framesin*8+stream->offset,stream->streamfile);
+/* decodes samples of a single frame from memory */
+static void decode_ngc_dsp_frame(VGMSTREAMCHANNEL * stream, const uint8_t * frame, sample_t * outbuf, int channelspacing, int first_sample, int samples_to_do, int32_t * hist1, int32_t * hist2) {
+    int i, sample_count;
+    int8_t header = frame[0];
     int32_t scale = 1 << (header & 0xf);
     int coef_index = (header >> 4) & 0xf;
-    int32_t hist1 = stream->adpcm_history1_16;
-    int32_t hist2 = stream->adpcm_history2_16;
     int coef1 = stream->adpcm_coef[coef_index*2];
     int coef2 = stream->adpcm_coef[coef_index*2+1];
 
-    first_sample = first_sample%14;
-
     for (i=first_sample,sample_count=0; i<first_sample+samples_to_do; i++,sample_count+=channelspacing) {
-        int sample_byte = read_8bit(framesin*8+stream->offset+1+i/2,stream->streamfile);
+        int sample_byte = frame[1 + i/2];
 
         outbuf[sample_count] = clamp16((
                  (((i&1?
                     get_low_nibble_signed(sample_byte):
                     get_high_nibble_signed(sample_byte)
                    ) * scale)<<11) + 1024 +
-                 (coef1 * hist1 + coef2 * hist2))>>11
+                 (coef1 * *hist1 + coef2 * *hist2))>>11
                 );
 
-        hist2 = hist1;
-        hist1 = outbuf[sample_count];
+        *hist2 = *hist1;
+        *hist1 = outbuf[sample_count];
     }
-
-    stream->adpcm_history1_16 = hist1;
-    stream->adpcm_history2_16 = hist2;
 }
 
-/* read from memory rather than a file */
-static void decode_ngc_dsp_subint_internal(VGMSTREAMCHANNEL * stream, sample_t * outbuf, int channelspacing, int32_t first_sample, int32_t samples_to_do, uint8_t * mem) {
-    int i=first_sample;
-    int32_t sample_count;
+/* reads bytes, leaving unread bytes (past EOF) as -1 like read_8bit */
+static void read_dsp_bytes(uint8_t * buf, off_t offset, size_t length, STREAMFILE *streamFile) {
+    size_t bytes = read_streamfile(buf, offset, length, streamFile);
+    if (bytes < length)
+        memset(buf + bytes, 0xFF, length - bytes);
+}
 
-    int8_t header = mem[0];
-    int32_t scale = 1 << (header & 0xf);
-    int coef_index = (header >> 4) & 0xf;
+/* Decodes any number of samples (usually a full interleave block), fetching whole frames
+ * at once rather than reading each byte. */
+void decode_ngc_dsp(VGMSTREAMCHANNEL * stream, sample_t * outbuf, int channelspacing, int32_t first_sample, int32_t samples_to_do) {
+    uint8_t frames[DSP_READ_FRAMES * DSP_FRAME_SIZE];
+    int frames_in, sample_count = 0;
     int32_t hist1 = stream->adpcm_history1_16;
     int32_t hist2 = stream->adpcm_history2_16;
-    int coef1 = stream->adpcm_coef[coef_index*2];
-    int coef2 = stream->adpcm_coef[coef_index*2+1];
 
-    first_sample = first_sample%14;
+    frames_in = first_sample / DSP_FRAME_SAMPLES;
+    first_sample = first_sample % DSP_FRAME_SAMPLES;
+
+    while (samples_to_do > 0) {
+        int i, frames_to_do;
+        off_t frames_offset = stream->offset + frames_in*DSP_FRAME_SIZE;
+        const uint8_t * data;
+
+        frames_to_do = (first_sample + samples_to_do + DSP_FRAME_SAMPLES - 1) / DSP_FRAME_SAMPLES;
+        data = get_streamfile_data(frames_offset, frames_to_do*DSP_FRAME_SIZE, stream->streamfile);
+        if (!data) {
+            if (frames_to_do > DSP_READ_FRAMES)
+                frames_to_do = DSP_READ_FRAMES;
+            read_dsp_bytes(frames, frames_offset, frames_to_do*DSP_FRAME_SIZE, stream->streamfile);
+            data = frames;
+        }
 
-    for (i=first_sample,sample_count=0; i<first_sample+samples_to_do; i++,sample_count+=channelspacing) {
-        int sample_byte = mem[1 + i/2];
+        for (i = 0; i < frames_to_do && samples_to_do > 0; i++) {
+            int samples_this_frame = DSP_FRAME_SAMPLES - first_sample;
+            if (samples_this_frame > samples_to_do)
+                samples_this_frame = samples_to_do;
 
-        outbuf[sample_count] = clamp16((
-                 (((i&1?
-                    get_low_nibble_signed(sample_byte):
-                    get_high_nibble_signed(sample_byte)
-                   ) * scale)<<11) + 1024 +
-                 (coef1 * hist1 + coef2 * hist2))>>11
-                );
+            decode_ngc_dsp_frame(stream, data + i*DSP_FRAME_SIZE, outbuf + sample_count*channelspacing, channelspacing,
+                    first_sample, samples_this_frame, &hist1, &hist2);
+
+            sample_count += samples_this_frame;
+            samples_to_do -= samples_this_frame;
+            first_sample = 0;
+        }
 
-        hist2 = hist1;
-        hist1 = outbuf[sample_count];
+        frames_in += frames_to_do;
     }
 
     stream->adpcm_history1_16 = hist1;
     stream->adpcm_history2_16 = hist2;
 }
 
+/* gets a channel's frame from byte-interleaved frames (ex. 0x08: 1122112211221122) */
+static void get_ngc_dsp_subint_frame(uint8_t * frame, off_t group_offset, int channelspacing, int channel, int interleave, STREAMFILE *streamFile) {
+    const uint8_t * group = NULL;
+    int i;
+
+    /* whole group of channel frames if possible */
+    if (DSP_FRAME_SIZE % interleave == 0)
+        group = get_streamfile_data(group_offset, DSP_FRAME_SIZE*channelspacing, streamFile);
+
+    /* base + subint section + subint byte + channel adjust */
+    for (i = 0; i < DSP_FRAME_SIZE; i += interleave) {
+        off_t offset = i*channelspacing + interleave*channel;
+        size_t bytes = interleave;
+        if (bytes > DSP_FRAME_SIZE - i)
+            bytes = DSP_FRAME_SIZE - i;
+
+        if (group)
+            memcpy(frame + i, group + offset, bytes);
+        else
+            read_dsp_bytes(frame + i, group_offset + offset, bytes, streamFile);
+    }
+}
+
 /* decode DSP with byte-interleaved frames (ex. 0x08: 1122112211221122) */
 void decode_ngc_dsp_subint(VGMSTREAMCHANNEL * stream, sample_t * outbuf, int channelspacing, int32_t first_sample, int32_t samples_to_do, int channel, int interleave) {
-    uint8_t sample_data[0x08];
-    int i;
+    uint8_t frame[DSP_FRAME_SIZE];
+    int frames_in, sample_count = 0;
+    int32_t hist1 = stream->adpcm_history1_16;
+    int32_t hist2 = stream->adpcm_history2_16;
 
-    int framesin = first_sample/14;
+    frames_in = first_sample / DSP_FRAME_SAMPLES;
+    first_sample = first_sample % DSP_FRAME_SAMPLES;
 
-    for (i=0; i < 0x08; i++) {
-        /* base + current frame + subint section + subint byte + channel adjust */
-        sample_data[i] = read_8bit(
-                stream->offset
-                + framesin*(0x08*channelspacing)
-                + i/interleave * interleave * channelspacing
-                + i%interleave
-                + interleave * channel, stream->streamfile);
+    while (samples_to_do > 0) {
+        int samples_this_frame = DSP_FRAME_SAMPLES - first_sample;
+        if (samples_this_frame > samples_to_do)
+            samples_this_frame = samples_to_do;
+
+        get_ngc_dsp_subint_frame(frame, stream->offset + frames_in*(DSP_FRAME_SIZE*channelspacing), channelspacing, channel, interleave, stream->streamfile);
+        decode_ngc_dsp_frame(stream, frame, outbuf + sample_count*channelspacing, channelspacing,
+                first_sample, samples_this_frame, &hist1, &hist2);
+
+        sample_count += samples_this_frame;
+        samples_to_do -= samples_this_frame;
+        first_sample = 0;
+        frames_in++;
     }
 
-    decode_ngc_dsp_subint_internal(stream, outbuf, channelspacing, first_sample, samples_to_do, sample_data);
+    stream->adpcm_history1_16 = hist1;
+    stream->adpcm_history2_16 = hist2;
 }
 
 
@@ -2,9 +2,26 @@
 #include "../util.h"
 #include <math.h>
 
+/* decode samples straight from the file data when the streamfile allows it (data size must be checked
+ * by caller), as the buffered per-sample reads below are the slow part */
+static void decode_pcm16_data(const uint8_t * data, sample_t * outbuf, int channelspacing, int32_t samples_to_do, size_t sample_step, int big_endian) {
+    int i, sample_count;
+    int16_t (*get_16bit)(const uint8_t *) = big_endian ? get_16bitBE : get_16bitLE;
+
+    for (i=0,sample_count=0; i<samples_to_do; i++,sample_count+=channelspacing) {
+        outbuf[sample_count]=get_16bit(data + i*sample_step);
+    }
+}
+
 void decode_pcm16le(VGMSTREAMCHANNEL * stream, sample_t * outbuf, int channelspacing, int32_t first_sample, int32_t samples_to_do) {
     int i;
     int32_t sample_count;
+    const uint8_t * data = get_streamfile_data(stream->offset+first_sample*2, samples_to_do*2, stream->streamfile);
+
+    if (data) {
+        decode_pcm16_data(data, outbuf, channelspacing, samples_to_do, 2, 0);
+        return;
+    }
 
     for (i=first_sample,sample_count=0; i<first_sample+samples_to_do; i++,sample_count+=channelspacing) {
         outbuf[sample_count]=read_16bitLE(stream->offset+i*2,stream->streamfile);
@@ -14,6 +31,12 @@ void decode_pcm16le(VGMSTREAMCHANNEL * stream, sample_t * outbuf, int channelspa
 void decode_pcm16be(VGMSTREAMCHANNEL * stream, sample_t * outbuf, int channelspacing, int32_t first_sample, int32_t samples_to_do) {
     int i;
     int32_t sample_count;
+    const uint8_t * data = get_streamfile_data(stream->offset+first_sample*2, samples_to_do*2, stream->streamfile);
+
+    if (data) {
+        decode_pcm16_data(data, outbuf, channelspacing, samples_to_do, 2, 1);
+        return;
+    }
 
     for (i=first_sample,sample_count=0; i<first_sample+samples_to_do; i++,sample_count+=channelspacing) {
         outbuf[sample_count]=read_16bitBE(stream->offset+i*2,stream->streamfile);
@@ -23,6 +46,15 @@ void decode_pcm16be(VGMSTREAMCHANNEL * stream, sample_t * outbuf, int channelspa
 void decode_pcm16_int(VGMSTREAMCHANNEL * stream, sample_t * outbuf, int channelspacing, int32_t first_sample, int32_t samples_to_do, int big_endian) {
     int i, sample_count;
     int16_t (*read_16bit)(off_t,STREAMFILE*) = big_endian ? read_16bitBE : read_16bitLE;
+    const uint8_t * data = NULL;
+
+    if (samples_to_do > 0)
+        data = get_streamfile_data(stream->offset+first_sample*2*channelspacing, ((samples_to_do-1)*channelspacing+1)*2, stream->streamfile);
+
+    if (data) {
+        decode_pcm16_data(data, outbuf, channelspacing, samples_to_do, 2*channelspacing, big_endian);
+        return;
+    }
 
     for (i=first_sample,sample_count=0; i<first_sample+samples_to_do; i++,sample_count+=channelspacing) {
         outbuf[sample_count]=read_16bit(stream->offset+i*2*channelspacing,stream->streamfile);
@@ -139,7 +171,7 @@ static int expand_ulaw(uint8_t ulawbyte) {
 
 #if 0   // the above follows Sun's implementation, but this works too
     {
-        static int exp_lut[8] = {0,132,396,924,1980,4092,8316,16764}; /* precalcs from bias */
+        static const int exp_lut[8] = {0,132,396,924,1980,4092,8316,16764}; /* precalcs from bias */
         new_sample = exp_lut[segment] + (quantization << (segment + 3));
         if (sign != 0) new_sample = -new_sample;
     }
@@ -42,12 +42,47 @@ static const int ps_adpcm_coefs_i[5][2] = {
  * may use int math in software, etc). There are inaudible rounding diffs between implementations.
  */
 
-/* standard PS-ADPCM (float math version) */
+#define PSX_READ_SIZE 0x200 /* bytes read at once when data can't be accessed directly */
+
+/* reads bytes, leaving unread bytes (past EOF) as -1 like read_8bit */
+static void read_psx_bytes(uint8_t * buf, off_t offset, size_t length, STREAMFILE *streamFile) {
+    size_t bytes = read_streamfile(buf, offset, length, streamFile);
+    if (bytes < length)
+        memset(buf + bytes, 0xFF, length - bytes);
+}
+
+/* Expands a frame's nibbles into scaled samples (before filtering). Kept apart from the filter
+ * loop below, as it has no dependencies between samples and compilers can vectorize it. */
+static void expand_psx_nibbles(int32_t * samples, const uint8_t * nibbles, int bytes, int shift_factor) {
+    int i;
+
+    for (i = 0; i < bytes; i++) {
+        uint8_t nibble = nibbles[i];
+        samples[i*2+0] = (int16_t)((nibble << 12) & 0xf000) >> shift_factor; /* low nibble first */
+        samples[i*2+1] = (int16_t)((nibble <<  8) & 0xf000) >> shift_factor; /* 16b sign extend + scale */
+    }
+}
+
+/* gets header values and validates them */
+static void get_psx_header(const uint8_t * frame, off_t frame_offset, uint8_t * coef_index, uint8_t * shift_factor) {
+    *coef_index   = (frame[0x00] >> 4) & 0xf;
+    *shift_factor = (frame[0x00] >> 0) & 0xf;
+
+    VGM_ASSERT_ONCE(*coef_index > 4 || *shift_factor > 12, "PS-ADPCM: incorrect coefs/shift at %x\n", (uint32_t)frame_offset);
+    if (*coef_index > 4) /* needed by inFamous/Afrika (PS3) (maybe it's supposed to use more filters?) */
+        *coef_index = 0; /* upper filters aren't used in PS1/PS2, maybe in PSP/PS3? */
+    if (*shift_factor > 12)
+        *shift_factor = 9; /* supposedly, from Nocash PSX docs */
+}
+
+
+/* standard PS-ADPCM (float math version).
+ * Decodes any number of samples (usually a full interleave block), fetching many frames at once. */
 void decode_psx(VGMSTREAMCHANNEL * stream, sample_t * outbuf, int channelspacing, int32_t first_sample, int32_t samples_to_do, int is_badflags) {
-    off_t frame_offset;
-    int i, frames_in, sample_count = 0;
+    uint8_t buf[PSX_READ_SIZE];
+    int32_t samples[28];
+    int frames_in, sample_count = 0;
     size_t bytes_per_frame, samples_per_frame;
-    uint8_t coef_index, shift_factor, flag;
     int32_t hist1 = stream->adpcm_history1_32;
     int32_t hist2 = stream->adpcm_history2_32;
 
@@ -57,42 +92,69 @@ void decode_psx(VGMSTREAMCHANNEL * stream, sample_t * outbuf, int channelspacing
     frames_in = first_sample / samples_per_frame;
     first_sample = first_sample % samples_per_frame;
 
-    /* parse frame header */
-    frame_offset = stream->offset + bytes_per_frame*frames_in;
-    coef_index   = ((uint8_t)read_8bit(frame_offset+0x00,stream->streamfile) >> 4) & 0xf;
-    shift_factor = ((uint8_t)read_8bit(frame_offset+0x00,stream->streamfile) >> 0) & 0xf;
-    flag = (uint8_t)read_8bit(frame_offset+0x01,stream->streamfile); /* only lower nibble needed */
-
-    VGM_ASSERT_ONCE(coef_index > 5 || shift_factor > 12, "PS-ADPCM: incorrect coefs/shift at %x\n", (uint32_t)frame_offset);
-    if (coef_index > 5) /* needed by inFamous (PS3) (maybe it's supposed to use more filters?) */
-        coef_index = 0; /* upper filters aren't used in PS1/PS2, maybe in PSP/PS3? */
-    if (shift_factor > 12)
-        shift_factor = 9; /* supposedly, from Nocash PSX docs */
-
-    if (is_badflags) /* some games store garbage or extra internal logic in the flags, must be ignored */
-        flag = 0;
-    VGM_ASSERT_ONCE(flag > 7,"PS-ADPCM: unknown flag at %x\n", (uint32_t)frame_offset); /* meta should use PSX-badflags */
-
-    /* decode nibbles */
-    for (i = first_sample; i < first_sample + samples_to_do; i++) {
-        int32_t sample = 0;
-
-        if (flag < 0x07) { /* with flag 0x07 decoded sample must be 0 */
-            uint8_t nibbles = (uint8_t)read_8bit(frame_offset+0x02+i/2,stream->streamfile);
-
-            sample = i&1 ? /* low nibble first */
-                    (nibbles >> 4) & 0x0f :
-                    (nibbles >> 0) & 0x0f;
-            sample = (int16_t)((sample << 12) & 0xf000) >> shift_factor; /* 16b sign extend + scale */
-            sample = (int)(sample + ps_adpcm_coefs_f[coef_index][0]*hist1 + ps_adpcm_coefs_f[coef_index][1]*hist2);
-            sample = clamp16(sample);
+    while (samples_to_do > 0) {
+        int f, frames_to_do;
+        off_t frames_offset = stream->offset + bytes_per_frame*frames_in;
+        const uint8_t * data;
+
+        frames_to_do = (first_sample + samples_to_do + samples_per_frame - 1) / samples_per_frame;
+        data = get_streamfile_data(frames_offset, frames_to_do*bytes_per_frame, stream->streamfile);
+        if (!data) {
+            if (frames_to_do > PSX_READ_SIZE / bytes_per_frame)
+                frames_to_do = PSX_READ_SIZE / bytes_per_frame;
+            read_psx_bytes(buf, frames_offset, frames_to_do*bytes_per_frame, stream->streamfile);
+            data = buf;
         }
 
-        outbuf[sample_count] = sample;
-        sample_count += channelspacing;
+        for (f = 0; f < frames_to_do && samples_to_do > 0; f++) {
+            const uint8_t * frame = data + f*bytes_per_frame;
+            int i, samples_this_frame;
+            uint8_t coef_index, shift_factor, flag;
+            double coef1, coef2;
+
+            /* parse frame header */
+            get_psx_header(frame, frames_offset + f*bytes_per_frame, &coef_index, &shift_factor);
+            flag = frame[0x01]; /* only lower nibble needed */
+            coef1 = ps_adpcm_coefs_f[coef_index][0];
+            coef2 = ps_adpcm_coefs_f[coef_index][1];
+
+            if (is_badflags) /* some games store garbage or extra internal logic in the flags, must be ignored */
+                flag = 0;
+            VGM_ASSERT_ONCE(flag > 7,"PS-ADPCM: unknown flag at %x\n", (uint32_t)(frames_offset + f*bytes_per_frame)); /* meta should use PSX-badflags */
+
+            samples_this_frame = samples_per_frame - first_sample;
+            if (samples_this_frame > samples_to_do)
+                samples_this_frame = samples_to_do;
+
+            /* decode nibbles */
+            if (flag < 0x07) {
+                expand_psx_nibbles(samples, frame + 0x02, bytes_per_frame - 0x02, shift_factor);
+                for (i = first_sample; i < first_sample + samples_this_frame; i++) {
+                    int32_t sample = (int)(samples[i] + coef1*hist1 + coef2*hist2);
+                    sample = clamp16(sample);
+
+                    outbuf[sample_count] = sample;
+                    sample_count += channelspacing;
+
+                    hist2 = hist1;
+                    hist1 = sample;
+                }
+            }
+            else { /* with flag 0x07 decoded sample must be 0 */
+                for (i = first_sample; i < first_sample + samples_this_frame; i++) {
+                    outbuf[sample_count] = 0;
+                    sample_count += channelspacing;
+
+                    hist2 = hist1;
+                    hist1 = 0;
+                }
+            }
 
-        hist2 = hist1;
-        hist1 = sample;
+            samples_to_do -= samples_this_frame;
+            first_sample = 0;
+        }
+
+        frames_in += frames_to_do;
     }
 
     stream->adpcm_history1_32 = hist1;
@@ -100,52 +162,132 @@ void decode_psx(VGMSTREAMCHANNEL * stream, sample_t * outbuf, int channelspacing
 }
 
 
+/* Decodes part of a configurable frame too big for the read buffers, reading it in pieces. */
+static void decode_psx_configurable_parts(VGMSTREAMCHANNEL * stream, sample_t * outbuf, int channelspacing, off_t frame_offset, int32_t first_sample, int32_t samples_to_do, int32_t * hist1, int32_t * hist2) {
+    uint8_t buf[PSX_READ_SIZE];
+    int32_t samples[PSX_READ_SIZE * 2];
+    int sample_count = 0;
+    uint8_t coef_index, shift_factor;
+    int coef1, coef2;
+
+    read_psx_bytes(buf, frame_offset, 0x01, stream->streamfile);
+    get_psx_header(buf, frame_offset, &coef_index, &shift_factor);
+    coef1 = ps_adpcm_coefs_i[coef_index][0];
+    coef2 = ps_adpcm_coefs_i[coef_index][1];
+
+    while (samples_to_do > 0) {
+        int i, bytes, samples_this_part, skip = first_sample % 2;
+
+        bytes = (skip + samples_to_do + 1) / 2;
+        if (bytes > PSX_READ_SIZE)
+            bytes = PSX_READ_SIZE;
+        samples_this_part = bytes*2 - skip;
+        if (samples_this_part > samples_to_do)
+            samples_this_part = samples_to_do;
+
+        read_psx_bytes(buf, frame_offset + 0x01 + first_sample / 2, bytes, stream->streamfile);
+        expand_psx_nibbles(samples, buf, bytes, shift_factor);
+        for (i = skip; i < skip + samples_this_part; i++) {
+            int32_t sample = samples[i] + ((coef1*(*hist1) + coef2*(*hist2)) >> 6);
+            sample = clamp16(sample);
+
+            outbuf[sample_count] = sample;
+            sample_count += channelspacing;
+
+            *hist2 = *hist1;
+            *hist1 = sample;
+        }
+
+        samples_to_do -= samples_this_part;
+        first_sample += samples_this_part;
+    }
+}
+
 /* PS-ADPCM with configurable frame size and no flag (int math version).
  * Found in some PC/PS3 games (FF XI in sizes 3/5/9/41, Afrika in size 4, Blur/James Bond in size 33, etc).
  *
  * Uses int math to decode, which seems more likely (based on FF XI PC's code in Moogle Toolbox). */
 void decode_psx_configurable(VGMSTREAMCHANNEL * stream, sample_t * outbuf, int channelspacing, int32_t first_sample, int32_t samples_to_do, int frame_size) {
-    off_t frame_offset;
-    int i, frames_in, sample_count = 0;
+    uint8_t buf[PSX_READ_SIZE];
+    int32_t samples[(PSX_READ_SIZE - 0x01) * 2];
+    int frames_in, frames_max, sample_count = 0;
     size_t bytes_per_frame, samples_per_frame;
-    uint8_t coef_index, shift_factor;
     int32_t hist1 = stream->adpcm_history1_32;
     int32_t hist2 = stream->adpcm_history2_32;
 
+    if (frame_size <= 0x01) {
+        VGM_LOG("PS-ADPCM: wrong frame size %x\n", frame_size);
+        return;
+    }
+
     /* external interleave (variable size), mono */
     bytes_per_frame = frame_size;
     samples_per_frame = (bytes_per_frame - 0x01) * 2; /* always 28 */
     frames_in = first_sample / samples_per_frame;
     first_sample = first_sample % samples_per_frame;
+    frames_max = PSX_READ_SIZE / bytes_per_frame;
+
+    while (samples_to_do > 0) {
+        int f, frames_to_do;
+        off_t frames_offset = stream->offset + bytes_per_frame*frames_in;
+        const uint8_t * data;
+
+        /* frames bigger than the buffers go in pieces, one at a time (unusual sizes) */
+        if (bytes_per_frame > PSX_READ_SIZE) {
+            int samples_this_frame = samples_per_frame - first_sample;
+            if (samples_this_frame > samples_to_do)
+                samples_this_frame = samples_to_do;
+
+            decode_psx_configurable_parts(stream, outbuf + sample_count, channelspacing, frames_offset, first_sample, samples_this_frame, &hist1, &hist2);
+            sample_count += samples_this_frame * channelspacing;
+            samples_to_do -= samples_this_frame;
+            first_sample = 0;
+            frames_in++;
+            continue;
+        }
+
+        frames_to_do = (first_sample + samples_to_do + samples_per_frame - 1) / samples_per_frame;
+        data = get_streamfile_data(frames_offset, frames_to_do*bytes_per_frame, stream->streamfile);
+        if (!data) {
+            if (frames_to_do > frames_max)
+                frames_to_do = frames_max;
+            read_psx_bytes(buf, frames_offset, frames_to_do*bytes_per_frame, stream->streamfile);
+            data = buf;
+        }
+
+        for (f = 0; f < frames_to_do && samples_to_do > 0; f++) {
+            const uint8_t * frame = data + f*bytes_per_frame;
+            int i, samples_this_frame;
+            uint8_t coef_index, shift_factor;
+            int coef1, coef2;
+
+            /* parse frame header */
+            get_psx_header(frame, frames_offset + f*bytes_per_frame, &coef_index, &shift_factor);
+            coef1 = ps_adpcm_coefs_i[coef_index][0];
+            coef2 = ps_adpcm_coefs_i[coef_index][1];
+
+            samples_this_frame = samples_per_frame - first_sample;
+            if (samples_this_frame > samples_to_do)
+                samples_this_frame = samples_to_do;
+
+            /* decode nibbles */
+            expand_psx_nibbles(samples, frame + 0x01, bytes_per_frame - 0x01, shift_factor);
+            for (i = first_sample; i < first_sample + samples_this_frame; i++) {
+                int32_t sample = samples[i] + ((coef1*hist1 + coef2*hist2) >> 6);
+                sample = clamp16(sample);
+
+                outbuf[sample_count] = sample;
+                sample_count += channelspacing;
+
+                hist2 = hist1;
+                hist1 = sample;
+            }
+
+            samples_to_do -= samples_this_frame;
+            first_sample = 0;
+        }
 
-    /* parse frame header */
-    frame_offset = stream->offset + bytes_per_frame*frames_in;
-    coef_index   = ((uint8_t)read_8bit(frame_offset+0x00,stream->streamfile) >> 4) & 0xf;
-    shift_factor = ((uint8_t)read_8bit(frame_offset+0x00,stream->streamfile) >> 0) & 0xf;
-
-    VGM_ASSERT_ONCE(coef_index > 5 || shift_factor > 12, "PS-ADPCM: incorrect coefs/shift at %x\n", (uint32_t)frame_offset);
-    if (coef_index > 5) /* needed by Afrika (PS3) (maybe it's supposed to use more filters?) */
-        coef_index = 0; /* upper filters aren't used in PS1/PS2, maybe in PSP/PS3? */
-    if (shift_factor > 12)
-        shift_factor = 9; /* supposedly, from Nocash PSX docs */
-
-    /* decode nibbles */
-    for (i = first_sample; i < first_sample + samples_to_do; i++) {
-        int32_t sample = 0;
-        uint8_t nibbles = (uint8_t)read_8bit(frame_offset+0x01+i/2,stream->streamfile);
-
-        sample = i&1 ? /* low nibble first */
-                (nibbles >> 4) & 0x0f :
-                (nibbles >> 0) & 0x0f;
-        sample = (int16_t)((sample << 12) & 0xf000) >> shift_factor; /* 16b sign extend + scale */
-        sample = sample + ((ps_adpcm_coefs_i[coef_index][0]*hist1 + ps_adpcm_coefs_i[coef_index][1]*hist2) >> 6);
-        sample = clamp16(sample);
-
-        outbuf[sample_count] = sample;
-        sample_count += channelspacing;
-
-        hist2 = hist1;
-        hist1 = sample;
+        frames_in += frames_to_do;
     }
 
     stream->adpcm_history1_32 = hist1;
@@ -6,7 +6,7 @@
 /* CBD2 - 2:1 Cuberoot-delta-exact compression (from the unreleased 3DO M2) */
 
 /* for (i=-128;i<128;i++) squares[i+128]=i<0?(-i*i)*2:(i*i)*2; */
-static int16_t squares[256] = {
+static const int16_t squares[256] = {
 -32768,-32258,-31752,-31250,-30752,-30258,-29768,-29282,-28800,-28322,-27848,
 -27378,-26912,-26450,-25992,-25538,-25088,-24642,-24200,-23762,-23328,-22898,
 -22472,-22050,-21632,-21218,-20808,-20402,-20000,-19602,-19208,-18818,-18432,
@@ -38,7 +38,7 @@ static int16_t squares[256] = {
 //    double j = (i/2)/2.0;
 //    cubes[i+128]=floor(j*j*j);
 //}
-static int16_t cubes[256]={
+static const int16_t cubes[256]={
 -32768,-31256,-31256,-29791,-29791,-28373,-28373,-27000,-27000,-25672,-25672,
 -24389,-24389,-23149,-23149,-21952,-21952,-20797,-20797,-19683,-19683,-18610,
 -18610,-17576,-17576,-16581,-16581,-15625,-15625,-14706,-14706,-13824,-13824,
@@ -63,7 +63,7 @@ static int16_t cubes[256]={
  16581, 17576, 17576, 18610, 18610, 19683, 19683, 20797, 20797, 21952, 21952,
  23149, 23149, 24389, 24389, 25672, 25672, 27000, 27000, 28373, 28373, 29791,
  29791, 31256, 31256};
-static void decode_delta_exact(VGMSTREAMCHANNEL * stream, sample * outbuf, int channelspacing, int32_t first_sample, int32_t samples_to_do, int16_t * table) {
+static void decode_delta_exact(VGMSTREAMCHANNEL * stream, sample * outbuf, int channelspacing, int32_t first_sample, int32_t samples_to_do, const int16_t * table) {
 
 	int32_t hist = stream->adpcm_history1_32;
 
@@ -82,7 +82,7 @@ static void decode_delta_exact(VGMSTREAMCHANNEL * stream, sample * outbuf, int c
 	stream->adpcm_history1_32=hist;
 }
 
-static void decode_delta_exact_int(VGMSTREAMCHANNEL * stream, sample * outbuf, int channelspacing, int32_t first_sample, int32_t samples_to_do, int16_t * table) {
+static void decode_delta_exact_int(VGMSTREAMCHANNEL * stream, sample * outbuf, int channelspacing, int32_t first_sample, int32_t samples_to_do, const int16_t * table) {
 
 	int32_t hist = stream->adpcm_history1_32;
 
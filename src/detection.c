@@ -0,0 +1,480 @@
+#include "vgmstream.h"
+#include "detection.h"
+#include "meta/meta.h"
+
+
+/**
+ * Format detection calls every init function in init_vgmstream_functions until one accepts the file,
+ * but most reject it right away from its extension or a fixed id, after opening and reading the file.
+ * Those checks are declared here so they can be done at once from the filename and first bytes, and
+ * only init functions that may accept the file are called.
+ *
+ * Each entry repeats the first extension and header checks of an init function (entries of the same
+ * function are alternatives), so they must match anything the function would accept (otherwise the
+ * file may be detected as some later format).
+ * Functions without entries (complex or variable checks) are always called. Entries are in the same
+ * order as init_vgmstream_functions, as they are matched while walking it (misplaced entries are just
+ * ignored, so detection is only slower).
+ */
+
+typedef struct {
+    init_vgmstream_t init_vgmstream;
+    const char * extensions;    /* same as check_extensions */
+    off_t magic_offset;         /* inside DETECTION_HEADER_SIZE */
+    size_t magic_size;          /* 0 = no magic */
+    const char * magic;
+} meta_signature;
+
+static const meta_signature meta_signatures[] = {
+    {init_vgmstream_adx, "adx,adp", 0x00, 2, "\x80\x00"},
+    {init_vgmstream_mca, "mca", 0x00, 4, "MADP"},
+    {init_vgmstream_btsnd, "btsnd", 0, 0, NULL},
+    {init_vgmstream_nds_strm, "strm", 0x00, 4, "STRM"},
+    {init_vgmstream_agsc, "agsc", 0x00, 4, "\x00\x00\x00\x01"},
+    {init_vgmstream_ngc_adpdtk, "dtk,adp,wav,lwav", 0, 0, NULL},
+    {init_vgmstream_rsf, "rsf", 0, 0, NULL},
+    {init_vgmstream_afc, "afc", 0, 0, NULL},
+    {init_vgmstream_ast, "ast", 0x00, 4, "STRM"},
+    {init_vgmstream_halpst, "hps", 0x00, 4, " HAL"},
+    {init_vgmstream_rs03, "dsp", 0x00, 4, "RS\x00\x03"},
+    {init_vgmstream_ngc_dsp_std, "dsp,adp", 0, 0, NULL},
+    {init_vgmstream_ngc_dsp_std_le, "adpcm", 0, 0, NULL},
+    {init_vgmstream_ngc_mdsp_std, "dsp,mdsp", 0, 0, NULL},
+    {init_vgmstream_csmp, "csmp", 0x00, 4, "CSMP"},
+    {init_vgmstream_cstr, "dsp", 0x00, 4, "Cstr"},
+    {init_vgmstream_gcsw, "gcw", 0x00, 4, "GCSW"},
+    {init_vgmstream_ps2_ads, "ads,ss2,pcm,adx,,800", 0x04, 4, "\x18\x00\x00\x00"},
+    {init_vgmstream_ps2_ads, "ads,ss2,pcm,adx,,800", 0x04, 4, " \x00\x00\x00"},
+    {init_vgmstream_nps, "nps,npsf", 0x00, 4, "NPSF"},
+    {init_vgmstream_ps2_rxw, "rxw", 0, 0, NULL},
+    {init_vgmstream_ngc_dsp_stm, "stm,lstm,dsp", 0x00, 2, "\x02\x00"},
+    {init_vgmstream_ps2_exst, "sts,x", 0x00, 4, "EXST"},
+    {init_vgmstream_ps2_svag, "svag", 0x00, 4, "Svag"},
+    {init_vgmstream_mib_mih, "mib", 0, 0, NULL},
+    {init_vgmstream_ngc_mpdsp, "mpdsp", 0, 0, NULL},
+    {init_vgmstream_ps2_mic, "mic", 0, 0, NULL},
+    {init_vgmstream_ngc_dsp_std_int, "dsp,mss,gcm", 0, 0, NULL},
+    {init_vgmstream_vag, "vag,swag,str,vig,l,r,vas,khv", 0, 0, NULL},
+    {init_vgmstream_psx_gms, "gms", 0, 0, NULL},
+    {init_vgmstream_ps2_ild, "ild", 0x00, 4, "ILD\x00"},
+    {init_vgmstream_ps2_pnb, "pnb", 0, 0, NULL},
+    {init_vgmstream_xbox_wavm, "wavm", 0, 0, NULL},
+    {init_vgmstream_ngc_str, "str", 0x00, 4, "\xfa\xaf\x00\x01"},
+    {init_vgmstream_ea_schl, "asf,lasf,str,eam,exa,sng,aud,sx,xa,strm,stm,hab,xsf,gsf,mus,", 0, 0, NULL},
+    {init_vgmstream_caf, "caf,cfn,", 0x00, 4, "CAF "},
+    {init_vgmstream_ps2_vpk, "vpk", 0x00, 4, " KPV"},
+    {init_vgmstream_genh, "genh", 0x00, 4, "GENH"},
+    {init_vgmstream_sli_ogg, "sli", 0, 0, NULL},
+    {init_vgmstream_sfl_ogg, "sfl", 0x00, 4, "RIFF"},
+    {init_vgmstream_sadb, "sad", 0x00, 4, "sadb"},
+    {init_vgmstream_ps2_bmdx, "bmdx", 0x00, 4, "\x01\x00" "d\x08"},
+    {init_vgmstream_wsi, "wsi", 0, 0, NULL},
+    {init_vgmstream_str_snds, "str", 0x00, 4, "CTRL"},
+    {init_vgmstream_str_snds, "str", 0x00, 4, "SNDS"},
+    {init_vgmstream_str_snds, "str", 0x00, 4, "SHDR"},
+    {init_vgmstream_ws_aud, "aud", 0, 0, NULL},
+    {init_vgmstream_ahx, "ahx", 0x00, 2, "\x80\x00"},
+    {init_vgmstream_ivb, "ivb", 0x00, 4, "BVII"},
+    {init_vgmstream_svs, "svs", 0x00, 4, "SVS\x00"},
+    {init_vgmstream_rifx, "wav,lwav", 0x00, 4, "RIFX"},
+    {init_vgmstream_pos, "pos", 0, 0, NULL},
+    {init_vgmstream_nwa, "nwa", 0, 0, NULL},
+    {init_vgmstream_ea_1snh, "asf,lasf,as4,cnk,sng,uv,tgq", 0x00, 4, "1SNh"},
+    {init_vgmstream_ea_1snh, "asf,lasf,as4,cnk,sng,uv,tgq", 0x00, 4, "SEAD"},
+    {init_vgmstream_ea_eacs, "eas,bnk", 0, 0, NULL},
+    {init_vgmstream_xss, "xss", 0, 0, NULL},
+    {init_vgmstream_sl3, "ms,sl3", 0x00, 4, "SL3\x00"},
+    {init_vgmstream_hgc1, "hgc1", 0x00, 4, "hgC1"},
+    {init_vgmstream_aus, "aus", 0x00, 4, "AUS "},
+    {init_vgmstream_fsb, "fsb,bnk", 0, 0, NULL},
+    {init_vgmstream_fsb5, "fsb", 0x00, 4, "FSB5"},
+    {init_vgmstream_rwx, "rwx", 0x00, 4, "RAWX"},
+    {init_vgmstream_ps2_xa30, "xa,xa30", 0x00, 4, "XA30"},
+    {init_vgmstream_musc, "mus,musc", 0x00, 4, "MUSC"},
+    {init_vgmstream_musx_v004, "musx", 0x00, 4, "MUSX"},
+    {init_vgmstream_musx_v005, "musx,sfx", 0x00, 4, "MUSX"},
+    {init_vgmstream_musx_v006, "sfx,musx", 0x00, 4, "MUSX"},
+    {init_vgmstream_musx_v010, "musx", 0x00, 4, "MUSX"},
+    {init_vgmstream_musx_v201, "musx", 0x00, 4, "MUSX"},
+    {init_vgmstream_leg, "leg", 0, 0, NULL},
+    {init_vgmstream_filp, "filp", 0x00, 4, "FILp"},
+    {init_vgmstream_ikm_ps2, "ikm", 0x00, 4, "IKM\x00"},
+    {init_vgmstream_ikm_pc, "ikm", 0x00, 4, "IKM\x00"},
+    {init_vgmstream_ikm_psp, "ikm", 0x00, 4, "IKM\x00"},
+    {init_vgmstream_sfs, "sfs", 0x00, 4, "STER"},
+    {init_vgmstream_bg00, "bg00", 0x00, 4, "BG00"},
+    {init_vgmstream_sat_dvi, "pcm,dvi", 0x00, 4, "DVI."},
+    {init_vgmstream_dc_kcey, "pcm,kcey", 0x00, 4, "KCEY"},
+    {init_vgmstream_ps2_rstm, "rsm,rstm", 0x00, 4, "RSTM"},
+    {init_vgmstream_ps2_kces, "kces,vig", 0x00, 4, "\x01\x00" "d\x08"},
+    {init_vgmstream_ps2_dxh, "dxh", 0x00, 4, "\x00" "DXH"},
+    {init_vgmstream_vsv, "vsv,psh", 0x0a, 1, "\x00"},
+    {init_vgmstream_scd_pcm, "pcm", 0, 0, NULL},
+    {init_vgmstream_ps2_pcm, "pcm", 0, 0, NULL},
+    {init_vgmstream_ps2_rkv, "rkv", 0x24, 4, "\x00\x00\x00\x00"},
+    {init_vgmstream_ps2_vas, "vas", 0, 0, NULL},
+    {init_vgmstream_ps2_tec, "tec", 0, 0, NULL},
+    {init_vgmstream_ps2_enth, "enth", 0, 0, NULL},
+    {init_vgmstream_sdt, "sdt", 0, 0, NULL},
+    {init_vgmstream_aix, "aix", 0x00, 4, "AIXF"},
+    {init_vgmstream_ngc_tydsp, "tydsp", 0, 0, NULL},
+    {init_vgmstream_ngc_swd, "swd", 0x00, 4, "PSF\xd1"},
+    {init_vgmstream_capdsp, "capdsp", 0, 0, NULL},
+    {init_vgmstream_xbox_wvs, "wvs", 0, 0, NULL},
+    {init_vgmstream_ngc_wvs, "wvs", 0, 0, NULL},
+    {init_vgmstream_dc_str, "str", 0, 0, NULL},
+    {init_vgmstream_dc_str_v2, "str", 0x00, 4, "\x02\x00\x00\x00"},
+    {init_vgmstream_xbox_matx, "matx", 0, 0, NULL},
+    {init_vgmstream_dec, "dec,de2", 0, 0, NULL},
+    {init_vgmstream_vs, "vs", 0x00, 4, "\xc8\x00\x00\x00"},
+    {init_vgmstream_dc_str, "str", 0, 0, NULL},
+    {init_vgmstream_dc_str_v2, "str", 0x00, 4, "\x02\x00\x00\x00"},
+    {init_vgmstream_xbox_xmu, "xmu", 0, 0, NULL},
+    {init_vgmstream_xbox_xvas, "xvas", 0, 0, NULL},
+    {init_vgmstream_ngc_bh2pcm, "bh2pcm", 0, 0, NULL},
+    {init_vgmstream_sat_sap, "sap", 0x0a, 4, "\x00\x10@\x0e"},
+    {init_vgmstream_dc_idvi, "dvi,idvi", 0x00, 4, "IDVI"},
+    {init_vgmstream_ps2_rnd, "rnd", 0, 0, NULL},
+    {init_vgmstream_idsp_tt, "gcm,idsp,wua", 0x00, 4, "IDSP"},
+    {init_vgmstream_kraw, "kraw", 0x00, 4, "kRAW"},
+    {init_vgmstream_ps2_omu, "omu", 0, 0, NULL},
+    {init_vgmstream_ps2_xa2, "xa2", 0, 0, NULL},
+    {init_vgmstream_nub_idsp, "idsp", 0x00, 4, "idsp"},
+    {init_vgmstream_idsp_nl, "idsp", 0x00, 4, "IDSP"},
+    {init_vgmstream_idsp_ie, "idsp", 0x00, 4, "IDSP"},
+    {init_vgmstream_ngc_ymf, "ymf", 0x00, 4, "\x00\x00\x01\x80"},
+    {init_vgmstream_sadl, "sad", 0x00, 4, "sadl"},
+    {init_vgmstream_ps2_ccc, "ccc", 0x00, 4, "\x01\x00\x00\x00"},
+    {init_vgmstream_fag, "fag", 0, 0, NULL},
+    {init_vgmstream_ps2_mihb, "mic,mihb", 0x00, 4, "@\x00\x00\x00"},
+    {init_vgmstream_ngc_pdt_split, "pdt", 0, 0, NULL},
+    {init_vgmstream_ngc_pdt, "pdt", 0x00, 2, "\x00\x01"},
+    {init_vgmstream_dc_asd, "asd", 0, 0, NULL},
+    {init_vgmstream_naomi_spsd, "str,spsd", 0x00, 4, "SPSD"},
+    {init_vgmstream_rsd2vag, "rsd", 0x00, 4, "RSD2"},
+    {init_vgmstream_rsd2pcmb, "rsd", 0x00, 4, "RSD2"},
+    {init_vgmstream_rsd2xadp, "rsd", 0x00, 4, "RSD2"},
+    {init_vgmstream_rsd3vag, "rsd", 0x00, 4, "RSD3"},
+    {init_vgmstream_rsd3gadp, "rsd", 0x00, 4, "RSD3"},
+    {init_vgmstream_rsd3pcm, "rsd", 0x00, 4, "RSD3"},
+    {init_vgmstream_rsd3pcmb, "rsd", 0x00, 4, "RSD3"},
+    {init_vgmstream_rsd4pcmb, "rsd", 0x00, 4, "RSD4"},
+    {init_vgmstream_rsd4pcm, "rsd", 0x00, 4, "RSD4"},
+    {init_vgmstream_rsd4radp, "rsd", 0x00, 4, "RSD4"},
+    {init_vgmstream_rsd4vag, "rsd", 0x00, 4, "RSD4"},
+    {init_vgmstream_rsd6vag, "rsd", 0x00, 4, "RSD6"},
+    {init_vgmstream_rsd6wadp, "rsd", 0x00, 4, "RSD6"},
+    {init_vgmstream_rsd6xadp, "rsd", 0x00, 4, "RSD6"},
+    {init_vgmstream_rsd6radp, "rsd", 0x00, 4, "RSD6"},
+    {init_vgmstream_bgw, "bgw", 0x00, 4, "BGMS"},
+    {init_vgmstream_spw, "spw", 0x00, 4, "SeWa"},
+    {init_vgmstream_ps2_ass, "ass", 0, 0, NULL},
+    {init_vgmstream_ubi_jade, "waa,wac,wad,wam,wav,lwav,psw", 0x00, 4, "RIFF"},
+    {init_vgmstream_ubi_jade_container, "waa,wac,wad,wam,wav,lwav,xma", 0, 0, NULL},
+    {init_vgmstream_nds_strm_ffta2, "bin,strm", 0x00, 4, "RIFF"},
+    {init_vgmstream_str_asr, "str,asr", 0, 0, NULL},
+    {init_vgmstream_zwdsp, "zwdsp", 0x00, 4, "\x00\x00\x00\x00"},
+    {init_vgmstream_gca, "gca", 0x00, 4, "GCA1"},
+    {init_vgmstream_spt_spd, "spd", 0, 0, NULL},
+    {init_vgmstream_ish_isd, "isd", 0, 0, NULL},
+    {init_vgmstream_gsp_gsb, "gsb", 0, 0, NULL},
+    {init_vgmstream_ydsp, "ydsp", 0x00, 4, "YDSP"},
+    {init_vgmstream_msvp, "msvp", 0x00, 4, "MSVp"},
+    {init_vgmstream_ngc_ssm, "ssm", 0, 0, NULL},
+    {init_vgmstream_ps2_joe, "joe", 0, 0, NULL},
+    {init_vgmstream_vgs, "vgs", 0x00, 4, "VgS!"},
+    {init_vgmstream_dcs_wav, "dcs", 0, 0, NULL},
+    {init_vgmstream_thp, "thp,dsp", 0x00, 4, "THP\x00"},
+    {init_vgmstream_wii_sts, "sts", 0, 0, NULL},
+    {init_vgmstream_ps2_p2bt, "p2bt", 0x00, 4, "MOVE"},
+    {init_vgmstream_ps2_p2bt, "p2bt", 0x00, 4, "P2BT"},
+    {init_vgmstream_ps2_gbts, "gbts", 0, 0, NULL},
+    {init_vgmstream_wii_sng, "sng", 0x00, 4, "0TSR"},
+    {init_vgmstream_ngc_dsp_iadp, "adp,iadp", 0x00, 4, "iadp"},
+    {init_vgmstream_utf_dsp, "aax,", 0x00, 4, "@UTF"},
+    {init_vgmstream_ngc_ffcc_str, "str", 0x00, 4, "STR\x00"},
+    {init_vgmstream_sat_baka, "baka", 0, 0, NULL},
+    {init_vgmstream_nds_swav, "swav", 0x00, 4, "SWAV"},
+    {init_vgmstream_ps2_vsf, "vsf", 0x00, 4, "VSF\x00"},
+    {init_vgmstream_nds_rrds, ",rrds", 0, 0, NULL},
+    {init_vgmstream_ps2_tk5, "tk5", 0x00, 4, "TK5S"},
+    {init_vgmstream_ps2_vsf_tta, "vsf", 0x00, 4, "SMSS"},
+    {init_vgmstream_ads, "ads", 0x00, 4, "dhSS"},
+    {init_vgmstream_ps2_mcg, "mcg", 0, 0, NULL},
+    {init_vgmstream_zsd, "zsd", 0x00, 4, "ZSD\x00"},
+    {init_vgmstream_ps2_vgs, "vgs", 0x00, 4, "VGS\x00"},
+    {init_vgmstream_ivaud, "ivaud,", 0, 0, NULL},
+    {init_vgmstream_wii_wsd, "wsd", 0, 0, NULL},
+    {init_vgmstream_wii_ndp, "ndp", 0x00, 4, "NDP\x00"},
+    {init_vgmstream_ps2_sps, "sps", 0x10, 4, "\x01\x00\x00\x00"},
+    {init_vgmstream_ps2_xa2_rrp, "xa2", 0, 0, NULL},
+    {init_vgmstream_nds_hwas, "hwas", 0x00, 4, "sawh"},
+    {init_vgmstream_ngc_lps, "lps", 0x08, 4, "\x10\x00\x00\x00"},
+    {init_vgmstream_ps2_snd, "snd", 0x00, 4, "SSND"},
+    {init_vgmstream_naomi_adpcm, "adpcm", 0x00, 4, "ADPC"},
+    {init_vgmstream_sd9, "sd9", 0x00, 4, "SD9\x00"},
+    {init_vgmstream_2dx9, "2dx9", 0x00, 4, "2DX9"},
+    {init_vgmstream_dsp_ygo, "dsp", 0, 0, NULL},
+    {init_vgmstream_ps2_vgv, "vgv", 0x08, 4, "\x00\x00\x00\x00"},
+    {init_vgmstream_ngc_gcub, "gcub", 0x00, 4, "GCub"},
+    {init_vgmstream_maxis_xa, "xa", 0x00, 4, "XAI\x00"},
+    {init_vgmstream_maxis_xa, "xa", 0x00, 4, "XAJ\x00"},
+    {init_vgmstream_ngc_sck_dsp, "dsp", 0, 0, NULL},
+    {init_vgmstream_apple_caff, "caf", 0x00, 4, "caff"},
+    {init_vgmstream_pc_mxst, "mxst", 0, 0, NULL},
+    {init_vgmstream_sab, "sab", 0x00, 4, "CSW2"},
+    {init_vgmstream_sab, "sab", 0x00, 4, "CSP2"},
+    {init_vgmstream_sab, "sab", 0x00, 4, "CSX2"},
+    {init_vgmstream_exakt_sc, "sc", 0, 0, NULL},
+    {init_vgmstream_wii_bns, "bns", 0, 0, NULL},
+    {init_vgmstream_wii_was, "was,dsp,isws", 0x00, 4, "iSWS"},
+    {init_vgmstream_pona_3do, "pona,sxd", 0x00, 4, "\x13\x02\x00\x00"},
+    {init_vgmstream_pona_psx, "pona", 0x00, 4, "\x00\x00\x08\x00"},
+    {init_vgmstream_xbox_hlwav, "hlwav", 0x00, 4, "\x14\x00\x00\x00"},
+    {init_vgmstream_stx, "stx", 0x0a, 2, "\x00\x04"},
+    {init_vgmstream_myspd, "myspd", 0, 0, NULL},
+    {init_vgmstream_his, "his", 0, 0, NULL},
+    {init_vgmstream_ps2_ast, "ast", 0x00, 4, "AST\x00"},
+    {init_vgmstream_dmsg, "dmsg", 0x00, 4, "RIFF"},
+    {init_vgmstream_ngc_dsp_aaap, "dsp", 0x00, 4, "AAAp"},
+    {init_vgmstream_ps2_ster, "ster", 0x00, 4, "STER"},
+    {init_vgmstream_ps2_wb, "wb", 0x00, 4, "\x00\x00\x00\x00"},
+    {init_vgmstream_bnsf, "bnsf", 0x00, 4, "BNSF"},
+    {init_vgmstream_ps2_gcm, "gcm", 0x00, 4, "MCG\x00"},
+    {init_vgmstream_ps2_smpl, "v0,v1,smpl", 0x00, 4, "SMPL"},
+    {init_vgmstream_ps2_msa, "msa", 0x00, 4, "\x00\x00\x00\x00"},
+    {init_vgmstream_ps2_voi, "voi", 0, 0, NULL},
+    {init_vgmstream_ngc_rkv, ",rkv,bo2", 0x00, 4, "\x00\x00\x00\x00"},
+    {init_vgmstream_dsp_ddsp, "ddsp", 0, 0, NULL},
+    {init_vgmstream_ps2_tk1, "ovb", 0x00, 4, "TK5S"},
+    {init_vgmstream_ngc_dsp_mpds, "dsp,mds", 0x00, 4, "MPDS"},
+    {init_vgmstream_dsp_str_ig, "str", 0, 0, NULL},
+    {init_vgmstream_ps2_b1s, "b1s", 0, 0, NULL},
+    {init_vgmstream_ps2_wad, "wad", 0, 0, NULL},
+    {init_vgmstream_dsp_xiii, "dsp", 0, 0, NULL},
+    {init_vgmstream_dsp_cabelas, "dsp", 0, 0, NULL},
+    {init_vgmstream_ps2_adm, "adm", 0, 0, NULL},
+    {init_vgmstream_ps2_lpcm, "lpcm", 0x00, 4, "LPCM"},
+    {init_vgmstream_dsp_bdsp, "bdsp", 0, 0, NULL},
+    {init_vgmstream_ps2_vms, "vms", 0x00, 4, "VMS "},
+    {init_vgmstream_xau, "xau", 0x00, 4, "XAU\x00"},
+    {init_vgmstream_ffw, "ffw", 0, 0, NULL},
+    {init_vgmstream_dsp_dspw, "dspw", 0x00, 4, "DSPW"},
+    {init_vgmstream_ps2_jstm, "stm,jstm", 0x00, 4, "JSTM"},
+    {init_vgmstream_ps3_cps, "cps", 0x00, 4, "CPS "},
+    {init_vgmstream_ngc_nst_dsp, "dsp", 0, 0, NULL},
+    {init_vgmstream_baf_badrip, "baf", 0x00, 4, "WAVE"},
+    {init_vgmstream_msf, "msf,at3,mp3", 0, 0, NULL},
+    {init_vgmstream_nub_vag, "vag", 0x00, 4, "vag\x00"},
+    {init_vgmstream_ps3_past, "past", 0x00, 4, "SNDP"},
+    {init_vgmstream_ngca, "ngca", 0x00, 4, "NGCA"},
+    {init_vgmstream_wii_ras, "ras", 0x00, 4, "RAS_"},
+    {init_vgmstream_ps2_spm, "spm", 0x00, 4, "SPM\x00"},
+    {init_vgmstream_x360_tra, "tra", 0, 0, NULL},
+    {init_vgmstream_ps2_iab, "iab", 0x00, 4, "\x10\x00\x00\x00"},
+    {init_vgmstream_vs_str, "vs,str", 0, 0, NULL},
+    {init_vgmstream_lsf_n1nj4n, "lsf", 0x00, 4, "!n1n"},
+    {init_vgmstream_vawx, "xwv,vawx", 0x00, 4, "VAWX"},
+    {init_vgmstream_ps2_wmus, "wmus", 0, 0, NULL},
+    {init_vgmstream_hyperscan_kvag, "bvg", 0x00, 4, "KVAG"},
+    {init_vgmstream_ios_psnd, "psnd", 0x00, 4, "PSND"},
+    {init_vgmstream_pc_adp_bos, "adp", 0x00, 4, "ADP!"},
+    {init_vgmstream_pc_adp_otns, "adp", 0, 0, NULL},
+    {init_vgmstream_eb_sfx, "sfx,sf0", 0, 0, NULL},
+    {init_vgmstream_eb_sf0, "sf0", 0, 0, NULL},
+    {init_vgmstream_mtaf, "mtaf", 0x00, 4, "MTAF"},
+    {init_vgmstream_tun, "tun", 0x00, 4, "ALP "},
+    {init_vgmstream_wpd, "wpd", 0x00, 4, " DPW"},
+    {init_vgmstream_mn_str, "mnstr", 0, 0, NULL},
+    {init_vgmstream_mss, "mss", 0x00, 4, "MCSS"},
+    {init_vgmstream_ps3_ivag, "ivag", 0x00, 4, "IVAG"},
+    {init_vgmstream_ps2_2pfs, "2pfs,sap", 0x00, 4, "2PFS"},
+    {init_vgmstream_xnb, "xnb", 0, 0, NULL},
+    {init_vgmstream_ubi_ckd, "ckd", 0x00, 4, "RIFF"},
+    {init_vgmstream_ps2_vbk, "vbk", 0x00, 4, ".VBK"},
+    {init_vgmstream_otm, "otm", 0x20, 4, "\x10\xb1\x02\x00"},
+    {init_vgmstream_bcstm, "bcstm", 0x00, 4, "CSTM"},
+    {init_vgmstream_idsp_nus3, "idsp", 0x00, 4, "IDSP"},
+    {init_vgmstream_ktss, "kns,ktss", 0x00, 4, "KTSS"},
+    {init_vgmstream_ps2_svag_snk, "svag", 0x00, 4, "VAGm"},
+    {init_vgmstream_ps2_vds_vdm, "vds,vdm", 0x00, 4, "VDS "},
+    {init_vgmstream_ps2_vds_vdm, "vds,vdm", 0x00, 4, "VDM "},
+    {init_vgmstream_x360_cxs, "cxs", 0x00, 4, "CXS "},
+    {init_vgmstream_dsp_adx, "adx", 0x00, 4, "\x02\x00\x00\x00"},
+    {init_vgmstream_akb, "akb,bytes", 0x00, 4, "AKB "},
+    {init_vgmstream_akb2, "akb,bytes", 0x00, 4, "AKB2"},
+    {init_vgmstream_bik, "bik,bika,bik2,bk2", 0, 0, NULL},
+    {init_vgmstream_x360_ast, "ast", 0x00, 4, "ASTB"},
+    {init_vgmstream_x360_pasx, "past", 0x00, 4, "PASX"},
+    {init_vgmstream_nub_xma, "xma", 0x00, 4, "xma\x00"},
+    {init_vgmstream_xma, "xma,xma2,nps,str", 0, 0, NULL},
+    {init_vgmstream_sxd, "sxd,sxd2,sxd3", 0, 0, NULL},
+    {init_vgmstream_ogl, "ogl", 0, 0, NULL},
+    {init_vgmstream_mc3, "mc3", 0x00, 4, "MPC3"},
+    {init_vgmstream_gtd, "gtd", 0x00, 4, "GHS "},
+    {init_vgmstream_rsd6xma, "rsd", 0x00, 4, "RSD6"},
+    {init_vgmstream_ta_aac_x360, "aac,laac,ace", 0x00, 4, "AAC "},
+    {init_vgmstream_ta_aac_ps3, "aac,laac,ace", 0x00, 4, "AAC "},
+    {init_vgmstream_ta_aac_mobile, "aac,laac", 0x00, 4, " CAA"},
+    {init_vgmstream_ta_aac_vita, "aac,laac", 0x00, 4, " CAA"},
+    {init_vgmstream_va3, "va3", 0x00, 4, "!3AV"},
+    {init_vgmstream_mta2, "mta2", 0x00, 4, "MTA2"},
+    {init_vgmstream_mta2_container, "dbm,bgm,mta2", 0, 0, NULL},
+    {init_vgmstream_ngc_ulw, "ulw", 0, 0, NULL},
+    {init_vgmstream_pc_xa30, "xa,xa30,e4x", 0x00, 4, "XA30"},
+    {init_vgmstream_pc_xa30, "xa,xa30,e4x", 0x00, 4, "e4x\x92"},
+    {init_vgmstream_wii_04sw, "xa,04sw", 0x00, 4, "04SW"},
+    {init_vgmstream_ea_bnk, "bnk,sdt,mus,abk,ast", 0, 0, NULL},
+    {init_vgmstream_ea_map_mus, "map,lin,mpf", 0x00, 4, "PFDx"},
+    {init_vgmstream_ea_schl_fixed, "asf,lasf", 0x00, 4, "SCHl"},
+    {init_vgmstream_sk_aud, "aud", 0x00, 4, "\x11SK\x10"},
+    {init_vgmstream_awc, "awc", 0, 0, NULL},
+    {init_vgmstream_opus_std, "opus,lopus", 0, 0, NULL},
+    {init_vgmstream_opus_n1, "opus,lopus", 0, 0, NULL},
+    {init_vgmstream_opus_capcom, "opus,lopus", 0, 0, NULL},
+    {init_vgmstream_opus_nop, "nop", 0x00, 4, "sadf"},
+    {init_vgmstream_opus_shinen, "opus,lopus", 0x08, 4, "\x01\x00\x00\x80"},
+    {init_vgmstream_opus_nus3, "opus,lopus", 0x00, 4, "OPUS"},
+    {init_vgmstream_opus_sps_n1, "sps,nlsd", 0x00, 4, "\x09\x00\x00\x00"},
+    {init_vgmstream_opus_nxa, "nxa", 0x00, 4, "NXA1"},
+    {init_vgmstream_pc_al2, "al2", 0, 0, NULL},
+    {init_vgmstream_pc_ast, "ast", 0x00, 4, "ASTL"},
+    {init_vgmstream_naac, "naac", 0x00, 4, "AAC "},
+    {init_vgmstream_ezw, "ezw", 0, 0, NULL},
+    {init_vgmstream_vxn, "vxn", 0x00, 4, "VoxN"},
+    {init_vgmstream_ea_snr_sns, "snr", 0, 0, NULL},
+    {init_vgmstream_ea_sps, "sps", 0, 0, NULL},
+    {init_vgmstream_ea_tmx, "tmx", 0x0c, 4, "1000"},
+    {init_vgmstream_ea_sbr, "sbr", 0x00, 4, "SBKR"},
+    {init_vgmstream_ngc_vid1, "ogg,logg", 0x00, 4, "VID1"},
+    {init_vgmstream_flx, "flx", 0, 0, NULL},
+    {init_vgmstream_kma9, "km9", 0x00, 4, "KMA9"},
+    {init_vgmstream_fsb_encrypted, "fsb,xen", 0, 0, NULL},
+    {init_vgmstream_xwc, "xwc", 0, 0, NULL},
+    {init_vgmstream_sps_n1, "sps", 0, 0, NULL},
+    {init_vgmstream_atx, "atx", 0x00, 4, "APA3"},
+    {init_vgmstream_waf, "waf", 0x00, 4, "WAF\x00"},
+    {init_vgmstream_rsd6at3p, "rsd", 0x00, 4, "RSD6"},
+    {init_vgmstream_rsd6wma, "rsd", 0x00, 4, "RSD6"},
+    {init_vgmstream_smv, "smv", 0, 0, NULL},
+    {init_vgmstream_nxap, "adp", 0x00, 4, "NXAP"},
+    {init_vgmstream_ea_wve_au00, "wve,fsv", 0x00, 4, "VLC0"},
+    {init_vgmstream_ea_wve_ad10, "wve", 0, 0, NULL},
+    {init_vgmstream_sthd, "stx", 0x00, 4, "STHD"},
+    {init_vgmstream_pcm_sre, "pcm", 0x00, 4, "\x00\x02\x00\x00"},
+    {init_vgmstream_dsp_mcadpcm, "mcadpcm", 0, 0, NULL},
+    {init_vgmstream_ubi_lyn, "sns,wav,lwav,son", 0x00, 4, "RIFF"},
+    {init_vgmstream_ubi_lyn_container, "sns,wav,lwav,son", 0, 0, NULL},
+    {init_vgmstream_msb_msh, "msb", 0, 0, NULL},
+    {init_vgmstream_smc_smh, "smc", 0, 0, NULL},
+    {init_vgmstream_ppst, "sng", 0x00, 4, "PPST"},
+    {init_vgmstream_ubi_bao_pk, "pk,lpk,cpk", 0, 0, NULL},
+    {init_vgmstream_ubi_bao_atomic, "bao,", 0x00, 1, "\x01"},
+    {init_vgmstream_ubi_bao_atomic, "bao,", 0x00, 1, "\x02"},
+    {init_vgmstream_dsp_switch_audio, "switch_audio,dsp", 0, 0, NULL},
+    {init_vgmstream_sadf, "sad", 0x00, 4, "sadf"},
+    {init_vgmstream_h4m, "h4m", 0x08, 4, "3\x00\x00\x00"},
+    {init_vgmstream_h4m, "h4m", 0x08, 4, "5\x00\x00\x00"},
+    {init_vgmstream_ps2_ads_container, "ads", 0, 0, NULL},
+    {init_vgmstream_asf, "asf,lasf", 0x00, 4, "ASF\x00"},
+    {init_vgmstream_xmd, "xmd", 0, 0, NULL},
+    {init_vgmstream_cks, "cks", 0x00, 4, "ckmk"},
+    {init_vgmstream_ckb, "ckb", 0x00, 4, "ckmk"},
+    {init_vgmstream_wv6, "wv6", 0x2c, 4, "WV6 "},
+    {init_vgmstream_str_wav, "str", 0, 0, NULL},
+    {init_vgmstream_hd3_bd3, "bd3", 0, 0, NULL},
+    {init_vgmstream_nus3bank, "nus3bank", 0x00, 4, "NUS3"},
+    {init_vgmstream_scd_sscf, "scd", 0x00, 4, "SSCF"},
+    {init_vgmstream_dsp_sps_n1, "vag,nlsd", 0x00, 4, "\x08\x00\x00\x00"},
+    {init_vgmstream_dsp_itl_ch, "itl", 0, 0, NULL},
+    {init_vgmstream_a2m, "int", 0x00, 4, "A2M\x00"},
+    {init_vgmstream_ahv, "ahv", 0x00, 4, "AHV\x00"},
+    {init_vgmstream_msv, "msv", 0x00, 4, "MSVp"},
+    {init_vgmstream_sdf, "sdf", 0x00, 4, "SDF\x00"},
+    {init_vgmstream_svg, "svg", 0x00, 4, "SVGp"},
+    {init_vgmstream_vis, "vis", 0x00, 4, "VISA"},
+    {init_vgmstream_vai, "vai", 0, 0, NULL},
+    {init_vgmstream_aif_asobo, "aif,laif,aiffl", 0x00, 2, "i\x00"},
+    {init_vgmstream_ao, "ao", 0x00, 4, "ALPH"},
+    {init_vgmstream_apc, "apc", 0x00, 4, "CRYO"},
+    {init_vgmstream_wv2, "wv2", 0x00, 4, "WAV2"},
+    {init_vgmstream_xau_konami, "xau", 0x00, 4, "SFXB"},
+    {init_vgmstream_derf, "adp", 0x00, 4, "DERF"},
+    {init_vgmstream_utk, "utk", 0x00, 4, "UTM0"},
+    {init_vgmstream_adpcm_capcom, "adpcm", 0x00, 4, "\x02\x00\x00\x00"},
+    {init_vgmstream_ue4opus, "opus,lopus,ue4opus", 0x00, 4, "UE4O"},
+    {init_vgmstream_ue4opus, "opus,lopus,ue4opus", 0x00, 4, "PUS\x00"},
+    {init_vgmstream_xwma, "xwma,xwm", 0x00, 4, "RIFF"},
+    {init_vgmstream_xopus, "xopus", 0x00, 4, "XOpu"},
+    {init_vgmstream_vs_square, "vs", 0x00, 4, "VS\x00\x00"},
+    {init_vgmstream_nwav, "nwav", 0x00, 4, "NWAV"},
+    {init_vgmstream_xpcm, "pcm", 0x00, 4, "XPCM"},
+    {init_vgmstream_msf_tamasoft, "msf", 0x00, 4, "MSF "},
+    {init_vgmstream_xps_dat, "xps", 0x0c, 4, "diff"},
+    {init_vgmstream_xps, "xps", 0x0c, 4, "diff"},
+    {init_vgmstream_opus_opusx, "opusx", 0x00, 4, "OPUS"},
+    {init_vgmstream_dsp_adpcmx, "adpcmx", 0x00, 4, "ADPY"},
+    {init_vgmstream_ogg_opus, "opus,lopus,ogg,logg", 0x00, 4, "OggS"},
+    {init_vgmstream_nus3audio, "nus3audio", 0x00, 4, "NUS3"},
+    {init_vgmstream_imc, "imc", 0, 0, NULL},
+    {init_vgmstream_imc_container, "imc", 0, 0, NULL},
+    {init_vgmstream_smp, "smp", 0, 0, NULL},
+    {init_vgmstream_gin, "gin", 0, 0, NULL},
+    {init_vgmstream_dsf, "dsf", 0x00, 4, "OCEA"},
+    {init_vgmstream_dsf, "dsf", 0x00, 4, "N DS"},
+    {init_vgmstream_dsf, "dsf", 0x00, 4, "A\x00\x00\x00"},
+    {init_vgmstream_208, "208", 0, 0, NULL},
+    {init_vgmstream_dsp_ds2, "ds2,dsp", 0, 0, NULL},
+    {init_vgmstream_ffdl, "ogg,logg,mp4,lmp4,bin,", 0, 0, NULL},
+    {init_vgmstream_strm_abylight, "strm", 0x00, 4, "STRM"},
+    {init_vgmstream_sfh, "at3", 0x00, 4, "\x00SFH"},
+    {init_vgmstream_msf_konami, "msf", 0x00, 4, "MSFC"},
+    {init_vgmstream_xwma_konami, "xwma", 0x00, 4, "XWMA"},
+    {init_vgmstream_ps2_int, "int,wp2", 0, 0, NULL},
+    {init_vgmstream_ps_headerless, "cvs,mib,mi4,snds,vb,xag", 0, 0, NULL},
+    {init_vgmstream_pc_snds, "snds", 0, 0, NULL},
+    {init_vgmstream_raw, "raw", 0, 0, NULL},
+};
+
+static const int meta_signatures_count = sizeof(meta_signatures) / sizeof(meta_signatures[0]);
+
+
+static int is_signature_match(const meta_signature * sig, const char * ext, const uint8_t * header, size_t header_size) {
+    if (sig->extensions && !check_extension_list(ext, sig->extensions))
+        return 0;
+
+    /* too small files can't be checked here (reads past EOF return -1 rather than failing) */
+    if (sig->magic_size > 0 && sig->magic_offset + sig->magic_size <= header_size) {
+        if (memcmp(header + sig->magic_offset, sig->magic, sig->magic_size) != 0)
+            return 0;
+    }
+
+    return 1;
+}
+
+void detection_get_candidates(STREAMFILE * streamFile, init_vgmstream_t * init_functions, int init_count, uint8_t * candidates) {
+    char filename[PATH_LIMIT];
+    uint8_t header[DETECTION_HEADER_SIZE];
+    size_t header_size;
+    const char * ext;
+    int i, pos = 0;
+
+    streamFile->get_name(streamFile, filename, sizeof(filename));
+    ext = filename_extension(filename);
+    header_size = read_streamfile(header, 0x00, sizeof(header), streamFile);
+
+    for (i = 0; i < init_count; i++) {
+        candidates[i] = 1;
+
+        /* not declared: must be called */
+        if (pos >= meta_signatures_count || meta_signatures[pos].init_vgmstream != init_functions[i])
+            continue;
+
+        candidates[i] = 0;
+        while (pos < meta_signatures_count && meta_signatures[pos].init_vgmstream == init_functions[i]) {
+            if (is_signature_match(&meta_signatures[pos], ext, header, header_size))
+                candidates[i] = 1;
+            pos++;
+        }
+    }
+}
@@ -0,0 +1,15 @@
+#ifndef _DETECTION_H_
+#define _DETECTION_H_
+
+#include "vgmstream.h"
+
+/* bytes read once from the start of the file to check for ids */
+#define DETECTION_HEADER_SIZE 0x40
+
+typedef VGMSTREAM * (*init_vgmstream_t)(STREAMFILE *streamFile);
+
+/* Marks which init functions (in detection order) may accept the file, from their declared extensions
+ * and header ids. Sets candidates[i] to 0 if init_functions[i] would surely fail, 1 otherwise. */
+void detection_get_candidates(STREAMFILE * streamFile, init_vgmstream_t * init_functions, int init_count, uint8_t * candidates);
+
+#endif /* _DETECTION_H_ */
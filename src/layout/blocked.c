@@ -21,6 +21,9 @@ void render_vgmstream_blocked(sample_t * buffer, int32_t sample_count, VGMSTREAM
         samples_this_block = vgmstream->current_block_size / frame_size * samples_per_frame;
     }
 
+    if (vgmstream->samples_into_block == 0)
+        block_index_add(vgmstream, vgmstream->current_sample);
+
 
     while (samples_written < sample_count) {
         int samples_to_do; 
@@ -83,11 +86,149 @@ void render_vgmstream_blocked(sample_t * buffer, int32_t sample_count, VGMSTREAM
             }
 
             vgmstream->samples_into_block = 0;
+            block_index_add(vgmstream, vgmstream->current_sample);
         }
 
     }
 }
 
+
+/* Block index: layout state at the start of each block found so far, so seeks can jump straight to
+ * the closest block rather than parsing every block header from the start. Blocks are the same
+ * every time the stream is played, so it's shared by resets (start_vgmstream) and filled by any
+ * block walk (rendering, seeking, or metas that check all blocks on open). Only positions are
+ * saved: decoder state from previous blocks isn't, so it's only useful for codecs without it. */
+typedef struct {
+    int32_t sample;             /* first sample of the block */
+    off_t current_block_offset;
+    size_t current_block_size;
+    size_t current_block_samples;
+    off_t next_block_offset;
+    size_t full_block_size;
+    int32_t ws_output_size;
+} block_point_t;
+
+typedef struct {
+    int count;
+    int max;
+    int channels;
+    block_point_t *points;
+    off_t *offsets;             /* [max][channels] */
+} block_index_data;
+
+/* Saves current block (just updated) as starting at block_sample. Blocks are expected in order,
+ * so those before the last saved block (like after loops) are ignored. */
+void block_index_add(VGMSTREAM * vgmstream, int32_t block_sample) {
+    block_index_data *data = vgmstream->block_index;
+    block_point_t *point;
+    int ch;
+
+    if (vgmstream->current_block_offset < 0 || vgmstream->current_block_offset == 0xFFFFFFFF ||
+            (int32_t)vgmstream->current_block_samples < 0)
+        return;
+
+    if (!data) {
+        data = calloc(1, sizeof(block_index_data));
+        if (!data) return;
+        data->channels = vgmstream->channels;
+
+        vgmstream->block_index = data;
+        ((VGMSTREAM*)vgmstream->start_vgmstream)->block_index = data; /* keep on resets */
+    }
+
+    /* channels may change after opening (dual stereo), ignore as offsets wouldn't apply */
+    if (data->channels != vgmstream->channels)
+        return;
+
+    /* empty blocks share sample with the next, keep the first one */
+    if (data->count > 0 && block_sample <= data->points[data->count - 1].sample)
+        return;
+
+    if (data->count == data->max) {
+        int max = data->max ? data->max * 2 : 256;
+        block_point_t *points_re;
+        off_t *offsets_re;
+
+        points_re = realloc(data->points, max * sizeof(block_point_t));
+        if (!points_re) return;
+        data->points = points_re;
+
+        offsets_re = realloc(data->offsets, max * data->channels * sizeof(off_t));
+        if (!offsets_re) return;
+        data->offsets = offsets_re;
+
+        data->max = max;
+    }
+
+    point = &data->points[data->count];
+    point->sample = block_sample;
+    point->current_block_offset = vgmstream->current_block_offset;
+    point->current_block_size = vgmstream->current_block_size;
+    point->current_block_samples = vgmstream->current_block_samples;
+    point->next_block_offset = vgmstream->next_block_offset;
+    point->full_block_size = vgmstream->full_block_size;
+    point->ws_output_size = vgmstream->ws_output_size;
+    for (ch = 0; ch < data->channels; ch++) {
+        data->offsets[data->count * data->channels + ch] = vgmstream->ch[ch].offset;
+    }
+
+    data->count++;
+}
+
+/* Moves to the closest known block that starts at or before seek_sample, if it's ahead of
+ * the current block. Returns 1 if moved. */
+int block_index_seek(VGMSTREAM * vgmstream, int32_t seek_sample) {
+    block_index_data *data = vgmstream->block_index;
+    block_point_t *point;
+    int min, max, ch;
+
+    if (!data || data->count == 0 || data->points[0].sample > seek_sample)
+        return 0;
+    if (data->channels != vgmstream->channels)
+        return 0;
+
+    /* binary search for the last block starting at or before seek_sample */
+    min = 0;
+    max = data->count - 1;
+    while (min < max) {
+        int mid = (min + max + 1) / 2;
+        if (data->points[mid].sample <= seek_sample)
+            min = mid;
+        else
+            max = mid - 1;
+    }
+
+    point = &data->points[min];
+    if (point->sample <= vgmstream->current_sample - vgmstream->samples_into_block)
+        return 0;
+
+    vgmstream->current_sample = point->sample;
+    vgmstream->samples_into_block = 0;
+    vgmstream->current_block_offset = point->current_block_offset;
+    vgmstream->current_block_size = point->current_block_size;
+    vgmstream->current_block_samples = point->current_block_samples;
+    vgmstream->next_block_offset = point->next_block_offset;
+    vgmstream->full_block_size = point->full_block_size;
+    vgmstream->ws_output_size = point->ws_output_size;
+    for (ch = 0; ch < data->channels; ch++) {
+        vgmstream->ch[ch].offset = data->offsets[min * data->channels + ch];
+    }
+
+    return 1;
+}
+
+void block_index_close(VGMSTREAM * vgmstream) {
+    block_index_data *data = vgmstream->block_index;
+
+    if (!data)
+        return;
+
+    free(data->points);
+    free(data->offsets);
+    free(data);
+    vgmstream->block_index = NULL;
+}
+
 /* helper functions to parse new block */
 void block_update(off_t block_offset, VGMSTREAM * vgmstream) {
     switch (vgmstream->layout_type) {
@@ -3,8 +3,9 @@
 
 
 /* Decodes samples for flat streams.
- * Data forms a single stream, and the decoder may internally skip chunks and move offsets as needed. */
-void render_vgmstream_flat(sample_t * buffer, int32_t sample_count, VGMSTREAM * vgmstream) {
+ * Data forms a single stream, and the decoder may internally skip chunks and move offsets as needed.
+ * Renders into buffer (PCM16) or buffer_f32 (float, for decoders with float output) depending on which is set. */
+static void render_flat_internal(sample_t * buffer, float * buffer_f32, int32_t sample_count, VGMSTREAM * vgmstream) {
     int samples_written = 0;
     int samples_per_frame, samples_this_block;
 
@@ -27,14 +28,28 @@ void render_vgmstream_flat(sample_t * buffer, int32_t sample_count, VGMSTREAM *
         if (samples_to_do == 0) {
             VGM_LOG("layout_flat: wrong samples_to_do 0 found\n"); /* could happen when calling render at EOF? */
             //VGM_LOG("layout_flat: tb=%i sib=%i, spf=%i\n", samples_this_block, vgmstream->samples_into_block, samples_per_frame);
-            memset(buffer + samples_written*vgmstream->channels, 0, (sample_count - samples_written) * vgmstream->channels * sizeof(sample_t));
+            if (buffer_f32)
+                memset(buffer_f32 + samples_written*vgmstream->channels, 0, (sample_count - samples_written) * vgmstream->channels * sizeof(float));
+            else
+                memset(buffer + samples_written*vgmstream->channels, 0, (sample_count - samples_written) * vgmstream->channels * sizeof(sample_t));
             break;
         }
 
-        decode_vgmstream(vgmstream, samples_written, samples_to_do, buffer);
+        if (buffer_f32)
+            decode_vgmstream_f32(vgmstream, samples_written, samples_to_do, buffer_f32);
+        else
+            decode_vgmstream(vgmstream, samples_written, samples_to_do, buffer);
 
         samples_written += samples_to_do;
         vgmstream->current_sample += samples_to_do;
         vgmstream->samples_into_block += samples_to_do;
     }
 }
+
+void render_vgmstream_flat(sample_t * buffer, int32_t sample_count, VGMSTREAM * vgmstream) {
+    render_flat_internal(buffer, NULL, sample_count, vgmstream);
+}
+
+void render_vgmstream_flat_f32(float * buffer, int32_t sample_count, VGMSTREAM * vgmstream) {
+    render_flat_internal(NULL, buffer, sample_count, vgmstream);
+}
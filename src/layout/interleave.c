@@ -2,25 +2,45 @@
 #include "../vgmstream.h"
 
 
+/* Precalculates frame/block samples, as frame sizes go through big per-codec switches. */
+void setup_layout_interleave(VGMSTREAM * vgmstream) {
+    int frame_size;
+    int has_interleave_last = vgmstream->interleave_last_block_size && vgmstream->channels > 1;
+
+    frame_size = get_vgmstream_frame_size(vgmstream);
+    vgmstream->interleave_frame_samples = get_vgmstream_samples_per_frame(vgmstream);
+    vgmstream->interleave_block_samples = frame_size == 0 ? 0 :
+            vgmstream->interleave_block_size / frame_size * vgmstream->interleave_frame_samples;
+
+    if (has_interleave_last) {
+        frame_size = get_vgmstream_shortframe_size(vgmstream);
+        vgmstream->interleave_last_frame_samples = get_vgmstream_samples_per_shortframe(vgmstream);
+        vgmstream->interleave_last_block_samples = frame_size == 0 ? 0 :
+                vgmstream->interleave_last_block_size / frame_size * vgmstream->interleave_last_frame_samples;
+    }
+    else {
+        vgmstream->interleave_last_frame_samples = vgmstream->interleave_frame_samples;
+        vgmstream->interleave_last_block_samples = vgmstream->interleave_block_samples;
+    }
+}
+
 /* Decodes samples for interleaved streams.
  * Data has interleaved chunks per channel, and once one is decoded the layout moves offsets,
  * skipping other chunks (essentially a simplified variety of blocked layout).
  * Incompatible with decoders that move offsets. */
 void render_vgmstream_interleave(sample_t * buffer, int32_t sample_count, VGMSTREAM * vgmstream) {
     int samples_written = 0;
-    int frame_size, samples_per_frame, samples_this_block;
+    int samples_per_frame, samples_this_block;
     int has_interleave_last = vgmstream->interleave_last_block_size && vgmstream->channels > 1;
 
-    frame_size = get_vgmstream_frame_size(vgmstream);
-    samples_per_frame = get_vgmstream_samples_per_frame(vgmstream);
-    samples_this_block = vgmstream->interleave_block_size / frame_size * samples_per_frame;
+    samples_per_frame = vgmstream->interleave_frame_samples;
+    samples_this_block = vgmstream->interleave_block_samples;
 
     if (has_interleave_last &&
             vgmstream->current_sample - vgmstream->samples_into_block + samples_this_block > vgmstream->num_samples) {
         /* adjust values again if inside last interleave */
-        frame_size = get_vgmstream_shortframe_size(vgmstream);
-        samples_per_frame = get_vgmstream_samples_per_shortframe(vgmstream);
-        samples_this_block = vgmstream->interleave_last_block_size / frame_size * samples_per_frame;
+        samples_per_frame = vgmstream->interleave_last_frame_samples;
+        samples_this_block = vgmstream->interleave_last_block_samples;
     }
 
     /* mono interleaved stream with no layout set, just behave like flat layout */
@@ -34,9 +54,8 @@ void render_vgmstream_interleave(sample_t * buffer, int32_t sample_count, VGMSTR
         if (vgmstream->loop_flag && vgmstream_do_loop(vgmstream)) {
             /* handle looping, restore standard interleave sizes */
             if (has_interleave_last) { /* assumes that won't loop back into a interleave_last */
-                frame_size = get_vgmstream_frame_size(vgmstream);
-                samples_per_frame = get_vgmstream_samples_per_frame(vgmstream);
-                samples_this_block = vgmstream->interleave_block_size / frame_size * samples_per_frame;
+                samples_per_frame = vgmstream->interleave_frame_samples;
+                samples_this_block = vgmstream->interleave_block_samples;
                 if (samples_this_block == 0 && vgmstream->channels == 1)
                     samples_this_block = vgmstream->num_samples;
             }
@@ -67,9 +86,8 @@ void render_vgmstream_interleave(sample_t * buffer, int32_t sample_count, VGMSTR
             if (has_interleave_last &&
                     vgmstream->current_sample + samples_this_block > vgmstream->num_samples) {
                 /* adjust values again if inside last interleave */
-                frame_size = get_vgmstream_shortframe_size(vgmstream);
-                samples_per_frame = get_vgmstream_samples_per_shortframe(vgmstream);
-                samples_this_block = vgmstream->interleave_last_block_size / frame_size * samples_per_frame;
+                samples_per_frame = vgmstream->interleave_last_frame_samples;
+                samples_this_block = vgmstream->interleave_last_block_samples;
                 if (samples_this_block == 0 && vgmstream->channels == 1)
                     samples_this_block = vgmstream->num_samples;
 
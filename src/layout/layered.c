@@ -1,53 +1,229 @@
 #include "layout.h"
 #include "../vgmstream.h"
 #include "../mixing.h"
+#include "../worker.h"
 
 
 /* NOTE: if loop settings change the layered vgmstreams must be notified (preferably using vgmstream_force_loop) */
 #define VGMSTREAM_MAX_LAYERS 255
 #define VGMSTREAM_LAYER_SAMPLE_BUFFER 8192
 
+/* Optional parallel rendering: layers are independent so each render window is split between
+ * workers (plus the calling thread), each rendering a share of layers into its own buffer.
+ * Once all are done layers are interleaved into outbuf as usual. */
+typedef struct {
+    struct layered_threads_t *threads;
+    int first_layer;            /* renders first_layer, first_layer + threads->count, etc */
+} layered_job_t;
+
+struct layered_threads_t {
+    layered_layout_data *data;
+    int count;                  /* total renderers (workers + caller) */
+    worker_t **workers;         /* count - 1 */
+    layered_job_t *jobs;        /* count, first one for the caller */
+    float *buffers;             /* one per layer (also used for PCM16) */
+    size_t buffer_samples;      /* per layer */
+
+    /* current window */
+    int32_t samples_to_do;
+    int is_f32;
+};
+
+
+/* Copies a layer's samples to its channel slice in outbuf. Goes frame by frame so both buffers
+ * are read/written in order (rather than striding the whole block per channel). */
+static void interleave_layer(sample_t * outbuf, int output_channels, int ch_offset, sample_t * layerbuf, int layer_channels, int32_t sample_count) {
+    int32_t s;
+    int ch;
+
+    outbuf += ch_offset;
+
+    switch(layer_channels) {
+        case 1:
+            for (s = 0; s < sample_count; s++) {
+                outbuf[0] = layerbuf[0];
+                outbuf += output_channels;
+                layerbuf += 1;
+            }
+            break;
+
+        case 2:
+            for (s = 0; s < sample_count; s++) {
+                outbuf[0] = layerbuf[0];
+                outbuf[1] = layerbuf[1];
+                outbuf += output_channels;
+                layerbuf += 2;
+            }
+            break;
+
+        default:
+            for (s = 0; s < sample_count; s++) {
+                for (ch = 0; ch < layer_channels; ch++) {
+                    outbuf[ch] = layerbuf[ch];
+                }
+                outbuf += output_channels;
+                layerbuf += layer_channels;
+            }
+            break;
+    }
+}
+
+/* same for float samples */
+static void interleave_layer_f32(float * outbuf, int output_channels, int ch_offset, float * layerbuf, int layer_channels, int32_t sample_count) {
+    int32_t s;
+    int ch;
+
+    outbuf += ch_offset;
+
+    switch(layer_channels) {
+        case 1:
+            for (s = 0; s < sample_count; s++) {
+                outbuf[0] = layerbuf[0];
+                outbuf += output_channels;
+                layerbuf += 1;
+            }
+            break;
+
+        case 2:
+            for (s = 0; s < sample_count; s++) {
+                outbuf[0] = layerbuf[0];
+                outbuf[1] = layerbuf[1];
+                outbuf += output_channels;
+                layerbuf += 2;
+            }
+            break;
+
+        default:
+            for (s = 0; s < sample_count; s++) {
+                for (ch = 0; ch < layer_channels; ch++) {
+                    outbuf[ch] = layerbuf[ch];
+                }
+                outbuf += output_channels;
+                layerbuf += layer_channels;
+            }
+            break;
+    }
+}
+
+static sample_t* get_layer_buffer(struct layered_threads_t *threads, int layer) {
+    return (sample_t*)(threads->buffers + layer * threads->buffer_samples);
+}
+
+static void render_layers_job(void *arg) {
+    layered_job_t *job = arg;
+    struct layered_threads_t *threads = job->threads;
+    layered_layout_data *data = threads->data;
+    int layer;
+
+    for (layer = job->first_layer; layer < data->layer_count; layer += threads->count) {
+        if (threads->is_f32) {
+            render_vgmstream_f32(threads->buffers + layer * threads->buffer_samples, threads->samples_to_do, data->layers[layer]);
+        }
+        else {
+            render_vgmstream(get_layer_buffer(threads, layer), threads->samples_to_do, data->layers[layer]);
+        }
+    }
+}
+
+/* renders all layers in parallel then moves them to their place in outbuf */
+static void render_layers_threaded(layered_layout_data *data, sample_t * outbuf, float * outbuf_f32, int32_t samples_to_do) {
+    struct layered_threads_t *threads = data->threads;
+    int i, layer, ch = 0;
+
+    threads->samples_to_do = samples_to_do;
+    threads->is_f32 = (outbuf_f32 != NULL);
+
+    for (i = 0; i < threads->count - 1; i++) {
+        worker_start(threads->workers[i]);
+    }
+    render_layers_job(&threads->jobs[threads->count - 1]);
+    for (i = 0; i < threads->count - 1; i++) {
+        worker_wait(threads->workers[i]);
+    }
+
+    for (layer = 0; layer < data->layer_count; layer++) {
+        int layer_channels;
+
+        mixing_info(data->layers[layer], NULL, &layer_channels);
+
+        if (outbuf_f32) {
+            interleave_layer_f32(outbuf_f32, data->output_channels, ch,
+                    threads->buffers + layer * threads->buffer_samples, layer_channels, samples_to_do);
+        }
+        else {
+            interleave_layer(outbuf, data->output_channels, ch,
+                    get_layer_buffer(threads, layer), layer_channels, samples_to_do);
+        }
+        ch += layer_channels;
+    }
+}
+
+/* renders each layer in turn then moves it to its place in outbuf */
+static void render_layers(layered_layout_data *data, sample_t * outbuf, float * outbuf_f32, int32_t samples_to_do) {
+    int layer, ch = 0;
+
+    for (layer = 0; layer < data->layer_count; layer++) {
+        int layer_input_channels, layer_channels;
+
+        /* layers may have its own number of channels */
+        mixing_info(data->layers[layer], &layer_input_channels, &layer_channels);
+
+        /* a layer with all channels (before and after its mixing) can go straight to outbuf */
+        if (layer_input_channels == data->output_channels && layer_channels == data->output_channels) {
+            if (outbuf_f32) {
+                render_vgmstream_f32(outbuf_f32, samples_to_do, data->layers[layer]);
+            }
+            else {
+                render_vgmstream(outbuf, samples_to_do, data->layers[layer]);
+            }
+            ch += layer_channels;
+            continue;
+        }
+
+        if (outbuf_f32) {
+            render_vgmstream_f32(data->buffer_f32, samples_to_do, data->layers[layer]);
+
+            interleave_layer_f32(outbuf_f32, data->output_channels, ch, data->buffer_f32, layer_channels, samples_to_do);
+            ch += layer_channels;
+            continue;
+        }
+
+        render_vgmstream(data->buffer, samples_to_do, data->layers[layer]);
+
+        /* mix layer samples to main samples */
+        interleave_layer(outbuf, data->output_channels, ch, data->buffer, layer_channels, samples_to_do);
+        ch += layer_channels;
+    }
+}
 
 /* Decodes samples for layered streams.
  * Similar to interleave layout, but decodec samples are mixed from complete vgmstreams, each
  * with custom codecs and different number of channels, creating a single super-vgmstream.
- * Usually combined with custom streamfiles to handle data interleaved in weird ways. */
-void render_vgmstream_layered(sample_t * outbuf, int32_t sample_count, VGMSTREAM * vgmstream) {
+ * Usually combined with custom streamfiles to handle data interleaved in weird ways.
+ * Renders into outbuf (PCM16) or outbuf_f32 (float) depending on which is set. */
+static void render_layered_internal(sample_t * outbuf, float * outbuf_f32, int32_t sample_count, VGMSTREAM * vgmstream) {
     int samples_written = 0;
     layered_layout_data *data = vgmstream->layout_data;
 
 
     while (samples_written < sample_count) {
         int samples_to_do = VGMSTREAM_LAYER_SAMPLE_BUFFER;
-        int layer, ch = 0;
+        sample_t *layers_outbuf = NULL;
+        float *layers_outbuf_f32 = NULL;
 
         if (samples_to_do > sample_count - samples_written)
             samples_to_do = sample_count - samples_written;
 
-        for (layer = 0; layer < data->layer_count; layer++) {
-            int s, layer_ch, layer_channels;
+        if (outbuf_f32)
+            layers_outbuf_f32 = outbuf_f32 + samples_written*data->output_channels;
+        else
+            layers_outbuf = outbuf + samples_written*data->output_channels;
 
-            /* each layer will handle its own looping/mixing internally */
-
-            /* layers may have its own number of channels */
-            mixing_info(data->layers[layer], NULL, &layer_channels);
-
-            render_vgmstream(
-                    data->buffer,
-                    samples_to_do,
-                    data->layers[layer]);
-
-            /* mix layer samples to main samples */
-            for (layer_ch = 0; layer_ch < layer_channels; layer_ch++) {
-                for (s = 0; s < samples_to_do; s++) {
-                    size_t layer_sample = s*layer_channels + layer_ch;
-                    size_t buffer_sample = (samples_written+s)*data->output_channels + ch;
-
-                    outbuf[buffer_sample] = data->buffer[layer_sample];
-                }
-                ch++;
-            }
-        }
+        /* each layer will handle its own looping/mixing internally */
+        if (data->threads)
+            render_layers_threaded(data, layers_outbuf, layers_outbuf_f32, samples_to_do);
+        else
+            render_layers(data, layers_outbuf, layers_outbuf_f32, samples_to_do);
 
         samples_written += samples_to_do;
         /* needed for info (ex. for mixing) */
@@ -57,6 +233,14 @@ void render_vgmstream_layered(sample_t * outbuf, int32_t sample_count, VGMSTREAM
     }
 }
 
+void render_vgmstream_layered(sample_t * outbuf, int32_t sample_count, VGMSTREAM * vgmstream) {
+    render_layered_internal(outbuf, NULL, sample_count, vgmstream);
+}
+
+void render_vgmstream_layered_f32(float * outbuf, int32_t sample_count, VGMSTREAM * vgmstream) {
+    render_layered_internal(NULL, outbuf, sample_count, vgmstream);
+}
+
 
 layered_layout_data* init_layout_layered(int layer_count) {
     layered_layout_data *data = NULL;
@@ -81,6 +265,7 @@ fail:
 int setup_layout_layered(layered_layout_data* data) {
     int i, max_input_channels = 0, max_output_channels = 0;
     sample_t *outbuf_re = NULL;
+    float *outbuf_f32_re = NULL;
 
 
     /* setup each VGMSTREAM (roughly equivalent to vgmstream.c's init_vgmstream_internal stuff) */
@@ -132,6 +317,10 @@ int setup_layout_layered(layered_layout_data* data) {
     if (!outbuf_re) goto fail;
     data->buffer = outbuf_re;
 
+    outbuf_f32_re = realloc(data->buffer_f32, VGMSTREAM_LAYER_SAMPLE_BUFFER*max_input_channels*sizeof(float));
+    if (!outbuf_f32_re) goto fail;
+    data->buffer_f32 = outbuf_f32_re;
+
     data->input_channels = max_input_channels;
     data->output_channels = max_output_channels;
 
@@ -140,18 +329,87 @@ fail:
     return 0; /* caller is expected to free */
 }
 
+static void free_layered_threads(struct layered_threads_t *threads) {
+    int i;
+
+    if (!threads)
+        return;
+
+    if (threads->workers) {
+        for (i = 0; i < threads->count - 1; i++) {
+            worker_close(threads->workers[i]);
+        }
+        free(threads->workers);
+    }
+    free(threads->jobs);
+    free(threads->buffers);
+    free(threads);
+}
+
+int setup_layout_layered_threads(layered_layout_data *data, int max_threads) {
+    struct layered_threads_t *threads = NULL;
+    int i;
+
+    if (!data)
+        return 0;
+
+    free_layered_threads(data->threads);
+    data->threads = NULL;
+
+    if (max_threads > data->layer_count)
+        max_threads = data->layer_count;
+    if (max_threads <= 1)
+        return 0;
+
+    threads = calloc(1, sizeof(struct layered_threads_t));
+    if (!threads) goto fail;
+
+    threads->data = data;
+    threads->count = max_threads;
+
+    /* layers can't share a buffer anymore (float size is also enough for PCM16) */
+    threads->buffer_samples = VGMSTREAM_LAYER_SAMPLE_BUFFER * data->input_channels;
+    threads->buffers = malloc(data->layer_count * threads->buffer_samples * sizeof(float));
+    if (!threads->buffers) goto fail;
+
+    threads->jobs = calloc(threads->count, sizeof(layered_job_t));
+    if (!threads->jobs) goto fail;
+    for (i = 0; i < threads->count; i++) {
+        threads->jobs[i].threads = threads;
+        threads->jobs[i].first_layer = i;
+    }
+
+    /* last job is done by the caller */
+    threads->workers = calloc(threads->count - 1, sizeof(worker_t*));
+    if (!threads->workers) goto fail;
+    for (i = 0; i < threads->count - 1; i++) {
+        threads->workers[i] = worker_init(render_layers_job, &threads->jobs[i]);
+        if (!threads->workers[i]) goto fail; /* no thread support */
+    }
+
+    data->threads = threads;
+    return 1;
+fail:
+    free_layered_threads(threads);
+    return 0;
+}
+
 void free_layout_layered(layered_layout_data *data) {
     int i;
 
     if (!data)
         return;
 
+    free_layered_threads(data->threads);
+
     if (data->layers) {
         for (i = 0; i < data->layer_count; i++) {
             close_vgmstream(data->layers[i]);
         }
         free(data->layers);
     }
+    free(data->buffer);
+    free(data->buffer_f32);
     free(data);
 }
 
@@ -8,6 +8,11 @@
 void render_vgmstream_blocked(sample_t * buffer, int32_t sample_count, VGMSTREAM * vgmstream);
 void block_update(off_t block_offset, VGMSTREAM * vgmstream);
 
+/* block index, filled while blocks are walked (see blocked.c) */
+void block_index_add(VGMSTREAM * vgmstream, int32_t block_sample);
+int block_index_seek(VGMSTREAM * vgmstream, int32_t seek_sample);
+void block_index_close(VGMSTREAM * vgmstream);
+
 void block_update_ast(off_t block_ofset, VGMSTREAM * vgmstream);
 void block_update_mxch(off_t block_ofset, VGMSTREAM * vgmstream);
 void block_update_halpst(off_t block_ofset, VGMSTREAM * vgmstream);
@@ -48,22 +53,29 @@ void block_update_xa_aiff(off_t block_offset, VGMSTREAM * vgmstream);
 void block_update_vs_square(off_t block_offset, VGMSTREAM * vgmstream);
 
 /* other layouts */
+void setup_layout_interleave(VGMSTREAM * vgmstream);
 void render_vgmstream_interleave(sample_t * buffer, int32_t sample_count, VGMSTREAM * vgmstream);
 
 void render_vgmstream_flat(sample_t * buffer, int32_t sample_count, VGMSTREAM * vgmstream);
+void render_vgmstream_flat_f32(float * buffer, int32_t sample_count, VGMSTREAM * vgmstream);
 
 void render_vgmstream_segmented(sample_t * buffer, int32_t sample_count, VGMSTREAM * vgmstream);
+void render_vgmstream_segmented_f32(float * buffer, int32_t sample_count, VGMSTREAM * vgmstream);
 segmented_layout_data* init_layout_segmented(int segment_count);
 int setup_layout_segmented(segmented_layout_data* data);
 void free_layout_segmented(segmented_layout_data *data);
 void reset_layout_segmented(segmented_layout_data *data);
+void seek_layout_segmented(VGMSTREAM *vgmstream, int32_t seek_sample);
+int setup_layout_segmented_prefetch(segmented_layout_data *data, int32_t samples);
 VGMSTREAM *allocate_segmented_vgmstream(segmented_layout_data* data, int loop_flag, int loop_start_segment, int loop_end_segment);
 
 void render_vgmstream_layered(sample_t * buffer, int32_t sample_count, VGMSTREAM * vgmstream);
+void render_vgmstream_layered_f32(float * buffer, int32_t sample_count, VGMSTREAM * vgmstream);
 layered_layout_data* init_layout_layered(int layer_count);
 int setup_layout_layered(layered_layout_data* data);
 void free_layout_layered(layered_layout_data *data);
 void reset_layout_layered(layered_layout_data *data);
+int setup_layout_layered_threads(layered_layout_data *data, int threads);
 VGMSTREAM *allocate_layered_vgmstream(layered_layout_data* data);
 
 #endif
@@ -1,18 +1,151 @@
 #include "layout.h"
 #include "../vgmstream.h"
 #include "../mixing.h"
+#include "../worker.h"
 
 #define VGMSTREAM_MAX_SEGMENTS 255
 #define VGMSTREAM_SEGMENT_SAMPLE_BUFFER 8192
 
+/* Optional prefetch: while a segment plays, a worker resets/positions the one that follows and
+ * renders its first samples, so changing segments doesn't stall on codec resets or header reads.
+ * Render then takes those samples and continues with the segment as usual. Segments must not be
+ * touched while the worker runs, so anything else that moves them stops the prefetch first. */
+typedef enum { PREFETCH_NONE, PREFETCH_STARTED, PREFETCH_READY } prefetch_state_t;
+
+struct segmented_prefetch_t {
+    segmented_layout_data *data;
+    worker_t *worker;
+    prefetch_state_t state;
+    float *buffer;              /* prefetched samples (also used for PCM16) */
+    int32_t max_samples;
+
+    /* current job */
+    int segment;
+    int32_t offset;             /* sample inside segment that prefetch starts from */
+    int is_f32;
+    int32_t filled;
+    int32_t consumed;
+};
+
+/* Returns the segment that contains sample (or the last one if past the end), and its first sample. */
+static int find_segment(segmented_layout_data *data, int32_t sample, int32_t *segment_start) {
+    int min = 0, max = data->segment_count - 1;
+
+    /* binary search for the last segment starting at or before sample */
+    while (min < max) {
+        int mid = (min + max + 1) / 2;
+        if (data->segment_starts[mid] <= sample)
+            min = mid;
+        else
+            max = mid - 1;
+    }
+
+    if (segment_start)
+        *segment_start = data->segment_starts[min];
+    return min;
+}
+
+static void prefetch_job(void *arg) {
+    struct segmented_prefetch_t *prefetch = arg;
+    VGMSTREAM *segment = prefetch->data->segments[prefetch->segment];
+    int32_t samples = segment->num_samples - prefetch->offset;
+
+    if (prefetch->offset == 0)
+        reset_vgmstream(segment);
+    else
+        vgmstream_seek(segment, prefetch->offset);
+
+    if (samples > prefetch->max_samples)
+        samples = prefetch->max_samples;
+    if (samples < 0)
+        samples = 0;
+
+    if (prefetch->is_f32)
+        render_vgmstream_f32(prefetch->buffer, samples, segment);
+    else
+        render_vgmstream((sample_t*)prefetch->buffer, samples, segment);
+    prefetch->filled = samples;
+}
+
+/* Starts prefetching where render goes after the current segment: next segment, or loop start
+ * if loop end is reached first. Skipped if that's the current segment (can't be used by both). */
+static void prefetch_start(VGMSTREAM *vgmstream, segmented_layout_data *data, int is_f32) {
+    struct segmented_prefetch_t *prefetch = data->prefetch;
+    int next_segment;
+    int32_t next_offset = 0;
+    int will_loop;
+
+    if (!prefetch || prefetch->state != PREFETCH_NONE)
+        return;
+
+    will_loop = vgmstream->loop_flag &&
+            vgmstream->current_sample <= vgmstream->loop_end_sample &&
+            vgmstream->loop_end_sample <= data->segment_starts[data->current_segment + 1] &&
+            !(vgmstream->loop_target && vgmstream->loop_target == vgmstream->loop_count + 1);
+    if (will_loop) {
+        int32_t segment_start;
+        next_segment = find_segment(data, vgmstream->loop_start_sample, &segment_start);
+        next_offset = vgmstream->loop_start_sample - segment_start;
+    }
+    else {
+        next_segment = data->current_segment + 1;
+    }
+
+    if (next_segment == data->current_segment || next_segment >= data->segment_count)
+        return;
+
+    prefetch->segment = next_segment;
+    prefetch->offset = next_offset;
+    prefetch->is_f32 = is_f32;
+    prefetch->filled = 0;
+    prefetch->consumed = 0;
+    prefetch->state = PREFETCH_STARTED;
+    worker_start(prefetch->worker);
+}
+
+/* Waits for any prefetch and drops it, so segments can be moved freely. */
+static void prefetch_stop(segmented_layout_data *data) {
+    struct segmented_prefetch_t *prefetch = data->prefetch;
+
+    if (!prefetch)
+        return;
+
+    if (prefetch->state == PREFETCH_STARTED)
+        worker_wait(prefetch->worker);
+    prefetch->state = PREFETCH_NONE;
+}
+
+/* Switches to the prefetched samples if they are for this segment and position. Returns 0 if
+ * there is nothing usable, in which case the caller must position the segment. */
+static int prefetch_use(segmented_layout_data *data, int segment, int32_t offset, int is_f32) {
+    struct segmented_prefetch_t *prefetch = data->prefetch;
+
+    if (!prefetch || prefetch->state == PREFETCH_NONE)
+        return 0;
+
+    if (prefetch->state == PREFETCH_STARTED)
+        worker_wait(prefetch->worker);
+
+    if (prefetch->state != PREFETCH_STARTED || prefetch->segment != segment ||
+            prefetch->offset != offset || prefetch->is_f32 != is_f32) {
+        prefetch->state = PREFETCH_NONE;
+        return 0;
+    }
+
+    prefetch->state = PREFETCH_READY;
+    return 1;
+}
+
 
 /* Decodes samples for segmented streams.
  * Chains together sequential vgmstreams, for data divided into separate sections or files
- * (like one part for intro and other for loop segments, which may even use different codecs). */
-void render_vgmstream_segmented(sample_t * outbuf, int32_t sample_count, VGMSTREAM * vgmstream) {
-    int samples_written = 0, loop_samples_skip = 0;
+ * (like one part for intro and other for loop segments, which may even use different codecs).
+ * Renders into outbuf (PCM16) or outbuf_f32 (float) depending on which is set. */
+static void render_segmented_internal(sample_t * outbuf, float * outbuf_f32, int32_t sample_count, VGMSTREAM * vgmstream) {
+    int samples_written = 0;
     segmented_layout_data *data = vgmstream->layout_data;
     int use_internal_buffer = 0;
+    int is_f32 = (outbuf_f32 != NULL);
 
 
     /* normally uses outbuf directly (faster) but could need internal buffer if downmixing */
@@ -26,35 +159,17 @@ void render_vgmstream_segmented(sample_t * outbuf, int32_t sample_count, VGMSTRE
         int samples_this_segment = data->segments[data->current_segment]->num_samples;
 
         if (vgmstream->loop_flag && vgmstream_do_loop(vgmstream)) {
-            int segment, loop_segment, total_samples;
-
-            /* handle looping by finding loop segment and loop_start inside that segment */
-            loop_segment = 0;
-            total_samples = 0;
-            while (total_samples < vgmstream->num_samples) {
-                int32_t segment_samples = data->segments[loop_segment]->num_samples;
-
-                if (vgmstream->loop_sample >= total_samples && vgmstream->loop_sample < total_samples + segment_samples) {
-                    loop_samples_skip = vgmstream->loop_sample - total_samples;
-                    break; /* loop_start falls within loop_segment's samples */
-                }
-                total_samples += segment_samples;
-                loop_segment++;
-            }
-
-            if (loop_segment == data->segment_count) {
-                VGM_LOG("segmented_layout: can't find loop segment\n");
-                loop_segment = 0;
-            }
-
-            data->current_segment = loop_segment;
-
-            /* loops can span multiple segments */
-            for (segment = loop_segment; segment < data->segment_count; segment++) {
-                reset_vgmstream(data->segments[segment]);
+            int32_t segment_start, loop_offset;
+
+            /* handle looping by moving to loop segment and loop_start inside that segment (later
+             * segments are reset when reached, so only this one needs to be repositioned) */
+            data->current_segment = find_segment(data, vgmstream->loop_sample, &segment_start);
+            loop_offset = vgmstream->loop_sample - segment_start;
+            if (!prefetch_use(data, data->current_segment, loop_offset, is_f32)) {
+                vgmstream_seek(data->segments[data->current_segment], loop_offset);
             }
 
-            vgmstream->samples_into_block = 0;
+            vgmstream->samples_into_block = loop_offset;
             continue;
         }
 
@@ -64,37 +179,83 @@ void render_vgmstream_segmented(sample_t * outbuf, int32_t sample_count, VGMSTRE
         if (samples_to_do > VGMSTREAM_SEGMENT_SAMPLE_BUFFER /*&& use_internal_buffer*/) /* always for fade/etc mixes */
             samples_to_do = VGMSTREAM_SEGMENT_SAMPLE_BUFFER;
 
-        /* segment looping: discard until actual start */
-        if (loop_samples_skip > 0) {
-            if (samples_to_do > loop_samples_skip)
-                samples_to_do = loop_samples_skip;
-        }
-
         /* detect segment change and restart */
         if (samples_to_do == 0) {
             data->current_segment++;
-            reset_vgmstream(data->segments[data->current_segment]);
+            if (!prefetch_use(data, data->current_segment, 0, is_f32)) {
+                reset_vgmstream(data->segments[data->current_segment]);
+            }
             vgmstream->samples_into_block = 0;
             continue;
         }
 
-        render_vgmstream(
-                use_internal_buffer ?
-                        data->buffer :
-                        &outbuf[samples_written * data->output_channels],
-                samples_to_do,
-                data->segments[data->current_segment]);
+        /* take prefetched samples first, then continue from where the prefetch left the segment */
+        if (data->prefetch && data->prefetch->state == PREFETCH_READY) {
+            struct segmented_prefetch_t *prefetch = data->prefetch;
+            int32_t samples_left = prefetch->filled - prefetch->consumed;
 
-        if (loop_samples_skip > 0) {
-            loop_samples_skip -= samples_to_do;
-            vgmstream->samples_into_block += samples_to_do;
-            continue;
+            if (samples_left > 0 && prefetch->is_f32 != is_f32) {
+                /* output format changed: drop and put the segment back where it should be */
+                prefetch->state = PREFETCH_NONE;
+                vgmstream_seek(data->segments[data->current_segment], vgmstream->samples_into_block);
+                continue;
+            }
+
+            if (samples_left > 0) {
+                if (samples_to_do > samples_left)
+                    samples_to_do = samples_left;
+
+                if (outbuf_f32) {
+                    memcpy(&outbuf_f32[samples_written * data->output_channels],
+                            prefetch->buffer + prefetch->consumed * data->output_channels,
+                            samples_to_do * data->output_channels * sizeof(float));
+                }
+                else {
+                    memcpy(&outbuf[samples_written * data->output_channels],
+                            (sample_t*)prefetch->buffer + prefetch->consumed * data->output_channels,
+                            samples_to_do * data->output_channels * sizeof(sample_t));
+                }
+                prefetch->consumed += samples_to_do;
+
+                samples_written += samples_to_do;
+                vgmstream->current_sample += samples_to_do;
+                vgmstream->samples_into_block += samples_to_do;
+                continue;
+            }
+
+            prefetch->state = PREFETCH_NONE;
+        }
+
+        prefetch_start(vgmstream, data, is_f32);
+
+        if (outbuf_f32) {
+            render_vgmstream_f32(
+                    use_internal_buffer ?
+                            data->buffer_f32 :
+                            &outbuf_f32[samples_written * data->output_channels],
+                    samples_to_do,
+                    data->segments[data->current_segment]);
+        }
+        else {
+            render_vgmstream(
+                    use_internal_buffer ?
+                            data->buffer :
+                            &outbuf[samples_written * data->output_channels],
+                    samples_to_do,
+                    data->segments[data->current_segment]);
         }
 
         if (use_internal_buffer) {
             int s;
-            for (s = 0; s < samples_to_do * data->output_channels; s++) {
-                outbuf[samples_written * data->output_channels + s] = data->buffer[s];
+            if (outbuf_f32) {
+                for (s = 0; s < samples_to_do * data->output_channels; s++) {
+                    outbuf_f32[samples_written * data->output_channels + s] = data->buffer_f32[s];
+                }
+            }
+            else {
+                for (s = 0; s < samples_to_do * data->output_channels; s++) {
+                    outbuf[samples_written * data->output_channels + s] = data->buffer[s];
+                }
             }
         }
 
@@ -104,6 +265,14 @@ void render_vgmstream_segmented(sample_t * outbuf, int32_t sample_count, VGMSTRE
     }
 }
 
+void render_vgmstream_segmented(sample_t * outbuf, int32_t sample_count, VGMSTREAM * vgmstream) {
+    render_segmented_internal(outbuf, NULL, sample_count, vgmstream);
+}
+
+void render_vgmstream_segmented_f32(float * outbuf, int32_t sample_count, VGMSTREAM * vgmstream) {
+    render_segmented_internal(NULL, outbuf, sample_count, vgmstream);
+}
+
 
 segmented_layout_data* init_layout_segmented(int segment_count) {
     segmented_layout_data *data = NULL;
@@ -129,6 +298,8 @@ fail:
 int setup_layout_segmented(segmented_layout_data* data) {
     int i, max_input_channels = 0, max_output_channels = 0;
     sample_t *outbuf_re = NULL;
+    float *outbuf_f32_re = NULL;
+    int32_t *starts_re = NULL;
 
 
     /* setup each VGMSTREAM (roughly equivalent to vgmstream.c's init_vgmstream_internal stuff) */
@@ -189,11 +360,25 @@ int setup_layout_segmented(segmented_layout_data* data) {
     if (max_output_channels > VGMSTREAM_MAX_CHANNELS || max_input_channels > VGMSTREAM_MAX_CHANNELS)
         goto fail;
 
+    /* segment positions, so loops and seeks can find their segment without walking all of them */
+    starts_re = realloc(data->segment_starts, (data->segment_count + 1) * sizeof(int32_t));
+    if (!starts_re) goto fail;
+    data->segment_starts = starts_re;
+
+    data->segment_starts[0] = 0;
+    for (i = 0; i < data->segment_count; i++) {
+        data->segment_starts[i+1] = data->segment_starts[i] + data->segments[i]->num_samples;
+    }
+
     /* create internal buffer big enough for mixing */
     outbuf_re = realloc(data->buffer, VGMSTREAM_SEGMENT_SAMPLE_BUFFER*max_input_channels*sizeof(sample_t));
     if (!outbuf_re) goto fail;
     data->buffer = outbuf_re;
 
+    outbuf_f32_re = realloc(data->buffer_f32, VGMSTREAM_SEGMENT_SAMPLE_BUFFER*max_input_channels*sizeof(float));
+    if (!outbuf_f32_re) goto fail;
+    data->buffer_f32 = outbuf_f32_re;
+
     data->input_channels = max_input_channels;
     data->output_channels = max_output_channels;
 
@@ -202,31 +387,95 @@ fail:
     return 0; /* caller is expected to free */
 }
 
+static void free_segmented_prefetch(struct segmented_prefetch_t *prefetch) {
+    if (!prefetch)
+        return;
+
+    worker_close(prefetch->worker);
+    free(prefetch->buffer);
+    free(prefetch);
+}
+
+int setup_layout_segmented_prefetch(segmented_layout_data *data, int32_t samples) {
+    struct segmented_prefetch_t *prefetch = NULL;
+
+    if (!data)
+        return 0;
+
+    prefetch_stop(data);
+    free_segmented_prefetch(data->prefetch);
+    data->prefetch = NULL;
+
+    if (samples <= 0 || data->segment_count <= 1)
+        return 0;
+    /* segments' mixing is set up for this max */
+    if (samples > VGMSTREAM_SEGMENT_SAMPLE_BUFFER)
+        samples = VGMSTREAM_SEGMENT_SAMPLE_BUFFER;
+
+    prefetch = calloc(1, sizeof(struct segmented_prefetch_t));
+    if (!prefetch) goto fail;
+
+    prefetch->data = data;
+    prefetch->state = PREFETCH_NONE;
+    prefetch->max_samples = samples;
+
+    prefetch->buffer = malloc(samples * data->input_channels * sizeof(float));
+    if (!prefetch->buffer) goto fail;
+
+    prefetch->worker = worker_init(prefetch_job, prefetch);
+    if (!prefetch->worker) goto fail; /* no thread support */
+
+    data->prefetch = prefetch;
+    return 1;
+fail:
+    free_segmented_prefetch(prefetch);
+    return 0;
+}
+
 void free_layout_segmented(segmented_layout_data *data) {
     int i;
 
     if (!data)
         return;
 
+    prefetch_stop(data);
+    free_segmented_prefetch(data->prefetch);
+
     if (data->segments) {
         for (i = 0; i < data->segment_count; i++) {
             close_vgmstream(data->segments[i]);
         }
         free(data->segments);
     }
+    free(data->segment_starts);
+    free(data->buffer);
+    free(data->buffer_f32);
     free(data);
 }
 
 void reset_layout_segmented(segmented_layout_data *data) {
-    int i;
-
     if (!data)
         return;
 
+    prefetch_stop(data);
+
+    /* other segments are reset once reached */
     data->current_segment = 0;
-    for (i = 0; i < data->segment_count; i++) {
-        reset_vgmstream(data->segments[i]);
-    }
+    reset_vgmstream(data->segments[0]);
+}
+
+/* Finds segment of the stream sample and seeks inside it (segments don't loop, the main vgmstream does) */
+void seek_layout_segmented(VGMSTREAM *vgmstream, int32_t seek_sample) {
+    int32_t segment_start;
+    segmented_layout_data *data = vgmstream->layout_data;
+
+    prefetch_stop(data);
+
+    data->current_segment = find_segment(data, seek_sample, &segment_start);
+    vgmstream_seek(data->segments[data->current_segment], seek_sample - segment_start);
+
+    vgmstream->current_sample = seek_sample;
+    vgmstream->samples_into_block = seek_sample - segment_start;
 }
 
 /* helper for easier creation of segments */
@@ -9,6 +9,8 @@ typedef struct {
     int is_music;
 
     int total_subsongs;
+    int entries;
+    off_t entries_offset;
 
     int channel_count;
     int sample_rate;
@@ -23,12 +25,17 @@ typedef struct {
 } awc_header;
 
 static int parse_awc_header(STREAMFILE* streamFile, awc_header* awc);
+static int parse_awc_stream(STREAMFILE* streamFile, awc_header* awc, off_t tags_offset, int tag_count);
+static VGMSTREAM * init_vgmstream_awc_header(STREAMFILE *streamFile, void * header);
 
 
 /* AWC - from RAGE (Rockstar Advanced Game Engine) audio (Red Dead Redemption, Max Payne 3, GTA5) */
 VGMSTREAM * init_vgmstream_awc(STREAMFILE *streamFile) {
-    VGMSTREAM * vgmstream = NULL;
     awc_header awc = {0};
+    int target_subsong = streamFile->stream_index;
+    int32_t (*read_32bit)(off_t,STREAMFILE*) = NULL;
+    int i;
+    uint32_t info_header, tag_count = 0, tags_skip = 0;
 
     /* check extension */
     if (!check_extensions(streamFile,"awc"))
@@ -38,31 +45,107 @@ VGMSTREAM * init_vgmstream_awc(STREAMFILE *streamFile) {
     if (!parse_awc_header(streamFile, &awc))
         goto fail;
 
+    read_32bit = awc.big_endian ? read_32bitBE : read_32bitLE;
+
+    if (awc.is_music) {
+        target_subsong = 1; /* we only need id 0, though channels may have its own tags/chunks */
+    }
+    else {
+        if (target_subsong == 0) target_subsong = 1;
+        if (target_subsong < 0 || target_subsong > awc.total_subsongs || awc.total_subsongs < 1) goto fail;
+    }
+
+    /* get stream base info */
+    for (i = 0; i < awc.entries; i++) {
+        info_header = read_32bit(awc.entries_offset + 0x04*i, streamFile);
+        tag_count   = (info_header >> 29) & 0x7; /* 3b */
+        //id        = (info_header >>  0) & 0x1FFFFFFF; /* 29b */
+        if (target_subsong-1 == i)
+            break;
+        tags_skip += tag_count; /* tags to skip to reach target's tags, in the next header */
+    }
+
+    if (!parse_awc_stream(streamFile, &awc, awc.entries_offset + 0x04*awc.entries + 0x08*tags_skip, tag_count))
+        goto fail;
+
+    return init_vgmstream_awc_header(streamFile, &awc);
+fail:
+    return NULL;
+}
+
+/* AWC subsongs, reading all entries in one go */
+VGMSTREAM_SUBSONGS * init_subsongs_awc(STREAMFILE *streamFile) {
+    VGMSTREAM_SUBSONGS * subsongs = NULL;
+    awc_header awc = {0};
+    int32_t (*read_32bit)(off_t,STREAMFILE*) = NULL;
+    int i;
+    off_t tags_offset;
+
+    if (!check_extensions(streamFile,"awc"))
+        goto fail;
+
+    if (!parse_awc_header(streamFile, &awc))
+        goto fail;
+    if (awc.total_subsongs < 1) goto fail;
+
+    read_32bit = awc.big_endian ? read_32bitBE : read_32bitLE;
+
+    subsongs = allocate_vgmstream_subsongs(sizeof(awc_header), init_vgmstream_awc_header);
+    if (!subsongs) goto fail;
+
+    /* music only has one subsong (id 0) */
+    tags_offset = awc.entries_offset + 0x04*awc.entries;
+    for (i = 0; i < awc.total_subsongs; i++) {
+        VGMSTREAM_SUBSONG * subsong;
+        awc_header entry = awc; /* each entry's values start from the base header */
+        uint32_t info_header = read_32bit(awc.entries_offset + 0x04*i, streamFile);
+        uint32_t tag_count   = (info_header >> 29) & 0x7; /* 3b */
+
+        if (!parse_awc_stream(streamFile, &entry, tags_offset, tag_count))
+            goto fail;
+        tags_offset += 0x08*tag_count;
+
+        subsong = add_vgmstream_subsong(subsongs, &entry);
+        if (!subsong) goto fail;
+        subsong->stream_offset = entry.stream_offset;
+        subsong->stream_size = entry.stream_size;
+    }
+
+    return subsongs;
+fail:
+    close_vgmstream_subsongs(subsongs);
+    return NULL;
+}
+
+static VGMSTREAM * init_vgmstream_awc_header(STREAMFILE *streamFile, void * header) {
+    VGMSTREAM * vgmstream = NULL;
+    awc_header* awc = header;
+
 
     /* build the VGMSTREAM */
-    vgmstream = allocate_vgmstream(awc.channel_count, 0);
+    vgmstream = allocate_vgmstream(awc->channel_count, 0);
     if (!vgmstream) goto fail;
 
-    vgmstream->sample_rate = awc.sample_rate;
-    vgmstream->num_samples = awc.num_samples;
-    vgmstream->num_streams = awc.total_subsongs;
-    vgmstream->stream_size = awc.stream_size;
+    vgmstream->sample_rate = awc->sample_rate;
+    vgmstream->num_samples = awc->num_samples;
+    vgmstream->num_streams = awc->total_subsongs;
+    vgmstream->stream_size = awc->stream_size;
     vgmstream->meta_type = meta_AWC;
 
 
-    switch(awc.codec) {
+    switch(awc->codec) {
         case 0x01:      /* PCM (PC/PS3) [sfx, rarely] */
-            if (awc.is_music) goto fail; /* blocked_awc needs to be prepared */
-            vgmstream->coding_type = awc.big_endian ? coding_PCM16BE : coding_PCM16LE;
+            if (awc->is_music) goto fail; /* blocked_awc needs to be prepared */
+            vgmstream->coding_type = awc->big_endian ? coding_PCM16BE : coding_PCM16LE;
             vgmstream->layout_type = layout_interleave;
             vgmstream->interleave_block_size = 0x02;
             break;
 
         case 0x04:      /* IMA (PC) */
             vgmstream->coding_type = coding_AWC_IMA;
-            vgmstream->layout_type = awc.is_music ? layout_blocked_awc : layout_none;
-            vgmstream->full_block_size = awc.block_chunk;
-            vgmstream->codec_endian = awc.big_endian;
+            vgmstream->layout_type = awc->is_music ? layout_blocked_awc : layout_none;
+            vgmstream->full_block_size = awc->block_chunk;
+            vgmstream->codec_endian = awc->big_endian;
             break;
 
 #ifdef VGM_USE_FFMPEG
@@ -71,20 +154,20 @@ VGMSTREAM * init_vgmstream_awc(STREAMFILE *streamFile) {
             size_t bytes, block_size, block_count, substream_size;
             off_t substream_offset;
 
-            if (awc.is_music) {
+            if (awc->is_music) {
                 /* 1ch XMAs in blocks, we'll use layered layout + custom IO to get multi-FFmpegs working */
                 int i;
                 layered_layout_data * data = NULL;
 
                 /* init layout */
-                data = init_layout_layered(awc.channel_count);
+                data = init_layout_layered(awc->channel_count);
                 if (!data) goto fail;
                 vgmstream->layout_data = data;
                 vgmstream->layout_type = layout_layered;
                 vgmstream->coding_type = coding_FFmpeg;
 
                 /* open each layer subfile */
-                for (i = 0; i < awc.channel_count; i++) {
+                for (i = 0; i < awc->channel_count; i++) {
                     STREAMFILE* temp_streamFile;
                     int layer_channels = 1;
 
@@ -92,14 +175,14 @@ VGMSTREAM * init_vgmstream_awc(STREAMFILE *streamFile) {
                     data->layers[i] = allocate_vgmstream(layer_channels, 0);
                     if (!data->layers[i]) goto fail;
 
-                    data->layers[i]->sample_rate = awc.sample_rate;
+                    data->layers[i]->sample_rate = awc->sample_rate;
                     data->layers[i]->meta_type = meta_AWC;
                     data->layers[i]->coding_type = coding_FFmpeg;
                     data->layers[i]->layout_type = layout_none;
-                    data->layers[i]->num_samples = awc.num_samples;
+                    data->layers[i]->num_samples = awc->num_samples;
 
                     /* setup custom IO streamfile, pass to FFmpeg and hope it's fooled */
-                    temp_streamFile = setup_awc_xma_streamfile(streamFile, awc.stream_offset, awc.stream_size, awc.block_chunk, awc.channel_count, i);
+                    temp_streamFile = setup_awc_xma_streamfile(streamFile, awc->stream_offset, awc->stream_size, awc->block_chunk, awc->channel_count, i);
                     if (!temp_streamFile) goto fail;
 
                     substream_offset = 0; /* where FFmpeg thinks data starts, which our custom streamFile will clamp */
@@ -107,7 +190,7 @@ VGMSTREAM * init_vgmstream_awc(STREAMFILE *streamFile) {
                     block_size = 0x8000; /* no idea */
                     block_count = substream_size / block_size; /* not accurate but not needed */
 
-                    bytes = ffmpeg_make_riff_xma2(buf, 0x100, awc.num_samples, substream_size, layer_channels, awc.sample_rate, block_count, block_size);
+                    bytes = ffmpeg_make_riff_xma2(buf, 0x100, awc->num_samples, substream_size, layer_channels, awc->sample_rate, block_count, block_size);
                     data->layers[i]->codec_data = init_ffmpeg_header_offset(temp_streamFile, buf,bytes, substream_offset,substream_size);
 
                     xma_fix_raw_samples(data->layers[i], temp_streamFile, substream_offset,substream_size, 0, 0,0); /* samples are ok? */
@@ -123,15 +206,15 @@ VGMSTREAM * init_vgmstream_awc(STREAMFILE *streamFile) {
             else {
                 /* regular XMA for sfx */
                 block_size = 0x8000; /* no idea */
-                block_count = awc.stream_size / block_size; /* not accurate but not needed */
+                block_count = awc->stream_size / block_size; /* not accurate but not needed */
 
-                bytes = ffmpeg_make_riff_xma2(buf, 0x100, awc.num_samples, awc.stream_size, awc.channel_count, awc.sample_rate, block_count, block_size);
-                vgmstream->codec_data = init_ffmpeg_header_offset(streamFile, buf,bytes, awc.stream_offset,awc.stream_size);
+                bytes = ffmpeg_make_riff_xma2(buf, 0x100, awc->num_samples, awc->stream_size, awc->channel_count, awc->sample_rate, block_count, block_size);
+                vgmstream->codec_data = init_ffmpeg_header_offset(streamFile, buf,bytes, awc->stream_offset,awc->stream_size);
                 if (!vgmstream->codec_data) goto fail;
                 vgmstream->coding_type = coding_FFmpeg;
                 vgmstream->layout_type = layout_none;
 
-                xma_fix_raw_samples(vgmstream, streamFile, awc.stream_offset,awc.stream_size, 0, 0,0); /* samples are ok? */
+                xma_fix_raw_samples(vgmstream, streamFile, awc->stream_offset,awc->stream_size, 0, 0,0); /* samples are ok? */
             }
 
             break;
@@ -143,10 +226,10 @@ VGMSTREAM * init_vgmstream_awc(STREAMFILE *streamFile) {
         case 0x07: {    /* MPEG (PS3) */
             mpeg_custom_config cfg = {0};
 
-            cfg.chunk_size = awc.block_chunk;
-            cfg.big_endian = awc.big_endian;
+            cfg.chunk_size = awc->block_chunk;
+            cfg.big_endian = awc->big_endian;
 
-            vgmstream->codec_data = init_mpeg_custom(streamFile, awc.stream_offset, &vgmstream->coding_type, vgmstream->channels, MPEG_AWC, &cfg);
+            vgmstream->codec_data = init_mpeg_custom(streamFile, awc->stream_offset, &vgmstream->coding_type, vgmstream->channels, MPEG_AWC, &cfg);
             if (!vgmstream->codec_data) goto fail;
             vgmstream->layout_type = layout_none;
 
@@ -155,12 +238,12 @@ VGMSTREAM * init_vgmstream_awc(STREAMFILE *streamFile) {
 #endif
 
         default:
-            VGM_LOG("AWC: unknown codec 0x%02x\n", awc.codec);
+            VGM_LOG("AWC: unknown codec 0x%02x\n", awc->codec);
             goto fail;
     }
 
 
-    if (!vgmstream_open_stream(vgmstream,streamFile,awc.stream_offset))
+    if (!vgmstream_open_stream(vgmstream,streamFile,awc->stream_offset))
         goto fail;
     return vgmstream;
 
@@ -173,13 +256,10 @@ fail:
 /* Parse Rockstar's AWC header (much info from LibertyV: https://github.com/koolkdev/libertyv).
  * Made of entries for N streams, each with a number of tags pointing to chunks (header, data, events, etc). */
 static int parse_awc_header(STREAMFILE* streamFile, awc_header* awc) {
-    int64_t (*read_64bit)(off_t,STREAMFILE*) = NULL;
     int32_t (*read_32bit)(off_t,STREAMFILE*) = NULL;
-    int16_t (*read_16bit)(off_t,STREAMFILE*) = NULL;
-    int i, ch, entries;
-    uint32_t flags, info_header, tag_count = 0, tags_skip = 0;
+    int entries;
+    uint32_t flags;
     off_t off;
-    int target_subsong = streamFile->stream_index;
 
 
     /* check header */
@@ -189,13 +269,9 @@ static int parse_awc_header(STREAMFILE* streamFile, awc_header* awc) {
 
     awc->big_endian = read_32bitBE(0x00,streamFile) == 0x54414441;
     if (awc->big_endian) {
-        read_64bit = read_64bitBE;
         read_32bit = read_32bitBE;
-        read_16bit = read_16bitBE;
     } else {
-        read_64bit = read_64bitLE;
         read_32bit = read_32bitLE;
-        read_16bit = read_16bitLE;
     }
 
 
@@ -230,26 +306,25 @@ static int parse_awc_header(STREAMFILE* streamFile, awc_header* awc) {
     awc->is_music = (read_32bit(off + 0x00,streamFile) & 0x1FFFFFFF) == 0x00000000;
     if (awc->is_music) { /* all streams except id 0 is a channel */
         awc->total_subsongs = 1;
-        target_subsong = 1; /* we only need id 0, though channels may have its own tags/chunks */
     }
     else { /* each stream is a single sound */
         awc->total_subsongs = entries;
-        if (target_subsong == 0) target_subsong = 1;
-        if (target_subsong < 0 || target_subsong > awc->total_subsongs || awc->total_subsongs < 1) goto fail;
     }
 
+    awc->entries = entries;
+    awc->entries_offset = off;
 
-    /* get stream base info */
-    for (i = 0; i < entries; i++) {
-        info_header = read_32bit(off + 0x04*i, streamFile);
-        tag_count   = (info_header >> 29) & 0x7; /* 3b */
-        //id        = (info_header >>  0) & 0x1FFFFFFF; /* 29b */
-        if (target_subsong-1 == i)
-            break;
-        tags_skip += tag_count; /* tags to skip to reach target's tags, in the next header */
-    }
-    off += 0x04*entries;
-    off += 0x08*tags_skip;
+    return 1;
+fail:
+    return 0;
+}
+
+/* Parse a stream entry's tags (each entry has a number of tags, saved after all entries). */
+static int parse_awc_stream(STREAMFILE* streamFile, awc_header* awc, off_t tags_offset, int tag_count) {
+    int64_t (*read_64bit)(off_t,STREAMFILE*) = awc->big_endian ? read_64bitBE : read_64bitLE;
+    int32_t (*read_32bit)(off_t,STREAMFILE*) = awc->big_endian ? read_32bitBE : read_32bitLE;
+    int16_t (*read_16bit)(off_t,STREAMFILE*) = awc->big_endian ? read_16bitBE : read_16bitLE;
+    int i, ch;
 
     /* get stream tags */
     for (i = 0; i < tag_count; i++) {
@@ -258,7 +333,7 @@ static int parse_awc_header(STREAMFILE* streamFile, awc_header* awc) {
         size_t size;
         off_t offset;
 
-        tag_header = (uint64_t)read_64bit(off + 0x08*i,streamFile);
+        tag_header = (uint64_t)read_64bit(tags_offset + 0x08*i,streamFile);
         tag    = (uint8_t)((tag_header >> 56) & 0xFF); /* 8b */
         size   =  (size_t)((tag_header >> 28) & 0x0FFFFFFF); /* 28b */
         offset =   (off_t)((tag_header >>  0) & 0x0FFFFFFF); /* 28b */
@@ -281,7 +356,7 @@ static int parse_awc_header(STREAMFILE* streamFile, awc_header* awc) {
                 awc->block_chunk = read_32bit(offset + 0x04,streamFile);
                 awc->channel_count = read_32bit(offset + 0x08,streamFile);
 
-                if (awc->channel_count != entries - 1) { /* not counting id-0 */
+                if (awc->channel_count != awc->entries - 1) { /* not counting id-0 */
                     VGM_LOG("AWC: number of music channels doesn't match entries\n");
                     goto fail;
                 }
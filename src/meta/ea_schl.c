@@ -1561,6 +1561,9 @@ static void update_ea_stream_size_and_samples(STREAMFILE* streamFile, off_t star
             multiple_schl = 1;
         }
 
+        /* save positions while at it, for seeking later */
+        block_index_add(vgmstream, num_samples);
+
         if (vgmstream->current_block_samples > 0) {
             /* HACK: fix num_samples for streams with multiple SCHl. Need to eventually get rid of this.
              * Get total samples by parsing block headers, needed when multiple files are stitched together.
@@ -19,8 +19,8 @@ VGMSTREAM * init_vgmstream_hca(STREAMFILE *streamFile) {
     hca_data = init_hca(streamFile);
     if (!hca_data) goto fail;
 
-    /* find decryption key in external file or preloaded list */
-    if (hca_data->info.encryptionEnabled) {
+    /* find decryption key in external file or preloaded list (slow and not needed for info) */
+    if (hca_data->info.encryptionEnabled && !streamFile->probe_only) {
         uint8_t keybuf[0x08+0x02];
         size_t keysize;
 
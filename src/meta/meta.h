@@ -192,10 +192,12 @@ VGMSTREAM * init_vgmstream_fsb(STREAMFILE * streamFile);
 VGMSTREAM * init_vgmstream_fsb4_wav(STREAMFILE * streamFile);
 
 VGMSTREAM * init_vgmstream_fsb5(STREAMFILE * streamFile);
+VGMSTREAM_SUBSONGS * init_subsongs_fsb5(STREAMFILE * streamFile);
 
 VGMSTREAM * init_vgmstream_rwx(STREAMFILE * streamFile);
 
 VGMSTREAM * init_vgmstream_xwb(STREAMFILE * streamFile);
+VGMSTREAM_SUBSONGS * init_subsongs_xwb(STREAMFILE * streamFile);
 
 VGMSTREAM * init_vgmstream_ps2_xa30(STREAMFILE * streamFile);
 
@@ -657,6 +659,7 @@ VGMSTREAM * init_vgmstream_sk_aud(STREAMFILE * streamFile);
 VGMSTREAM * init_vgmstream_stm(STREAMFILE * streamFile);
 
 VGMSTREAM * init_vgmstream_awc(STREAMFILE * streamFile);
+VGMSTREAM_SUBSONGS * init_subsongs_awc(STREAMFILE * streamFile);
 
 VGMSTREAM * init_vgmstream_opus_std(STREAMFILE * streamFile);
 VGMSTREAM * init_vgmstream_opus_n1(STREAMFILE * streamFile);
@@ -675,6 +678,7 @@ VGMSTREAM * init_vgmstream_pc_ast(STREAMFILE * streamFile);
 VGMSTREAM * init_vgmstream_naac(STREAMFILE * streamFile);
 
 VGMSTREAM * init_vgmstream_ubi_sb(STREAMFILE * streamFile);
+VGMSTREAM_SUBSONGS * init_subsongs_ubi_sb(STREAMFILE * streamFile);
 VGMSTREAM * init_vgmstream_ubi_sm(STREAMFILE * streamFile);
 VGMSTREAM * init_vgmstream_ubi_bnm(STREAMFILE * streamFile);
 
@@ -711,6 +715,7 @@ VGMSTREAM * init_vgmstream_sps_n1(STREAMFILE *streamFile);
 VGMSTREAM * init_vgmstream_atx(STREAMFILE *streamFile);
 
 VGMSTREAM * init_vgmstream_sqex_sead(STREAMFILE * streamFile);
+VGMSTREAM_SUBSONGS * init_subsongs_sqex_sead(STREAMFILE * streamFile);
 
 VGMSTREAM * init_vgmstream_waf(STREAMFILE * streamFile);
 
@@ -746,6 +751,7 @@ VGMSTREAM * init_vgmstream_ppst(STREAMFILE *streamFile);
 VGMSTREAM * init_vgmstream_opus_sps_n1_segmented(STREAMFILE *streamFile);
 
 VGMSTREAM * init_vgmstream_ubi_bao_pk(STREAMFILE *streamFile);
+VGMSTREAM_SUBSONGS * init_subsongs_ubi_bao_pk(STREAMFILE *streamFile);
 VGMSTREAM * init_vgmstream_ubi_bao_atomic(STREAMFILE *streamFile);
 
 VGMSTREAM * init_vgmstream_h4m(STREAMFILE *streamFile);
@@ -766,6 +772,7 @@ VGMSTREAM * init_vgmstream_wavebatch(STREAMFILE *streamFile);
 VGMSTREAM * init_vgmstream_hd3_bd3(STREAMFILE *streamFile);
 
 VGMSTREAM * init_vgmstream_bnk_sony(STREAMFILE *streamFile);
+VGMSTREAM_SUBSONGS * init_subsongs_bnk_sony(STREAMFILE *streamFile);
 
 VGMSTREAM * init_vgmstream_nus3bank(STREAMFILE *streamFile);
 
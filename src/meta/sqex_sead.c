@@ -2,33 +2,144 @@
 #include "../coding/coding.h"
 
 
+typedef struct {
+    int big_endian;
+    int is_sab;
+    int is_mab;
+    int total_subsongs;
+
+    off_t mtrl_offset;
+    off_t meta_offset;
+
+    int channel_count;
+    int codec;
+    int sample_rate;
+    int loop_flag;
+    int loop_start;
+    int loop_end;
+    off_t extradata_offset;
+    size_t extradata_size;
+    size_t stream_size;
+    size_t special_size;
+} sead_header;
+
+static int parse_sead_header(STREAMFILE * streamFile, sead_header* sead);
+static int parse_sead_stream(STREAMFILE * streamFile, sead_header* sead, off_t meta_offset);
+static VGMSTREAM * init_vgmstream_sqex_sead_header(STREAMFILE * streamFile, void * header);
 static STREAMFILE* setup_sead_hca_streamfile(STREAMFILE *streamFile, off_t subfile_offset, size_t subfile_size, int encryption, size_t header_size, size_t key_start);
 
 /* SABF/MABF - Square Enix's "sead" audio games [Dragon Quest Builders (PS3), Dissidia Opera Omnia (mobile), FF XV (PS4)] */
 VGMSTREAM * init_vgmstream_sqex_sead(STREAMFILE * streamFile) {
-    VGMSTREAM * vgmstream = NULL;
-    off_t start_offset, tables_offset, mtrl_offset, meta_offset, extradata_offset; //, info_offset, name_offset = 0;
-    size_t stream_size, descriptor_size, extradata_size, special_size; //, name_size = 0;
+    sead_header sead = {0};
+    int target_subsong = streamFile->stream_index;
+    int32_t (*read_32bit)(off_t,STREAMFILE*) = NULL;
+    int16_t (*read_16bit)(off_t,STREAMFILE*) = NULL;
+
+
+    /* check extensions (.sab: sound/bgm, .mab: music, .sbin: Dissidia Opera Omnia .sab) */
+    if ( !check_extensions(streamFile,"sab,mab,sbin"))
+        goto fail;
+
+    if (!parse_sead_header(streamFile, &sead))
+        goto fail;
+
+    read_32bit = sead.big_endian ? read_32bitBE : read_32bitLE;
+    read_16bit = sead.big_endian ? read_16bitBE : read_16bitLE;
+
+    /* find meta_offset in mtrl */
+    {
+        int i, subsong = 0;
+        int entries = read_16bit(sead.mtrl_offset+0x04,streamFile);
+        off_t entries_offset = sead.mtrl_offset + 0x10;
+
+        if (target_subsong == 0) target_subsong = 1;
 
+        /* manually find subsongs as entries can be dummy (ex. sfx banks in Dissidia Opera Omnia) */
+        for (i = 0; i < entries; i++) {
+            off_t entry_offset = sead.mtrl_offset + read_32bit(entries_offset + i*0x04,streamFile);
 
-    int loop_flag = 0, channel_count, codec, sample_rate, loop_start, loop_end;
-    int is_sab = 0, is_mab = 0;
-    int total_subsongs, target_subsong = streamFile->stream_index;
+            if (read_8bit(entry_offset+0x05,streamFile) == 0)
+                continue; /* codec 0 when dummy */
 
+            subsong++;
+            if (subsong == target_subsong) {
+                sead.meta_offset = entry_offset;
+                break;
+            }
+        }
+        if (sead.meta_offset == 0) goto fail;
+        /* SAB can contain 0 entries too */
+    }
+
+    if (!parse_sead_stream(streamFile, &sead, sead.meta_offset))
+        goto fail;
+
+    return init_vgmstream_sqex_sead_header(streamFile, &sead);
+fail:
+    return NULL;
+}
+
+/* SABF/MABF subsongs, reading all mtrl entries in one go */
+VGMSTREAM_SUBSONGS * init_subsongs_sqex_sead(STREAMFILE * streamFile) {
+    VGMSTREAM_SUBSONGS * subsongs = NULL;
+    sead_header sead = {0};
     int32_t (*read_32bit)(off_t,STREAMFILE*) = NULL;
     int16_t (*read_16bit)(off_t,STREAMFILE*) = NULL;
+    int i, entries;
+    off_t entries_offset;
 
 
-    /* check extensions (.sab: sound/bgm, .mab: music, .sbin: Dissidia Opera Omnia .sab) */
     if ( !check_extensions(streamFile,"sab,mab,sbin"))
         goto fail;
 
+    if (!parse_sead_header(streamFile, &sead))
+        goto fail;
+    if (sead.total_subsongs <= 0) goto fail;
+
+    read_32bit = sead.big_endian ? read_32bitBE : read_32bitLE;
+    read_16bit = sead.big_endian ? read_16bitBE : read_16bitLE;
+
+    subsongs = allocate_vgmstream_subsongs(sizeof(sead_header), init_vgmstream_sqex_sead_header);
+    if (!subsongs) goto fail;
+
+    entries = read_16bit(sead.mtrl_offset+0x04,streamFile);
+    entries_offset = sead.mtrl_offset + 0x10;
+    for (i = 0; i < entries; i++) {
+        VGMSTREAM_SUBSONG * subsong;
+        sead_header entry = sead;
+        off_t entry_offset = sead.mtrl_offset + read_32bit(entries_offset + i*0x04,streamFile);
+
+        if (read_8bit(entry_offset+0x05,streamFile) == 0)
+            continue; /* codec 0 when dummy */
+
+        if (!parse_sead_stream(streamFile, &entry, entry_offset))
+            goto fail;
+
+        subsong = add_vgmstream_subsong(subsongs, &entry);
+        if (!subsong) goto fail;
+        subsong->stream_offset = entry.extradata_offset + entry.extradata_size;
+        subsong->stream_size = entry.stream_size;
+    }
+
+    return subsongs;
+fail:
+    close_vgmstream_subsongs(subsongs);
+    return NULL;
+}
+
+/* parse main header and tables, and count subsongs */
+static int parse_sead_header(STREAMFILE * streamFile, sead_header* sead) {
+    off_t tables_offset;
+    size_t descriptor_size;
+    int32_t (*read_32bit)(off_t,STREAMFILE*) = NULL;
+    int16_t (*read_16bit)(off_t,STREAMFILE*) = NULL;
+
 
     /** main header **/
     if (read_32bitBE(0x00,streamFile) == 0x73616266) { /* "sabf" */
-        is_sab = 1;
+        sead->is_sab = 1;
     } else if (read_32bitBE(0x00,streamFile) == 0x6D616266) { /* "mabf" */
-        is_mab = 1;
+        sead->is_mab = 1;
     } else {
         goto fail;
     }
@@ -41,6 +152,7 @@ VGMSTREAM * init_vgmstream_sqex_sead(STREAMFILE * streamFile) {
     if (read_16bitBE(0x06,streamFile) < 0x100) { /* use some value as no apparent flag */
         read_32bit = read_32bitBE;
         read_16bit = read_16bitBE;
+        sead->big_endian = 1;
     } else {
         read_32bit = read_32bitLE;
         read_16bit = read_16bitLE;
@@ -57,7 +169,7 @@ VGMSTREAM * init_vgmstream_sqex_sead(STREAMFILE * streamFile) {
 
 
     /** offset tables **/
-    if (is_sab) {
+    if (sead->is_sab) {
         if (read_32bitBE(tables_offset+0x00,streamFile) != 0x736E6420) goto fail; /* "snd " (info) */
         if (read_32bitBE(tables_offset+0x10,streamFile) != 0x73657120) goto fail; /* "seq " (unknown) */
         if (read_32bitBE(tables_offset+0x20,streamFile) != 0x74726B20) goto fail; /* "trk " (unknown) */
@@ -65,15 +177,15 @@ VGMSTREAM * init_vgmstream_sqex_sead(STREAMFILE * streamFile) {
       //info_offset = read_32bit(tables_offset+0x08,streamFile);
       //seq_offset  = read_32bit(tables_offset+0x18,streamFile);
       //trk_offset  = read_32bit(tables_offset+0x28,streamFile);
-        mtrl_offset = read_32bit(tables_offset+0x38,streamFile);
+        sead->mtrl_offset = read_32bit(tables_offset+0x38,streamFile);
     }
-    else if (is_mab) {
+    else if (sead->is_mab) {
         if (read_32bitBE(tables_offset+0x00,streamFile) != 0x6D757363) goto fail; /* "musc" (info) */
         if (read_32bitBE(tables_offset+0x10,streamFile) != 0x696E7374) goto fail; /* "inst" (unknown) */
         if (read_32bitBE(tables_offset+0x20,streamFile) != 0x6D74726C) goto fail; /* "mtrl" (headers/streams) */
       //info_offset = read_32bit(tables_offset+0x08,streamFile);
       //inst_offset = read_32bit(tables_offset+0x18,streamFile);
-        mtrl_offset = read_32bit(tables_offset+0x28,streamFile);
+        sead->mtrl_offset = read_32bit(tables_offset+0x28,streamFile);
     }
     else {
         goto fail;
@@ -82,48 +194,52 @@ VGMSTREAM * init_vgmstream_sqex_sead(STREAMFILE * streamFile) {
      * 0x00(2): 0x00/01?, 0x02: size? (0x10), 0x04(2): entries, 0x06+: padded to 0x10
      * 0x10+0x04*entry: offset from section start, also padded to 0x10 at the end */
 
-    /* find meta_offset in mtrl and total subsongs */
+    /* find total subsongs */
     {
         int i;
-        int entries = read_16bit(mtrl_offset+0x04,streamFile);
-        off_t entries_offset = mtrl_offset + 0x10;
+        int entries = read_16bit(sead->mtrl_offset+0x04,streamFile);
+        off_t entries_offset = sead->mtrl_offset + 0x10;
 
-        if (target_subsong == 0) target_subsong = 1;
-        total_subsongs = 0;
-        meta_offset = 0;
+        sead->total_subsongs = 0;
 
         /* manually find subsongs as entries can be dummy (ex. sfx banks in Dissidia Opera Omnia) */
         for (i = 0; i < entries; i++) {
-            off_t entry_offset = mtrl_offset + read_32bit(entries_offset + i*0x04,streamFile);
+            off_t entry_offset = sead->mtrl_offset + read_32bit(entries_offset + i*0x04,streamFile);
 
             if (read_8bit(entry_offset+0x05,streamFile) == 0)
                 continue; /* codec 0 when dummy */
 
-            total_subsongs++;
-            if (!meta_offset && total_subsongs == target_subsong)
-                meta_offset = entry_offset;
+            sead->total_subsongs++;
         }
-        if (meta_offset == 0) goto fail;
-        /* SAB can contain 0 entries too */
     }
 
+    return 1;
+fail:
+    return 0;
+}
+
+/* parse a mtrl entry's stream header */
+static int parse_sead_stream(STREAMFILE * streamFile, sead_header* sead, off_t meta_offset) {
+    int32_t (*read_32bit)(off_t,STREAMFILE*) = sead->big_endian ? read_32bitBE : read_32bitLE;
+
+    sead->meta_offset = meta_offset;
 
     /** stream header **/
     /* 0x00(2): 0x00/01? */
     /* 0x02(2): base entry size? (0x20) */
-    channel_count   =  read_8bit(meta_offset+0x04,streamFile);
-    codec           =  read_8bit(meta_offset+0x05,streamFile);
-  //entry_id        = read_16bit(meta_offset+0x06,streamFile);
-    sample_rate     = read_32bit(meta_offset+0x08,streamFile);
-    loop_start      = read_32bit(meta_offset+0x0c,streamFile); /* in samples but usually ignored */
+    sead->channel_count   =  read_8bit(meta_offset+0x04,streamFile);
+    sead->codec           =  read_8bit(meta_offset+0x05,streamFile);
+  //entry_id              = read_16bit(meta_offset+0x06,streamFile);
+    sead->sample_rate     = read_32bit(meta_offset+0x08,streamFile);
+    sead->loop_start      = read_32bit(meta_offset+0x0c,streamFile); /* in samples but usually ignored */
 
-    loop_end        = read_32bit(meta_offset+0x10,streamFile);
-    extradata_size  = read_32bit(meta_offset+0x14,streamFile); /* including subfile header, can be 0 */
-    stream_size     = read_32bit(meta_offset+0x18,streamFile); /* not including subfile header */
-    special_size    = read_32bit(meta_offset+0x1c,streamFile);
+    sead->loop_end        = read_32bit(meta_offset+0x10,streamFile);
+    sead->extradata_size  = read_32bit(meta_offset+0x14,streamFile); /* including subfile header, can be 0 */
+    sead->stream_size     = read_32bit(meta_offset+0x18,streamFile); /* not including subfile header */
+    sead->special_size    = read_32bit(meta_offset+0x1c,streamFile);
 
-    loop_flag       = (loop_end > 0);
-    extradata_offset = meta_offset + 0x20;
+    sead->loop_flag       = (sead->loop_end > 0);
+    sead->extradata_offset = meta_offset + 0x20;
 
 
     /** info section (get stream name) **/
@@ -143,44 +259,54 @@ VGMSTREAM * init_vgmstream_sqex_sead(STREAMFILE * streamFile) {
         // (loops, maybe proper num_samples) are listed per material but don't always match thei header
     //}
 
+    return 1;
+}
+
+static VGMSTREAM * init_vgmstream_sqex_sead_header(STREAMFILE * streamFile, void * header) {
+    VGMSTREAM * vgmstream = NULL;
+    sead_header* sead = header;
+    off_t start_offset;
+    int32_t (*read_32bit)(off_t,STREAMFILE*) = sead->big_endian ? read_32bitBE : read_32bitLE;
+    int16_t (*read_16bit)(off_t,STREAMFILE*) = sead->big_endian ? read_16bitBE : read_16bitLE;
+
 
     /* build the VGMSTREAM */
-    vgmstream = allocate_vgmstream(channel_count,loop_flag);
+    vgmstream = allocate_vgmstream(sead->channel_count,sead->loop_flag);
     if (!vgmstream) goto fail;
 
-    vgmstream->sample_rate = sample_rate;
-    vgmstream->num_streams = total_subsongs;
-    vgmstream->stream_size = stream_size;
-    vgmstream->meta_type = is_sab ? meta_SQEX_SAB : meta_SQEX_MAB;
+    vgmstream->sample_rate = sead->sample_rate;
+    vgmstream->num_streams = sead->total_subsongs;
+    vgmstream->stream_size = sead->stream_size;
+    vgmstream->meta_type = sead->is_sab ? meta_SQEX_SAB : meta_SQEX_MAB;
 
-    switch(codec) {
+    switch(sead->codec) {
 
         case 0x01: { /* PCM [Chrono Trigger sfx (PC)] */
-            start_offset = extradata_offset + extradata_size;
+            start_offset = sead->extradata_offset + sead->extradata_size;
 
             vgmstream->coding_type = coding_PCM16LE;
             vgmstream->layout_type = layout_interleave;
             vgmstream->interleave_block_size = 0x02;
 
-            vgmstream->num_samples = pcm_bytes_to_samples(stream_size, vgmstream->channels, 16);
-            vgmstream->loop_start_sample = loop_start;
-            vgmstream->loop_end_sample   = loop_end;
+            vgmstream->num_samples = pcm_bytes_to_samples(sead->stream_size, vgmstream->channels, 16);
+            vgmstream->loop_start_sample = sead->loop_start;
+            vgmstream->loop_end_sample   = sead->loop_end;
             break;
         }
 
         case 0x02: { /* MSADPCM [Dragon Quest Builders (Vita) sfx] */
-            start_offset = extradata_offset + extradata_size;
+            start_offset = sead->extradata_offset + sead->extradata_size;
 
             /* 0x00 (2): null?, 0x02(2): entry size? */
             vgmstream->coding_type = coding_MSADPCM;
             vgmstream->layout_type = layout_none;
-            vgmstream->interleave_block_size = read_16bit(extradata_offset+0x04,streamFile);
+            vgmstream->interleave_block_size = read_16bit(sead->extradata_offset+0x04,streamFile);
 
             /* much like AKBs, there are slightly different loop values here, probably more accurate
              * (if no loop, loop_end doubles as num_samples) */
-            vgmstream->num_samples = msadpcm_bytes_to_samples(stream_size, vgmstream->interleave_block_size, vgmstream->channels);
-            vgmstream->loop_start_sample = read_32bit(extradata_offset+0x08, streamFile); //loop_start
-            vgmstream->loop_end_sample   = read_32bit(extradata_offset+0x0c, streamFile); //loop_end
+            vgmstream->num_samples = msadpcm_bytes_to_samples(sead->stream_size, vgmstream->interleave_block_size, vgmstream->channels);
+            vgmstream->loop_start_sample = read_32bit(sead->extradata_offset+0x08, streamFile); //loop_start
+            vgmstream->loop_end_sample   = read_32bit(sead->extradata_offset+0x0c, streamFile); //loop_end
             break;
         }
 
@@ -188,11 +314,11 @@ VGMSTREAM * init_vgmstream_sqex_sead(STREAMFILE * streamFile) {
         case 0x03: { /* OGG [Final Fantasy XV Benchmark sfx (PC)] */
             VGMSTREAM *ogg_vgmstream = NULL;
             ogg_vorbis_meta_info_t ovmi = {0};
-            off_t subfile_offset = extradata_offset + extradata_size;
+            off_t subfile_offset = sead->extradata_offset + sead->extradata_size;
 
             ovmi.meta_type = vgmstream->meta_type;
-            ovmi.total_subsongs = total_subsongs;
-            ovmi.stream_size = stream_size;
+            ovmi.total_subsongs = sead->total_subsongs;
+            ovmi.stream_size = sead->stream_size;
             /* post header has some kind of repeated values, config/table? */
 
             ogg_vgmstream = init_vgmstream_ogg_vorbis_callbacks(streamFile, NULL, subfile_offset, &ovmi);
@@ -215,21 +341,21 @@ VGMSTREAM * init_vgmstream_sqex_sead(STREAMFILE * streamFile) {
         case 0x04: { /* ATRAC9 [Dragon Quest Builders (Vita), Final Fantaxy XV (PS4)] */
             atrac9_config cfg = {0};
 
-            start_offset = extradata_offset + extradata_size;
+            start_offset = sead->extradata_offset + sead->extradata_size;
             /* post header has various typical ATRAC9 values */
             cfg.channels = vgmstream->channels;
-            cfg.config_data = read_32bit(extradata_offset+0x0c,streamFile);
-            cfg.encoder_delay = read_32bit(extradata_offset+0x18,streamFile);
+            cfg.config_data = read_32bit(sead->extradata_offset+0x0c,streamFile);
+            cfg.encoder_delay = read_32bit(sead->extradata_offset+0x18,streamFile);
 
             vgmstream->codec_data = init_atrac9(&cfg);
             if (!vgmstream->codec_data) goto fail;
             vgmstream->coding_type = coding_ATRAC9;
             vgmstream->layout_type = layout_none;
 
-            vgmstream->sample_rate = read_32bit(extradata_offset+0x1c,streamFile); /* SAB's sample rate can be different but it's ignored */
-            vgmstream->num_samples = read_32bit(extradata_offset+0x10,streamFile); /* loop values above are also weird and ignored */
-            vgmstream->loop_start_sample = read_32bit(extradata_offset+0x20, streamFile) - (loop_flag ? cfg.encoder_delay : 0); //loop_start
-            vgmstream->loop_end_sample   = read_32bit(extradata_offset+0x24, streamFile) - (loop_flag ? cfg.encoder_delay : 0); //loop_end
+            vgmstream->sample_rate = read_32bit(sead->extradata_offset+0x1c,streamFile); /* SAB's sample rate can be different but it's ignored */
+            vgmstream->num_samples = read_32bit(sead->extradata_offset+0x10,streamFile); /* loop values above are also weird and ignored */
+            vgmstream->loop_start_sample = read_32bit(sead->extradata_offset+0x20, streamFile) - (sead->loop_flag ? cfg.encoder_delay : 0); //loop_start
+            vgmstream->loop_end_sample   = read_32bit(sead->extradata_offset+0x24, streamFile) - (sead->loop_flag ? cfg.encoder_delay : 0); //loop_end
             break;
         }
 #endif
@@ -239,7 +365,7 @@ VGMSTREAM * init_vgmstream_sqex_sead(STREAMFILE * streamFile) {
             mpeg_codec_data *mpeg_data = NULL;
             mpeg_custom_config cfg = {0};
 
-            start_offset = extradata_offset + extradata_size;
+            start_offset = sead->extradata_offset + sead->extradata_size;
             /* post header is a proper MSF, but sample rate/loops are ignored in favor of SAB's */
 
             mpeg_data = init_mpeg_custom(streamFile, start_offset, &vgmstream->coding_type, vgmstream->channels, MPEG_STANDARD, &cfg);
@@ -247,9 +373,9 @@ VGMSTREAM * init_vgmstream_sqex_sead(STREAMFILE * streamFile) {
             vgmstream->codec_data = mpeg_data;
             vgmstream->layout_type = layout_none;
 
-            vgmstream->num_samples = mpeg_bytes_to_samples(stream_size, mpeg_data);
-            vgmstream->loop_start_sample = loop_start;
-            vgmstream->loop_end_sample = loop_end;
+            vgmstream->num_samples = mpeg_bytes_to_samples(sead->stream_size, mpeg_data);
+            vgmstream->loop_start_sample = sead->loop_start;
+            vgmstream->loop_end_sample = sead->loop_end;
             break;
         }
 #endif
@@ -258,13 +384,13 @@ VGMSTREAM * init_vgmstream_sqex_sead(STREAMFILE * streamFile) {
             //todo there is no easy way to use the HCA decoder; try subfile hack for now
             VGMSTREAM *temp_vgmstream = NULL;
             STREAMFILE *temp_streamFile = NULL;
-            off_t subfile_offset = extradata_offset + 0x10;
-            size_t subfile_size = stream_size + extradata_size - 0x10;
+            off_t subfile_offset = sead->extradata_offset + 0x10;
+            size_t subfile_size = sead->stream_size + sead->extradata_size - 0x10;
 
             /* post header: values from the HCA header, in file endianness + HCA header */
-            size_t key_start = special_size & 0xff;
-            size_t header_size = read_16bit(extradata_offset+0x02, streamFile);
-            int encryption = read_16bit(extradata_offset+0x0c, streamFile); //maybe 8bit?
+            size_t key_start = sead->special_size & 0xff;
+            size_t header_size = read_16bit(sead->extradata_offset+0x02, streamFile);
+            int encryption = read_16bit(sead->extradata_offset+0x0c, streamFile); //maybe 8bit?
             /* encryption type 0x01 found in Final Fantasy XII TZA (PS4/PC) */
 
             temp_streamFile = setup_sead_hca_streamfile(streamFile, subfile_offset, subfile_size, encryption, header_size, key_start);
@@ -289,7 +415,7 @@ VGMSTREAM * init_vgmstream_sqex_sead(STREAMFILE * streamFile) {
 
         case 0x00: /* dummy entry */
         default:
-            VGM_LOG("SQEX SEAD: unknown codec %x\n", codec);
+            VGM_LOG("SQEX SEAD: unknown codec %x\n", sead->codec);
             goto fail;
     }
 
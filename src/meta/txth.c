@@ -368,7 +368,7 @@ VGMSTREAM * init_vgmstream_txth(STREAMFILE *streamFile) {
             /* get coefs */
             for (i = 0; i < vgmstream->channels; i++) {
                 int16_t (*read_16bit)(off_t , STREAMFILE*) = txth.coef_big_endian ? read_16bitBE : read_16bitLE;
-                int16_t (*get_16bit)(uint8_t * p) = txth.coef_big_endian ? get_16bitBE : get_16bitLE;
+                int16_t (*get_16bit)(const uint8_t * p) = txth.coef_big_endian ? get_16bitBE : get_16bitLE;
 
                 /* normal/split coefs */
                 if (txth.coef_mode == 0) { /* normal mode */
@@ -126,8 +126,9 @@ typedef struct {
 
 static int parse_header(ubi_bao_header * bao, STREAMFILE *streamFile, off_t offset);
 static int parse_bao(ubi_bao_header * bao, STREAMFILE *streamFile, off_t offset, int target_subsong);
-static int parse_pk(ubi_bao_header * bao, STREAMFILE *streamFile);
+static int parse_pk(ubi_bao_header * bao, STREAMFILE *streamFile, int target_subsong, VGMSTREAM_SUBSONGS * subsongs);
 static VGMSTREAM * init_vgmstream_ubi_bao_header(ubi_bao_header * bao, STREAMFILE *streamFile);
+static VGMSTREAM * init_vgmstream_ubi_bao_subsong(STREAMFILE *streamFile, void * header);
 static STREAMFILE * setup_bao_streamfile(ubi_bao_header *bao, STREAMFILE *streamFile);
 static STREAMFILE * open_atomic_bao(ubi_bao_file file_type, uint32_t file_id, int is_stream, STREAMFILE *streamFile);
 static int find_package_bao(uint32_t bao_id, STREAMFILE *streamFile, off_t *out_offset, size_t *out_size);
@@ -149,7 +150,7 @@ VGMSTREAM * init_vgmstream_ubi_bao_pk(STREAMFILE *streamFile) {
      * .pk has an index pointing to memory BAOs and tables with external stream BAOs in .spk. */
 
      /* main parse */
-    if (!parse_pk(&bao, streamFile))
+    if (!parse_pk(&bao, streamFile, streamFile->stream_index, NULL))
         goto fail;
 
     build_readable_name(bao.readable_name, sizeof(bao.readable_name), &bao);
@@ -158,6 +159,26 @@ fail:
     return NULL;
 }
 
+/* .PK subsongs, parsing every header BAO in a single index pass */
+VGMSTREAM_SUBSONGS * init_subsongs_ubi_bao_pk(STREAMFILE *streamFile) {
+    VGMSTREAM_SUBSONGS * subsongs = NULL;
+    ubi_bao_header bao = { 0 };
+
+    if (!check_extensions(streamFile, "pk,lpk,cpk"))
+        goto fail;
+
+    subsongs = allocate_vgmstream_subsongs(sizeof(ubi_bao_header), init_vgmstream_ubi_bao_subsong);
+    if (!subsongs) goto fail;
+
+    if (!parse_pk(&bao, streamFile, 0, subsongs))
+        goto fail;
+
+    return subsongs;
+fail:
+    close_vgmstream_subsongs(subsongs);
+    return NULL;
+}
+
 /* .BAO - single BAO files from Ubisoft's sound engine ("DARE") games in 2008+ */
 VGMSTREAM * init_vgmstream_ubi_bao_atomic(STREAMFILE *streamFile) {
     ubi_bao_header bao = { 0 };
@@ -686,6 +707,10 @@ fail:
 }
 
 
+static VGMSTREAM * init_vgmstream_ubi_bao_subsong(STREAMFILE *streamFile, void * header) {
+    return init_vgmstream_ubi_bao_header(header, streamFile);
+}
+
 static VGMSTREAM * init_vgmstream_ubi_bao_header(ubi_bao_header * bao, STREAMFILE * streamFile) {
     VGMSTREAM * vgmstream = NULL;
 
@@ -740,13 +765,13 @@ fail:
 /* parse a .pk (package) file: index + BAOs + external .spk resource table. We want header
  * BAOs pointing to internal/external stream BAOs (.spk is the same, with stream BAOs only).
  * A fun feature of .pk is that different BAOs in a .pk can point to different .spk BAOs
- * that actually hold the same data, with different GUID too, somehow. */
-static int parse_pk(ubi_bao_header * bao, STREAMFILE *streamFile) {
+ * that actually hold the same data, with different GUID too, somehow.
+ * If subsongs is set every header BAO is parsed and saved there instead of the target. */
+static int parse_pk(ubi_bao_header * bao, STREAMFILE *streamFile, int target_subsong, VGMSTREAM_SUBSONGS * subsongs) {
     int i;
     int index_entries;
     size_t index_size, index_header_size;
     off_t bao_offset;
-    int target_subsong = streamFile->stream_index;
     STREAMFILE *streamIndex = NULL;
     STREAMFILE *streamTest = NULL;
 
@@ -755,7 +780,7 @@ static int parse_pk(ubi_bao_header * bao, STREAMFILE *streamFile) {
         goto fail;
     /* index and resources are always LE */
 
-    if (target_subsong <= 0) target_subsong = 1;
+    if (target_subsong <= 0 && !subsongs) target_subsong = 1;
 
     bao->version = read_32bitBE(0x00, streamFile) & 0x00FFFFFF;
     index_size = read_32bitLE(0x04, streamFile); /* can be 0, not including  */
@@ -798,12 +823,43 @@ static int parse_pk(ubi_bao_header * bao, STREAMFILE *streamFile) {
         //;VGM_LOG("UBI BAO: offset=%x, size=%x\n", (uint32_t)bao_offset, bao_size);
 
         /* parse and continue to find out total_subsongs */
-        if (!parse_bao(bao, streamTest, bao_offset, target_subsong))
-            goto fail;
+        if (!subsongs) {
+            if (!parse_bao(bao, streamTest, bao_offset, target_subsong))
+                goto fail;
+        }
+        else {
+            int prev_subsongs = bao->total_subsongs;
+
+            if (!parse_bao(bao, streamTest, bao_offset, 0))
+                goto fail;
+
+            if (bao->total_subsongs > prev_subsongs) {
+                VGMSTREAM_SUBSONG * subsong;
+                ubi_bao_header entry = *bao; /* from current state, same as parsing only that target */
+
+                if (parse_header(&entry, streamTest, bao_offset))
+                    build_readable_name(entry.readable_name, sizeof(entry.readable_name), &entry);
+                else
+                    entry.type = TYPE_NONE; /* will fail on open like by index */
+
+                subsong = add_vgmstream_subsong(subsongs, &entry);
+                if (!subsong) goto fail;
+                subsong->stream_offset = entry.stream_offset;
+                subsong->stream_size = entry.stream_size;
+            }
+        }
 
         bao_offset += bao_size; /* files simply concat BAOs */
     }
 
+    /* final count is only known at the end */
+    if (subsongs) {
+        for (i = 0; i < subsongs->num_subsongs; i++) {
+            ubi_bao_header * entry = (ubi_bao_header *)(subsongs->headers + i * subsongs->header_size);
+            entry->total_subsongs = bao->total_subsongs;
+        }
+    }
+
     //;VGM_LOG("UBI BAO: class "); {int i; for (i=0;i<16;i++){ VGM_ASSERT(bao->classes[i],"%02x=%i ",i,bao->classes[i]); }} VGM_LOG("\n");
     //;VGM_LOG("UBI BAO: types "); {int i; for (i=0;i<16;i++){ VGM_ASSERT(bao->types[i],"%02x=%i ",i,bao->types[i]); }} VGM_LOG("\n");
 
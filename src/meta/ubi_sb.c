@@ -166,8 +166,10 @@ typedef struct {
 
 static int parse_bnm_header(ubi_sb_header * sb, STREAMFILE *streamFile);
 static int parse_header(ubi_sb_header * sb, STREAMFILE *streamFile, off_t offset, int index);
-static int parse_sb(ubi_sb_header * sb, STREAMFILE *streamFile, int target_subsong);
+static int parse_sb_bank(ubi_sb_header * sb, STREAMFILE *streamFile);
+static int parse_sb(ubi_sb_header * sb, STREAMFILE *streamFile, int target_subsong, VGMSTREAM_SUBSONGS * subsongs);
 static VGMSTREAM * init_vgmstream_ubi_sb_header(ubi_sb_header *sb, STREAMFILE* streamTest, STREAMFILE *streamFile);
+static VGMSTREAM * init_vgmstream_ubi_sb_subsong(STREAMFILE *streamFile, void * header);
 static int config_sb_platform(ubi_sb_header * sb, STREAMFILE *streamFile);
 static int config_sb_version(ubi_sb_header * sb, STREAMFILE *streamFile);
 
@@ -176,7 +178,6 @@ static int config_sb_version(ubi_sb_header * sb, STREAMFILE *streamFile);
 VGMSTREAM * init_vgmstream_ubi_sb(STREAMFILE *streamFile) {
     VGMSTREAM* vgmstream = NULL;
     STREAMFILE *streamTest = NULL;
-    int32_t(*read_32bit)(off_t, STREAMFILE*) = NULL;
     ubi_sb_header sb = {0};
     int target_subsong = streamFile->stream_index;
 
@@ -189,11 +190,8 @@ VGMSTREAM * init_vgmstream_ubi_sb(STREAMFILE *streamFile) {
      * but can also reference .ss0/ls0 (sound stream) external files for longer streams.
      * A companion .sp0 (sound project) describes files and if it uses BANKs (.sbX) or MAPs (.smX). */
 
-
-    /* PLATFORM DETECTION */
-    if (!config_sb_platform(&sb, streamFile))
+    if (!parse_sb_bank(&sb, streamFile))
         goto fail;
-    read_32bit = sb.big_endian ? read_32bitBE : read_32bitLE;
 
     if (target_subsong <= 0) target_subsong = 1;
 
@@ -201,50 +199,109 @@ VGMSTREAM * init_vgmstream_ubi_sb(STREAMFILE *streamFile) {
     streamTest = reopen_streamfile(streamFile, 0x100);
     if (!streamTest) goto fail;
 
+    if (!parse_sb(&sb, streamTest, target_subsong, NULL))
+        goto fail;
 
-    /* SB HEADER */
-    /* SBx layout: header, section1, section2, extra section, section3, data (all except header can be null) */
-    sb.is_bank = 1;
-    sb.version       = read_32bit(0x00, streamFile);
-    sb.section1_num  = read_32bit(0x04, streamFile);
-    sb.section2_num  = read_32bit(0x08, streamFile);
-    sb.section3_num  = read_32bit(0x0c, streamFile);
-    sb.sectionX_size = read_32bit(0x10, streamFile);
-    sb.flag1         = read_32bit(0x14, streamFile);
-    sb.flag2         = read_32bit(0x18, streamFile);
+    /* CREATE VGMSTREAM */
+    vgmstream = init_vgmstream_ubi_sb_header(&sb, streamTest, streamFile);
+    close_streamfile(streamTest);
+    return vgmstream;
 
-    if (!config_sb_version(&sb, streamFile))
-        goto fail;
+fail:
+    close_streamfile(streamTest);
+    return NULL;
+}
+
+/* .SBx subsongs, parsing every header in a single section pass */
+VGMSTREAM_SUBSONGS * init_subsongs_ubi_sb(STREAMFILE *streamFile) {
+    VGMSTREAM_SUBSONGS * subsongs = NULL;
+    STREAMFILE *streamTest = NULL;
+    ubi_sb_header sb = {0};
 
-    sb.section1_offset = 0x1c;
-    if (sb.cfg.is_padded_section1_offset)
-        sb.section1_offset = align_size_to_block(sb.section1_offset, 0x10);
 
-    sb.section2_offset = sb.section1_offset + sb.cfg.section1_entry_size * sb.section1_num;
-    if (sb.cfg.is_padded_section2_offset)
-        sb.section2_offset = align_size_to_block(sb.section2_offset, 0x10);
+    if (!check_extensions(streamFile, "sb0,sb1,sb2,sb3,sb4,sb5,sb6,sb7"))
+        goto fail;
 
-    sb.sectionX_offset = sb.section2_offset + sb.cfg.section2_entry_size * sb.section2_num;
-    if (sb.cfg.is_padded_sectionX_offset)
-        sb.sectionX_offset = align_size_to_block(sb.sectionX_offset, 0x10);
+    if (!parse_sb_bank(&sb, streamFile))
+        goto fail;
+
+    streamTest = reopen_streamfile(streamFile, 0x100);
+    if (!streamTest) goto fail;
 
-    sb.section3_offset = sb.sectionX_offset + sb.sectionX_size;
-    if (sb.cfg.is_padded_section3_offset)
-        sb.section3_offset = align_size_to_block(sb.section3_offset, 0x10);
+    subsongs = allocate_vgmstream_subsongs(sizeof(ubi_sb_header), init_vgmstream_ubi_sb_subsong);
+    if (!subsongs) goto fail;
 
-    if (!parse_sb(&sb, streamTest, target_subsong))
+    if (!parse_sb(&sb, streamTest, 0, subsongs))
         goto fail;
 
-    /* CREATE VGMSTREAM */
-    vgmstream = init_vgmstream_ubi_sb_header(&sb, streamTest, streamFile);
     close_streamfile(streamTest);
-    return vgmstream;
+    return subsongs;
+fail:
+    close_streamfile(streamTest);
+    close_vgmstream_subsongs(subsongs);
+    return NULL;
+}
+
+static VGMSTREAM * init_vgmstream_ubi_sb_subsong(STREAMFILE *streamFile, void * header) {
+    VGMSTREAM* vgmstream = NULL;
+    STREAMFILE *streamTest = NULL;
 
+    streamTest = reopen_streamfile(streamFile, 0x100);
+    if (!streamTest) goto fail;
+
+    vgmstream = init_vgmstream_ubi_sb_header(header, streamTest, streamFile);
+    close_streamfile(streamTest);
+    return vgmstream;
 fail:
     close_streamfile(streamTest);
     return NULL;
 }
 
+/* SBx base header and section layout */
+static int parse_sb_bank(ubi_sb_header * sb, STREAMFILE *streamFile) {
+    int32_t(*read_32bit)(off_t, STREAMFILE*) = NULL;
+
+    /* PLATFORM DETECTION */
+    if (!config_sb_platform(sb, streamFile))
+        goto fail;
+    read_32bit = sb->big_endian ? read_32bitBE : read_32bitLE;
+
+
+    /* SB HEADER */
+    /* SBx layout: header, section1, section2, extra section, section3, data (all except header can be null) */
+    sb->is_bank = 1;
+    sb->version       = read_32bit(0x00, streamFile);
+    sb->section1_num  = read_32bit(0x04, streamFile);
+    sb->section2_num  = read_32bit(0x08, streamFile);
+    sb->section3_num  = read_32bit(0x0c, streamFile);
+    sb->sectionX_size = read_32bit(0x10, streamFile);
+    sb->flag1         = read_32bit(0x14, streamFile);
+    sb->flag2         = read_32bit(0x18, streamFile);
+
+    if (!config_sb_version(sb, streamFile))
+        goto fail;
+
+    sb->section1_offset = 0x1c;
+    if (sb->cfg.is_padded_section1_offset)
+        sb->section1_offset = align_size_to_block(sb->section1_offset, 0x10);
+
+    sb->section2_offset = sb->section1_offset + sb->cfg.section1_entry_size * sb->section1_num;
+    if (sb->cfg.is_padded_section2_offset)
+        sb->section2_offset = align_size_to_block(sb->section2_offset, 0x10);
+
+    sb->sectionX_offset = sb->section2_offset + sb->cfg.section2_entry_size * sb->section2_num;
+    if (sb->cfg.is_padded_sectionX_offset)
+        sb->sectionX_offset = align_size_to_block(sb->sectionX_offset, 0x10);
+
+    sb->section3_offset = sb->sectionX_offset + sb->sectionX_size;
+    if (sb->cfg.is_padded_section3_offset)
+        sb->section3_offset = align_size_to_block(sb->section3_offset, 0x10);
+
+    return 1;
+fail:
+    return 0;
+}
+
 /* .SMx - maps (sets of custom SBx files) also from Ubisoft's sound engine games in ~2000-2008+ */
 VGMSTREAM * init_vgmstream_ubi_sm(STREAMFILE *streamFile) {
     VGMSTREAM* vgmstream = NULL;
@@ -330,7 +387,7 @@ VGMSTREAM * init_vgmstream_ubi_sm(STREAMFILE *streamFile) {
         //;VGM_ASSERT(sb.map_unknown != 0, "UBI SM: unknown map_unknown at %x\n", (uint32_t)offset);
         VGM_ASSERT(sb.version_empty != 0, "UBI SM: unknown version_empty at %x\n", (uint32_t)offset);
 
-        if (!parse_sb(&sb, streamTest, target_subsong))
+        if (!parse_sb(&sb, streamTest, target_subsong, NULL))
             goto fail;
 
         /* snapshot of current sb if subsong was found
@@ -380,7 +437,7 @@ VGMSTREAM * init_vgmstream_ubi_bnm(STREAMFILE *streamFile) {
     if (!parse_bnm_header(&sb, streamTest))
         goto fail;
 
-    if (!parse_sb(&sb, streamTest, target_subsong))
+    if (!parse_sb(&sb, streamTest, target_subsong, NULL))
         goto fail;
 
     /* CREATE VGMSTREAM */
@@ -1752,7 +1809,8 @@ fail:
 }
 
 /* parse a bank and its possible audio headers */
-static int parse_sb(ubi_sb_header * sb, STREAMFILE *streamFile, int target_subsong) {
+/* if subsongs is set every header is parsed and saved there instead of the target */
+static int parse_sb(ubi_sb_header * sb, STREAMFILE *streamFile, int target_subsong, VGMSTREAM_SUBSONGS * subsongs) {
     int32_t (*read_32bit)(off_t,STREAMFILE*) = sb->big_endian ? read_32bitBE : read_32bitLE;
     int i;
 
@@ -1780,6 +1838,21 @@ static int parse_sb(ubi_sb_header * sb, STREAMFILE *streamFile, int target_subso
 
         sb->bank_subsongs++;
         sb->total_subsongs++;
+        if (subsongs) {
+            VGMSTREAM_SUBSONG * subsong;
+            ubi_sb_header entry = *sb; /* from current state, same as parsing only that target */
+
+            if (parse_header(&entry, streamFile, offset, i))
+                build_readable_name(entry.readable_name, sizeof(entry.readable_name), &entry);
+            else
+                entry.type = UBI_NONE; /* will fail on open like by index */
+
+            subsong = add_vgmstream_subsong(subsongs, &entry);
+            if (!subsong) goto fail;
+            subsong->stream_offset = entry.stream_offset;
+            subsong->stream_size = entry.stream_size;
+            continue;
+        }
         if (sb->total_subsongs != target_subsong)
             continue;
 
@@ -1791,6 +1864,15 @@ static int parse_sb(ubi_sb_header * sb, STREAMFILE *streamFile, int target_subso
 
     /* either found target subsong or it's in another bank (in case of maps), both handled externally */
 
+    /* final counts are only known at the end */
+    if (subsongs) {
+        for (i = 0; i < subsongs->num_subsongs; i++) {
+            ubi_sb_header * entry = (ubi_sb_header *)(subsongs->headers + i * subsongs->header_size);
+            entry->bank_subsongs = sb->bank_subsongs;
+            entry->total_subsongs = sb->total_subsongs;
+        }
+    }
+
     //;VGM_LOG("UBI SB: types "); {int i; for (i=0;i<16;i++){ VGM_ASSERT(sb->types[i],"%02x=%i ",i,sb->types[i]); }} VGM_LOG("\n");
 
     return 1;
@@ -324,8 +324,10 @@ VGMSTREAM * init_vgmstream_wwise(STREAMFILE *streamFile) {
                     }
                 }
 
-                vgmstream->codec_data = init_vorbis_custom(streamFile, start_offset + setup_offset, VORBIS_WWISE, &cfg);
-                if (!vgmstream->codec_data) goto fail;
+                if (!streamFile->probe_only) {
+                    vgmstream->codec_data = init_vorbis_custom(streamFile, start_offset + setup_offset, VORBIS_WWISE, &cfg);
+                    if (!vgmstream->codec_data) goto fail;
+                }
             }
             else {
                 /* newer Wwise (>2012) */
@@ -369,12 +371,14 @@ VGMSTREAM * init_vgmstream_wwise(STREAMFILE *streamFile) {
                 }
 
                 /* try with the selected codebooks */
-                vgmstream->codec_data = init_vorbis_custom(streamFile, start_offset + setup_offset, VORBIS_WWISE, &cfg);
-                if (!vgmstream->codec_data) {
-                    /* codebooks failed: try again with the other type */
-                    cfg.setup_type  = is_wem ? WWV_EXTERNAL_CODEBOOKS : WWV_AOTUV603_CODEBOOKS;
+                if (!streamFile->probe_only) {
                     vgmstream->codec_data = init_vorbis_custom(streamFile, start_offset + setup_offset, VORBIS_WWISE, &cfg);
-                    if (!vgmstream->codec_data) goto fail;
+                    if (!vgmstream->codec_data) {
+                        /* codebooks failed: try again with the other type */
+                        cfg.setup_type  = is_wem ? WWV_EXTERNAL_CODEBOOKS : WWV_AOTUV603_CODEBOOKS;
+                        vgmstream->codec_data = init_vorbis_custom(streamFile, start_offset + setup_offset, VORBIS_WWISE, &cfg);
+                        if (!vgmstream->codec_data) goto fail;
+                    }
                 }
             }
             vgmstream->layout_type = layout_none;
@@ -446,8 +450,10 @@ VGMSTREAM * init_vgmstream_wwise(STREAMFILE *streamFile) {
                 bytes = ffmpeg_make_riff_xma_from_fmt_chunk(buf,0x100, ww.fmt_offset, ww.fmt_size, ww.data_size, streamFile, ww.big_endian);
             }
 
-            vgmstream->codec_data = init_ffmpeg_header_offset(streamFile, buf,bytes, ww.data_offset,ww.data_size);
-            if ( !vgmstream->codec_data ) goto fail;
+            if (!streamFile->probe_only) {
+                vgmstream->codec_data = init_ffmpeg_header_offset(streamFile, buf,bytes, ww.data_offset,ww.data_size);
+                if ( !vgmstream->codec_data ) goto fail;
+            }
             vgmstream->coding_type = coding_FFmpeg;
             vgmstream->layout_type = layout_none;
 
@@ -546,8 +552,10 @@ VGMSTREAM * init_vgmstream_wwise(STREAMFILE *streamFile) {
 
             skip = switch_opus_get_encoder_delay(start_offset, streamFile); /* should be 120 */
 
-            vgmstream->codec_data = init_ffmpeg_switch_opus(streamFile, start_offset,ww.data_size, vgmstream->channels, skip, vgmstream->sample_rate);
-            if (!vgmstream->codec_data) goto fail;
+            if (!streamFile->probe_only) {
+                vgmstream->codec_data = init_ffmpeg_switch_opus(streamFile, start_offset,ww.data_size, vgmstream->channels, skip, vgmstream->sample_rate);
+                if (!vgmstream->codec_data) goto fail;
+            }
             vgmstream->coding_type = coding_FFmpeg;
             vgmstream->layout_type = layout_none;
             break;
@@ -69,22 +69,25 @@ typedef struct {
     uint32_t loop_end_sample;
 
     char wavebank_name[64+1];
+    char stream_name[STREAM_NAME_SIZE];
 
     int is_crackdown;
     int fix_xma_num_samples;
     int fix_xma_loop_samples;
 } xwb_header;
 
+static int parse_xwb_header(STREAMFILE *streamFile, xwb_header * xwb);
+static int parse_xwb_entry(STREAMFILE *streamFile, xwb_header * xwb, int subsong);
+static VGMSTREAM * init_vgmstream_xwb_header(STREAMFILE *streamFile, void * header);
 static void get_name(char * buf, size_t maxsize, int target_subsong, xwb_header * xwb, STREAMFILE *streamFile);
+static int get_xwb_name(char * buf, size_t maxsize, int target_subsong, xwb_header * xwb, STREAMFILE *streamFile);
+static off_t * get_xsb_names(xwb_header * xwb, STREAMFILE *streamXsb);
 
 
 /* XWB - XACT Wave Bank (Microsoft SDK format for XBOX/XBOX360/Windows) */
 VGMSTREAM * init_vgmstream_xwb(STREAMFILE *streamFile) {
-    VGMSTREAM * vgmstream = NULL;
-    off_t start_offset, offset, suboffset;
     xwb_header xwb = {0};
     int target_subsong = streamFile->stream_index;
-    int32_t (*read_32bit)(off_t,STREAMFILE*) = NULL;
 
 
     /* checks */
@@ -93,12 +96,93 @@ VGMSTREAM * init_vgmstream_xwb(STREAMFILE *streamFile) {
      * (extensionless): Ikaruga (X360/PC), Grabbed by the Ghoulies (Xbox) */
     if (!check_extensions(streamFile,"xwb,xna,"))
         goto fail;
+
+    if (!parse_xwb_header(streamFile, &xwb))
+        goto fail;
+
+    if (target_subsong == 0) target_subsong = 1; /* auto: default to 1 */
+    if (target_subsong < 0 || target_subsong > xwb.total_subsongs || xwb.total_subsongs < 1) goto fail;
+
+    if (!parse_xwb_entry(streamFile, &xwb, target_subsong))
+        goto fail;
+
+    get_name(xwb.stream_name,STREAM_NAME_SIZE, target_subsong, &xwb, streamFile);
+
+    return init_vgmstream_xwb_header(streamFile, &xwb);
+fail:
+    return NULL;
+}
+
+/* XWB subsongs, reading all entries and names (that may need a whole .xsb parse) in one go */
+VGMSTREAM_SUBSONGS * init_subsongs_xwb(STREAMFILE *streamFile) {
+    VGMSTREAM_SUBSONGS * subsongs = NULL;
+    STREAMFILE *streamXsb = NULL;
+    off_t * xsb_names = NULL;
+    int xsb_tried = 0;
+    xwb_header xwb = {0};
+    int i;
+
+
+    if (!check_extensions(streamFile,"xwb,xna,"))
+        goto fail;
+
+    if (!parse_xwb_header(streamFile, &xwb))
+        goto fail;
+    if (xwb.total_subsongs < 1) goto fail;
+
+    subsongs = allocate_vgmstream_subsongs(sizeof(xwb_header), init_vgmstream_xwb_header);
+    if (!subsongs) goto fail;
+
+    for (i = 0; i < xwb.total_subsongs; i++) {
+        VGMSTREAM_SUBSONG * subsong;
+        xwb_header entry = xwb; /* each entry's values start from the base header */
+
+        if (!parse_xwb_entry(streamFile, &entry, i + 1))
+            goto fail;
+
+        /* same as get_name */
+        if (!get_xwb_name(entry.stream_name,STREAM_NAME_SIZE, i + 1, &entry, streamFile)) {
+            if (!xsb_tried) {
+                xsb_tried = 1;
+                streamXsb = open_xsb_filename_pair(streamFile);
+                if (streamXsb)
+                    xsb_names = get_xsb_names(&xwb, streamXsb);
+            }
+
+            if (xsb_names && xsb_names[i] > 0)
+                read_string(entry.stream_name,STREAM_NAME_SIZE, xsb_names[i],streamXsb); /* null-terminated */
+            else
+                entry.stream_name[0] = '\0';
+        }
+
+        subsong = add_vgmstream_subsong(subsongs, &entry);
+        if (!subsong) goto fail;
+        subsong->stream_offset = entry.stream_offset;
+        subsong->stream_size = entry.stream_size;
+    }
+
+    free(xsb_names);
+    close_streamfile(streamXsb);
+    return subsongs;
+fail:
+    free(xsb_names);
+    close_streamfile(streamXsb);
+    close_vgmstream_subsongs(subsongs);
+    return NULL;
+}
+
+/* parse main header (WAVEBANKHEADER) and base entry (WAVEBANKDATA) */
+static int parse_xwb_header(STREAMFILE *streamFile, xwb_header * xwb) {
+    off_t offset, suboffset;
+    int32_t (*read_32bit)(off_t,STREAMFILE*) = NULL;
+
+
     if ((read_32bitBE(0x00,streamFile) != 0x57424E44) &&    /* "WBND" (LE) */
         (read_32bitBE(0x00,streamFile) != 0x444E4257))      /* "DNBW" (BE) */
         goto fail;
 
-    xwb.little_endian = read_32bitBE(0x00,streamFile) == 0x57424E44; /* WBND */
-    if (xwb.little_endian) {
+    xwb->little_endian = read_32bitBE(0x00,streamFile) == 0x57424E44; /* WBND */
+    if (xwb->little_endian) {
         read_32bit = read_32bitLE;
     } else {
         read_32bit = read_32bitBE;
@@ -106,93 +190,100 @@ VGMSTREAM * init_vgmstream_xwb(STREAMFILE *streamFile) {
 
 
     /* read main header (WAVEBANKHEADER) */
-    xwb.version = read_32bit(0x04, streamFile); /* XACT3: 0x04=tool version, 0x08=header version */
+    xwb->version = read_32bit(0x04, streamFile); /* XACT3: 0x04=tool version, 0x08=header version */
 
     /* Crackdown 1 (X360), essentially XACT2 but may have split header in some cases */
-    if (xwb.version == XACT_CRACKDOWN) {
-        xwb.version = XACT2_2_MAX;
-        xwb.is_crackdown = 1;
+    if (xwb->version == XACT_CRACKDOWN) {
+        xwb->version = XACT2_2_MAX;
+        xwb->is_crackdown = 1;
     }
 
     /* read segment offsets (SEGIDX) */
-    if (xwb.version <= XACT1_0_MAX) {
-        xwb.total_subsongs = read_32bit(0x0c, streamFile);
-        read_string(xwb.wavebank_name,0x10+1, 0x10, streamFile); /* null-terminated */
-        xwb.base_offset     = 0;
-        xwb.base_size       = 0;
-        xwb.entry_offset    = 0x50;
-        xwb.entry_elem_size = 0x14;
-        xwb.entry_size      = xwb.entry_elem_size * xwb.total_subsongs;
-        xwb.data_offset     = xwb.entry_offset + xwb.entry_size;
-        xwb.data_size       = get_streamfile_size(streamFile) - xwb.data_offset;
-
-        xwb.names_offset    = 0;
-        xwb.names_size      = 0;
-        xwb.names_entry_size= 0;
-        xwb.extra_offset    = 0;
-        xwb.extra_size      = 0;
+    if (xwb->version <= XACT1_0_MAX) {
+        xwb->total_subsongs = read_32bit(0x0c, streamFile);
+        read_string(xwb->wavebank_name,0x10+1, 0x10, streamFile); /* null-terminated */
+        xwb->base_offset     = 0;
+        xwb->base_size       = 0;
+        xwb->entry_offset    = 0x50;
+        xwb->entry_elem_size = 0x14;
+        xwb->entry_size      = xwb->entry_elem_size * xwb->total_subsongs;
+        xwb->data_offset     = xwb->entry_offset + xwb->entry_size;
+        xwb->data_size       = get_streamfile_size(streamFile) - xwb->data_offset;
+
+        xwb->names_offset    = 0;
+        xwb->names_size      = 0;
+        xwb->names_entry_size= 0;
+        xwb->extra_offset    = 0;
+        xwb->extra_size      = 0;
     }
     else {
-        offset = xwb.version <= XACT2_2_MAX ? 0x08 : 0x0c;
-        xwb.base_offset = read_32bit(offset+0x00, streamFile);//BANKDATA
-        xwb.base_size   = read_32bit(offset+0x04, streamFile);
-        xwb.entry_offset= read_32bit(offset+0x08, streamFile);//ENTRYMETADATA
-        xwb.entry_size  = read_32bit(offset+0x0c, streamFile);
+        offset = xwb->version <= XACT2_2_MAX ? 0x08 : 0x0c;
+        xwb->base_offset = read_32bit(offset+0x00, streamFile);//BANKDATA
+        xwb->base_size   = read_32bit(offset+0x04, streamFile);
+        xwb->entry_offset= read_32bit(offset+0x08, streamFile);//ENTRYMETADATA
+        xwb->entry_size  = read_32bit(offset+0x0c, streamFile);
 
         /* read extra segments (values can be 0 == no segment) */
-        if (xwb.version <= XACT1_1_MAX) {
-            xwb.names_offset    = read_32bit(offset+0x10, streamFile);//ENTRYNAMES
-            xwb.names_size      = read_32bit(offset+0x14, streamFile);
-            xwb.names_entry_size= 0x40;
-            xwb.extra_offset    = 0;
-            xwb.extra_size      = 0;
+        if (xwb->version <= XACT1_1_MAX) {
+            xwb->names_offset    = read_32bit(offset+0x10, streamFile);//ENTRYNAMES
+            xwb->names_size      = read_32bit(offset+0x14, streamFile);
+            xwb->names_entry_size= 0x40;
+            xwb->extra_offset    = 0;
+            xwb->extra_size      = 0;
             suboffset = 0x04*2;
         }
-        else if (xwb.version <= XACT2_1_MAX) {
-            xwb.names_offset    = read_32bit(offset+0x10, streamFile);//ENTRYNAMES
-            xwb.names_size      = read_32bit(offset+0x14, streamFile);
-            xwb.names_entry_size= 0x40;
-            xwb.extra_offset    = read_32bit(offset+0x18, streamFile);//EXTRA
-            xwb.extra_size      = read_32bit(offset+0x1c, streamFile);
+        else if (xwb->version <= XACT2_1_MAX) {
+            xwb->names_offset    = read_32bit(offset+0x10, streamFile);//ENTRYNAMES
+            xwb->names_size      = read_32bit(offset+0x14, streamFile);
+            xwb->names_entry_size= 0x40;
+            xwb->extra_offset    = read_32bit(offset+0x18, streamFile);//EXTRA
+            xwb->extra_size      = read_32bit(offset+0x1c, streamFile);
             suboffset = 0x04*2 + 0x04*2;
         } else {
-            xwb.extra_offset    = read_32bit(offset+0x10, streamFile);//SEEKTABLES
-            xwb.extra_size      = read_32bit(offset+0x14, streamFile);
-            xwb.names_offset    = read_32bit(offset+0x18, streamFile);//ENTRYNAMES
-            xwb.names_size      = read_32bit(offset+0x1c, streamFile);
-            xwb.names_entry_size= 0x40;
+            xwb->extra_offset    = read_32bit(offset+0x10, streamFile);//SEEKTABLES
+            xwb->extra_size      = read_32bit(offset+0x14, streamFile);
+            xwb->names_offset    = read_32bit(offset+0x18, streamFile);//ENTRYNAMES
+            xwb->names_size      = read_32bit(offset+0x1c, streamFile);
+            xwb->names_entry_size= 0x40;
             suboffset = 0x04*2 + 0x04*2;
         }
 
-        xwb.data_offset = read_32bit(offset+0x10+suboffset, streamFile);//ENTRYWAVEDATA
-        xwb.data_size   = read_32bit(offset+0x14+suboffset, streamFile);
+        xwb->data_offset = read_32bit(offset+0x10+suboffset, streamFile);//ENTRYWAVEDATA
+        xwb->data_size   = read_32bit(offset+0x14+suboffset, streamFile);
 
         /* for Techland's XWB with no data */
-        if (xwb.base_offset == 0) goto fail;
+        if (xwb->base_offset == 0) goto fail;
 
         /* read base entry (WAVEBANKDATA) */
-        offset = xwb.base_offset;
-        xwb.base_flags = (uint32_t)read_32bit(offset+0x00, streamFile);
-        xwb.total_subsongs       = read_32bit(offset+0x04, streamFile);
-        read_string(xwb.wavebank_name,0x40+1, offset+0x08, streamFile); /* null-terminated */
-        suboffset = 0x08 + (xwb.version <= XACT1_1_MAX ? 0x10 : 0x40);
-        xwb.entry_elem_size = read_32bit(offset+suboffset+0x00, streamFile);
+        offset = xwb->base_offset;
+        xwb->base_flags = (uint32_t)read_32bit(offset+0x00, streamFile);
+        xwb->total_subsongs       = read_32bit(offset+0x04, streamFile);
+        read_string(xwb->wavebank_name,0x40+1, offset+0x08, streamFile); /* null-terminated */
+        suboffset = 0x08 + (xwb->version <= XACT1_1_MAX ? 0x10 : 0x40);
+        xwb->entry_elem_size = read_32bit(offset+suboffset+0x00, streamFile);
         /* suboff+0x04: meta name entry size */
-        xwb.entry_alignment = read_32bit(offset+suboffset+0x08, streamFile); /* usually 1 dvd sector */
-        xwb.format          = read_32bit(offset+suboffset+0x0c, streamFile); /* compact mode only */
+        xwb->entry_alignment = read_32bit(offset+suboffset+0x08, streamFile); /* usually 1 dvd sector */
+        xwb->format          = read_32bit(offset+suboffset+0x0c, streamFile); /* compact mode only */
         /* suboff+0x10: build time 64b (XACT2/3) */
     }
 
-    //;VGM_LOG("XWB: wavebank name='%s'\n", xwb.wavebank_name);
+    //;VGM_LOG("XWB: wavebank name='%s'\n", xwb->wavebank_name);
 
-    if (target_subsong == 0) target_subsong = 1; /* auto: default to 1 */
-    if (target_subsong < 0 || target_subsong > xwb.total_subsongs || xwb.total_subsongs < 1) goto fail;
+    return 1;
+fail:
+    return 0;
+}
+
+/* parse a stream entry (WAVEBANKENTRY) and its format */
+static int parse_xwb_entry(STREAMFILE *streamFile, xwb_header * xwb, int subsong) {
+    off_t offset;
+    int32_t (*read_32bit)(off_t,STREAMFILE*) = xwb->little_endian ? read_32bitLE : read_32bitBE;
 
 
     /* read stream entry (WAVEBANKENTRY) */
-    offset = xwb.entry_offset + (target_subsong-1) * xwb.entry_elem_size;
+    offset = xwb->entry_offset + (subsong-1) * xwb->entry_elem_size;
 
-    if (xwb.base_flags & WAVEBANK_FLAGS_COMPACT) { /* compact entry [NFL Fever 2004 demo from Amped 2 (Xbox)] */
+    if (xwb->base_flags & WAVEBANK_FLAGS_COMPACT) { /* compact entry [NFL Fever 2004 demo from Amped 2 (Xbox)] */
         uint32_t entry, size_deviation, sector_offset;
         off_t next_stream_offset;
 
@@ -200,240 +291,250 @@ VGMSTREAM * init_vgmstream_xwb(STREAMFILE *streamFile) {
         size_deviation = ((entry >> 21) & 0x7FF); /* 11b, padding data for sector alignment in bytes*/
         sector_offset = (entry & 0x1FFFFF); /* 21b, offset within data in sectors */
 
-        xwb.stream_offset  = xwb.data_offset + sector_offset*xwb.entry_alignment;
+        xwb->stream_offset  = xwb->data_offset + sector_offset*xwb->entry_alignment;
 
         /* find size using next offset */
-        if (target_subsong < xwb.total_subsongs) {
+        if (subsong < xwb->total_subsongs) {
             uint32_t next_entry = (uint32_t)read_32bit(offset+0x04, streamFile);
-            next_stream_offset = xwb.data_offset + (next_entry & 0x1FFFFF)*xwb.entry_alignment;
+            next_stream_offset = xwb->data_offset + (next_entry & 0x1FFFFF)*xwb->entry_alignment;
         }
         else { /* for last entry (or first, when subsongs = 1) */
-            next_stream_offset = xwb.data_offset + xwb.data_size;
+            next_stream_offset = xwb->data_offset + xwb->data_size;
         }
-        xwb.stream_size = next_stream_offset - xwb.stream_offset - size_deviation;
+        xwb->stream_size = next_stream_offset - xwb->stream_offset - size_deviation;
     }
-    else if (xwb.version <= XACT1_0_MAX) {
-        xwb.format          = (uint32_t)read_32bit(offset+0x00, streamFile);
-        xwb.stream_offset   = xwb.data_offset + (uint32_t)read_32bit(offset+0x04, streamFile);
-        xwb.stream_size     = (uint32_t)read_32bit(offset+0x08, streamFile);
+    else if (xwb->version <= XACT1_0_MAX) {
+        xwb->format          = (uint32_t)read_32bit(offset+0x00, streamFile);
+        xwb->stream_offset   = xwb->data_offset + (uint32_t)read_32bit(offset+0x04, streamFile);
+        xwb->stream_size     = (uint32_t)read_32bit(offset+0x08, streamFile);
 
-        xwb.loop_start      = (uint32_t)read_32bit(offset+0x0c, streamFile);
-        xwb.loop_end        = (uint32_t)read_32bit(offset+0x10, streamFile);//length
+        xwb->loop_start      = (uint32_t)read_32bit(offset+0x0c, streamFile);
+        xwb->loop_end        = (uint32_t)read_32bit(offset+0x10, streamFile);//length
     }
     else {
         uint32_t entry_info = (uint32_t)read_32bit(offset+0x00, streamFile);
-        if (xwb.version <= XACT1_1_MAX) {
-            xwb.entry_flags = entry_info;
+        if (xwb->version <= XACT1_1_MAX) {
+            xwb->entry_flags = entry_info;
         } else {
-            xwb.entry_flags = (entry_info) & 0xF; /*4b*/
-            xwb.num_samples = (entry_info >> 4) & 0x0FFFFFFF; /*28b*/
+            xwb->entry_flags = (entry_info) & 0xF; /*4b*/
+            xwb->num_samples = (entry_info >> 4) & 0x0FFFFFFF; /*28b*/
         }
-        xwb.format          = (uint32_t)read_32bit(offset+0x04, streamFile);
-        xwb.stream_offset   = xwb.data_offset + (uint32_t)read_32bit(offset+0x08, streamFile);
-        xwb.stream_size     = (uint32_t)read_32bit(offset+0x0c, streamFile);
+        xwb->format          = (uint32_t)read_32bit(offset+0x04, streamFile);
+        xwb->stream_offset   = xwb->data_offset + (uint32_t)read_32bit(offset+0x08, streamFile);
+        xwb->stream_size     = (uint32_t)read_32bit(offset+0x0c, streamFile);
 
-        if (xwb.version <= XACT2_1_MAX) { /* LoopRegion (bytes) */
-            xwb.loop_start  = (uint32_t)read_32bit(offset+0x10, streamFile);
-            xwb.loop_end    = (uint32_t)read_32bit(offset+0x14, streamFile);//length (LoopRegion) or offset (XMALoopRegion in late XACT2)
+        if (xwb->version <= XACT2_1_MAX) { /* LoopRegion (bytes) */
+            xwb->loop_start  = (uint32_t)read_32bit(offset+0x10, streamFile);
+            xwb->loop_end    = (uint32_t)read_32bit(offset+0x14, streamFile);//length (LoopRegion) or offset (XMALoopRegion in late XACT2)
         } else { /* LoopRegion (samples) */
-            xwb.loop_start_sample   = (uint32_t)read_32bit(offset+0x10, streamFile);
-            xwb.loop_end_sample     = (uint32_t)read_32bit(offset+0x14, streamFile) + xwb.loop_start_sample;
+            xwb->loop_start_sample   = (uint32_t)read_32bit(offset+0x10, streamFile);
+            xwb->loop_end_sample     = (uint32_t)read_32bit(offset+0x14, streamFile) + xwb->loop_start_sample;
         }
     }
 
 
     /* parse format */
-    if (xwb.version <= XACT1_0_MAX) {
-        xwb.bits_per_sample = (xwb.format >> 31) & 0x1; /*1b*/
-        xwb.sample_rate     = (xwb.format >> 4) & 0x7FFFFFF; /*27b*/
-        xwb.channels        = (xwb.format >> 1) & 0x7; /*3b*/
-        xwb.tag             = (xwb.format) & 0x1; /*1b*/
+    if (xwb->version <= XACT1_0_MAX) {
+        xwb->bits_per_sample = (xwb->format >> 31) & 0x1; /*1b*/
+        xwb->sample_rate     = (xwb->format >> 4) & 0x7FFFFFF; /*27b*/
+        xwb->channels        = (xwb->format >> 1) & 0x7; /*3b*/
+        xwb->tag             = (xwb->format) & 0x1; /*1b*/
     }
-    else if (xwb.version <= XACT1_1_MAX) {
-        xwb.bits_per_sample = (xwb.format >> 31) & 0x1; /*1b*/
-        xwb.sample_rate     = (xwb.format >> 5) & 0x3FFFFFF; /*26b*/
-        xwb.channels        = (xwb.format >> 2) & 0x7; /*3b*/
-        xwb.tag             = (xwb.format) & 0x3; /*2b*/
+    else if (xwb->version <= XACT1_1_MAX) {
+        xwb->bits_per_sample = (xwb->format >> 31) & 0x1; /*1b*/
+        xwb->sample_rate     = (xwb->format >> 5) & 0x3FFFFFF; /*26b*/
+        xwb->channels        = (xwb->format >> 2) & 0x7; /*3b*/
+        xwb->tag             = (xwb->format) & 0x3; /*2b*/
     }
-    else if (xwb.version <= XACT2_0_MAX) {
-        xwb.bits_per_sample = (xwb.format >> 31) & 0x1; /*1b*/
-        xwb.block_align     = (xwb.format >> 24) & 0xFF; /*8b*/
-        xwb.sample_rate     = (xwb.format >> 4) & 0x7FFFF; /*19b*/
-        xwb.channels        = (xwb.format >> 1) & 0x7; /*3b*/
-        xwb.tag             = (xwb.format) & 0x1; /*1b*/
+    else if (xwb->version <= XACT2_0_MAX) {
+        xwb->bits_per_sample = (xwb->format >> 31) & 0x1; /*1b*/
+        xwb->block_align     = (xwb->format >> 24) & 0xFF; /*8b*/
+        xwb->sample_rate     = (xwb->format >> 4) & 0x7FFFF; /*19b*/
+        xwb->channels        = (xwb->format >> 1) & 0x7; /*3b*/
+        xwb->tag             = (xwb->format) & 0x1; /*1b*/
     }
     else {
-        xwb.bits_per_sample = (xwb.format >> 31) & 0x1; /*1b*/
-        xwb.block_align     = (xwb.format >> 23) & 0xFF; /*8b*/
-        xwb.sample_rate     = (xwb.format >> 5) & 0x3FFFF; /*18b*/
-        xwb.channels        = (xwb.format >> 2) & 0x7; /*3b*/
-        xwb.tag             = (xwb.format) & 0x3; /*2b*/
+        xwb->bits_per_sample = (xwb->format >> 31) & 0x1; /*1b*/
+        xwb->block_align     = (xwb->format >> 23) & 0xFF; /*8b*/
+        xwb->sample_rate     = (xwb->format >> 5) & 0x3FFFF; /*18b*/
+        xwb->channels        = (xwb->format >> 2) & 0x7; /*3b*/
+        xwb->tag             = (xwb->format) & 0x3; /*2b*/
     }
 
     /* standardize tag to codec */
-    if (xwb.version <= XACT1_0_MAX) {
-        switch(xwb.tag){
-            case 0: xwb.codec = PCM; break;
-            case 1: xwb.codec = XBOX_ADPCM; break;
+    if (xwb->version <= XACT1_0_MAX) {
+        switch(xwb->tag){
+            case 0: xwb->codec = PCM; break;
+            case 1: xwb->codec = XBOX_ADPCM; break;
             default: goto fail;
         }
     }
-    else if (xwb.version <= XACT1_1_MAX) {
-        switch(xwb.tag){
-            case 0: xwb.codec = PCM; break;
-            case 1: xwb.codec = XBOX_ADPCM; break;
-            case 2: xwb.codec = WMA; break;
-            case 3: xwb.codec = OGG; break; /* extension */
+    else if (xwb->version <= XACT1_1_MAX) {
+        switch(xwb->tag){
+            case 0: xwb->codec = PCM; break;
+            case 1: xwb->codec = XBOX_ADPCM; break;
+            case 2: xwb->codec = WMA; break;
+            case 3: xwb->codec = OGG; break; /* extension */
             default: goto fail;
         }
     }
-    else if (xwb.version <= XACT2_2_MAX) {
-        switch(xwb.tag) {
-            case 0: xwb.codec = PCM; break;
+    else if (xwb->version <= XACT2_2_MAX) {
+        switch(xwb->tag) {
+            case 0: xwb->codec = PCM; break;
             /* Table Tennis (v34): XMA1, Prey (v38): XMA2, v35/36/37: ? */
-            case 1: xwb.codec = xwb.version <= XACT2_0_MAX ? XMA1 : XMA2; break;
-            case 2: xwb.codec = MS_ADPCM; break;
+            case 1: xwb->codec = xwb->version <= XACT2_0_MAX ? XMA1 : XMA2; break;
+            case 2: xwb->codec = MS_ADPCM; break;
             default: goto fail;
         }
     }
     else {
-        switch(xwb.tag) {
-            case 0: xwb.codec = PCM; break;
-            case 1: xwb.codec = XMA2; break;
-            case 2: xwb.codec = MS_ADPCM; break;
-            case 3: xwb.codec = XWMA; break;
+        switch(xwb->tag) {
+            case 0: xwb->codec = PCM; break;
+            case 1: xwb->codec = XMA2; break;
+            case 2: xwb->codec = MS_ADPCM; break;
+            case 3: xwb->codec = XWMA; break;
             default: goto fail;
         }
     }
 
 
     /* format hijacks from creative devs, using non-official codecs */
-    if (xwb.version == XACT_TECHLAND && xwb.codec == XMA2 /* XACT_TECHLAND used in their X360 games too */
-            && (xwb.block_align == 0x60 || xwb.block_align == 0x98 || xwb.block_align == 0xc0) ) { /* standard ATRAC3 blocks sizes */
+    if (xwb->version == XACT_TECHLAND && xwb->codec == XMA2 /* XACT_TECHLAND used in their X360 games too */
+            && (xwb->block_align == 0x60 || xwb->block_align == 0x98 || xwb->block_align == 0xc0) ) { /* standard ATRAC3 blocks sizes */
         /* Techland ATRAC3 [Nail'd (PS3), Sniper: Ghost Warrior (PS3)] */
-        xwb.codec = ATRAC3;
+        xwb->codec = ATRAC3;
 
         /* num samples uses a modified entry_info format (maybe skip samples + samples? sfx use the standard format)
          * ignore for now and just calc max samples */
-        xwb.num_samples = atrac3_bytes_to_samples(xwb.stream_size, xwb.block_align * xwb.channels);
+        xwb->num_samples = atrac3_bytes_to_samples(xwb->stream_size, xwb->block_align * xwb->channels);
     }
-    else if (xwb.codec == OGG) {
+    else if (xwb->codec == OGG) {
         /* Oddworld: Stranger's Wrath (iOS/Android) */
-        xwb.num_samples = xwb.stream_size / (2 * xwb.channels); /* uncompressed bytes */
-        xwb.stream_size = xwb.loop_end;
-        xwb.loop_start = 0;
-        xwb.loop_end = 0;
+        xwb->num_samples = xwb->stream_size / (2 * xwb->channels); /* uncompressed bytes */
+        xwb->stream_size = xwb->loop_end;
+        xwb->loop_start = 0;
+        xwb->loop_end = 0;
     }
-    else if (xwb.version == XACT3_0_MAX && xwb.codec == XMA2
-            && xwb.bits_per_sample == 0x01 && xwb.block_align == 0x04
-            && xwb.data_size == 0x55951c1c) { /* some kind of id? */
+    else if (xwb->version == XACT3_0_MAX && xwb->codec == XMA2
+            && xwb->bits_per_sample == 0x01 && xwb->block_align == 0x04
+            && xwb->data_size == 0x55951c1c) { /* some kind of id? */
         /* Stardew Valley (Switch), full interleaved DSPs (including headers) */
-        xwb.codec = DSP;
+        xwb->codec = DSP;
     }
-    else if (xwb.version == XACT3_0_MAX && xwb.codec == XMA2
-            && xwb.bits_per_sample == 0x01 && xwb.block_align == 0x04
-            && xwb.data_size == 0x4e0a1000) { /* some kind of id? */
+    else if (xwb->version == XACT3_0_MAX && xwb->codec == XMA2
+            && xwb->bits_per_sample == 0x01 && xwb->block_align == 0x04
+            && xwb->data_size == 0x4e0a1000) { /* some kind of id? */
         /* Stardew Valley (Vita), standard RIFF with ATRAC9 */
-        xwb.codec = ATRAC9_RIFF;
+        xwb->codec = ATRAC9_RIFF;
     }
 
 
     /* test loop after the above fixes */
-    xwb.loop_flag = (xwb.loop_end > 0 || xwb.loop_end_sample > xwb.loop_start)
-        && !(xwb.entry_flags & WAVEBANKENTRY_FLAGS_IGNORELOOP);
+    xwb->loop_flag = (xwb->loop_end > 0 || xwb->loop_end_sample > xwb->loop_start)
+        && !(xwb->entry_flags & WAVEBANKENTRY_FLAGS_IGNORELOOP);
 
     /* Oddworld OGG the data_size value is size of uncompressed bytes instead;  DSP uses some id/config as value */
-    if (xwb.codec != OGG && xwb.codec != DSP && xwb.codec != ATRAC9_RIFF) {
+    if (xwb->codec != OGG && xwb->codec != DSP && xwb->codec != ATRAC9_RIFF) {
         /* some low-q rips don't remove padding, relax validation a bit */
-        if (xwb.data_offset + xwb.data_size > get_streamfile_size(streamFile))
+        if (xwb->data_offset + xwb->data_size > get_streamfile_size(streamFile))
             goto fail;
     }
 
 
     /* fix samples */
-    if (xwb.version <= XACT2_2_MAX && xwb.codec == PCM) {
-        int bits_per_sample = xwb.bits_per_sample == 0 ? 8 : 16;
-        xwb.num_samples = pcm_bytes_to_samples(xwb.stream_size, xwb.channels, bits_per_sample);
-        if (xwb.loop_flag) {
-            xwb.loop_start_sample = pcm_bytes_to_samples(xwb.loop_start, xwb.channels, bits_per_sample);
-            xwb.loop_end_sample   = pcm_bytes_to_samples(xwb.loop_start + xwb.loop_end, xwb.channels, bits_per_sample);
+    if (xwb->version <= XACT2_2_MAX && xwb->codec == PCM) {
+        int bits_per_sample = xwb->bits_per_sample == 0 ? 8 : 16;
+        xwb->num_samples = pcm_bytes_to_samples(xwb->stream_size, xwb->channels, bits_per_sample);
+        if (xwb->loop_flag) {
+            xwb->loop_start_sample = pcm_bytes_to_samples(xwb->loop_start, xwb->channels, bits_per_sample);
+            xwb->loop_end_sample   = pcm_bytes_to_samples(xwb->loop_start + xwb->loop_end, xwb->channels, bits_per_sample);
         }
     }
-    else if (xwb.version <= XACT1_1_MAX && xwb.codec == XBOX_ADPCM) {
-        xwb.block_align = 0x24 * xwb.channels; /* not really needed... */
-        xwb.num_samples = xbox_ima_bytes_to_samples(xwb.stream_size, xwb.channels);
-        if (xwb.loop_flag) {
-            xwb.loop_start_sample = xbox_ima_bytes_to_samples(xwb.loop_start, xwb.channels);
-            xwb.loop_end_sample   = xbox_ima_bytes_to_samples(xwb.loop_start + xwb.loop_end, xwb.channels);
+    else if (xwb->version <= XACT1_1_MAX && xwb->codec == XBOX_ADPCM) {
+        xwb->block_align = 0x24 * xwb->channels; /* not really needed... */
+        xwb->num_samples = xbox_ima_bytes_to_samples(xwb->stream_size, xwb->channels);
+        if (xwb->loop_flag) {
+            xwb->loop_start_sample = xbox_ima_bytes_to_samples(xwb->loop_start, xwb->channels);
+            xwb->loop_end_sample   = xbox_ima_bytes_to_samples(xwb->loop_start + xwb->loop_end, xwb->channels);
         }
     }
-    else if (xwb.version <= XACT2_2_MAX && xwb.codec == MS_ADPCM && xwb.loop_flag) {
-        int block_size = (xwb.block_align + 22) * xwb.channels; /*22=CONVERSION_OFFSET (?)*/
+    else if (xwb->version <= XACT2_2_MAX && xwb->codec == MS_ADPCM && xwb->loop_flag) {
+        int block_size = (xwb->block_align + 22) * xwb->channels; /*22=CONVERSION_OFFSET (?)*/
 
-        xwb.loop_start_sample = msadpcm_bytes_to_samples(xwb.loop_start, block_size, xwb.channels);
-        xwb.loop_end_sample   = msadpcm_bytes_to_samples(xwb.loop_start + xwb.loop_end, block_size, xwb.channels);
+        xwb->loop_start_sample = msadpcm_bytes_to_samples(xwb->loop_start, block_size, xwb->channels);
+        xwb->loop_end_sample   = msadpcm_bytes_to_samples(xwb->loop_start + xwb->loop_end, block_size, xwb->channels);
     }
-    else if (xwb.version <= XACT2_1_MAX && (xwb.codec == XMA1 || xwb.codec == XMA2) && xwb.loop_flag) {
+    else if (xwb->version <= XACT2_1_MAX && (xwb->codec == XMA1 || xwb->codec == XMA2) && xwb->loop_flag) {
         /* v38: byte offset, v40+: sample offset, v39: ? */
         /* need to manually find sample offsets, thanks to Microsoft's dumb headers */
         ms_sample_data msd = {0};
 
-        msd.xma_version = xwb.codec == XMA1 ? 1 : 2;
-        msd.channels    = xwb.channels;
-        msd.data_offset = xwb.stream_offset;
-        msd.data_size   = xwb.stream_size;
-        msd.loop_flag   = xwb.loop_flag;
-        msd.loop_start_b = xwb.loop_start; /* bit offset in the stream */
-        msd.loop_end_b   = (xwb.loop_end >> 4); /*28b */
+        msd.xma_version = xwb->codec == XMA1 ? 1 : 2;
+        msd.channels    = xwb->channels;
+        msd.data_offset = xwb->stream_offset;
+        msd.data_size   = xwb->stream_size;
+        msd.loop_flag   = xwb->loop_flag;
+        msd.loop_start_b = xwb->loop_start; /* bit offset in the stream */
+        msd.loop_end_b   = (xwb->loop_end >> 4); /*28b */
         /* XACT adds +1 to the subframe, but this means 0 can't be used? */
-        msd.loop_end_subframe    = ((xwb.loop_end >> 2) & 0x3) + 1; /* 2b */
-        msd.loop_start_subframe  = ((xwb.loop_end >> 0) & 0x3) + 1; /* 2b */
+        msd.loop_end_subframe    = ((xwb->loop_end >> 2) & 0x3) + 1; /* 2b */
+        msd.loop_start_subframe  = ((xwb->loop_end >> 0) & 0x3) + 1; /* 2b */
 
         xma_get_samples(&msd, streamFile);
-        xwb.loop_start_sample = msd.loop_start_sample;
-        xwb.loop_end_sample   = msd.loop_end_sample;
+        xwb->loop_start_sample = msd.loop_start_sample;
+        xwb->loop_end_sample   = msd.loop_end_sample;
 
-        /* if provided, xwb.num_samples is equal to msd.num_samples after proper adjustments (+ 128 - start_skip - end_skip) */
-        xwb.fix_xma_loop_samples = 1;
-        xwb.fix_xma_num_samples = 0;
+        /* if provided, xwb->num_samples is equal to msd.num_samples after proper adjustments (+ 128 - start_skip - end_skip) */
+        xwb->fix_xma_loop_samples = 1;
+        xwb->fix_xma_num_samples = 0;
 
         /* for XWB v22 (and below?) this seems normal [Project Gotham Racing (X360)] */
-        if (xwb.num_samples == 0) {
-            xwb.num_samples   = msd.num_samples;
-            xwb.fix_xma_num_samples = 1;
+        if (xwb->num_samples == 0) {
+            xwb->num_samples   = msd.num_samples;
+            xwb->fix_xma_num_samples = 1;
         }
     }
-    else if ((xwb.codec == XMA1 || xwb.codec == XMA2) &&  xwb.loop_flag) {
-        /* unlike prev versions, xwb.num_samples is the full size without adjustments */
-        xwb.fix_xma_loop_samples = 1;
-        xwb.fix_xma_num_samples = 1;
-
-        /* Crackdown does use xwb.num_samples after adjustments (but not loops) */
-        if (xwb.is_crackdown) {
-            xwb.fix_xma_num_samples = 0;
+    else if ((xwb->codec == XMA1 || xwb->codec == XMA2) &&  xwb->loop_flag) {
+        /* unlike prev versions, xwb->num_samples is the full size without adjustments */
+        xwb->fix_xma_loop_samples = 1;
+        xwb->fix_xma_num_samples = 1;
+
+        /* Crackdown does use xwb->num_samples after adjustments (but not loops) */
+        if (xwb->is_crackdown) {
+            xwb->fix_xma_num_samples = 0;
         }
     }
 
+    return 1;
+fail:
+    return 0;
+}
+
+static VGMSTREAM * init_vgmstream_xwb_header(STREAMFILE *streamFile, void * header) {
+    VGMSTREAM * vgmstream = NULL;
+    xwb_header * xwb = header;
+    off_t start_offset;
+
 
     /* build the VGMSTREAM */
-    vgmstream = allocate_vgmstream(xwb.channels,xwb.loop_flag);
+    vgmstream = allocate_vgmstream(xwb->channels,xwb->loop_flag);
     if (!vgmstream) goto fail;
 
-    vgmstream->sample_rate = xwb.sample_rate;
-    vgmstream->num_samples = xwb.num_samples;
-    vgmstream->loop_start_sample = xwb.loop_start_sample;
-    vgmstream->loop_end_sample   = xwb.loop_end_sample;
-    vgmstream->num_streams = xwb.total_subsongs;
-    vgmstream->stream_size = xwb.stream_size;
+    vgmstream->sample_rate = xwb->sample_rate;
+    vgmstream->num_samples = xwb->num_samples;
+    vgmstream->loop_start_sample = xwb->loop_start_sample;
+    vgmstream->loop_end_sample   = xwb->loop_end_sample;
+    vgmstream->num_streams = xwb->total_subsongs;
+    vgmstream->stream_size = xwb->stream_size;
     vgmstream->meta_type = meta_XWB;
-    get_name(vgmstream->stream_name,STREAM_NAME_SIZE, target_subsong, &xwb, streamFile);
+    strcpy(vgmstream->stream_name, xwb->stream_name);
 
-    switch(xwb.codec) {
+    switch(xwb->codec) {
         case PCM: /* Unreal Championship (Xbox)[PCM8], KOF2003 (Xbox)[PCM16LE], Otomedius (X360)[PCM16BE] */
-            vgmstream->coding_type = xwb.bits_per_sample == 0 ? coding_PCM8_U :
-                    (xwb.little_endian ? coding_PCM16LE : coding_PCM16BE);
-            vgmstream->layout_type = xwb.channels > 1 ? layout_interleave : layout_none;
-            vgmstream->interleave_block_size = xwb.bits_per_sample == 0 ? 0x01 : 0x02;
+            vgmstream->coding_type = xwb->bits_per_sample == 0 ? coding_PCM8_U :
+                    (xwb->little_endian ? coding_PCM16LE : coding_PCM16BE);
+            vgmstream->layout_type = xwb->channels > 1 ? layout_interleave : layout_none;
+            vgmstream->interleave_block_size = xwb->bits_per_sample == 0 ? 0x01 : 0x02;
             break;
 
         case XBOX_ADPCM: /* Silent Hill 4 (Xbox) */
@@ -444,7 +545,7 @@ VGMSTREAM * init_vgmstream_xwb(STREAMFILE *streamFile) {
         case MS_ADPCM: /* Persona 4 Ultimax (AC) */
             vgmstream->coding_type = coding_MSADPCM;
             vgmstream->layout_type = layout_none;
-            vgmstream->interleave_block_size = (xwb.block_align + 22) * xwb.channels; /*22=CONVERSION_OFFSET (?)*/
+            vgmstream->interleave_block_size = (xwb->block_align + 22) * xwb->channels; /*22=CONVERSION_OFFSET (?)*/
             break;
 
 #ifdef VGM_USE_FFMPEG
@@ -452,13 +553,13 @@ VGMSTREAM * init_vgmstream_xwb(STREAMFILE *streamFile) {
             uint8_t buf[0x100];
             int bytes;
 
-            bytes = ffmpeg_make_riff_xma1(buf,0x100, vgmstream->num_samples, xwb.stream_size, vgmstream->channels, vgmstream->sample_rate, 0);
-            vgmstream->codec_data = init_ffmpeg_header_offset(streamFile, buf,bytes, xwb.stream_offset,xwb.stream_size);
+            bytes = ffmpeg_make_riff_xma1(buf,0x100, vgmstream->num_samples, xwb->stream_size, vgmstream->channels, vgmstream->sample_rate, 0);
+            vgmstream->codec_data = init_ffmpeg_header_offset(streamFile, buf,bytes, xwb->stream_offset,xwb->stream_size);
             if (!vgmstream->codec_data) goto fail;
             vgmstream->coding_type = coding_FFmpeg;
             vgmstream->layout_type = layout_none;
 
-            xma_fix_raw_samples(vgmstream, streamFile, xwb.stream_offset,xwb.stream_size, 0, xwb.fix_xma_num_samples,xwb.fix_xma_loop_samples);
+            xma_fix_raw_samples(vgmstream, streamFile, xwb->stream_offset,xwb->stream_size, 0, xwb->fix_xma_num_samples,xwb->fix_xma_loop_samples);
 
             /* this fixes some XMA1, perhaps the above isn't reading end_skip correctly (doesn't happen for all files though) */
             if (vgmstream->loop_flag &&
@@ -474,22 +575,22 @@ VGMSTREAM * init_vgmstream_xwb(STREAMFILE *streamFile) {
             int bytes, block_size, block_count;
 
             block_size = 0x10000; /* XACT default */
-            block_count = xwb.stream_size / block_size + (xwb.stream_size % block_size ? 1 : 0);
+            block_count = xwb->stream_size / block_size + (xwb->stream_size % block_size ? 1 : 0);
 
-            bytes = ffmpeg_make_riff_xma2(buf,0x100, vgmstream->num_samples, xwb.stream_size, vgmstream->channels, vgmstream->sample_rate, block_count, block_size);
-            vgmstream->codec_data = init_ffmpeg_header_offset(streamFile, buf,bytes, xwb.stream_offset,xwb.stream_size);
+            bytes = ffmpeg_make_riff_xma2(buf,0x100, vgmstream->num_samples, xwb->stream_size, vgmstream->channels, vgmstream->sample_rate, block_count, block_size);
+            vgmstream->codec_data = init_ffmpeg_header_offset(streamFile, buf,bytes, xwb->stream_offset,xwb->stream_size);
             if (!vgmstream->codec_data) goto fail;
             vgmstream->coding_type = coding_FFmpeg;
             vgmstream->layout_type = layout_none;
 
-            xma_fix_raw_samples(vgmstream, streamFile, xwb.stream_offset,xwb.stream_size, 0, xwb.fix_xma_num_samples,xwb.fix_xma_loop_samples);
+            xma_fix_raw_samples(vgmstream, streamFile, xwb->stream_offset,xwb->stream_size, 0, xwb->fix_xma_num_samples,xwb->fix_xma_loop_samples);
             break;
         }
 
         case WMA: { /* WMAudio1 (WMA v2): Prince of Persia 2 port (Xbox) */
             ffmpeg_codec_data *ffmpeg_data = NULL;
 
-            ffmpeg_data = init_ffmpeg_offset(streamFile, xwb.stream_offset,xwb.stream_size);
+            ffmpeg_data = init_ffmpeg_offset(streamFile, xwb->stream_offset,xwb->stream_size);
             if ( !ffmpeg_data ) goto fail;
             vgmstream->codec_data = ffmpeg_data;
             vgmstream->coding_type = coding_FFmpeg;
@@ -505,17 +606,17 @@ VGMSTREAM * init_vgmstream_xwb(STREAMFILE *streamFile) {
             uint8_t buf[0x100];
             int bytes, bps_index, block_align, block_index, avg_bps, wma_codec;
 
-            bps_index = (xwb.block_align >> 5);  /* upper 3b bytes-per-second index (docs say 2b+6b but are wrong) */
-            block_index =  (xwb.block_align) & 0x1F; /*lower 5b block alignment index */
+            bps_index = (xwb->block_align >> 5);  /* upper 3b bytes-per-second index (docs say 2b+6b but are wrong) */
+            block_index =  (xwb->block_align) & 0x1F; /*lower 5b block alignment index */
             if (bps_index >= 7) goto fail;
             if (block_index >= 17) goto fail;
 
             avg_bps = wma_avg_bps_index[bps_index];
             block_align = wma_block_align_index[block_index];
-            wma_codec = xwb.bits_per_sample ? 0x162 : 0x161; /* 0=WMAudio2, 1=WMAudio3 */
+            wma_codec = xwb->bits_per_sample ? 0x162 : 0x161; /* 0=WMAudio2, 1=WMAudio3 */
 
-            bytes = ffmpeg_make_riff_xwma(buf,0x100, wma_codec, xwb.stream_size, vgmstream->channels, vgmstream->sample_rate, avg_bps, block_align);
-            vgmstream->codec_data = init_ffmpeg_header_offset(streamFile, buf,bytes, xwb.stream_offset,xwb.stream_size);
+            bytes = ffmpeg_make_riff_xwma(buf,0x100, wma_codec, xwb->stream_size, vgmstream->channels, vgmstream->sample_rate, avg_bps, block_align);
+            vgmstream->codec_data = init_ffmpeg_header_offset(streamFile, buf,bytes, xwb->stream_offset,xwb->stream_size);
             if (!vgmstream->codec_data) goto fail;
             vgmstream->coding_type = coding_FFmpeg;
             vgmstream->layout_type = layout_none;
@@ -526,12 +627,12 @@ VGMSTREAM * init_vgmstream_xwb(STREAMFILE *streamFile) {
             uint8_t buf[0x100];
             int bytes;
 
-            int block_size = xwb.block_align * vgmstream->channels;
-            int joint_stereo = xwb.block_align == 0x60; /* untested, ATRAC3 default */
+            int block_size = xwb->block_align * vgmstream->channels;
+            int joint_stereo = xwb->block_align == 0x60; /* untested, ATRAC3 default */
             int skip_samples = 0; /* unknown */
 
-            bytes = ffmpeg_make_riff_atrac3(buf,0x100, vgmstream->num_samples, xwb.stream_size, vgmstream->channels, vgmstream->sample_rate, block_size, joint_stereo, skip_samples);
-            vgmstream->codec_data = init_ffmpeg_header_offset(streamFile, buf,bytes, xwb.stream_offset,xwb.stream_size);
+            bytes = ffmpeg_make_riff_atrac3(buf,0x100, vgmstream->num_samples, xwb->stream_size, vgmstream->channels, vgmstream->sample_rate, block_size, joint_stereo, skip_samples);
+            vgmstream->codec_data = init_ffmpeg_header_offset(streamFile, buf,bytes, xwb->stream_offset,xwb->stream_size);
             if ( !vgmstream->codec_data ) goto fail;
             vgmstream->coding_type = coding_FFmpeg;
             vgmstream->layout_type = layout_none;
@@ -539,7 +640,7 @@ VGMSTREAM * init_vgmstream_xwb(STREAMFILE *streamFile) {
         }
 
         case OGG: { /* Oddworld: Strangers Wrath (iOS/Android) extension */
-            vgmstream->codec_data = init_ffmpeg_offset(streamFile, xwb.stream_offset, xwb.stream_size);
+            vgmstream->codec_data = init_ffmpeg_offset(streamFile, xwb->stream_offset, xwb->stream_size);
             if ( !vgmstream->codec_data ) goto fail;
             vgmstream->coding_type = coding_FFmpeg;
             vgmstream->layout_type = layout_none;
@@ -550,11 +651,11 @@ VGMSTREAM * init_vgmstream_xwb(STREAMFILE *streamFile) {
         case DSP: { /* Stardew Valley (Switch) extension */
             vgmstream->coding_type = coding_NGC_DSP;
             vgmstream->layout_type = layout_interleave;
-            vgmstream->interleave_block_size = xwb.stream_size / xwb.channels;
+            vgmstream->interleave_block_size = xwb->stream_size / xwb->channels;
 
-            dsp_read_coefs(vgmstream,streamFile,xwb.stream_offset + 0x1c,vgmstream->interleave_block_size,!xwb.little_endian);
-            dsp_read_hist (vgmstream,streamFile,xwb.stream_offset + 0x3c,vgmstream->interleave_block_size,!xwb.little_endian);
-            xwb.stream_offset += 0x60; /* skip DSP header */
+            dsp_read_coefs(vgmstream,streamFile,xwb->stream_offset + 0x1c,vgmstream->interleave_block_size,!xwb->little_endian);
+            dsp_read_hist (vgmstream,streamFile,xwb->stream_offset + 0x3c,vgmstream->interleave_block_size,!xwb->little_endian);
+            xwb->stream_offset += 0x60; /* skip DSP header */
             break;
         }
 
@@ -564,9 +665,9 @@ VGMSTREAM * init_vgmstream_xwb(STREAMFILE *streamFile) {
             STREAMFILE *temp_streamFile = NULL;
 
             /* standard RIFF, use subfile (seems doesn't use xwb loops) */
-            VGM_ASSERT(xwb.loop_flag, "XWB: RIFF ATRAC9 loop flag found\n");
+            VGM_ASSERT(xwb->loop_flag, "XWB: RIFF ATRAC9 loop flag found\n");
 
-            temp_streamFile = setup_subfile_streamfile(streamFile, xwb.stream_offset,xwb.stream_size, "at9");
+            temp_streamFile = setup_subfile_streamfile(streamFile, xwb->stream_offset,xwb->stream_size, "at9");
             if (!temp_streamFile) goto fail;
 
             temp_vgmstream = init_vgmstream_riff(temp_streamFile);
@@ -588,7 +689,7 @@ VGMSTREAM * init_vgmstream_xwb(STREAMFILE *streamFile) {
     }
 
 
-    start_offset = xwb.stream_offset;
+    start_offset = xwb->stream_offset;
 
     if ( !vgmstream_open_stream(vgmstream,streamFile,start_offset) )
         goto fail;
@@ -639,6 +740,34 @@ fail:
     return 0;
 }
 
+/* name offsets for all streams (-1 if not found), in a single .xsb parse */
+static off_t * get_xsb_names(xwb_header * xwb, STREAMFILE *streamFile) {
+    xsb_header xsb = {0};
+    int i;
+
+    xsb.stream_names_count = xwb->total_subsongs;
+    xsb.stream_names = malloc(xsb.stream_names_count * sizeof(off_t));
+    if (!xsb.stream_names) goto fail;
+    for (i = 0; i < xsb.stream_names_count; i++) {
+        xsb.stream_names[i] = -1;
+    }
+
+    xsb.selected_stream = -1;
+    if (!parse_xsb(&xsb, streamFile, xwb->wavebank_name))
+        goto fail;
+
+    if ((xwb->version <= XACT1_1_MAX && xsb.version > XSB_XACT1_2_MAX) ||
+        (xwb->version <= XACT2_2_MAX && xsb.version > XSB_XACT2_MAX)) {
+        VGM_LOG("XSB: mismatched XACT versions: xsb v%i vs xwb v%i\n", xsb.version, xwb->version);
+        goto fail;
+    }
+
+    return xsb.stream_names;
+fail:
+    free(xsb.stream_names);
+    return NULL;
+}
+
 static void get_name(char * buf, size_t maxsize, int target_subsong, xwb_header * xwb, STREAMFILE *streamXwb) {
     STREAMFILE *streamXsb = NULL;
     int name_found;
@@ -11,6 +11,8 @@ typedef struct {
     /* config */
     int selected_stream;
     int selected_wavebank;
+    off_t * stream_names;   /* if set, saves the first name found for every stream instead (-1 if not found) */
+    int stream_names_count;
 
     /* state */
     int big_endian;
@@ -41,6 +43,15 @@ static void xsb_check_stream(xsb_header * xsb, int stream_index, int wavebank_in
     if (xsb->parse_done)
         return;
 
+    /* same as finding each stream separately, but parsing once */
+    if (xsb->stream_names) {
+        if (stream_index >= 0 && stream_index < xsb->stream_names_count && xsb->stream_names[stream_index] == -1 &&
+                (xsb->selected_wavebank == wavebank_index || wavebank_index == -1 || wavebank_index == 255)) {
+            xsb->stream_names[stream_index] = name_offset;
+        }
+        return;
+    }
+
     /* multiple names may correspond to a stream, so commenting parse_done
      * will allow to search for other names instead of first only */
     if (xsb->selected_stream == stream_index &&
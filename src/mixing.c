@@ -14,7 +14,7 @@
  *
  * It works using two buffers:
  * - outbuf: plugin's pcm16 buffer, at least input_channels*sample_count
- * - mixbuf: internal's pcmfloat buffer, at least mixing_channels*sample_count
+ * - mixbuf: internal's pcmfloat buffer, at least mixing_channels*sample_count (planar)
  * outbuf starts with decoded samples of vgmstream->channel size. This unsures that
  * if no mixing is done (most common case) we can skip copying samples between buffers.
  * Resulting outbuf after mixing has samples for ->output_channels (plus garbage).
@@ -39,16 +39,18 @@
  * - copy mixbuf to outbuf
  * segmented/layered layouts handle mixing on their own.
  *
- * Mixing is tuned for most common case (no mix except fade-out at the end) and is
- * fast enough but not super-optimized yet, there is some penalty the more effects
- * are applied. Maybe could add extra sub-ops to avoid ifs and dumb values (volume=0.0
- * could simply use a clear op), only use mixbuf if necessary (swap can be done without
- * mixbuf if it goes first) or add function pointer indexes but isn't too important.
- * Operations are applied once per "step" with 1 sample from all channels to simplify code
- * (and maybe improve memory cache?), though maybe it should call one function per operation.
+ * Mixing is tuned for most common case (no mix except fade-out at the end). On setup the
+ * command chain is "compiled" into mixing steps: runs of channel moves (swap/upmix/downmix/
+ * killmix) are folded into a single remap, and each step is applied to the whole sample
+ * block before the next (simple loops the compiler can vectorize) rather than interpreting
+ * the chain per sample. Since every op only works within one sample 'lane' results are the
+ * same as applying all ops per sample. Mixbuf is split into one plane per channel during
+ * steps, so channel moves only need to reorder plane pointers.
  */
 
 #define VGMSTREAM_MAX_MIXING 128
+#define MIXING_FADE_BLOCK 256   /* samples per precomputed fade curve (max distance between points) */
+#define MIXING_FADE_POINTS 1024 /* curve points per fade */
 
 
 /* mixing info */
@@ -60,7 +62,8 @@ typedef enum {
     MIX_UPMIX,
     MIX_DOWNMIX,
     MIX_KILLMIX,
-    MIX_FADE
+    MIX_FADE,
+    MIX_REMAP   /* internal (compiled swap/upmix/downmix/killmix) */
 } mix_command_t;
 
 typedef struct {
@@ -80,6 +83,17 @@ typedef struct {
     int32_t time_post;  /* position after time_end where vol_end applies (-1 = end) */
 } mix_command_data;
 
+/* compiled mix, applied to a block of samples */
+typedef struct {
+    mix_command_t command;
+    int ch_dst;
+    int ch_src;
+    float vol;
+    int channels;           /* step channels after applying */
+    int8_t map[VGMSTREAM_MAX_CHANNELS]; /* remap: source channel per channel (-1 = silence) */
+    mix_command_data *mix;  /* fade info */
+} mix_step_data;
+
 typedef struct {
     int mixing_channels;    /* max channels needed to mix */
     int output_channels;    /* resulting channels after mixing */
@@ -88,6 +102,11 @@ typedef struct {
     size_t mixing_size;     /* mixing max */
     mix_command_data mixing_chain[VGMSTREAM_MAX_MIXING]; /* effects to apply (could be alloc'ed but to simplify...) */
     float* mixbuf;          /* internal mixing buffer */
+    int32_t mixbuf_samples; /* max samples per call the buffer can take */
+
+    int step_count;         /* compiled mixes */
+    int step_input_channels; /* channels when compiled */
+    mix_step_data mixing_steps[VGMSTREAM_MAX_MIXING];
 } mixing_data;
 
 
@@ -115,10 +134,11 @@ static int is_active(mixing_data *data, int32_t current_start, int32_t current_e
     return 0;
 }
 
-static int32_t get_current_pos(VGMSTREAM* vgmstream) {
+/* gets play position of the block to mix (vgmstream was already decoded past it) */
+static int32_t get_current_pos(VGMSTREAM* vgmstream, int32_t sample_count) {
     int32_t current_pos;
 
-    if (vgmstream->loop_flag && vgmstream->current_sample > vgmstream->loop_start_sample) {
+    if (vgmstream->loop_flag && vgmstream->current_sample >= vgmstream->loop_start_sample) {
         int loop_pre = vgmstream->loop_start_sample;
         int loop_into = vgmstream->current_sample - vgmstream->loop_start_sample;
         int loop_samples = vgmstream->loop_end_sample - vgmstream->loop_start_sample;
@@ -128,256 +148,513 @@ static int32_t get_current_pos(VGMSTREAM* vgmstream) {
         current_pos = vgmstream->current_sample;
     }
 
-    return current_pos;
+    return current_pos - sample_count;
 }
 
-static int get_fade_gain(mix_command_data *mix, float *out_cur_vol, int32_t current_subpos) {
-    //todo optimizations: interleave calcs, maybe use cosf, powf, etc?
-    float cur_vol = 0.0f;
-
-    if ((current_subpos >= mix->time_pre || mix->time_pre < 0) && current_subpos < mix->time_start) {
-        cur_vol = mix->vol_start; /* before */
-    }
-    else if (current_subpos >= mix->time_end && (current_subpos < mix->time_post || mix->time_post < 0)) {
-        cur_vol = mix->vol_end; /* after */
-    }
-    else if (current_subpos >= mix->time_start && current_subpos < mix->time_end) {
-        /* in between */
-        float range_vol, range_dur, range_idx, index, gain;
-
-        if (mix->vol_start < mix->vol_end) { /* fade in */
-            range_vol = mix->vol_end - mix->vol_start;
-            range_dur = mix->time_end - mix->time_start;
-            range_idx = current_subpos - mix->time_start;
-            index = range_idx / range_dur;
-        } else { /* fade out */
-            range_vol = mix->vol_end - mix->vol_start;
-            range_dur = mix->time_end - mix->time_start;
-            range_idx = mix->time_end - current_subpos;
-            index = range_idx / range_dur;
-        }
+/* gets volume in the middle of a fade (time_start <= current_subpos < time_end) */
+static float get_fade_ramp(mix_command_data *mix, int32_t current_subpos) {
+    float cur_vol;
+    float range_vol, range_dur, range_idx, index, gain;
+
+    if (mix->vol_start < mix->vol_end) { /* fade in */
+        range_vol = mix->vol_end - mix->vol_start;
+        range_dur = mix->time_end - mix->time_start;
+        range_idx = current_subpos - mix->time_start;
+        index = range_idx / range_dur;
+    } else { /* fade out */
+        range_vol = mix->vol_end - mix->vol_start;
+        range_dur = mix->time_end - mix->time_start;
+        range_idx = mix->time_end - current_subpos;
+        index = range_idx / range_dur;
+    }
 
-        /* Fading is done like this:
-         * - find current position within fade duration
-         * - get linear % (or rather, index from 0.0 .. 1.0) of duration
-         * - apply shape to % (from linear fade to curved fade)
-         * - get final volume for that point
-         *
-         * Roughly speaking some curve shapes are better for fades (decay rate is more natural
-         * sounding in that highest to mid/low happens faster but low to lowest takes more time,
-         * kinda like a gunshot or bell), and others for crossfades (decay of fade-in + fade-out
-         * is adjusted so that added volume level stays constant-ish).
-         *
-         * As curves can fade in two ways ('normal' and curving 'the other way'), they are adjusted
-         * to get 'normal' shape on both fades (by reversing index and making 1 - gain), thus some
-         * curves are complementary (exponential fade-in ~= logarithmic fade-out); the following
-         * are described taking fade-in = normal.
-         */
-
-        /* (curve math mostly from SoX/FFmpeg) */
-        switch(mix->shape) {
-            /* 2.5f in L/E 'pow' is the attenuation factor, where 5.0 (100db) is common but a bit fast
-             * (alt calculations with 'exp' from FFmpeg use (factor)*ln(0.1) = -NN.N...  */
-
-            case 'E': /* exponential (for fade-outs, closer to natural decay of sound) */
-                //gain = pow(0.1f, (1.0f - index) * 2.5f);
-                gain = exp(-5.75646273248511f * (1.0f - index));
-                break;
-            case 'L': /* logarithmic (inverse of the above, maybe for crossfades) */
-                //gain = 1 - pow(0.1f, (index) * 2.5f);
-                gain = 1 - exp(-5.75646273248511f * (index));
-                break;
+    /* Fading is done like this:
+     * - find current position within fade duration
+     * - get linear % (or rather, index from 0.0 .. 1.0) of duration
+     * - apply shape to % (from linear fade to curved fade)
+     * - get final volume for that point
+     *
+     * Roughly speaking some curve shapes are better for fades (decay rate is more natural
+     * sounding in that highest to mid/low happens faster but low to lowest takes more time,
+     * kinda like a gunshot or bell), and others for crossfades (decay of fade-in + fade-out
+     * is adjusted so that added volume level stays constant-ish).
+     *
+     * As curves can fade in two ways ('normal' and curving 'the other way'), they are adjusted
+     * to get 'normal' shape on both fades (by reversing index and making 1 - gain), thus some
+     * curves are complementary (exponential fade-in ~= logarithmic fade-out); the following
+     * are described taking fade-in = normal.
+     */
 
-            case 'H': /* raised sine wave or cosine wave (for more musical crossfades) */
-                gain = (1.0f - cos(index * M_PI )) / 2.0f;
-                break;
+    /* (curve math mostly from SoX/FFmpeg) */
+    switch(mix->shape) {
+        /* 2.5f in L/E 'pow' is the attenuation factor, where 5.0 (100db) is common but a bit fast
+         * (alt calculations with 'exp' from FFmpeg use (factor)*ln(0.1) = -NN.N...  */
+
+        case 'E': /* exponential (for fade-outs, closer to natural decay of sound) */
+            //gain = pow(0.1f, (1.0f - index) * 2.5f);
+            gain = exp(-5.75646273248511f * (1.0f - index));
+            break;
+        case 'L': /* logarithmic (inverse of the above, maybe for crossfades) */
+            //gain = 1 - pow(0.1f, (index) * 2.5f);
+            gain = 1 - exp(-5.75646273248511f * (index));
+            break;
+
+        case 'H': /* raised sine wave or cosine wave (for more musical crossfades) */
+            gain = (1.0f - cos(index * M_PI )) / 2.0f;
+            break;
+
+        case 'Q': /* quarter of sine wave (for musical fades) */
+            gain = sin(index * M_PI / 2.0f);
+            break;
+
+        case 'p': /* parabola (maybe for crossfades) */
+            gain =  1.0f - sqrt(1.0f - index);
+            break;
+        case 'P': /* inverted parabola (maybe for fades) */
+            gain = (1.0f - (1.0f - index) * (1.0f - index));
+            break;
+
+        case 'T': /* triangular/linear (simpler/sharper fades) */
+        default:
+            gain = index;
+            break;
+    }
 
-            case 'Q': /* quarter of sine wave (for musical fades) */
-                gain = sin(index * M_PI / 2.0f);
-                break;
+    if (mix->vol_start < mix->vol_end) {  /* fade in */
+        cur_vol = mix->vol_start + range_vol * gain;
+    } else { /* fade out */
+        cur_vol = mix->vol_end - range_vol * gain; //mix->vol_start - range_vol * (1 - gain);
+    }
 
-            case 'p': /* parabola (maybe for crossfades) */
-                gain =  1.0f - sqrt(1.0f - index);
-                break;
-            case 'P': /* inverted parabola (maybe for fades) */
-                gain = (1.0f - (1.0f - index) * (1.0f - index));
-                break;
+    return cur_vol;
+}
 
-            case 'T': /* triangular/linear (simpler/sharper fades) */
-            default:
-                gain = index;
-                break;
+/* Fills fade volumes for a block of samples starting at current_pos, or returns 0 if the block
+ * doesn't change volume. Slow curves are computed at fixed points (1/MIXING_FADE_POINTS of the
+ * fade, up to MIXING_FADE_BLOCK apart, plus fade end) and linearly interpolated in between
+ * (difference is minimal), to avoid calling pow/sin/etc per sample. Points don't depend on
+ * block sizes so output is the same however it's rendered.
+ * Positions outside the fade get 1.0, same as not applying it. */
+static int get_fade_gains(mix_command_data *mix, float *gains, int32_t current_pos, int32_t sample_count) {
+    int32_t i, j, s, n, point_size;
+    int is_active = 0, is_exact;
+
+    for (i = 0; i < sample_count; i += n) {
+        int32_t current_subpos = current_pos + i;
+        float cur_vol;
+
+        n = sample_count - i;
+
+        if ((current_subpos >= mix->time_pre || mix->time_pre < 0) && current_subpos < mix->time_start) {
+            /* before */
+            if (n > mix->time_start - current_subpos)
+                n = mix->time_start - current_subpos;
+            cur_vol = mix->vol_start;
+        }
+        else if (current_subpos >= mix->time_end && (current_subpos < mix->time_post || mix->time_post < 0)) {
+            /* after */
+            if (mix->time_post >= 0 && n > mix->time_post - current_subpos)
+                n = mix->time_post - current_subpos;
+            cur_vol = mix->vol_end;
         }
+        else if (current_subpos >= mix->time_start && current_subpos < mix->time_end) {
+            /* in between */
+            if (n > mix->time_end - current_subpos)
+                n = mix->time_end - current_subpos;
 
-        if (mix->vol_start < mix->vol_end) {  /* fade in */
-            cur_vol = mix->vol_start + range_vol * gain;
-        } else { /* fade out */
-            cur_vol = mix->vol_end - range_vol * gain; //mix->vol_start - range_vol * (1 - gain);
+            point_size = (mix->time_end - mix->time_start) / MIXING_FADE_POINTS;
+            if (point_size > MIXING_FADE_BLOCK)
+                point_size = MIXING_FADE_BLOCK;
+
+            /* parabola's start is too steep to interpolate */
+            is_exact = (mix->shape == 'p');
+
+            if (is_exact || point_size <= 1) {
+                for (s = 0; s < n; s++) {
+                    gains[i + s] = get_fade_ramp(mix, current_subpos + s);
+                }
+            }
+            else {
+                int32_t m;
+                for (s = 0; s < n; s += m) {
+                    int32_t pos = current_subpos + s;
+                    int32_t point_start = pos - (pos - mix->time_start) % point_size;
+                    int32_t point_end = point_start + point_size;
+                    float vol_start, vol_step;
+
+                    m = n - s;
+                    if (m > point_end - pos)
+                        m = point_end - pos;
+
+                    if (point_end > mix->time_end - 1)
+                        point_end = mix->time_end - 1;
+
+                    vol_start = get_fade_ramp(mix, point_start);
+                    vol_step = point_end > point_start ?
+                            (get_fade_ramp(mix, point_end) - vol_start) / (point_end - point_start) :
+                            0.0f;
+
+                    for (j = 0; j < m; j++) {
+                        gains[i + s + j] = vol_start + vol_step * (pos + j - point_start);
+                    }
+                }
+            }
+
+            is_active = 1;
+            continue;
+        }
+        else {
+            /* outside fade */
+            if (current_subpos < mix->time_pre && n > mix->time_pre - current_subpos)
+                n = mix->time_pre - current_subpos;
+            cur_vol = 1.0f;
+        }
+
+        if (cur_vol != 1.0f)
+            is_active = 1;
+        for (s = 0; s < n; s++) {
+            gains[i + s] = cur_vol;
         }
-    }
-    else {
-        goto fail;
     }
 
-    *out_cur_vol = cur_vol;
-    return 1;
-fail:
-    return 0;
+    return is_active;
 }
 
-void mix_vgmstream(sample_t *outbuf, int32_t sample_count, VGMSTREAM* vgmstream) {
-    mixing_data *data = vgmstream->mixing_data;
-    int ch, s, m, ok;
+/* Converts the mixing chain into steps (see mixing_setup). Mixing ops are designed to apply in order,
+ * all channels per 1 sample 'step'. Since some ops change total channels, channel number meaning
+ * varies as ops move them around, ex:
+ * - 4ch w/ "1-2,2+3" = ch1<>ch3, ch2(old ch1)+ch3 = 4ch: ch2 ch1+ch3 ch3 ch4
+ * - 4ch w/ "2+3,1-2" = ch2+ch3, ch1<>ch2(modified) = 4ch: ch2+ch3 ch1 ch3 ch4
+ * - 2ch w/ "1+2,1u" = ch1+ch2, ch1(add and push rest) = 3ch: ch1' ch1+ch2 ch2
+ * - 2ch w/ "1u,1+2" = ch1(add and push rest) = 3ch: ch1'+ch1 ch1 ch2
+ * - 2ch w/ "1-2,1d" = ch1<>ch2, ch1(drop and move ch2(old ch1) to ch1) = ch1
+ * - 2ch w/ "1d,1-2" = ch1(drop and pull rest), ch1(do nothing, ch2 doesn't exist now) = ch2
+ * Channel moves only change where each channel is read from, so they are tracked in a map and
+ * emitted as one remap before the next op that touches sample values. */
+static void compile_mixing(mixing_data *data, int input_channels) {
+    int m, ch, channels, map_channels, is_moved;
+    int8_t map[VGMSTREAM_MAX_CHANNELS];
+    int8_t temp_m;
+    mix_step_data *step;
+
+    data->step_count = 0;
+    data->step_input_channels = input_channels;
+
+    channels = input_channels;
+    map_channels = input_channels;
+    for (ch = 0; ch < channels; ch++) {
+        map[ch] = ch;
+    }
 
-    int32_t current_pos, current_subpos;
-    float temp_f, temp_min, temp_max, cur_vol;
-    float *temp_mixbuf;
-    sample_t *temp_outbuf;
+    for (m = 0; m <= data->mixing_count; m++) {
+        mix_command_data *mix = m < data->mixing_count ? &data->mixing_chain[m] : NULL;
 
-    const float limiter_max = 32767.0f;
-    const float limiter_min = -32768.0f;
+        if (mix) {
+            switch(mix->command) {
+                case MIX_SWAP:
+                    temp_m = map[mix->ch_dst];
+                    map[mix->ch_dst] = map[mix->ch_src];
+                    map[mix->ch_src] = temp_m;
+                    continue;
 
+                case MIX_UPMIX:
+                    channels += 1;
+                    for (ch = channels - 1; ch > mix->ch_dst; ch--) {
+                        map[ch] = map[ch-1];
+                    }
+                    map[mix->ch_dst] = -1; /* inserted as silent */
+                    continue;
 
-    /* no support or not need to apply */
-    if (!data || !data->mixing_on || data->mixing_count == 0)
-        return;
+                case MIX_DOWNMIX:
+                    channels -= 1;
+                    for (ch = mix->ch_dst; ch < channels; ch++) {
+                        map[ch] = map[ch+1];
+                    }
+                    continue;
 
-    /* try to skip if no ops apply (for example if fade set but does nothing yet) */
-    current_pos = get_current_pos(vgmstream);
-    if (!is_active(data, current_pos, current_pos + sample_count))
-        return;
+                case MIX_KILLMIX:
+                    channels = mix->ch_dst;
+                    continue;
 
+                default:
+                    break;
+            }
+        }
 
-    /* use advancing buffer pointers to simplify logic */
-    temp_mixbuf = data->mixbuf;
-    temp_outbuf = outbuf;
+        /* flush pending moves (dropping trailing channels doesn't need any) */
+        is_moved = 0;
+        for (ch = 0; ch < channels; ch++) {
+            if (map[ch] != ch)
+                is_moved = 1;
+        }
 
-    /* apply mixes in order per channel */
-    for (s = 0; s < sample_count; s++) {
-        /* reset after new sample 'step'*/
-        float *stpbuf = temp_mixbuf;
-        int step_channels = vgmstream->channels;
+        if (is_moved || channels > map_channels) {
+            step = &data->mixing_steps[data->step_count];
+            step->command = MIX_REMAP;
+            step->channels = channels;
+            memcpy(step->map, map, sizeof(map));
+            data->step_count++;
+        }
 
-        for (ch = 0; ch < step_channels; ch++) {
-            stpbuf[ch] = temp_outbuf[ch]; /* copy current 'lane' */
+        for (ch = 0; ch < channels; ch++) {
+            map[ch] = ch;
         }
+        map_channels = channels;
+
+        if (!mix)
+            break;
+
+        step = &data->mixing_steps[data->step_count];
+        step->command = mix->command;
+        step->ch_dst = mix->ch_dst;
+        step->ch_src = mix->ch_src;
+        step->vol = mix->vol;
+        step->channels = channels;
+        step->mix = mix;
+        data->step_count++;
+    }
+}
 
-        for (m = 0; m < data->mixing_count; m++) {
-            mix_command_data mix = data->mixing_chain[m];
+/* Applies all mixes to samples in buf (PCM16) or buf_f32 (float), writing back output_channels per sample.
+ * Limiter range is passed since float samples use -1.0..1.0 rather than PCM16 range. */
+static void mix_samples(mixing_data *data, sample_t *buf, float *buf_f32, int32_t sample_count,
+        int32_t current_pos, VGMSTREAM* vgmstream, float limiter_max, float limiter_min) {
+    int ch, m, ok;
+    int32_t s;
+    int input_channels = vgmstream->channels;
+    int channels;
+    float temp_min, temp_max;
+    float fade_gains[MIXING_FADE_BLOCK];
+    float *planes[VGMSTREAM_MAX_CHANNELS]; /* current plane for each channel */
+    float *temp_planes[VGMSTREAM_MAX_CHANNELS];
+
+
+    if (sample_count <= 0)
+        return;
 
-            /* mixing ops are designed to apply in order, all channels per 1 sample 'step'. Since some ops change
-             * total channels, channel number meaning varies as ops move them around, ex:
-             * - 4ch w/ "1-2,2+3" = ch1<>ch3, ch2(old ch1)+ch3 = 4ch: ch2 ch1+ch3 ch3 ch4
-             * - 4ch w/ "2+3,1-2" = ch2+ch3, ch1<>ch2(modified) = 4ch: ch2+ch3 ch1 ch3 ch4
-             * - 2ch w/ "1+2,1u" = ch1+ch2, ch1(add and push rest) = 3ch: ch1' ch1+ch2 ch2
-             * - 2ch w/ "1u,1+2" = ch1(add and push rest) = 3ch: ch1'+ch1 ch1 ch2
-             * - 2ch w/ "1-2,1d" = ch1<>ch2, ch1(drop and move ch2(old ch1) to ch1) = ch1
-             * - 2ch w/ "1d,1-2" = ch1(drop and pull rest), ch1(do nothing, ch2 doesn't exist now) = ch2
-             */
-            switch(mix.command) {
+    if (data->step_input_channels != input_channels)
+        compile_mixing(data, input_channels);
 
-                case MIX_SWAP:
-                    temp_f = stpbuf[mix.ch_dst];
-                    stpbuf[mix.ch_dst] = stpbuf[mix.ch_src];
-                    stpbuf[mix.ch_src] = temp_f;
-                    break;
+    /* a lone fade over all channels (like the usual end fade-out) has nothing to move around,
+     * so it's applied in place (same result as below), with gains spread per channel in mixbuf
+     * first so the multiply is a flat loop */
+    if (data->step_count == 1 && data->mixing_steps[0].command == MIX_FADE && data->mixing_steps[0].ch_dst < 0) {
+        float *gains = data->mixbuf;
 
-                case MIX_ADD:
-                    stpbuf[mix.ch_dst] = stpbuf[mix.ch_dst] + stpbuf[mix.ch_src] * mix.vol;
-                    break;
+        for (s = 0; s < sample_count; s += MIXING_FADE_BLOCK) {
+            int32_t i, j, block_count = MIXING_FADE_BLOCK;
+            if (block_count > sample_count - s)
+                block_count = sample_count - s;
 
-                case MIX_VOLUME:
-                    if (mix.ch_dst < 0) {
-                        for (ch = 0; ch < step_channels; ch++) {
-                            stpbuf[ch] = stpbuf[ch] * mix.vol;
-                        }
-                    }
-                    else {
-                        stpbuf[mix.ch_dst] = stpbuf[mix.ch_dst] * mix.vol;
-                    }
-                    break;
+            ok = get_fade_gains(data->mixing_steps[0].mix, fade_gains, current_pos + s, block_count);
+            if (!ok)
+                continue;
 
-                case MIX_LIMIT:
-                    temp_max = limiter_max * mix.vol;
-                    temp_min = limiter_min * mix.vol;
+            for (i = 0, j = 0; i < block_count; i++) {
+                for (ch = 0; ch < input_channels; ch++) {
+                    gains[j++] = fade_gains[i];
+                }
+            }
 
-                    if (mix.ch_dst < 0) {
-                        for (ch = 0; ch < step_channels; ch++) {
-                            if (stpbuf[ch] > temp_max)
-                                stpbuf[ch] = temp_max;
-                            else if (stpbuf[ch] < temp_min)
-                                stpbuf[ch] = temp_min;
-                        }
-                    }
-                    else {
-                        if (stpbuf[mix.ch_dst] > temp_max)
-                            stpbuf[mix.ch_dst] = temp_max;
-                        else if (stpbuf[mix.ch_dst] < temp_min)
-                            stpbuf[mix.ch_dst] = temp_min;
-                    }
-                    break;
+            if (buf_f32) {
+                float *block = buf_f32 + s * input_channels;
+                for (j = 0; j < block_count * input_channels; j++) {
+                    block[j] = block[j] * gains[j];
+                }
+            }
+            else {
+                sample_t *block = buf + s * input_channels;
+                for (j = 0; j < block_count * input_channels; j++) {
+                    block[j] = clamp16( (int32_t)(block[j] * gains[j]) );
+                }
+            }
+        }
+        return;
+    }
 
-                case MIX_UPMIX:
-                    step_channels += 1;
-                    for (ch = step_channels - 1; ch > mix.ch_dst; ch--) {
-                        stpbuf[ch] = stpbuf[ch-1]; /* 'push' channels forward (or pull backwards) */
-                    }
-                    stpbuf[mix.ch_dst] = 0; /* inserted as silent */
-                    break;
+    /* split input into planes */
+    for (ch = 0; ch < data->mixing_channels; ch++) {
+        planes[ch] = data->mixbuf + ch * sample_count;
+    }
 
-                case MIX_DOWNMIX:
-                    step_channels -= 1;
-                    for (ch = mix.ch_dst; ch < step_channels; ch++) {
-                        stpbuf[ch] = stpbuf[ch+1]; /* 'pull' channels back */
+    if (buf_f32) {
+        for (ch = 0; ch < input_channels; ch++) {
+            float *plane = planes[ch];
+            for (s = 0; s < sample_count; s++) {
+                plane[s] = buf_f32[s*input_channels + ch];
+            }
+        }
+    }
+    else {
+        for (ch = 0; ch < input_channels; ch++) {
+            float *plane = planes[ch];
+            for (s = 0; s < sample_count; s++) {
+                plane[s] = buf[s*input_channels + ch];
+            }
+        }
+    }
+
+    channels = input_channels;
+    for (m = 0; m < data->step_count; m++) {
+        mix_step_data *step = &data->mixing_steps[m];
+        float *dst = step->ch_dst < 0 ? NULL : planes[step->ch_dst];
+        float *src = planes[step->ch_src];
+        float vol = step->vol;
+
+        switch(step->command) {
+            case MIX_REMAP: {
+                /* moved channels keep their plane, inserted ones get a free plane (as channels never
+                 * go over mixing_channels there is always one) */
+                int plane_used[VGMSTREAM_MAX_CHANNELS] = {0};
+                int free_plane = 0;
+
+                for (ch = 0; ch < step->channels; ch++) {
+                    if (step->map[ch] < 0)
+                        continue;
+                    temp_planes[ch] = planes[step->map[ch]];
+                    plane_used[(temp_planes[ch] - data->mixbuf) / sample_count] = 1;
+                }
+
+                for (ch = 0; ch < step->channels; ch++) {
+                    if (step->map[ch] >= 0)
+                        continue;
+                    while (plane_used[free_plane]) {
+                        free_plane++;
                     }
-                    break;
+                    plane_used[free_plane] = 1;
+                    temp_planes[ch] = data->mixbuf + free_plane * sample_count;
+                    memset(temp_planes[ch], 0, sample_count * sizeof(float)); /* inserted as silent */
+                }
 
-                case MIX_KILLMIX:
-                    step_channels = mix.ch_dst; /* clamp channels */
-                    break;
+                for (ch = 0; ch < step->channels; ch++) {
+                    planes[ch] = temp_planes[ch];
+                }
+                break;
+            }
+
+            case MIX_ADD:
+                for (s = 0; s < sample_count; s++) {
+                    dst[s] = dst[s] + src[s] * vol;
+                }
+                break;
 
-                case MIX_FADE:
-                    current_subpos = current_pos + s;
+            case MIX_VOLUME:
+                for (ch = 0; ch < channels; ch++) {
+                    float *plane = planes[ch];
+                    if (dst && plane != dst)
+                        continue;
+                    for (s = 0; s < sample_count; s++) {
+                        plane[s] = plane[s] * vol;
+                    }
+                }
+                break;
 
-                    ok = get_fade_gain(&mix, &cur_vol, current_subpos);
-                    if (!ok) {
-                        break;
+            case MIX_LIMIT:
+                temp_max = limiter_max * vol;
+                temp_min = limiter_min * vol;
+
+                for (ch = 0; ch < channels; ch++) {
+                    float *plane = planes[ch];
+                    if (dst && plane != dst)
+                        continue;
+                    for (s = 0; s < sample_count; s++) {
+                        if (plane[s] > temp_max)
+                            plane[s] = temp_max;
+                        else if (plane[s] < temp_min)
+                            plane[s] = temp_min;
                     }
+                }
+                break;
 
-                    if (mix.ch_dst < 0) {
-                        for (ch = 0; ch < step_channels; ch++) {
-                            stpbuf[ch] = stpbuf[ch] * cur_vol;
+            case MIX_FADE:
+                for (s = 0; s < sample_count; s += MIXING_FADE_BLOCK) {
+                    int32_t i, block_count = MIXING_FADE_BLOCK;
+                    if (block_count > sample_count - s)
+                        block_count = sample_count - s;
+
+                    ok = get_fade_gains(step->mix, fade_gains, current_pos + s, block_count);
+                    if (!ok)
+                        continue;
+
+                    for (ch = 0; ch < channels; ch++) {
+                        float *plane = planes[ch] + s;
+                        if (dst && planes[ch] != dst)
+                            continue;
+                        for (i = 0; i < block_count; i++) {
+                            plane[i] = plane[i] * fade_gains[i];
                         }
                     }
-                    else {
-                        stpbuf[mix.ch_dst] = stpbuf[mix.ch_dst] * cur_vol;
-                    }
-                    break;
+                }
+                break;
 
-                default:
-                    break;
-            }
+            default:
+                break;
         }
 
-        temp_mixbuf += step_channels;
-        temp_outbuf += vgmstream->channels;
+        channels = step->channels;
     }
 
-    /* copy resulting mix to output */
-    for (s = 0; s < sample_count * data->output_channels; s++) {
-        /* when casting float to int, value is simply truncated:
-         * - (int)1.7 = 1, (int)-1.7 = -1
-         * alts for more accurate rounding could be:
-         * - (int)floor(f)
-         * - (int)(f < 0 ? f - 0.5f : f + 0.5f)
-         * - (((int) (f1 + 32768.5)) - 32768)
-         * - etc
-         * but since +-1 isn't really audible we'll just cast as it's the fastest
-         */
-        outbuf[s] = clamp16( (int32_t)data->mixbuf[s] );
+    /* join planes back into the output buffer */
+    if (buf_f32) {
+        for (ch = 0; ch < data->output_channels; ch++) {
+            float *plane = planes[ch];
+            for (s = 0; s < sample_count; s++) {
+                buf_f32[s*data->output_channels + ch] = plane[s];
+            }
+        }
+    }
+    else {
+        for (ch = 0; ch < data->output_channels; ch++) {
+            float *plane = planes[ch];
+            for (s = 0; s < sample_count; s++) {
+                /* when casting float to int, value is simply truncated:
+                 * - (int)1.7 = 1, (int)-1.7 = -1
+                 * alts for more accurate rounding could be:
+                 * - (int)floor(f)
+                 * - (int)(f < 0 ? f - 0.5f : f + 0.5f)
+                 * - (((int) (f1 + 32768.5)) - 32768)
+                 * - etc
+                 * but since +-1 isn't really audible we'll just cast as it's the fastest
+                 */
+                buf[s*data->output_channels + ch] = clamp16( (int32_t)plane[s] );
+            }
+        }
     }
 }
 
+void mix_vgmstream(sample_t *outbuf, int32_t sample_count, VGMSTREAM* vgmstream) {
+    mixing_data *data = vgmstream->mixing_data;
+    int32_t current_pos;
+
+
+    /* no support or not need to apply */
+    if (!data || !data->mixing_on || data->mixing_count == 0)
+        return;
+
+    /* try to skip if no ops apply (for example if fade set but does nothing yet) */
+    current_pos = get_current_pos(vgmstream, sample_count);
+    if (!is_active(data, current_pos, current_pos + sample_count))
+        return;
+
+    mix_samples(data, outbuf, NULL, sample_count, current_pos, vgmstream, 32767.0f, -32768.0f);
+}
+
+void mix_vgmstream_f32(float *outbuf, int32_t sample_count, VGMSTREAM* vgmstream) {
+    mixing_data *data = vgmstream->mixing_data;
+    int32_t current_pos;
+
+
+    if (!data || !data->mixing_on || data->mixing_count == 0)
+        return;
+
+    current_pos = get_current_pos(vgmstream, sample_count);
+    if (!is_active(data, current_pos, current_pos + sample_count))
+        return;
+
+    /* not clamped, so mixes may go past 1.0 and it's up to the caller to limit them */
+    mix_samples(data, NULL, outbuf, sample_count, current_pos, vgmstream, 32767.0f / 32768.0f, -1.0f);
+}
+
 /* ******************************************************************* */
 
 void mixing_init(VGMSTREAM* vgmstream) {
@@ -623,9 +900,9 @@ void mixing_push_fade(VGMSTREAM* vgmstream, int ch_dst, double vol_start, double
     mix_prev = get_last_fade(data, mix.ch_dst);
     if (mix_prev == NULL) {
         if (vol_start == 1.0 && time_pre < 0)
-            time_pre = time_start; /* fade-out helds default volume before fade start can be clamped */
+            mix.time_pre = time_start; /* fade-out helds default volume before fade start can be clamped */
         if (vol_end == 1.0 && time_post < 0)
-            time_post = time_end; /* fade-in helds default volume after fade end can be clamped */
+            mix.time_post = time_end; /* fade-in helds default volume after fade end can be clamped */
     }
     else if (mix_prev->time_post < 0 || mix.time_pre < 0) {
         int is_prev = 1;
@@ -948,8 +1225,12 @@ void mixing_setup(VGMSTREAM * vgmstream, int32_t max_sample_count) {
     if (!mixbuf_re) goto fail;
 
     data->mixbuf = mixbuf_re;
+    data->mixbuf_samples = max_sample_count;
     data->mixing_on = 1;
 
+    /* chain can't change once mixing is on */
+    compile_mixing(data, vgmstream->channels);
+
     /* since data exists on its own memory and pointer is already set
      * there is no need to propagate to start_vgmstream */
 
@@ -960,6 +1241,31 @@ fail:
     return;
 }
 
+int mixing_reserve(VGMSTREAM * vgmstream, int32_t max_sample_count) {
+    mixing_data *data = vgmstream->mixing_data;
+    float *mixbuf_re = NULL;
+
+    if (!data || !data->mixing_on || max_sample_count <= data->mixbuf_samples)
+        return 1;
+
+    mixbuf_re = realloc(data->mixbuf, max_sample_count*data->mixing_channels*sizeof(float));
+    if (!mixbuf_re) goto fail;
+
+    data->mixbuf = mixbuf_re;
+    data->mixbuf_samples = max_sample_count;
+    return 1;
+fail:
+    return 0;
+}
+
+int mixing_output_channels(VGMSTREAM * vgmstream) {
+    mixing_data *data = vgmstream->mixing_data;
+
+    if (!data || !data->mixing_on)
+        return vgmstream->channels;
+    return data->output_channels;
+}
+
 void mixing_info(VGMSTREAM * vgmstream, int *out_input_channels, int *out_output_channels) {
     mixing_data *data = vgmstream->mixing_data;
     int input_channels, output_channels;
@@ -7,6 +7,9 @@
  * outbuf must big enough to hold output_channels*samples_to_do */
 void mix_vgmstream(sample_t *outbuf, int32_t sample_count, VGMSTREAM* vgmstream);
 
+/* Same as mix_vgmstream but for float samples (-1.0..1.0), that aren't clamped after mixing. */
+void mix_vgmstream_f32(float *outbuf, int32_t sample_count, VGMSTREAM* vgmstream);
+
 /* internal mixing pre-setup for vgmstream (doesn't imply usage).
  * If init somehow fails next calls are ignored. */
 void mixing_init(VGMSTREAM* vgmstream);
@@ -21,6 +24,13 @@ void mixing_setup(VGMSTREAM * vgmstream, int32_t max_sample_count);
 /* gets current mixing info */
 void mixing_info(VGMSTREAM * vgmstream, int *input_channels, int *output_channels);
 
+/* Lets mixing take up to max_sample_count per call, for internal renders that may go over
+ * the caller's max (does nothing if mixing isn't on). Returns 0 on error. */
+int mixing_reserve(VGMSTREAM * vgmstream, int32_t max_sample_count);
+
+/* channels in rendered samples (after mixing if it's on) */
+int mixing_output_channels(VGMSTREAM * vgmstream);
+
 /* adds mixes filtering and optimizing if needed */
 void mixing_push_swap(VGMSTREAM* vgmstream, int ch_dst, int ch_src);
 void mixing_push_add(VGMSTREAM* vgmstream, int ch_dst, int ch_src, double volume);
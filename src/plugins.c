@@ -243,3 +243,10 @@ void vgmstream_mixing_autodownmix(VGMSTREAM *vgmstream, int max_channels) {
 
     return;
 }
+
+void vgmstream_mixing_fadeout(VGMSTREAM *vgmstream, int32_t start_sample, int32_t fade_samples) {
+    if (start_sample < 0 || fade_samples <= 0)
+        return;
+
+    mixing_push_fade(vgmstream, -1, 1.0, 0.0, 'T', -1, start_sample, start_sample + fade_samples, -1);
+}
@@ -89,7 +89,8 @@ void vgmstream_mixing_enable(VGMSTREAM* vgmstream, int32_t max_sample_count, int
 /* sets automatic downmixing if vgmstream's channels are higher than max_channels */
 void vgmstream_mixing_autodownmix(VGMSTREAM *vgmstream, int max_channels);
 
-/* sets a fadeout */
-//void vgmstream_mixing_fadeout(VGMSTREAM *vgmstream, float start_second, float duration_seconds);
+/* sets a linear fade-out of all channels at start_sample (in play position, so including
+ * loops) that lasts fade_samples, with silence after. Must be set before enabling mixing. */
+void vgmstream_mixing_fadeout(VGMSTREAM *vgmstream, int32_t start_sample, int32_t fade_samples);
 
 #endif /* _PLUGINS_H_ */
@@ -0,0 +1,355 @@
+#include "vgmstream.h"
+#include "seek_index.h"
+#include "mixing.h"
+
+
+/**
+ * The seek index saves decoder state every N samples, so codecs that need previous frames to
+ * decode (most ADPCM) can restart from a close point when seeking instead of from the beginning.
+ *
+ * Only the parts of each channel that change while decoding are saved (offsets, histories, etc,
+ * not coef tables) plus layout position, so it's only valid for codecs that keep all their state
+ * in VGMSTREAMCHANNEL (no codec_data). States are saved after a render call crosses an index
+ * point, so their exact sample depends on the caller's buffer size (or filled at once by decoding
+ * the whole stream). Memory is bounded: if the stream is too long for max entries the interval
+ * is increased.
+ *
+ * Stream state at some sample is the same in every loop pass, except for types that keep ADPCM
+ * history from loop end when looping. Those get a second table for looped passes, that keeps
+ * states of the last pass played (as each pass may differ slightly).
+ */
+
+#define SEEK_INDEX_DEFAULT_ENTRIES 0x400
+#define SEEK_INDEX_BUILD_SAMPLES 0x1000
+
+
+/* channel values that change while decoding */
+typedef struct {
+    off_t offset;
+    off_t frame_header_offset;
+    int samples_left_in_frame;
+    int16_t adpcm_coef[16];
+    int32_t adpcm_history1_32;
+    int32_t adpcm_history2_32;
+    int32_t adpcm_history3_32;
+    int32_t adpcm_history4_32;
+    double adpcm_history1_double;
+    double adpcm_history2_double;
+    int adpcm_step_index;
+    int adpcm_scale;
+    struct g72x_state g72x_state;
+    uint16_t adx_xor;
+} seek_channel_t;
+
+/* layout values that change while decoding */
+typedef struct {
+    int32_t current_sample;     /* -1 = not saved */
+    int loop_count;
+    int32_t samples_into_block;
+    off_t current_block_offset;
+    size_t current_block_size;
+    size_t current_block_samples;
+    off_t next_block_offset;
+    size_t full_block_size;
+    int32_t ws_output_size;
+} seek_point_t;
+
+typedef struct {
+    int32_t interval;           /* samples between points */
+    int entries;                /* points per table */
+    int channels;
+    int tables;                 /* 2 if looped passes have different state */
+    seek_point_t* points;       /* [tables][entries] */
+    seek_channel_t* chs;        /* [tables][entries][channels] */
+
+    /* loop start values, as resets clear them (while loop_ch is kept) */
+    int has_loop;
+    int32_t loop_sample;
+    int32_t loop_samples_into_block;
+    off_t loop_block_offset;
+    size_t loop_block_size;
+    size_t loop_block_samples;
+    off_t loop_next_block_offset;
+} seek_index_data;
+
+
+/* ******************************************************************* */
+
+static void save_state(seek_index_data* data, int pos, VGMSTREAM* vgmstream) {
+    seek_point_t* point = &data->points[pos];
+    seek_channel_t* chs = &data->chs[pos * data->channels];
+    int ch;
+
+    point->current_sample = vgmstream->current_sample;
+    point->loop_count = vgmstream->loop_count;
+    point->samples_into_block = vgmstream->samples_into_block;
+    point->current_block_offset = vgmstream->current_block_offset;
+    point->current_block_size = vgmstream->current_block_size;
+    point->current_block_samples = vgmstream->current_block_samples;
+    point->next_block_offset = vgmstream->next_block_offset;
+    point->full_block_size = vgmstream->full_block_size;
+    point->ws_output_size = vgmstream->ws_output_size;
+
+    for (ch = 0; ch < data->channels; ch++) {
+        VGMSTREAMCHANNEL* stream = &vgmstream->ch[ch];
+
+        chs[ch].offset = stream->offset;
+        chs[ch].frame_header_offset = stream->frame_header_offset;
+        chs[ch].samples_left_in_frame = stream->samples_left_in_frame;
+        memcpy(chs[ch].adpcm_coef, stream->adpcm_coef, sizeof(stream->adpcm_coef));
+        chs[ch].adpcm_history1_32 = stream->adpcm_history1_32;
+        chs[ch].adpcm_history2_32 = stream->adpcm_history2_32;
+        chs[ch].adpcm_history3_32 = stream->adpcm_history3_32;
+        chs[ch].adpcm_history4_32 = stream->adpcm_history4_32;
+        chs[ch].adpcm_history1_double = stream->adpcm_history1_double;
+        chs[ch].adpcm_history2_double = stream->adpcm_history2_double;
+        chs[ch].adpcm_step_index = stream->adpcm_step_index;
+        chs[ch].adpcm_scale = stream->adpcm_scale;
+        chs[ch].g72x_state = stream->g72x_state;
+        chs[ch].adx_xor = stream->adx_xor;
+    }
+}
+
+static void load_state(seek_index_data* data, int pos, VGMSTREAM* vgmstream) {
+    seek_point_t* point = &data->points[pos];
+    seek_channel_t* chs = &data->chs[pos * data->channels];
+    int ch;
+
+    vgmstream->current_sample = point->current_sample;
+    vgmstream->samples_into_block = point->samples_into_block;
+    vgmstream->current_block_offset = point->current_block_offset;
+    vgmstream->current_block_size = point->current_block_size;
+    vgmstream->current_block_samples = point->current_block_samples;
+    vgmstream->next_block_offset = point->next_block_offset;
+    vgmstream->full_block_size = point->full_block_size;
+    vgmstream->ws_output_size = point->ws_output_size;
+
+    for (ch = 0; ch < data->channels; ch++) {
+        VGMSTREAMCHANNEL* stream = &vgmstream->ch[ch];
+
+        stream->offset = chs[ch].offset;
+        stream->frame_header_offset = chs[ch].frame_header_offset;
+        stream->samples_left_in_frame = chs[ch].samples_left_in_frame;
+        memcpy(stream->adpcm_coef, chs[ch].adpcm_coef, sizeof(stream->adpcm_coef));
+        stream->adpcm_history1_32 = chs[ch].adpcm_history1_32;
+        stream->adpcm_history2_32 = chs[ch].adpcm_history2_32;
+        stream->adpcm_history3_32 = chs[ch].adpcm_history3_32;
+        stream->adpcm_history4_32 = chs[ch].adpcm_history4_32;
+        stream->adpcm_history1_double = chs[ch].adpcm_history1_double;
+        stream->adpcm_history2_double = chs[ch].adpcm_history2_double;
+        stream->adpcm_step_index = chs[ch].adpcm_step_index;
+        stream->adpcm_scale = chs[ch].adpcm_scale;
+        stream->g72x_state = chs[ch].g72x_state;
+        stream->adx_xor = chs[ch].adx_xor;
+    }
+}
+
+static int get_table(seek_index_data* data, int loop_count) {
+    return (data->tables > 1 && loop_count > 0) ? 1 : 0;
+}
+
+
+/* ******************************************************************* */
+
+int seek_index_init(VGMSTREAM* vgmstream, int32_t interval, int max_entries) {
+    seek_index_data* data = NULL;
+    int i, total;
+
+    if (interval <= 0)
+        goto fail;
+    if (max_entries <= 0)
+        max_entries = SEEK_INDEX_DEFAULT_ENTRIES;
+
+    /* state must be fully in channels */
+    if (vgmstream->codec_data)
+        goto fail;
+    if (vgmstream->layout_type == layout_segmented || vgmstream->layout_type == layout_layered)
+        goto fail;
+
+    data = calloc(1, sizeof(seek_index_data));
+    if (!data) goto fail;
+
+    if (vgmstream->num_samples / max_entries >= interval)
+        interval = vgmstream->num_samples / max_entries + 1;
+
+    data->interval = interval;
+    data->entries = vgmstream->num_samples / interval + 1;
+    data->channels = vgmstream->channels;
+    data->tables = vgmstream_is_loop_history_kept(vgmstream) ? 2 : 1;
+
+    total = data->tables * data->entries;
+
+    data->points = malloc(total * sizeof(seek_point_t));
+    if (!data->points) goto fail;
+    data->chs = malloc(total * data->channels * sizeof(seek_channel_t));
+    if (!data->chs) goto fail;
+
+    for (i = 0; i < total; i++) {
+        data->points[i].current_sample = -1;
+    }
+
+    vgmstream->seek_index = data;
+    return 1;
+fail:
+    if (data) {
+        free(data->points);
+        free(data->chs);
+    }
+    free(data);
+    return 0;
+}
+
+void seek_index_close(VGMSTREAM* vgmstream) {
+    seek_index_data* data = NULL;
+    if (!vgmstream) return;
+
+    data = vgmstream->seek_index;
+    if (!data) return;
+
+    free(data->points);
+    free(data->chs);
+    free(data);
+    vgmstream->seek_index = NULL;
+}
+
+void seek_index_update(VGMSTREAM* vgmstream) {
+    seek_index_data* data = vgmstream->seek_index;
+    int slot, table, pos;
+
+    if (!data) return;
+
+    if (vgmstream->hit_loop && !data->has_loop) {
+        data->loop_sample = vgmstream->loop_sample;
+        data->loop_samples_into_block = vgmstream->loop_samples_into_block;
+        data->loop_block_offset = vgmstream->loop_block_offset;
+        data->loop_block_size = vgmstream->loop_block_size;
+        data->loop_block_samples = vgmstream->loop_block_samples;
+        data->loop_next_block_offset = vgmstream->loop_next_block_offset;
+        data->has_loop = 1;
+    }
+
+    if (vgmstream->current_sample < 0)
+        return;
+    slot = vgmstream->current_sample / data->interval;
+    if (slot >= data->entries)
+        return;
+
+    /* keep first state after each index point (closest to it) */
+    table = get_table(data, vgmstream->loop_count);
+    pos = table * data->entries + slot;
+    if (data->points[pos].current_sample >= 0 && (table == 0 || data->points[pos].loop_count == vgmstream->loop_count))
+        return;
+
+    save_state(data, pos, vgmstream);
+}
+
+int seek_index_restore(VGMSTREAM* vgmstream, int32_t seek_sample, int32_t min_sample, int loop_count, int loop_flag) {
+    seek_index_data* data = vgmstream->seek_index;
+    int slot, table, pos = -1;
+
+    if (!data) return 0;
+
+    table = get_table(data, loop_count);
+    slot = seek_sample / data->interval;
+    if (slot >= data->entries)
+        slot = data->entries - 1;
+
+    for (; slot >= 0; slot--) {
+        seek_point_t* point = &data->points[table * data->entries + slot];
+        if (point->current_sample < 0 || point->current_sample > seek_sample)
+            continue;
+        if (table > 0 && point->loop_count != loop_count)
+            continue;
+        if (point->current_sample <= min_sample)
+            return 0; /* current position (or other) is closer */
+
+        /* past loop start next loop end needs its values, which may be unknown after resets */
+        if (loop_flag && point->current_sample > vgmstream->loop_start_sample && !vgmstream->hit_loop && !data->has_loop)
+            continue;
+
+        pos = table * data->entries + slot;
+        break;
+    }
+    if (pos < 0)
+        return 0;
+
+    if (loop_flag && data->points[pos].current_sample > vgmstream->loop_start_sample && !vgmstream->hit_loop) {
+        vgmstream->loop_sample = data->loop_sample;
+        vgmstream->loop_samples_into_block = data->loop_samples_into_block;
+        vgmstream->loop_block_offset = data->loop_block_offset;
+        vgmstream->loop_block_size = data->loop_block_size;
+        vgmstream->loop_block_samples = data->loop_block_samples;
+        vgmstream->loop_next_block_offset = data->loop_next_block_offset;
+        vgmstream->hit_loop = 1;
+    }
+
+    load_state(data, pos, vgmstream);
+    vgmstream->loop_count = loop_count;
+    vgmstream->loop_flag = loop_flag;
+    return 1;
+}
+
+void seek_index_reset_loop(VGMSTREAM* vgmstream) {
+    seek_index_data* data = vgmstream->seek_index;
+    int i;
+
+    if (!data) return;
+
+    data->has_loop = 0;
+    if (data->tables > 1) {
+        for (i = 0; i < data->entries; i++) {
+            data->points[data->entries + i].current_sample = -1;
+        }
+    }
+}
+
+void seek_index_build(VGMSTREAM* vgmstream) {
+    seek_index_data* data = vgmstream->seek_index;
+    sample_t* buf = NULL;
+    int input_channels = 0, output_channels = 0;
+    int32_t play_samples, samples_done = 0;
+
+    if (!data) return;
+
+    reset_vgmstream(vgmstream);
+    vgmstream->loop_target = 0; /* restored on reset */
+
+    /* whole stream, or up to loop end plus a looped pass if it has different state */
+    if (vgmstream->loop_flag) {
+        play_samples = vgmstream->loop_end_sample;
+        if (data->tables > 1)
+            play_samples += vgmstream->loop_end_sample - vgmstream->loop_start_sample;
+    }
+    else {
+        play_samples = vgmstream->num_samples;
+    }
+
+    mixing_info(vgmstream, &input_channels, &output_channels);
+    if (output_channels < input_channels)
+        output_channels = input_channels;
+    if (output_channels < vgmstream->channels)
+        output_channels = vgmstream->channels;
+
+    buf = malloc(SEEK_INDEX_BUILD_SAMPLES * output_channels * sizeof(sample_t));
+    if (!buf) goto fail;
+
+    /* may be over the caller's max */
+    if (!mixing_reserve(vgmstream, SEEK_INDEX_BUILD_SAMPLES))
+        goto fail;
+
+    while (samples_done < play_samples) {
+        /* stop right at index points */
+        int samples_to_do = data->interval - (vgmstream->current_sample % data->interval);
+        if (samples_to_do > SEEK_INDEX_BUILD_SAMPLES)
+            samples_to_do = SEEK_INDEX_BUILD_SAMPLES;
+        if (samples_to_do > play_samples - samples_done)
+            samples_to_do = play_samples - samples_done;
+
+        render_vgmstream(buf, samples_to_do, vgmstream);
+        samples_done += samples_to_do;
+    }
+
+fail:
+    free(buf);
+    reset_vgmstream(vgmstream);
+}
@@ -0,0 +1,23 @@
+#ifndef _SEEK_INDEX_H_
+#define _SEEK_INDEX_H_
+
+#include "vgmstream.h"
+
+/* internal seek index setup for vgmstream (see vgmstream_set_seek_index) */
+int seek_index_init(VGMSTREAM* vgmstream, int32_t interval, int max_entries);
+void seek_index_close(VGMSTREAM* vgmstream);
+
+/* Saves current decoder state if a new index point was reached. Called after decoding. */
+void seek_index_update(VGMSTREAM* vgmstream);
+
+/* Restores the closest saved state before seek_sample (and after min_sample) for the target loop pass.
+ * Returns 1 if restored, in which case vgmstream is positioned at some sample <= seek_sample. */
+int seek_index_restore(VGMSTREAM* vgmstream, int32_t seek_sample, int32_t min_sample, int loop_count, int loop_flag);
+
+/* Forgets states that depend on loop points (after they change). */
+void seek_index_reset_loop(VGMSTREAM* vgmstream);
+
+/* Decodes the whole stream once to fill the index, then resets. */
+void seek_index_build(VGMSTREAM* vgmstream);
+
+#endif /* _SEEK_INDEX_H_ */
@@ -1,95 +1,317 @@
 #ifndef _MSC_VER
 #include <unistd.h>
 #endif
+#if !defined(_WIN32) && !defined(XBMC)
+#define STREAMFILE_USE_MMAP
+#define STREAMFILE_USE_PREAD
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#endif
+#ifdef VGM_USE_PTHREADS
+#include <pthread.h>
+#endif
 #include "streamfile.h"
 #include "util.h"
 #include "vgmstream.h"
+#include "worker.h"
+
 
+/* STDIO pages: fixed-size blocks of the file, shared by all streamfiles re-opened from the same
+ * FILE (channels, codec reopens), so overlapping reads are done once instead of per streamfile */
+#define STDIO_PAGE_SIZE     STREAMFILE_DEFAULT_BUFFER_SIZE
+#define STDIO_PAGES_MAX     96  /* LRU bound for all files in a group (pages in use by some streamfile are never evicted) */
+#define STDIO_READAHEAD_MAX 16  /* max pages loaded at once on a miss (512KB, so readers don't evict each other's) */
 
-/* a STREAMFILE that operates via standard IO using a buffer */
 typedef struct {
-    STREAMFILE sf;          /* callbacks */
+    off_t offset;           /* page start (aligned to page size) */
+    size_t size;            /* valid data (less than page size at EOF) */
+    uint8_t * data;
+    int users;              /* streamfiles currently reading this page */
+    uint32_t last_use;      /* LRU counter */
+} STDIO_PAGE;
+
+typedef struct STDIO_GROUP STDIO_GROUP;
 
+/* actual FILE plus its page cache, shared by all streamfiles re-opened from the same file */
+typedef struct {
+    int refs;               /* streamfiles using this file (protected by the group lock) */
     FILE * infile;          /* actual FILE */
+    size_t filesize;        /* cached file size */
+    char name[PATH_LIMIT];  /* FILE filename */
+    STDIO_GROUP * group;
+
+    STDIO_PAGE ** pages;    /* loaded pages (pointers stay valid when the list grows) */
+    int page_count;
+    streamfile_stats_t stats;
+} STDIO_FILE;
+
+/* files opened through each other (reopens, companion files, TXTP layers), so each path is opened
+ * once, and reads use a single fd (pread doesn't need a FILE position) no matter how many
+ * streamfiles use it; opening the same path 255 times for layers would otherwise hit fd limits */
+struct STDIO_GROUP {
+    STDIO_FILE ** files;
+    int file_count;
+    int page_count;         /* pages of all files, so segments that were played don't keep theirs */
+    uint32_t use_count;     /* LRU clock */
+    uint8_t * readahead_buf; /* for loading many pages with one read (done with the lock held) */
+#ifdef VGM_USE_PTHREADS
+    pthread_mutex_t lock;   /* files and their pages (streamfiles may be read from layer/prefetch threads) */
+#endif
+};
+
+/* a STREAMFILE that operates via standard IO using shared pages */
+typedef struct {
+    STREAMFILE sf;          /* callbacks */
+
+    STDIO_FILE * file;      /* shared FILE and pages */
+    STDIO_PAGE * page;      /* current page (held, so can be read without locking) */
+    int readahead;          /* pages to load on a miss (grows while reading forward) */
     char name[PATH_LIMIT];  /* FILE filename */
     off_t offset;           /* last read offset (info) */
-    off_t buffer_offset;    /* current buffer data start */
-    uint8_t * buffer;       /* data buffer */
-    size_t buffersize;      /* max buffer size */
-    size_t validsize;       /* current buffer size */
-    size_t filesize;        /* buffered file size */
 } STDIOSTREAMFILE;
 
-static STREAMFILE * open_stdio_streamfile_buffer(const char * const filename, size_t buffersize);
-static STREAMFILE * open_stdio_streamfile_buffer_by_file(FILE *infile,const char * const filename, size_t buffersize);
+static STREAMFILE * open_stdio_streamfile_in_group(STDIO_GROUP * group, FILE * infile, const char * const filename);
+static STREAMFILE * open_stdio_streamfile_by_stdio_file(STDIO_FILE * file, const char * const filename);
 
-static size_t read_stdio(STDIOSTREAMFILE *streamfile,uint8_t * dest, off_t offset, size_t length) {
-    size_t length_read_total = 0;
+static void stdio_group_lock(STDIO_GROUP * group) {
+#ifdef VGM_USE_PTHREADS
+    pthread_mutex_lock(&group->lock);
+#endif
+}
+static void stdio_group_unlock(STDIO_GROUP * group) {
+#ifdef VGM_USE_PTHREADS
+    pthread_mutex_unlock(&group->lock);
+#endif
+}
 
-    if (!streamfile || !dest || length <= 0 || offset < 0)
-        return 0;
+/* reads from the FILE (called with the lock held, as non-pread reads move the FILE position) */
+static size_t stdio_read_file(STDIO_FILE * file, uint8_t * buf, off_t offset, size_t length) {
+    size_t done = 0;
 
-    /* is the part of the requested length in the buffer? */
-    if (offset >= streamfile->buffer_offset && offset < streamfile->buffer_offset + streamfile->validsize) {
-        size_t length_to_read;
-        off_t offset_into_buffer = offset - streamfile->buffer_offset;
+    file->stats.refills++;
 
-        length_to_read = streamfile->validsize - offset_into_buffer;
-        if (length_to_read > length)
-            length_to_read = length;
+#ifdef STREAMFILE_USE_PREAD
+    while (done < length) {
+        ssize_t bytes = pread(fileno(file->infile), buf + done, length - done, offset + done);
+        if (bytes <= 0)
+            break; /* EOF or error */
+        done += bytes;
+    }
+#else
+    /* position to new offset */
+    if (fseeko(file->infile,offset,SEEK_SET)) {
+        return 0; /* this shouldn't happen in our code */
+    }
 
-        memcpy(dest,streamfile->buffer + offset_into_buffer,length_to_read);
-        length_read_total += length_to_read;
-        length -= length_to_read;
-        offset += length_to_read;
-        dest += length_to_read;
+#ifdef _MSC_VER
+    /* Workaround a bug that appears when compiling with MSVC (later versions).
+     * This bug is deterministic and seemingly appears randomly after seeking.
+     * It results in fread returning data from the wrong area of the file.
+     * HPS is one format that is almost always affected by this. */
+    fseek(file->infile, ftell(file->infile), SEEK_SET);
+#endif
+
+    done = fread(buf,sizeof(uint8_t),length,file->infile);
+#endif
+
+    file->stats.bytes_read += done;
+    return done;
+}
+
+/* loads consecutive pages from page_offset with a single read */
+static void stdio_load_pages(STDIO_FILE * file, STDIO_PAGE ** pages, int count, off_t page_offset) {
+    STDIO_GROUP * group = file->group;
+    size_t bytes;
+    int i;
+
+    if (count > 1 && !group->readahead_buf) {
+        group->readahead_buf = malloc(STDIO_READAHEAD_MAX * STDIO_PAGE_SIZE);
+        if (!group->readahead_buf)
+            count = 1;
     }
 
+    if (count == 1) {
+        pages[0]->offset = page_offset;
+        pages[0]->size = stdio_read_file(file, pages[0]->data, page_offset, STDIO_PAGE_SIZE);
+        return;
+    }
+
+    bytes = stdio_read_file(file, group->readahead_buf, page_offset, count * STDIO_PAGE_SIZE);
+    for (i = 0; i < count; i++) {
+        size_t page_bytes = 0;
+        if (bytes > i * STDIO_PAGE_SIZE)
+            page_bytes = bytes - i * STDIO_PAGE_SIZE;
+        if (page_bytes > STDIO_PAGE_SIZE)
+            page_bytes = STDIO_PAGE_SIZE;
+
+        memcpy(pages[i]->data, group->readahead_buf + i * STDIO_PAGE_SIZE, page_bytes);
+        pages[i]->offset = page_offset + i * STDIO_PAGE_SIZE;
+        pages[i]->size = page_bytes;
+    }
+}
+
+static STDIO_PAGE * stdio_find_page(STDIO_FILE * file, off_t page_offset) {
+    int i;
+
+    for (i = 0; i < file->page_count; i++) {
+        if (file->pages[i]->offset == page_offset)
+            return file->pages[i];
+    }
+    return NULL;
+}
+
+/* returns the least recently used page not in use of any file in the group (moved to this file),
+ * or a new one if under the bound or all are in use */
+static STDIO_PAGE * stdio_get_free_page(STDIO_FILE * file) {
+    STDIO_GROUP * group = file->group;
+    STDIO_FILE * owner = NULL;
+    STDIO_PAGE * page = NULL;
+    STDIO_PAGE ** pages;
+    int i, f, index = 0;
+
+    if (group->page_count >= STDIO_PAGES_MAX) {
+        for (f = 0; f < group->file_count; f++) {
+            STDIO_FILE * curr_file = group->files[f];
+            for (i = 0; i < curr_file->page_count; i++) {
+                STDIO_PAGE * curr = curr_file->pages[i];
+                if (curr->users == 0 && (!page || curr->last_use < page->last_use)) {
+                    page = curr;
+                    owner = curr_file;
+                    index = i;
+                }
+            }
+        }
+        if (page && owner == file)
+            return page;
+    }
+
+    pages = realloc(file->pages, (file->page_count + 1) * sizeof(STDIO_PAGE*));
+    if (!pages) return NULL;
+    file->pages = pages;
+
+    if (page) {
+        owner->pages[index] = owner->pages[owner->page_count - 1];
+        owner->page_count--;
+        file->pages[file->page_count] = page;
+        file->page_count++;
+        return page;
+    }
+
+    page = calloc(1, sizeof(STDIO_PAGE));
+    if (!page) return NULL;
+    page->data = malloc(STDIO_PAGE_SIZE);
+    if (!page->data) {
+        free(page);
+        return NULL;
+    }
+    page->offset = -1;
+    file->pages[file->page_count] = page;
+    file->page_count++;
+    group->page_count++;
+    return page;
+}
+
+/* releases the old page (if any) and returns the page that has offset, loading it if needed
+ * along with up to readahead-1 next pages */
+static STDIO_PAGE * stdio_get_page(STDIO_FILE * file, STDIO_PAGE * old_page, off_t offset, int readahead) {
+    off_t page_offset = offset - (offset % STDIO_PAGE_SIZE);
+    STDIO_PAGE * pages[STDIO_READAHEAD_MAX];
+    STDIO_PAGE * page = NULL;
+    int i, count;
+
+    stdio_group_lock(file->group);
+
+    if (old_page)
+        old_page->users--;
+
+    page = stdio_find_page(file, page_offset);
+    if (page) {
+        page->users++;
+        page->last_use = ++file->group->use_count;
+        stdio_group_unlock(file->group);
+        return page;
+    }
+
+    /* pick pages for the missing range (held meanwhile so they aren't picked twice) */
+    count = 0;
+    while (count < readahead) {
+        off_t curr_offset = page_offset + count * STDIO_PAGE_SIZE;
+        if (count > 0 && (curr_offset >= file->filesize || stdio_find_page(file, curr_offset)))
+            break;
+
+        pages[count] = stdio_get_free_page(file);
+        if (!pages[count])
+            break;
+        pages[count]->users++;
+        pages[count]->offset = -1; /* not valid until loaded */
+        count++;
+    }
+    if (count == 0) {
+        stdio_group_unlock(file->group);
+        return NULL;
+    }
+
+    stdio_load_pages(file, pages, count, page_offset);
+
+    /* first page stays held by the caller, readahead pages are used after it */
+    for (i = 0; i < count; i++) {
+        if (i > 0)
+            pages[i]->users--;
+        pages[i]->last_use = ++file->group->use_count;
+    }
+    page = pages[0];
+
+    stdio_group_unlock(file->group);
+    return page;
+}
+
+static size_t read_stdio(STDIOSTREAMFILE *streamfile,uint8_t * dest, off_t offset, size_t length) {
+    size_t length_read_total = 0;
+
+    if (!streamfile || !dest || length <= 0 || offset < 0)
+        return 0;
 
-    /* read the rest of the requested length */
     while (length > 0) {
+        STDIO_PAGE * page = streamfile->page;
         size_t length_to_read;
+        off_t offset_into_page;
 
         /* ignore requests at EOF */
-        if (offset >= streamfile->filesize) {
+        if (offset >= streamfile->file->filesize) {
             //offset = streamfile->filesize; /* seems fseek doesn't clamp offset */
-            VGM_ASSERT_ONCE(offset > streamfile->filesize, "STDIO: reading over filesize 0x%x @ 0x%x + 0x%x\n", streamfile->filesize, (uint32_t)offset, length);
+            VGM_ASSERT_ONCE(offset > streamfile->file->filesize, "STDIO: reading over filesize 0x%x @ 0x%x + 0x%x\n", streamfile->file->filesize, (uint32_t)offset, length);
             break;
         }
 
-        /* position to new offset */
-        if (fseeko(streamfile->infile,offset,SEEK_SET)) {
-            break; /* this shouldn't happen in our code */
-        }
-
-#ifdef _MSC_VER
-        /* Workaround a bug that appears when compiling with MSVC (later versions).
-         * This bug is deterministic and seemingly appears randomly after seeking.
-         * It results in fread returning data from the wrong area of the file.
-         * HPS is one format that is almost always affected by this. */
-        fseek(streamfile->infile, ftell(streamfile->infile), SEEK_SET);
-#endif
-
-        /* fill the buffer (offset now is beyond buffer_offset) */
-        streamfile->buffer_offset = offset;
-        streamfile->validsize = fread(streamfile->buffer,sizeof(uint8_t),streamfile->buffersize,streamfile->infile);
+        /* move to the page with offset (shared with other streamfiles) */
+        if (!page || offset < page->offset || offset >= page->offset + STDIO_PAGE_SIZE) {
+            /* decoders reading forward move to the next page, while header parsing and seeks jump around */
+            if (page && offset >= page->offset + STDIO_PAGE_SIZE && offset < page->offset + 2 * STDIO_PAGE_SIZE) {
+                streamfile->readahead *= 2;
+                if (streamfile->readahead > STDIO_READAHEAD_MAX)
+                    streamfile->readahead = STDIO_READAHEAD_MAX;
+            }
+            else {
+                streamfile->readahead = 1;
+            }
 
-        /* decide how much must be read this time */
-        if (length > streamfile->buffersize)
-            length_to_read = streamfile->buffersize;
-        else
-            length_to_read = length;
+            page = stdio_get_page(streamfile->file, page, offset, streamfile->readahead);
+            streamfile->page = page;
+            if (!page)
+                break;
+        }
 
         /* give up on partial reads (EOF) */
-        if (streamfile->validsize < length_to_read) {
-            memcpy(dest,streamfile->buffer,streamfile->validsize);
-            offset += streamfile->validsize;
-            length_read_total += streamfile->validsize;
+        offset_into_page = offset - page->offset;
+        if (offset_into_page >= page->size)
             break;
-        }
 
-        /* use the new buffer */
-        memcpy(dest,streamfile->buffer,length_to_read);
+        length_to_read = page->size - offset_into_page;
+        if (length_to_read > length)
+            length_to_read = length;
+
+        memcpy(dest,page->data + offset_into_page,length_to_read);
         offset += length_to_read;
         length_read_total += length_to_read;
         length -= length_to_read;
@@ -100,7 +322,7 @@ static size_t read_stdio(STDIOSTREAMFILE *streamfile,uint8_t * dest, off_t offse
     return length_read_total;
 }
 static size_t get_size_stdio(STDIOSTREAMFILE * streamfile) {
-    return streamfile->filesize;
+    return streamfile->file->filesize;
 }
 static off_t get_offset_stdio(STDIOSTREAMFILE *streamfile) {
     return streamfile->offset;
@@ -109,47 +331,111 @@ static void get_name_stdio(STDIOSTREAMFILE *streamfile,char *buffer,size_t lengt
     strncpy(buffer,streamfile->name,length);
     buffer[length-1]='\0';
 }
+static void get_stats_stdio(STDIOSTREAMFILE *streamfile, streamfile_stats_t * stats) {
+    stdio_group_lock(streamfile->file->group);
+    *stats = streamfile->file->stats; /* shared by all streamfiles of the file */
+    stdio_group_unlock(streamfile->file->group);
+}
+/* drops a reference to the file, closing it when unused (and the group when empty) */
+static void stdio_file_release(STDIO_FILE * file) {
+    STDIO_GROUP * group = file->group;
+    int i, refs, file_count;
+
+    stdio_group_lock(group);
+    refs = --file->refs;
+    if (refs <= 0) {
+        for (i = 0; i < group->file_count; i++) {
+            if (group->files[i] == file) {
+                group->files[i] = group->files[group->file_count - 1];
+                group->file_count--;
+                break;
+            }
+        }
+        group->page_count -= file->page_count;
+    }
+    file_count = group->file_count;
+    stdio_group_unlock(group);
+
+    if (refs > 0)
+        return;
+
+    for (i = 0; i < file->page_count; i++) {
+        free(file->pages[i]->data);
+        free(file->pages[i]);
+    }
+    free(file->pages);
+    fclose(file->infile);
+    free(file);
+
+    if (file_count == 0) {
+        free(group->files);
+        free(group->readahead_buf);
+#ifdef VGM_USE_PTHREADS
+        pthread_mutex_destroy(&group->lock);
+#endif
+        free(group);
+    }
+}
+
 static void close_stdio(STDIOSTREAMFILE * streamfile) {
-    fclose(streamfile->infile);
-    free(streamfile->buffer);
+    STDIO_FILE * file = streamfile->file;
+
+    if (streamfile->page) {
+        stdio_group_lock(file->group);
+        streamfile->page->users--;
+        stdio_group_unlock(file->group);
+    }
+
+    stdio_file_release(file);
     free(streamfile);
 }
 
 static STREAMFILE *open_stdio(STDIOSTREAMFILE *streamFile,const char * const filename,size_t buffersize) {
-    int newfd;
-    FILE *newfile;
-    STREAMFILE *newstreamFile;
+    STDIO_GROUP * group = streamFile->file->group;
+    STDIO_FILE * file = NULL;
+    STREAMFILE * newstreamFile;
+    FILE * infile;
+    int i;
 
     if (!filename)
         return NULL;
-#if !defined (__ANDROID__)
-    // if same name, duplicate the file pointer we already have open
-    if (!strcmp(streamFile->name,filename)) {
-        if (((newfd = dup(fileno(streamFile->infile))) >= 0) &&
-            (newfile = fdopen( newfd, "rb" ))) 
-        {
-            newstreamFile = open_stdio_streamfile_buffer_by_file(newfile,filename,buffersize);
-            if (newstreamFile) { 
-                return newstreamFile;
-            }
-            // failure, close it and try the default path (which will probably fail a second time)
-            fclose(newfile);
+
+    /* if this or other file in the group has the same name, share the FILE and pages we already have */
+    stdio_group_lock(group);
+    for (i = 0; i < group->file_count; i++) {
+        if (!strcmp(group->files[i]->name,filename)) {
+            file = group->files[i];
+            file->refs++;
+            break;
         }
     }
-#endif    
+    stdio_group_unlock(group);
+
+    if (file) {
+        newstreamFile = open_stdio_streamfile_by_stdio_file(file,filename);
+        if (!newstreamFile)
+            stdio_file_release(file);
+        return newstreamFile;
+    }
+
     // a normal open, open a new file
-    return open_stdio_streamfile_buffer(filename,buffersize);
+    infile = fopen(filename,"rb");
+    if (!infile) return NULL;
+
+    newstreamFile = open_stdio_streamfile_in_group(group,infile,filename);
+    if (!newstreamFile) {
+        fclose(infile);
+    }
+
+    return newstreamFile;
 }
 
-static STREAMFILE * open_stdio_streamfile_buffer_by_file(FILE *infile,const char * const filename, size_t buffersize) {
-    uint8_t * buffer = NULL;
+/* makes a streamfile over an open file, which must have a reference taken for it */
+static STREAMFILE * open_stdio_streamfile_by_stdio_file(STDIO_FILE * file, const char * const filename) {
     STDIOSTREAMFILE * streamfile = NULL;
 
-    buffer = calloc(buffersize,1);
-    if (!buffer) goto fail;
-
     streamfile = calloc(1,sizeof(STDIOSTREAMFILE));
-    if (!streamfile) goto fail;
+    if (!streamfile) return NULL;
 
     streamfile->sf.read = (void*)read_stdio;
     streamfile->sf.get_size = (void*)get_size_stdio;
@@ -158,41 +444,97 @@ static STREAMFILE * open_stdio_streamfile_buffer_by_file(FILE *infile,const char
     streamfile->sf.open = (void*)open_stdio;
     streamfile->sf.close = (void*)close_stdio;
 
-    streamfile->infile = infile;
-    streamfile->buffersize = buffersize;
-    streamfile->buffer = buffer;
+    streamfile->sf.get_stats = (void*)get_stats_stdio;
+
+    streamfile->file = file;
+    streamfile->readahead = 1;
 
     strncpy(streamfile->name,filename,sizeof(streamfile->name));
     streamfile->name[sizeof(streamfile->name)-1] = '\0';
 
+    return &streamfile->sf;
+}
+
+/* opens a streamfile over a new FILE, added to the group (or a new group if NULL); the FILE
+ * is owned by the streamfile on success. Streamfiles read through shared pages of
+ * STDIO_PAGE_SIZE, so reopens' buffersize is ignored. */
+static STREAMFILE * open_stdio_streamfile_in_group(STDIO_GROUP * group, FILE * infile, const char * const filename) {
+    STDIO_FILE * file = NULL;
+    STDIO_FILE ** files;
+    STREAMFILE * streamFile = NULL;
+    int new_group = (group == NULL);
+
+    if (new_group) {
+        group = calloc(1,sizeof(STDIO_GROUP));
+        if (!group) return NULL;
+#ifdef VGM_USE_PTHREADS
+        if (pthread_mutex_init(&group->lock, NULL) != 0) {
+            free(group);
+            return NULL;
+        }
+#endif
+    }
+
+    file = calloc(1,sizeof(STDIO_FILE));
+    if (!file) goto fail;
+
+    file->refs = 1;
+    file->infile = infile;
+    file->group = group;
+    strncpy(file->name,filename,sizeof(file->name));
+    file->name[sizeof(file->name)-1] = '\0';
+
     /* cache filesize */
-    fseeko(streamfile->infile,0,SEEK_END);
-    streamfile->filesize = ftello(streamfile->infile);
+    fseeko(file->infile,0,SEEK_END);
+    file->filesize = ftello(file->infile);
 
     /* Typically fseek(o)/ftell(o) may only handle up to ~2.14GB, signed 32b = 0x7FFFFFFF
      * (happens in banks like FSB, though rarely). Can be remedied with the
      * preprocessor (-D_FILE_OFFSET_BITS=64 in GCC) but it's not well tested. */
-    if (streamfile->filesize == 0xFFFFFFFF) { /* -1 on error */
+    if (file->filesize == 0xFFFFFFFF) { /* -1 on error */
         VGM_LOG("STREAMFILE: ftell error\n");
-        goto fail; /* can be ignored but may result in strange/unexpected behaviors */
+        goto fail_file; /* can be ignored but may result in strange/unexpected behaviors */
     }
 
-    return &streamfile->sf;
+    streamFile = open_stdio_streamfile_by_stdio_file(file, filename);
+    if (!streamFile) goto fail_file;
 
+    stdio_group_lock(group);
+    files = realloc(group->files, (group->file_count + 1) * sizeof(STDIO_FILE*));
+    if (files) {
+        group->files = files;
+        group->files[group->file_count] = file;
+        group->file_count++;
+    }
+    stdio_group_unlock(group);
+    if (!files) {
+        free(streamFile);
+        goto fail_file;
+    }
+
+    return streamFile;
+
+fail_file:
+    free(file);
 fail:
-    free(buffer);
-    free(streamfile);
+    if (new_group) {
+#ifdef VGM_USE_PTHREADS
+        pthread_mutex_destroy(&group->lock);
+#endif
+        free(group);
+    }
     return NULL;
 }
 
-static STREAMFILE * open_stdio_streamfile_buffer(const char * const filename, size_t buffersize) {
+
+STREAMFILE * open_stdio_streamfile(const char * filename) {
     FILE * infile;
     STREAMFILE *streamFile;
 
     infile = fopen(filename,"rb");
     if (!infile) return NULL;
 
-    streamFile = open_stdio_streamfile_buffer_by_file(infile,filename,buffersize);
+    streamFile = open_stdio_streamfile_in_group(NULL,infile,filename);
     if (!streamFile) {
         fclose(infile);
     }
@@ -200,56 +542,252 @@ static STREAMFILE * open_stdio_streamfile_buffer(const char * const filename, si
     return streamFile;
 }
 
+STREAMFILE * open_stdio_streamfile_by_file(FILE * file, const char * filename) {
+    return open_stdio_streamfile_in_group(NULL,file,filename);
+}
 
-STREAMFILE * open_stdio_streamfile(const char * filename) {
-    return open_stdio_streamfile_buffer(filename,STREAMFILE_DEFAULT_BUFFER_SIZE);
+/* **************************************************** */
+
+#ifdef STREAMFILE_USE_MMAP
+/* file mapping, shared by all streamfiles re-opened from the same file */
+typedef struct {
+    int refs;
+    uint8_t * data;
+    size_t size;
+} MMAP_DATA;
+
+/* a STREAMFILE that reads from a memory-mapped file */
+typedef struct {
+    STREAMFILE sf;
+
+    MMAP_DATA * map;
+    char name[PATH_LIMIT];
+    off_t offset;           /* last read offset (info) */
+} MMAP_STREAMFILE;
+
+static STREAMFILE * open_mmap_streamfile_by_map(MMAP_DATA * map, const char * const filename);
+
+static size_t mmap_read(MMAP_STREAMFILE *streamfile, uint8_t * dest, off_t offset, size_t length) {
+    size_t filesize = streamfile->map->size;
+
+    if (!dest || length <= 0 || offset < 0)
+        return 0;
+
+    /* ignore requests at EOF */
+    if (offset >= filesize) {
+        VGM_ASSERT_ONCE(offset > filesize, "MMAP: reading over filesize 0x%x @ 0x%x + 0x%x\n", filesize, (uint32_t)offset, length);
+        return 0;
+    }
+
+    if (length > filesize - offset)
+        length = filesize - offset;
+
+    memcpy(dest, streamfile->map->data + offset, length);
+    streamfile->offset = offset + length;
+    return length;
 }
+static const uint8_t * mmap_get_data(MMAP_STREAMFILE *streamfile, off_t offset, size_t length) {
+    size_t filesize = streamfile->map->size;
 
-STREAMFILE * open_stdio_streamfile_by_file(FILE * file, const char * filename) {
-    return open_stdio_streamfile_buffer_by_file(file,filename,STREAMFILE_DEFAULT_BUFFER_SIZE);
+    if (offset < 0 || offset > filesize || length > filesize - offset)
+        return NULL;
+    return streamfile->map->data + offset;
+}
+static size_t mmap_get_size(MMAP_STREAMFILE * streamfile) {
+    return streamfile->map->size;
+}
+static off_t mmap_get_offset(MMAP_STREAMFILE *streamfile) {
+    return streamfile->offset;
+}
+static void mmap_get_name(MMAP_STREAMFILE *streamfile, char *buffer, size_t length) {
+    strncpy(buffer,streamfile->name,length);
+    buffer[length-1]='\0';
+}
+static STREAMFILE *mmap_open(MMAP_STREAMFILE *streamfile, const char * const filename, size_t buffersize) {
+    if (!filename)
+        return NULL;
+
+    /* if same name, share the mapping we already have */
+    if (!strcmp(streamfile->name,filename))
+        return open_mmap_streamfile_by_map(streamfile->map, filename);
+
+    return open_mmap_streamfile(filename);
+}
+static void mmap_close(MMAP_STREAMFILE * streamfile) {
+    MMAP_DATA * map = streamfile->map;
+
+    map->refs--;
+    if (map->refs <= 0) {
+        munmap(map->data, map->size);
+        free(map);
+    }
+    free(streamfile);
+}
+
+static STREAMFILE * open_mmap_streamfile_by_map(MMAP_DATA * map, const char * const filename) {
+    MMAP_STREAMFILE * streamfile = NULL;
+
+    streamfile = calloc(1,sizeof(MMAP_STREAMFILE));
+    if (!streamfile) return NULL;
+
+    streamfile->sf.read = (void*)mmap_read;
+    streamfile->sf.get_size = (void*)mmap_get_size;
+    streamfile->sf.get_offset = (void*)mmap_get_offset;
+    streamfile->sf.get_name = (void*)mmap_get_name;
+    streamfile->sf.open = (void*)mmap_open;
+    streamfile->sf.close = (void*)mmap_close;
+    streamfile->sf.get_data = (void*)mmap_get_data;
+
+    streamfile->map = map;
+    map->refs++;
+
+    strncpy(streamfile->name,filename,sizeof(streamfile->name));
+    streamfile->name[sizeof(streamfile->name)-1] = '\0';
+
+    return &streamfile->sf;
+}
+
+STREAMFILE * open_mmap_streamfile(const char * filename) {
+    STREAMFILE *streamFile = NULL;
+    MMAP_DATA * map = NULL;
+    struct stat st;
+    void * data;
+    int fd;
+
+    fd = open(filename, O_RDONLY);
+    if (fd < 0) return NULL;
+
+    /* empty or special files (or too big for the address space) use regular reads */
+    if (fstat(fd, &st) != 0 || !S_ISREG(st.st_mode) || st.st_size <= 0 || (uint64_t)st.st_size != (size_t)st.st_size) {
+        close(fd);
+        return open_stdio_streamfile(filename);
+    }
+
+    data = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd); /* mapping stays valid */
+    if (data == MAP_FAILED) {
+        VGM_LOG("MMAP: can't map file, using stdio\n");
+        return open_stdio_streamfile(filename);
+    }
+
+    map = calloc(1,sizeof(MMAP_DATA));
+    if (!map) goto fail;
+    map->data = data;
+    map->size = (size_t)st.st_size;
+
+    streamFile = open_mmap_streamfile_by_map(map, filename);
+    if (!streamFile) goto fail;
+
+    return streamFile;
+fail:
+    munmap(data, (size_t)st.st_size);
+    free(map);
+    return NULL;
+}
+#else
+STREAMFILE * open_mmap_streamfile(const char * filename) {
+    return open_stdio_streamfile(filename); /* no mapping support */
 }
+#endif
 
 /* **************************************************** */
 
+#define BUFFER_READAHEAD_MAX 0x100000 /* max refill size when reading forward */
+#define BUFFER_BLOCKS_DEFAULT 4    /* for open_buffer_streamfile_blocks (open_buffer_streamfile uses 1) */
+
+/* a cached range of the inner streamfile */
+typedef struct {
+    off_t offset;           /* block data start */
+    size_t size;            /* valid data */
+    size_t alloc;           /* allocated data (grows with readahead) */
+    uint8_t * data;         /* allocated on first load */
+    uint32_t last_use;      /* LRU counter */
+} BUFFER_BLOCK;
+
 typedef struct {
     STREAMFILE sf;
 
     STREAMFILE *inner_sf;
     off_t offset;           /* last read offset (info) */
-    off_t buffer_offset;    /* current buffer data start */
-    uint8_t * buffer;       /* data buffer */
-    size_t buffersize;      /* max buffer size */
-    size_t validsize;       /* current buffer size */
+    size_t buffersize;      /* base block size (refill size on random reads) */
     size_t filesize;        /* buffered file size */
+
+    /* several blocks so reads alternating between distant offsets (interleaved channels,
+     * header + data) don't evict each other, each growing on its own when read forward */
+    BUFFER_BLOCK * blocks;
+    int block_count;
+    BUFFER_BLOCK * curr;    /* last used block */
+    uint32_t use_count;     /* LRU clock */
+    streamfile_stats_t stats;
 } BUFFER_STREAMFILE;
 
+static BUFFER_BLOCK * buffer_find_block(BUFFER_STREAMFILE *streamfile, off_t offset) {
+    int i;
 
-static size_t buffer_read(BUFFER_STREAMFILE *streamfile, uint8_t * dest, off_t offset, size_t length) {
-    size_t length_read_total = 0;
+    if (offset >= streamfile->curr->offset && offset < streamfile->curr->offset + streamfile->curr->size)
+        return streamfile->curr;
 
-    if (!streamfile || !dest || length <= 0 || offset < 0)
-        return 0;
+    for (i = 0; i < streamfile->block_count; i++) {
+        BUFFER_BLOCK * block = &streamfile->blocks[i];
+        if (offset >= block->offset && offset < block->offset + block->size)
+            return block;
+    }
+    return NULL;
+}
 
-    /* is the part of the requested length in the buffer? */
-    if (offset >= streamfile->buffer_offset && offset < streamfile->buffer_offset + streamfile->validsize) {
-        size_t length_to_read;
-        off_t offset_into_buffer = offset - streamfile->buffer_offset;
+/* loads a block at offset, reusing the block that ends there (doubling its size, as it's being read
+ * forward by a decoder) or else the least recently used one (base size, for header parsing and seeks).
+ * Unused blocks are picked first and allocated here, so blocks that are never needed cost nothing. */
+static BUFFER_BLOCK * buffer_load_block(BUFFER_STREAMFILE *streamfile, off_t offset) {
+    BUFFER_BLOCK * block = NULL;
+    size_t readahead = streamfile->buffersize;
+    int i;
 
-        length_to_read = streamfile->validsize - offset_into_buffer;
-        if (length_to_read > length)
-            length_to_read = length;
+    for (i = 0; i < streamfile->block_count; i++) {
+        BUFFER_BLOCK * curr = &streamfile->blocks[i];
+        if (curr->size > 0 && offset == curr->offset + curr->size) {
+            block = curr;
+            readahead = block->size * 2;
+            if (readahead < streamfile->buffersize)
+                readahead = streamfile->buffersize;
+            if (readahead > BUFFER_READAHEAD_MAX)
+                readahead = BUFFER_READAHEAD_MAX;
+            break;
+        }
+        if (!block || curr->last_use < block->last_use)
+            block = curr;
+    }
 
-        memcpy(dest,streamfile->buffer + offset_into_buffer,length_to_read);
-        length_read_total += length_to_read;
-        length -= length_to_read;
-        offset += length_to_read;
-        dest += length_to_read;
+    if (readahead > block->alloc) {
+        uint8_t * data = realloc(block->data, readahead);
+        if (data) {
+            block->data = data;
+            block->alloc = readahead;
+        }
+        else {
+            readahead = block->alloc;
+        }
     }
 
+    block->offset = offset;
+    block->size = 0;
+    if (readahead > 0) /* not allocated on failure */
+        block->size = streamfile->inner_sf->read(streamfile->inner_sf, block->data, offset, readahead);
+    streamfile->stats.refills++;
+    streamfile->stats.bytes_read += block->size;
+    return block;
+}
+
+static size_t buffer_read(BUFFER_STREAMFILE *streamfile, uint8_t * dest, off_t offset, size_t length) {
+    size_t length_read_total = 0;
+
+    if (!streamfile || !dest || length <= 0 || offset < 0)
+        return 0;
 
-    /* read the rest of the requested length */
     while (length > 0) {
+        BUFFER_BLOCK * block;
         size_t length_to_read;
+        off_t offset_into_block;
 
         /* ignore requests at EOF */
         if (offset >= streamfile->filesize) {
@@ -258,26 +796,27 @@ static size_t buffer_read(BUFFER_STREAMFILE *streamfile, uint8_t * dest, off_t o
             break;
         }
 
-        /* fill the buffer (offset now is beyond buffer_offset) */
-        streamfile->buffer_offset = offset;
-        streamfile->validsize = streamfile->inner_sf->read(streamfile->inner_sf, streamfile->buffer, streamfile->buffer_offset, streamfile->buffersize);
+        block = buffer_find_block(streamfile, offset);
+        if (block) {
+            streamfile->stats.hits++;
+        }
+        else {
+            block = buffer_load_block(streamfile, offset);
 
-        /* decide how much must be read this time */
-        if (length > streamfile->buffersize)
-            length_to_read = streamfile->buffersize;
-        else
-            length_to_read = length;
 
-        /* give up on partial reads (EOF) */
-        if (streamfile->validsize < length_to_read) {
-            memcpy(dest,streamfile->buffer,streamfile->validsize);
-            offset += streamfile->validsize;
-            length_read_total += streamfile->validsize;
-            break;
+            /* give up on failed reads (partial reads stop here on the next loop) */
+            if (block->size == 0)
+                break;
         }
+        block->last_use = ++streamfile->use_count;
+        streamfile->curr = block;
+
+        offset_into_block = offset - block->offset;
+        length_to_read = block->size - offset_into_block;
+        if (length_to_read > length)
+            length_to_read = length;
 
-        /* use the new buffer */
-        memcpy(dest,streamfile->buffer,length_to_read);
+        memcpy(dest,block->data + offset_into_block,length_to_read);
         offset += length_to_read;
         length_read_total += length_to_read;
         length -= length_to_read;
@@ -296,17 +835,29 @@ static size_t buffer_get_offset(BUFFER_STREAMFILE * streamfile) {
 static void buffer_get_name(BUFFER_STREAMFILE *streamfile, char *buffer, size_t length) {
     streamfile->inner_sf->get_name(streamfile->inner_sf, buffer, length); /* default */
 }
+static void buffer_get_stats(BUFFER_STREAMFILE *streamfile, streamfile_stats_t * stats) {
+    *stats = streamfile->stats;
+}
 static STREAMFILE *buffer_open(BUFFER_STREAMFILE *streamfile, const char * const filename, size_t buffersize) {
     STREAMFILE *new_inner_sf = streamfile->inner_sf->open(streamfile->inner_sf,filename,buffersize);
-    return open_buffer_streamfile(new_inner_sf, buffersize); /* original buffer size is preferable? */
+    return open_buffer_streamfile_blocks(new_inner_sf, buffersize, streamfile->block_count); /* original buffer size is preferable? */
 }
 static void buffer_close(BUFFER_STREAMFILE *streamfile) {
+    int i;
+
     streamfile->inner_sf->close(streamfile->inner_sf);
-    free(streamfile->buffer);
+    for (i = 0; i < streamfile->block_count; i++) {
+        free(streamfile->blocks[i].data);
+    }
+    free(streamfile->blocks);
     free(streamfile);
 }
 
 STREAMFILE *open_buffer_streamfile(STREAMFILE *streamfile, size_t buffer_size) {
+    return open_buffer_streamfile_blocks(streamfile, buffer_size, 1);
+}
+
+STREAMFILE *open_buffer_streamfile_blocks(STREAMFILE *streamfile, size_t buffer_size, int block_count) {
     BUFFER_STREAMFILE *this_sf = NULL;
 
     if (!streamfile) goto fail;
@@ -318,8 +869,13 @@ STREAMFILE *open_buffer_streamfile(STREAMFILE *streamfile, size_t buffer_size) {
     if (this_sf->buffersize == 0)
         this_sf->buffersize = STREAMFILE_DEFAULT_BUFFER_SIZE;
 
-    this_sf->buffer = calloc(this_sf->buffersize,1);
-    if (!this_sf->buffer) goto fail;
+    this_sf->block_count = block_count;
+    if (this_sf->block_count <= 0)
+        this_sf->block_count = BUFFER_BLOCKS_DEFAULT;
+
+    this_sf->blocks = calloc(this_sf->block_count,sizeof(BUFFER_BLOCK));
+    if (!this_sf->blocks) goto fail;
+    this_sf->curr = &this_sf->blocks[0];
 
     /* set callbacks and internals */
     this_sf->sf.read = (void*)buffer_read;
@@ -328,7 +884,202 @@ STREAMFILE *open_buffer_streamfile(STREAMFILE *streamfile, size_t buffer_size) {
     this_sf->sf.get_name = (void*)buffer_get_name;
     this_sf->sf.open = (void*)buffer_open;
     this_sf->sf.close = (void*)buffer_close;
+    this_sf->sf.get_stats = (void*)buffer_get_stats;
+    this_sf->sf.stream_index = streamfile->stream_index;
+    this_sf->sf.probe_only = streamfile->probe_only;
+
+    this_sf->inner_sf = streamfile;
+
+    this_sf->filesize = streamfile->get_size(streamfile);
+
+    return &this_sf->sf;
+
+fail:
+    free(this_sf);
+    return NULL;
+}
+
+/* **************************************************** */
+
+#define ASYNC_WINDOW_SIZE   0x40000
+
+typedef struct {
+    off_t offset;           /* window data start */
+    size_t size;            /* valid data */
+    uint8_t * data;
+} ASYNC_WINDOW;
+
+/* a STREAMFILE that reads in windows, loading the next one in a background thread while reading forward */
+typedef struct {
+    STREAMFILE sf;
+
+    STREAMFILE *inner_sf;   /* only read by the worker while a prefetch is running */
+    off_t offset;           /* last read offset (info) */
+    size_t filesize;        /* cached file size */
+    size_t window_size;
+
+    ASYNC_WINDOW windows[2];
+    ASYNC_WINDOW * curr;    /* window being read */
+    ASYNC_WINDOW * next;    /* window being prefetched */
+    int prefetching;        /* next window was started (must wait before using it or inner_sf) */
+    worker_t* worker;       /* NULL if threads aren't available (loads are done on misses) */
+    streamfile_stats_t stats;
+} ASYNC_STREAMFILE;
+
+static void async_load_window(ASYNC_STREAMFILE *streamfile, ASYNC_WINDOW * window, off_t offset) {
+    window->offset = offset;
+    window->size = streamfile->inner_sf->read(streamfile->inner_sf, window->data, offset, streamfile->window_size);
+    streamfile->stats.refills++;
+    streamfile->stats.bytes_read += window->size;
+}
+
+static void async_prefetch_job(void* arg) {
+    ASYNC_STREAMFILE *streamfile = arg;
+    async_load_window(streamfile, streamfile->next, streamfile->next->offset);
+}
+
+/* waits for a started prefetch, so windows and inner_sf can be used */
+static void async_wait(ASYNC_STREAMFILE *streamfile) {
+    if (!streamfile->prefetching)
+        return;
+    worker_wait(streamfile->worker);
+    streamfile->prefetching = 0;
+}
+
+/* makes the current window have offset, then starts loading the next one if reading forward */
+static void async_move_window(ASYNC_STREAMFILE *streamfile, off_t offset) {
+    ASYNC_WINDOW * curr = streamfile->curr;
+    int is_forward = (curr->size > 0 && offset == curr->offset + curr->size);
+
+    async_wait(streamfile);
+
+    if (streamfile->next->size > 0 && offset >= streamfile->next->offset && offset < streamfile->next->offset + streamfile->next->size) {
+        streamfile->curr = streamfile->next;
+        streamfile->next = curr;
+        is_forward = 1;
+    }
+    else {
+        async_load_window(streamfile, curr, offset);
+    }
+
+    streamfile->next->size = 0;
+    if (!streamfile->worker || !is_forward || streamfile->curr->size < streamfile->window_size)
+        return;
+
+    streamfile->next->offset = streamfile->curr->offset + streamfile->curr->size;
+    if (streamfile->next->offset >= streamfile->filesize)
+        return;
+    streamfile->prefetching = 1;
+    worker_start(streamfile->worker);
+}
+
+static size_t async_read(ASYNC_STREAMFILE *streamfile, uint8_t * dest, off_t offset, size_t length) {
+    size_t length_read_total = 0;
+
+    if (!streamfile || !dest || length <= 0 || offset < 0)
+        return 0;
+
+    while (length > 0) {
+        ASYNC_WINDOW * curr = streamfile->curr;
+        size_t length_to_read;
+
+        /* ignore requests at EOF */
+        if (offset >= streamfile->filesize) {
+            VGM_ASSERT_ONCE(offset > streamfile->filesize, "ASYNC: reading over filesize 0x%x @ 0x%x + 0x%x\n", streamfile->filesize, (uint32_t)offset, length);
+            break;
+        }
+
+        if (offset < curr->offset || offset >= curr->offset + curr->size) {
+            async_move_window(streamfile, offset);
+            curr = streamfile->curr;
+
+            /* give up on partial reads (EOF) */
+            if (offset >= curr->offset + curr->size)
+                break;
+        }
+
+        length_to_read = curr->offset + curr->size - offset;
+        if (length_to_read > length)
+            length_to_read = length;
+
+        memcpy(dest, curr->data + (offset - curr->offset), length_to_read);
+        offset += length_to_read;
+        length_read_total += length_to_read;
+        length -= length_to_read;
+        dest += length_to_read;
+    }
+
+    streamfile->offset = offset;
+    return length_read_total;
+}
+static size_t async_get_size(ASYNC_STREAMFILE * streamfile) {
+    return streamfile->filesize; /* cache */
+}
+static off_t async_get_offset(ASYNC_STREAMFILE * streamfile) {
+    return streamfile->offset; /* cache */
+}
+static void async_get_name(ASYNC_STREAMFILE *streamfile, char *buffer, size_t length) {
+    streamfile->inner_sf->get_name(streamfile->inner_sf, buffer, length); /* default */
+}
+static void async_get_stats(ASYNC_STREAMFILE *streamfile, streamfile_stats_t * stats) {
+    async_wait(streamfile); /* stats are updated by the worker */
+    *stats = streamfile->stats;
+}
+static STREAMFILE *async_open(ASYNC_STREAMFILE *streamfile, const char * const filename, size_t buffersize) {
+    STREAMFILE *new_inner_sf, *new_sf;
+
+    async_wait(streamfile); /* inner_sf can't be used meanwhile */
+    new_inner_sf = streamfile->inner_sf->open(streamfile->inner_sf,filename,buffersize);
+    if (!new_inner_sf) return NULL;
+
+    new_sf = open_async_streamfile(new_inner_sf, streamfile->window_size);
+    if (!new_sf) {
+        close_streamfile(new_inner_sf);
+        return NULL;
+    }
+    return new_sf;
+}
+static void async_close(ASYNC_STREAMFILE *streamfile) {
+    if (streamfile->worker)
+        worker_close(streamfile->worker); /* waits for the prefetch */
+    streamfile->inner_sf->close(streamfile->inner_sf);
+    free(streamfile->windows[0].data);
+    free(streamfile->windows[1].data);
+    free(streamfile);
+}
+
+STREAMFILE *open_async_streamfile(STREAMFILE *streamfile, size_t window_size) {
+    ASYNC_STREAMFILE *this_sf = NULL;
+
+    if (!streamfile) goto fail;
+
+    this_sf = calloc(1,sizeof(ASYNC_STREAMFILE));
+    if (!this_sf) goto fail;
+
+    this_sf->window_size = window_size;
+    if (this_sf->window_size == 0)
+        this_sf->window_size = ASYNC_WINDOW_SIZE;
+
+    this_sf->windows[0].data = malloc(this_sf->window_size);
+    if (!this_sf->windows[0].data) goto fail;
+    this_sf->windows[1].data = malloc(this_sf->window_size);
+    if (!this_sf->windows[1].data) goto fail;
+    this_sf->curr = &this_sf->windows[0];
+    this_sf->next = &this_sf->windows[1];
+
+    /* without threads works as a plain buffered streamfile */
+    this_sf->worker = worker_init(async_prefetch_job, this_sf);
+
+    /* set callbacks and internals */
+    this_sf->sf.read = (void*)async_read;
+    this_sf->sf.get_size = (void*)async_get_size;
+    this_sf->sf.get_offset = (void*)async_get_offset;
+    this_sf->sf.get_name = (void*)async_get_name;
+    this_sf->sf.open = (void*)async_open;
+    this_sf->sf.close = (void*)async_close;
+    this_sf->sf.get_stats = (void*)async_get_stats;
     this_sf->sf.stream_index = streamfile->stream_index;
+    this_sf->sf.probe_only = streamfile->probe_only;
 
     this_sf->inner_sf = streamfile;
 
@@ -337,7 +1088,10 @@ STREAMFILE *open_buffer_streamfile(STREAMFILE *streamfile, size_t buffer_size) {
     return &this_sf->sf;
 
 fail:
-    if (this_sf) free(this_sf->buffer);
+    if (this_sf) {
+        free(this_sf->windows[0].data);
+        free(this_sf->windows[1].data);
+    }
     free(this_sf);
     return NULL;
 }
@@ -357,6 +1111,12 @@ typedef struct {
 static size_t wrap_read(WRAP_STREAMFILE *streamfile, uint8_t * dest, off_t offset, size_t length) {
     return streamfile->inner_sf->read(streamfile->inner_sf, dest, offset, length); /* default */
 }
+static const uint8_t * wrap_get_data(WRAP_STREAMFILE *streamfile, off_t offset, size_t length) {
+    return get_streamfile_data(offset, length, streamfile->inner_sf); /* default */
+}
+static void wrap_get_stats(WRAP_STREAMFILE *streamfile, streamfile_stats_t * stats) {
+    streamfile->inner_sf->get_stats(streamfile->inner_sf, stats); /* default */
+}
 static size_t wrap_get_size(WRAP_STREAMFILE * streamfile) {
     return streamfile->inner_sf->get_size(streamfile->inner_sf); /* default */
 }
@@ -389,7 +1149,12 @@ STREAMFILE *open_wrap_streamfile(STREAMFILE *streamfile) {
     this_sf->sf.get_name = (void*)wrap_get_name;
     this_sf->sf.open = (void*)wrap_open;
     this_sf->sf.close = (void*)wrap_close;
+    if (streamfile->get_data)
+        this_sf->sf.get_data = (void*)wrap_get_data;
+    if (streamfile->get_stats)
+        this_sf->sf.get_stats = (void*)wrap_get_stats;
     this_sf->sf.stream_index = streamfile->stream_index;
+    this_sf->sf.probe_only = streamfile->probe_only;
 
     this_sf->inner_sf = streamfile;
 
@@ -411,6 +1176,14 @@ static size_t clamp_read(CLAMP_STREAMFILE *streamfile, uint8_t *dest, off_t offs
     size_t clamp_length = length > (streamfile->size - offset) ? (streamfile->size - offset) : length;
     return streamfile->inner_sf->read(streamfile->inner_sf, dest, inner_offset, clamp_length);
 }
+static const uint8_t * clamp_get_data(CLAMP_STREAMFILE *streamfile, off_t offset, size_t length) {
+    if (offset < 0 || offset > streamfile->size || length > streamfile->size - offset)
+        return NULL;
+    return get_streamfile_data(streamfile->start + offset, length, streamfile->inner_sf);
+}
+static void clamp_get_stats(CLAMP_STREAMFILE *streamfile, streamfile_stats_t * stats) {
+    streamfile->inner_sf->get_stats(streamfile->inner_sf, stats); /* default */
+}
 static size_t clamp_get_size(CLAMP_STREAMFILE *streamfile) {
     return streamfile->size;
 }
@@ -455,7 +1228,12 @@ STREAMFILE *open_clamp_streamfile(STREAMFILE *streamfile, off_t start, size_t si
     this_sf->sf.get_name = (void*)clamp_get_name;
     this_sf->sf.open = (void*)clamp_open;
     this_sf->sf.close = (void*)clamp_close;
+    if (streamfile->get_data)
+        this_sf->sf.get_data = (void*)clamp_get_data;
+    if (streamfile->get_stats)
+        this_sf->sf.get_stats = (void*)clamp_get_stats;
     this_sf->sf.stream_index = streamfile->stream_index;
+    this_sf->sf.probe_only = streamfile->probe_only;
 
     this_sf->inner_sf = streamfile;
     this_sf->start = start;
@@ -521,6 +1299,7 @@ STREAMFILE *open_io_streamfile(STREAMFILE *streamfile, void* data, size_t data_s
     this_sf->sf.open = (void*)io_open;
     this_sf->sf.close = (void*)io_close;
     this_sf->sf.stream_index = streamfile->stream_index;
+    this_sf->sf.probe_only = streamfile->probe_only;
 
     this_sf->inner_sf = streamfile;
     if (data) {
@@ -550,6 +1329,12 @@ typedef struct {
 static size_t fakename_read(FAKENAME_STREAMFILE *streamfile, uint8_t * dest, off_t offset, size_t length) {
     return streamfile->inner_sf->read(streamfile->inner_sf, dest, offset, length); /* default */
 }
+static const uint8_t * fakename_get_data(FAKENAME_STREAMFILE *streamfile, off_t offset, size_t length) {
+    return get_streamfile_data(offset, length, streamfile->inner_sf); /* default */
+}
+static void fakename_get_stats(FAKENAME_STREAMFILE *streamfile, streamfile_stats_t * stats) {
+    streamfile->inner_sf->get_stats(streamfile->inner_sf, stats); /* default */
+}
 static size_t fakename_get_size(FAKENAME_STREAMFILE * streamfile) {
     return streamfile->inner_sf->get_size(streamfile->inner_sf); /* default */
 }
@@ -594,7 +1379,12 @@ STREAMFILE *open_fakename_streamfile(STREAMFILE *streamfile, const char * fakena
     this_sf->sf.get_name = (void*)fakename_get_name;
     this_sf->sf.open = (void*)fakename_open;
     this_sf->sf.close = (void*)fakename_close;
+    if (streamfile->get_data)
+        this_sf->sf.get_data = (void*)fakename_get_data;
+    if (streamfile->get_stats)
+        this_sf->sf.get_stats = (void*)fakename_get_stats;
     this_sf->sf.stream_index = streamfile->stream_index;
+    this_sf->sf.probe_only = streamfile->probe_only;
 
     this_sf->inner_sf = streamfile;
 
@@ -740,6 +1530,7 @@ STREAMFILE *open_multifile_streamfile(STREAMFILE **streamfiles, size_t streamfil
     this_sf->sf.open = (void*)multifile_open;
     this_sf->sf.close = (void*)multifile_close;
     this_sf->sf.stream_index = streamfiles[0]->stream_index;
+    this_sf->sf.probe_only = streamfiles[0]->probe_only;
 
     this_sf->inner_sfs_size = streamfiles_size;
     this_sf->inner_sfs = calloc(streamfiles_size, sizeof(STREAMFILE*));
@@ -982,13 +1773,17 @@ void fix_dir_separators(char * filename) {
  */
 int check_extensions(STREAMFILE *streamFile, const char * cmp_exts) {
     char filename[PATH_LIMIT];
-    const char * ext = NULL;
+
+    streamFile->get_name(streamFile,filename,sizeof(filename));
+    return check_extension_list(filename_extension(filename), cmp_exts);
+}
+
+/* Checks if an extension (without dot) is in a list, with the same rules as check_extensions. */
+int check_extension_list(const char * ext, const char * cmp_exts) {
     const char * cmp_ext = NULL;
     const char * ststr_res = NULL;
     size_t ext_len, cmp_len;
 
-    streamFile->get_name(streamFile,filename,sizeof(filename));
-    ext = filename_extension(filename);
     ext_len = strlen(ext);
 
     cmp_ext = cmp_exts;
@@ -55,6 +55,13 @@
 #endif
 #endif
 
+/* counters of reads done by buffered streamfiles to their underlying file (for testing) */
+typedef struct {
+    uint32_t refills;       /* reads done on buffer misses */
+    uint32_t hits;          /* reads served from the buffer (if counted) */
+    size_t bytes_read;      /* total bytes those reads returned */
+} streamfile_stats_t;
+
 /* struct representing a file with callbacks. Code should use STREAMFILEs and not std C functions
  * to do file operations, as plugins may need to provide their own callbacks.
  * Reads from arbitrary offsets, meaning internally may need fseek equivalents during reads. */
@@ -72,20 +79,49 @@ typedef struct _STREAMFILE {
      * Not ideal here, but it's the simplest way to pass to all init_vgmstream_x functions. */
     int stream_index; /* 0=default/auto (first), 1=first, N=Nth */
 
+    /* Set when only stream info is needed (see probe_vgmstream), so metas may skip decoder setup.
+     * Only set internally on a wrapped streamfile. External streamfiles must be zero-initialized
+     * (calloc/memset) so this and stream_index start as 0. */
+    int probe_only;
+
+    /* Optional (may be NULL): returns a pointer to length bytes of file data at offset without
+     * copying, valid until the streamfile is closed, or NULL if not possible (use read then). */
+    const uint8_t * (*get_data)(struct _STREAMFILE *,off_t offset,size_t length);
+
+    /* Optional (may be NULL): fills read counters of the underlying buffer or file. */
+    void (*get_stats)(struct _STREAMFILE *,streamfile_stats_t * stats);
+
 } STREAMFILE;
 
 /* Opens a standard STREAMFILE, opening from path.
- * Uses stdio (FILE) for operations, thus plugins may not want to use it. */
+ * Uses stdio (FILE) for operations, thus plugins may not want to use it. Files opened through it
+ * (per channel reopens, companion files, TXTP layers) share one FILE per path and its read pages. */
 STREAMFILE *open_stdio_streamfile(const char * filename);
 
 /* Opens a standard STREAMFILE from a pre-opened FILE. */
 STREAMFILE *open_stdio_streamfile_by_file(FILE * file, const char * filename);
 
+/* Opens a STREAMFILE that memory-maps a local file, so reads need no syscalls and
+ * re-opening the same file (ex. per channel) shares a single mapping. Data can be accessed
+ * without copying (see get_streamfile_data). Falls back to stdio if the file can't be mapped. */
+STREAMFILE *open_mmap_streamfile(const char * filename);
+
 /* Opens a STREAMFILE that does buffered IO.
  * Can be used when the underlying IO may be slow (like when using custom IO).
  * Buffer size is optional. */
 STREAMFILE *open_buffer_streamfile(STREAMFILE *streamfile, size_t buffer_size);
 
+/* Same as open_buffer_streamfile (which uses a single block), but with a number of cached blocks
+ * (0 = default), for reads that alternate between distant offsets (like interleaved channels in
+ * custom IO). Blocks are allocated as they are needed. */
+STREAMFILE *open_buffer_streamfile_blocks(STREAMFILE *streamfile, size_t buffer_size, int block_count);
+
+/* Opens a STREAMFILE that reads in windows and, while reading forward, loads the next window
+ * in a background thread as the current one is used, so decoding doesn't wait on slow IO
+ * (network mounts, custom IO). Without thread support works as a buffered streamfile.
+ * Window size is optional. */
+STREAMFILE *open_async_streamfile(STREAMFILE *streamfile, size_t window_size);
+
 /* Opens a STREAMFILE that doesn't close the underlying streamfile.
  * Calls to open won't wrap the new SF (assumes it needs to be closed).
  * Can be used in metas to test custom IO without closing the external SF. */
@@ -144,6 +180,32 @@ static inline size_t get_streamfile_size(STREAMFILE * streamfile) {
     return streamfile->get_size(streamfile);
 }
 
+/* get a pointer to file data if the streamfile allows direct access, NULL otherwise */
+static inline const uint8_t * get_streamfile_data(off_t offset, size_t length, STREAMFILE * streamfile) {
+    if (!streamfile->get_data)
+        return NULL;
+    return streamfile->get_data(streamfile,offset,length);
+}
+
+/* get read counters if the streamfile keeps them, returns 0 otherwise */
+static inline int get_streamfile_stats(streamfile_stats_t * stats, STREAMFILE * streamfile) {
+    if (!streamfile->get_stats)
+        return 0;
+    streamfile->get_stats(streamfile,stats);
+    return 1;
+}
+
+/* get a pointer to file data directly if possible, or read into buf (of at least length bytes)
+ * otherwise. Returns NULL if the whole length can't be read. */
+static inline const uint8_t * read_streamfile_data(uint8_t * buf, off_t offset, size_t length, STREAMFILE * streamfile) {
+    const uint8_t * data = get_streamfile_data(offset,length,streamfile);
+    if (data)
+        return data;
+    if (read_streamfile(buf,offset,length,streamfile) != length)
+        return NULL;
+    return buf;
+}
+
 
 /* Sometimes you just need an int, and we're doing the buffering.
 * Note, however, that if these fail to read they'll return -1,
@@ -264,6 +326,7 @@ size_t read_key_file(uint8_t * buf, size_t bufsize, STREAMFILE *streamFile);
 void fix_dir_separators(char * filename);
 
 int check_extensions(STREAMFILE *streamFile, const char * cmp_exts);
+int check_extension_list(const char * ext, const char * cmp_exts);
 
 int find_chunk_be(STREAMFILE *streamFile, uint32_t chunk_id, off_t start_offset, int full_chunk_size, off_t *out_chunk_offset, size_t *out_chunk_size);
 int find_chunk_le(STREAMFILE *streamFile, uint32_t chunk_id, off_t start_offset, int full_chunk_size, off_t *out_chunk_offset, size_t *out_chunk_size);
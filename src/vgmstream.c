@@ -10,11 +10,17 @@
 #include "layout/layout.h"
 #include "coding/coding.h"
 #include "mixing.h"
+#include "seek_index.h"
+#include "detection.h"
 
 static void try_dual_file_stereo(VGMSTREAM * opened_vgmstream, STREAMFILE *streamFile, VGMSTREAM* (*init_vgmstream_function)(STREAMFILE*));
+static void setup_vgmstream_codec(VGMSTREAM * vgmstream);
+static void render_buffer_reset(VGMSTREAM * vgmstream);
+static void render_buffer_close(VGMSTREAM * vgmstream);
 
 
-/* list of metadata parser functions that will recognize files, used on init */
+/* list of metadata parser functions that will recognize files, used on init
+ * (detection.c declares their first checks, in the same order, to skip them quickly) */
 VGMSTREAM * (*init_vgmstream_functions[])(STREAMFILE *streamFile) = {
     init_vgmstream_adx,
     init_vgmstream_brstm,
@@ -492,108 +498,141 @@ VGMSTREAM * (*init_vgmstream_functions[])(STREAMFILE *streamFile) = {
 #endif
 };
 
+/* List of functions that parse all subsongs of a bank at once, saving a header to init each
+ * (see get_vgmstream_subsongs). Other multi-stream formats are opened by index. */
+static VGMSTREAM_SUBSONGS * (*init_subsongs_functions[])(STREAMFILE *streamFile) = {
+    init_subsongs_fsb5,
+    init_subsongs_xwb,
+    init_subsongs_awc,
+    init_subsongs_bnk_sony,
+    init_subsongs_sqex_sead,
+    init_subsongs_ubi_sb,
+    init_subsongs_ubi_bao_pk,
+};
 
-/* internal version with all parameters */
-static VGMSTREAM * init_vgmstream_internal(STREAMFILE *streamFile) {
-    int i, fcns_size;
-    
-    if (!streamFile)
-        return NULL;
-
-    fcns_size = (sizeof(init_vgmstream_functions)/sizeof(init_vgmstream_functions[0]));
-    /* try a series of formats, see which works */
-    for (i =0; i < fcns_size; i++) {
-        /* call init function and see if valid VGMSTREAM was returned */
-        VGMSTREAM * vgmstream = (init_vgmstream_functions[i])(streamFile);
-        if (!vgmstream)
-            continue;
-
-        /* fail if there is nothing to play (without this check vgmstream can generate empty files) */
-        if (vgmstream->num_samples <= 0) {
-            VGM_LOG("VGMSTREAM: wrong num_samples %i\n", vgmstream->num_samples);
-            close_vgmstream(vgmstream);
-            continue;
-        }
 
-        /* everything should have a reasonable sample rate */
-        if (vgmstream->sample_rate < VGMSTREAM_MIN_SAMPLE_RATE || vgmstream->sample_rate > VGMSTREAM_MAX_SAMPLE_RATE) {
-            VGM_LOG("VGMSTREAM: wrong sample_rate %i\n", vgmstream->sample_rate);
-            close_vgmstream(vgmstream);
-            continue;
-        }
+/* Validates and fixes common values of a VGMSTREAM returned by an init function. Returns 0 if it
+ * must be discarded. The init function is only needed to find dual stereo pairs (may be NULL). */
+static int prepare_vgmstream(VGMSTREAM * vgmstream, STREAMFILE *streamFile, VGMSTREAM* (*init_vgmstream_function)(STREAMFILE*)) {
 
-        /* sanify loops and remove bad metadata */
-        if (vgmstream->loop_flag) {
-            if (vgmstream->loop_end_sample <= vgmstream->loop_start_sample
-                    || vgmstream->loop_end_sample > vgmstream->num_samples
-                    || vgmstream->loop_start_sample < 0) {
-                VGM_LOG("VGMSTREAM: wrong loops ignored (lss=%i, lse=%i, ns=%i)\n",
-                        vgmstream->loop_start_sample, vgmstream->loop_end_sample, vgmstream->num_samples);
-                vgmstream->loop_flag = 0;
-                vgmstream->loop_start_sample = 0;
-                vgmstream->loop_end_sample = 0;
-            }
-        }
+    /* fail if there is nothing to play (without this check vgmstream can generate empty files) */
+    if (vgmstream->num_samples <= 0) {
+        VGM_LOG("VGMSTREAM: wrong num_samples %i\n", vgmstream->num_samples);
+        return 0;
+    }
 
-        /* test if candidate for dual stereo */
-        if (vgmstream->channels == 1 && vgmstream->allow_dual_stereo == 1) {
-            try_dual_file_stereo(vgmstream, streamFile, init_vgmstream_functions[i]);
-        }
+    /* everything should have a reasonable sample rate */
+    if (vgmstream->sample_rate < VGMSTREAM_MIN_SAMPLE_RATE || vgmstream->sample_rate > VGMSTREAM_MAX_SAMPLE_RATE) {
+        VGM_LOG("VGMSTREAM: wrong sample_rate %i\n", vgmstream->sample_rate);
+        return 0;
+    }
 
-        /* clean as loops are readable metadata but loop fields may contain garbage
-         * (done *after* dual stereo as it needs loop fields to match) */
-        if (!vgmstream->loop_flag) {
+    /* sanify loops and remove bad metadata */
+    if (vgmstream->loop_flag) {
+        if (vgmstream->loop_end_sample <= vgmstream->loop_start_sample
+                || vgmstream->loop_end_sample > vgmstream->num_samples
+                || vgmstream->loop_start_sample < 0) {
+            VGM_LOG("VGMSTREAM: wrong loops ignored (lss=%i, lse=%i, ns=%i)\n",
+                    vgmstream->loop_start_sample, vgmstream->loop_end_sample, vgmstream->num_samples);
+            vgmstream->loop_flag = 0;
             vgmstream->loop_start_sample = 0;
             vgmstream->loop_end_sample = 0;
         }
+    }
+
+    /* test if candidate for dual stereo */
+    if (vgmstream->channels == 1 && vgmstream->allow_dual_stereo == 1 && init_vgmstream_function) {
+        try_dual_file_stereo(vgmstream, streamFile, init_vgmstream_function);
+    }
+
+    /* clean as loops are readable metadata but loop fields may contain garbage
+     * (done *after* dual stereo as it needs loop fields to match) */
+    if (!vgmstream->loop_flag) {
+        vgmstream->loop_start_sample = 0;
+        vgmstream->loop_end_sample = 0;
+    }
 
 #ifdef VGM_USE_FFMPEG
-        /* check FFmpeg streams here, for lack of a better place */
-        if (vgmstream->coding_type == coding_FFmpeg) {
-            ffmpeg_codec_data *data = (ffmpeg_codec_data *) vgmstream->codec_data;
-            if (data && data->streamCount && !vgmstream->num_streams) {
-                vgmstream->num_streams = data->streamCount;
-            }
+    /* check FFmpeg streams here, for lack of a better place */
+    if (vgmstream->coding_type == coding_FFmpeg) {
+        ffmpeg_codec_data *data = (ffmpeg_codec_data *) vgmstream->codec_data;
+        if (data && data->streamCount && !vgmstream->num_streams) {
+            vgmstream->num_streams = data->streamCount;
         }
+    }
 #endif
 
-        /* some players are picky with incorrect channel layouts */
-        if (vgmstream->channel_layout > 0) {
-            int output_channels = vgmstream->channels;
-            int ch, count = 0, max_ch = 32;
-            for (ch = 0; ch < max_ch; ch++) {
-                int bit = (vgmstream->channel_layout >> ch) & 1;
-                if (ch > 17 && bit) {
-                    VGM_LOG("VGMSTREAM: wrong bit %i in channel_layout %x\n", ch, vgmstream->channel_layout);
-                    vgmstream->channel_layout = 0;
-                    break;
-                }
-                count += bit;
-            }
-
-            if (count > output_channels) {
-                VGM_LOG("VGMSTREAM: wrong totals %i in channel_layout %x\n", count, vgmstream->channel_layout);
+    /* some players are picky with incorrect channel layouts */
+    if (vgmstream->channel_layout > 0) {
+        int output_channels = vgmstream->channels;
+        int ch, count = 0, max_ch = 32;
+        for (ch = 0; ch < max_ch; ch++) {
+            int bit = (vgmstream->channel_layout >> ch) & 1;
+            if (ch > 17 && bit) {
+                VGM_LOG("VGMSTREAM: wrong bit %i in channel_layout %x\n", ch, vgmstream->channel_layout);
                 vgmstream->channel_layout = 0;
+                break;
             }
+            count += bit;
         }
 
-        /* files can have thousands subsongs, but let's put a limit */
-        if (vgmstream->num_streams < 0 || vgmstream->num_streams > VGMSTREAM_MAX_SUBSONGS) {
-            VGM_LOG("VGMSTREAM: wrong num_streams (ns=%i)\n", vgmstream->num_streams);
-            close_vgmstream(vgmstream);
-            continue;
+        if (count > output_channels) {
+            VGM_LOG("VGMSTREAM: wrong totals %i in channel_layout %x\n", count, vgmstream->channel_layout);
+            vgmstream->channel_layout = 0;
         }
+    }
 
-        /* save info */
-        /* stream_index 0 may be used by plugins to signal "vgmstream default" (IOW don't force to 1) */
-        if (vgmstream->stream_index == 0) {
-            vgmstream->stream_index = streamFile->stream_index;
-        }
+    /* files can have thousands subsongs, but let's put a limit */
+    if (vgmstream->num_streams < 0 || vgmstream->num_streams > VGMSTREAM_MAX_SUBSONGS) {
+        VGM_LOG("VGMSTREAM: wrong num_streams (ns=%i)\n", vgmstream->num_streams);
+        return 0;
+    }
+
+    /* save info */
+    /* stream_index 0 may be used by plugins to signal "vgmstream default" (IOW don't force to 1) */
+    if (vgmstream->stream_index == 0) {
+        vgmstream->stream_index = streamFile->stream_index;
+    }
+
+    return 1;
+}
+
+/* internal version with all parameters */
+static VGMSTREAM * init_vgmstream_internal(STREAMFILE *streamFile) {
+    int i, pass, fcns_size;
+    uint8_t candidates[sizeof(init_vgmstream_functions)/sizeof(init_vgmstream_functions[0])];
+
+    if (!streamFile)
+        return NULL;
+
+    fcns_size = (sizeof(init_vgmstream_functions)/sizeof(init_vgmstream_functions[0]));
+
+    /* skip formats that surely won't work, from extension and header ids read once (if none works
+     * the rest are tried anyway, so it's always the first format in list order that works) */
+    detection_get_candidates(streamFile, init_vgmstream_functions, fcns_size, candidates);
+
+    /* try a series of formats, see which works */
+    for (pass = 1; pass >= 0; pass--) {
+        for (i =0; i < fcns_size; i++) {
+            VGMSTREAM * vgmstream;
 
+            if (candidates[i] != pass)
+                continue;
 
-        setup_vgmstream(vgmstream); /* final setup */
+            /* call init function and see if valid VGMSTREAM was returned */
+            vgmstream = (init_vgmstream_functions[i])(streamFile);
+            if (!vgmstream)
+                continue;
 
-        return vgmstream;
+            if (!prepare_vgmstream(vgmstream, streamFile, init_vgmstream_functions[i])) {
+                close_vgmstream(vgmstream);
+                continue;
+            }
+
+            setup_vgmstream(vgmstream); /* final setup */
+
+            return vgmstream;
+        }
     }
 
     /* not supported */
@@ -602,6 +641,10 @@ static VGMSTREAM * init_vgmstream_internal(STREAMFILE *streamFile) {
 
 void setup_vgmstream(VGMSTREAM * vgmstream) {
 
+    setup_vgmstream_codec(vgmstream);
+    if (vgmstream->layout_type == layout_interleave)
+        setup_layout_interleave(vgmstream);
+
     /* save start things so we can restart when seeking */
     memcpy(vgmstream->start_ch, vgmstream->ch, sizeof(VGMSTREAMCHANNEL)*vgmstream->channels);
     memcpy(vgmstream->start_vgmstream, vgmstream, sizeof(VGMSTREAM));
@@ -626,12 +669,254 @@ VGMSTREAM * init_vgmstream_from_STREAMFILE(STREAMFILE *streamFile) {
     return init_vgmstream_internal(streamFile);
 }
 
+/* format detection without setting up decoders (where metas allow it), returns info only */
+int probe_vgmstream(const char * const filename, VGMSTREAM_INFO * info) {
+    int ok = 0;
+    STREAMFILE *streamFile = open_stdio_streamfile(filename);
+    if (streamFile) {
+        ok = probe_vgmstream_from_STREAMFILE(streamFile, info);
+        close_streamfile(streamFile);
+    }
+    return ok;
+}
+
+static void get_vgmstream_info(VGMSTREAM * vgmstream, VGMSTREAM_INFO * info) {
+    memset(info, 0, sizeof(VGMSTREAM_INFO));
+    info->channels = vgmstream->channels;
+    info->sample_rate = vgmstream->sample_rate;
+    info->num_samples = vgmstream->num_samples;
+    info->loop_flag = vgmstream->loop_flag;
+    info->loop_start_sample = vgmstream->loop_start_sample;
+    info->loop_end_sample = vgmstream->loop_end_sample;
+    info->num_streams = vgmstream->num_streams;
+    info->stream_index = vgmstream->stream_index;
+    snprintf(info->stream_name, STREAM_NAME_SIZE, "%s", vgmstream->stream_name);
+    info->channel_layout = vgmstream->channel_layout;
+    info->meta_type = vgmstream->meta_type;
+    info->coding_type = vgmstream->coding_type;
+    info->layout_type = vgmstream->layout_type;
+}
+
+int probe_vgmstream_from_STREAMFILE(STREAMFILE *streamFile, VGMSTREAM_INFO * info) {
+    STREAMFILE *temp_streamFile = NULL;
+    VGMSTREAM *vgmstream = NULL;
+
+    if (!streamFile || !info)
+        goto fail;
+
+    /* flag a wrapper rather than the caller's streamfile */
+    temp_streamFile = open_wrap_streamfile(streamFile);
+    if (!temp_streamFile) goto fail;
+    temp_streamFile->probe_only = 1;
+
+    vgmstream = init_vgmstream_internal(temp_streamFile);
+    if (!vgmstream) goto fail;
+
+    get_vgmstream_info(vgmstream, info);
+
+    close_vgmstream(vgmstream);
+    close_streamfile(temp_streamFile);
+    return 1;
+fail:
+    close_vgmstream(vgmstream);
+    close_streamfile(temp_streamFile);
+    return 0;
+}
+
+/* inits a subsong from the header its meta saved, finishing it like init_vgmstream_internal */
+static VGMSTREAM * init_vgmstream_subsong_header(STREAMFILE *streamFile, VGMSTREAM_SUBSONGS * subsongs, int subsong) {
+    VGMSTREAM *vgmstream = NULL;
+    void * header = subsongs->headers + subsongs->header_size * (subsong - 1);
+
+    vgmstream = subsongs->init_header(streamFile, header);
+    if (!vgmstream) goto fail;
+
+    vgmstream->stream_index = subsong;
+    if (!prepare_vgmstream(vgmstream, streamFile, NULL))
+        goto fail;
+
+    setup_vgmstream(vgmstream);
+    return vgmstream;
+fail:
+    close_vgmstream(vgmstream);
+    return NULL;
+}
+
+/* fills subsong info from each saved header, returns 0 if the list isn't from the expected meta */
+static int get_vgmstream_subsongs_info(STREAMFILE *streamFile, VGMSTREAM_SUBSONGS * subsongs, meta_t meta_type) {
+    int i;
+
+    for (i = 0; i < subsongs->num_subsongs; i++) {
+        VGMSTREAM_SUBSONG * subsong = &subsongs->subsongs[i];
+        VGMSTREAM *vgmstream = init_vgmstream_subsong_header(streamFile, subsongs, i + 1);
+
+        if (!vgmstream || vgmstream->meta_type != meta_type) {
+            close_vgmstream(vgmstream);
+            if (i == 0) /* first subsong must open like when detected */
+                return 0;
+            continue; /* leave zeroed, as it would fail opening by index too */
+        }
+
+        get_vgmstream_info(vgmstream, &subsong->info);
+        if (!subsong->stream_size)
+            subsong->stream_size = vgmstream->stream_size;
+        close_vgmstream(vgmstream);
+    }
+
+    return 1;
+}
+
+VGMSTREAM_SUBSONGS * get_vgmstream_subsongs(STREAMFILE *streamFile) {
+    VGMSTREAM_SUBSONGS * subsongs = NULL;
+    STREAMFILE *temp_streamFile = NULL;
+    VGMSTREAM *vgmstream = NULL;
+    meta_t meta_type;
+    int i, num_streams, fcns_size;
+
+    if (!streamFile)
+        goto fail;
+
+    /* subsongs are built in probe mode (see probe_vgmstream) */
+    temp_streamFile = open_wrap_streamfile(streamFile);
+    if (!temp_streamFile) goto fail;
+    temp_streamFile->probe_only = 1;
+    temp_streamFile->stream_index = 0;
+
+    /* find format and subsong count with the default subsong */
+    vgmstream = init_vgmstream_internal(temp_streamFile);
+    if (!vgmstream) goto fail;
+
+    meta_type = vgmstream->meta_type;
+    num_streams = vgmstream->num_streams > 0 ? vgmstream->num_streams : 1;
+    close_vgmstream(vgmstream);
+    vgmstream = NULL;
+
+    /* parse all headers in one go if some meta knows this file */
+    fcns_size = (sizeof(init_subsongs_functions)/sizeof(init_subsongs_functions[0]));
+    for (i = 0; i < fcns_size; i++) {
+        subsongs = (init_subsongs_functions[i])(temp_streamFile);
+        if (!subsongs)
+            continue;
+
+        if (subsongs->num_subsongs == num_streams && get_vgmstream_subsongs_info(temp_streamFile, subsongs, meta_type))
+            break;
+
+        close_vgmstream_subsongs(subsongs);
+        subsongs = NULL;
+    }
+
+    /* otherwise open each subsong by index */
+    if (!subsongs) {
+        subsongs = allocate_vgmstream_subsongs(0, NULL);
+        if (!subsongs) goto fail;
+
+        for (i = 0; i < num_streams; i++) {
+            VGMSTREAM_SUBSONG * subsong = add_vgmstream_subsong(subsongs, NULL);
+            if (!subsong) goto fail;
+
+            temp_streamFile->stream_index = i + 1;
+            vgmstream = init_vgmstream_internal(temp_streamFile);
+            if (!vgmstream)
+                continue;
+
+            get_vgmstream_info(vgmstream, &subsong->info);
+            subsong->stream_size = vgmstream->stream_size;
+            close_vgmstream(vgmstream);
+            vgmstream = NULL;
+        }
+    }
+
+    close_streamfile(temp_streamFile);
+    return subsongs;
+fail:
+    close_vgmstream(vgmstream);
+    close_vgmstream_subsongs(subsongs);
+    close_streamfile(temp_streamFile);
+    return NULL;
+}
+
+VGMSTREAM * open_vgmstream_subsong(STREAMFILE *streamFile, VGMSTREAM_SUBSONGS * subsongs, int subsong) {
+    STREAMFILE *temp_streamFile = NULL;
+    VGMSTREAM *vgmstream = NULL;
+
+    if (!streamFile || !subsongs || subsong < 1 || subsong > subsongs->num_subsongs)
+        return NULL;
+
+    /* external streamfiles may not init probe_only */
+    temp_streamFile = open_wrap_streamfile(streamFile);
+    if (!temp_streamFile) return NULL;
+    temp_streamFile->probe_only = 0;
+
+    if (subsongs->init_header) {
+        vgmstream = init_vgmstream_subsong_header(temp_streamFile, subsongs, subsong);
+    }
+    else {
+        temp_streamFile->stream_index = subsong;
+        vgmstream = init_vgmstream_internal(temp_streamFile);
+    }
+
+    close_streamfile(temp_streamFile);
+    return vgmstream;
+}
+
+void close_vgmstream_subsongs(VGMSTREAM_SUBSONGS * subsongs) {
+    if (!subsongs)
+        return;
+
+    free(subsongs->subsongs);
+    free(subsongs->headers);
+    free(subsongs);
+}
+
+VGMSTREAM_SUBSONGS * allocate_vgmstream_subsongs(size_t header_size, VGMSTREAM * (*init_header)(STREAMFILE *streamFile, void * header)) {
+    VGMSTREAM_SUBSONGS * subsongs = calloc(1, sizeof(VGMSTREAM_SUBSONGS));
+    if (!subsongs) return NULL;
+
+    subsongs->header_size = init_header ? header_size : 0;
+    subsongs->init_header = init_header;
+    return subsongs;
+}
+
+VGMSTREAM_SUBSONG * add_vgmstream_subsong(VGMSTREAM_SUBSONGS * subsongs, const void * header) {
+    VGMSTREAM_SUBSONG * subsong;
+
+    if (subsongs->num_subsongs >= VGMSTREAM_MAX_SUBSONGS)
+        return NULL;
+
+    /* grow as needed, as metas may not know the total until the end */
+    if (subsongs->num_subsongs == subsongs->max_subsongs) {
+        int max_subsongs = subsongs->max_subsongs ? subsongs->max_subsongs * 2 : 64;
+        VGMSTREAM_SUBSONG * new_subsongs;
+
+        new_subsongs = realloc(subsongs->subsongs, max_subsongs * sizeof(VGMSTREAM_SUBSONG));
+        if (!new_subsongs) return NULL;
+        subsongs->subsongs = new_subsongs;
+
+        if (subsongs->header_size) {
+            uint8_t * new_headers = realloc(subsongs->headers, max_subsongs * subsongs->header_size);
+            if (!new_headers) return NULL;
+            subsongs->headers = new_headers;
+        }
+
+        subsongs->max_subsongs = max_subsongs;
+    }
+
+    subsong = &subsongs->subsongs[subsongs->num_subsongs];
+    memset(subsong, 0, sizeof(VGMSTREAM_SUBSONG));
+    if (subsongs->header_size)
+        memcpy(subsongs->headers + subsongs->header_size * subsongs->num_subsongs, header, subsongs->header_size);
+
+    subsongs->num_subsongs++;
+    return subsong;
+}
+
 /* Reset a VGMSTREAM to its state at the start of playback (when a plugin seeks back to zero). */
 void reset_vgmstream(VGMSTREAM * vgmstream) {
 
     /* reset the VGMSTREAM and channels back to their original state */
     memcpy(vgmstream, vgmstream->start_vgmstream, sizeof(VGMSTREAM));
     memcpy(vgmstream->ch, vgmstream->start_ch, sizeof(VGMSTREAMCHANNEL)*vgmstream->channels);
+    render_buffer_reset(vgmstream);
     /* loop_ch is not reset here because there is a possibility of the
      * init_vgmstream_* function doing something tricky and precomputing it.
      * Otherwise hit_loop will be 0 and it will be copied over anyway when we
@@ -929,6 +1214,9 @@ void close_vgmstream(VGMSTREAM * vgmstream) {
     }
 
     mixing_close(vgmstream);
+    seek_index_close(vgmstream);
+    block_index_close(vgmstream);
+    render_buffer_close(vgmstream);
     free(vgmstream->ch);
     free(vgmstream->start_ch);
     free(vgmstream->loop_ch);
@@ -996,6 +1284,9 @@ void vgmstream_force_loop(VGMSTREAM* vgmstream, int loop_flag, int loop_start_sa
 
     /* segmented layout loops with standard loop start/end values and works ok */
 
+    /* saved states may depend on old loop values */
+    seek_index_reset_loop(vgmstream);
+
     /* notify of new initial state */
     setup_vgmstream(vgmstream);
 }
@@ -1018,9 +1309,96 @@ void vgmstream_set_loop_target(VGMSTREAM* vgmstream, int loop_target) {
     setup_vgmstream(vgmstream);
 }
 
+int vgmstream_set_seek_index(VGMSTREAM* vgmstream, int32_t interval, int max_entries) {
+    int i, ok = 0;
+    if (!vgmstream) return 0;
 
-/* Decode data into sample buffer */
-void render_vgmstream(sample * buffer, int32_t sample_count, VGMSTREAM * vgmstream) {
+    /* propagate to layouts made of vgmstreams (that are seeked separately) */
+    if (vgmstream->layout_type == layout_layered) {
+        layered_layout_data *data = vgmstream->layout_data;
+        for (i = 0; i < data->layer_count; i++) {
+            ok |= vgmstream_set_seek_index(data->layers[i], interval, max_entries);
+        }
+        return ok;
+    }
+    if (vgmstream->layout_type == layout_segmented) {
+        segmented_layout_data *data = vgmstream->layout_data;
+        for (i = 0; i < data->segment_count; i++) {
+            ok |= vgmstream_set_seek_index(data->segments[i], interval, max_entries);
+        }
+        return ok;
+    }
+
+    seek_index_close(vgmstream);
+    if (interval > 0)
+        ok = seek_index_init(vgmstream, interval, max_entries);
+
+    /* keep on resets */
+    ((VGMSTREAM*)vgmstream->start_vgmstream)->seek_index = vgmstream->seek_index;
+    return ok;
+}
+
+void vgmstream_build_seek_index(VGMSTREAM* vgmstream) {
+    int i;
+    if (!vgmstream) return;
+
+    if (vgmstream->layout_type == layout_layered) {
+        layered_layout_data *data = vgmstream->layout_data;
+        for (i = 0; i < data->layer_count; i++) {
+            vgmstream_build_seek_index(data->layers[i]);
+        }
+        return;
+    }
+    if (vgmstream->layout_type == layout_segmented) {
+        segmented_layout_data *data = vgmstream->layout_data;
+        for (i = 0; i < data->segment_count; i++) {
+            vgmstream_build_seek_index(data->segments[i]);
+        }
+        return;
+    }
+
+    seek_index_build(vgmstream);
+}
+
+int vgmstream_set_layer_threads(VGMSTREAM* vgmstream, int threads) {
+    int i, ok = 0;
+    if (!vgmstream) return 0;
+
+    if (vgmstream->layout_type == layout_layered) {
+        return setup_layout_layered_threads(vgmstream->layout_data, threads);
+    }
+    if (vgmstream->layout_type == layout_segmented) {
+        segmented_layout_data *data = vgmstream->layout_data;
+        for (i = 0; i < data->segment_count; i++) {
+            ok |= vgmstream_set_layer_threads(data->segments[i], threads);
+        }
+        return ok;
+    }
+
+    return 0;
+}
+
+int vgmstream_set_segment_prefetch(VGMSTREAM* vgmstream, int32_t samples) {
+    int i, ok = 0;
+    if (!vgmstream) return 0;
+
+    if (vgmstream->layout_type == layout_segmented) {
+        return setup_layout_segmented_prefetch(vgmstream->layout_data, samples);
+    }
+    if (vgmstream->layout_type == layout_layered) {
+        layered_layout_data *data = vgmstream->layout_data;
+        for (i = 0; i < data->layer_count; i++) {
+            ok |= vgmstream_set_segment_prefetch(data->layers[i], samples);
+        }
+        return ok;
+    }
+
+    return 0;
+}
+
+
+/* Decode data into sample buffer using the layout (without mixing) */
+static void render_layout(sample * buffer, int32_t sample_count, VGMSTREAM * vgmstream) {
     switch (vgmstream->layout_type) {
         case layout_interleave:
             render_vgmstream_interleave(buffer,sample_count,vgmstream);
@@ -1077,50 +1455,302 @@ void render_vgmstream(sample * buffer, int32_t sample_count, VGMSTREAM * vgmstre
         default:
             break;
     }
+}
+
+/* Decode data into sample buffer using the layout, then mix */
+static void render_unbuffered(sample * buffer, int32_t sample_count, VGMSTREAM * vgmstream) {
+    render_layout(buffer, sample_count, vgmstream);
+
+    if (vgmstream->seek_index)
+        seek_index_update(vgmstream);
 
     mix_vgmstream(buffer, sample_count, vgmstream);
 }
 
-/* Get the number of samples of a single frame (smallest self-contained sample group, 1/N channels) */
-int get_vgmstream_samples_per_frame(VGMSTREAM * vgmstream) {
-    switch (vgmstream->coding_type) {
-        case coding_CRI_ADX:
-        case coding_CRI_ADX_fixed:
-        case coding_CRI_ADX_exp:
-        case coding_CRI_ADX_enc_8:
-        case coding_CRI_ADX_enc_9:
-            return (vgmstream->interleave_block_size - 2) * 2;
-
-        case coding_NGC_DSP:
-        case coding_NGC_DSP_subint:
-            return 14;
-        case coding_NGC_AFC:
-            return 16;
-        case coding_NGC_DTK:
-            return 28;
-        case coding_G721:
-            return 1;
+/* Decoders with float output, that can skip PCM16 in render_vgmstream_f32 (only flat layouts for now) */
+static int has_decode_f32(VGMSTREAM * vgmstream) {
+    if (vgmstream->layout_type != layout_none)
+        return 0;
 
-        case coding_PCM16LE:
-        case coding_PCM16BE:
-        case coding_PCM16_int:
-        case coding_PCM8:
-        case coding_PCM8_int:
-        case coding_PCM8_U:
-        case coding_PCM8_U_int:
-        case coding_PCM8_SB:
-        case coding_ULAW:
-        case coding_ULAW_int:
-        case coding_ALAW:
-        case coding_PCMFLOAT:
+    switch (vgmstream->coding_type) {
+#ifdef VGM_USE_FFMPEG
+        case coding_FFmpeg:
             return 1;
-#ifdef VGM_USE_VORBIS
-        case coding_OGG_VORBIS:
-        case coding_VORBIS_custom:
 #endif
-#ifdef VGM_USE_MPEG
-        case coding_MPEG_custom:
-        case coding_MPEG_ealayer3:
+        default:
+            return 0;
+    }
+}
+
+/* Decode data into float sample buffer using the layout, then mix */
+static void render_unbuffered_f32(float * buffer, int32_t sample_count, VGMSTREAM * vgmstream) {
+    switch (vgmstream->layout_type) {
+        case layout_segmented:
+            render_vgmstream_segmented_f32(buffer,sample_count,vgmstream);
+            break;
+        case layout_layered:
+            render_vgmstream_layered_f32(buffer,sample_count,vgmstream);
+            break;
+        default: {
+            int32_t i, count = sample_count * vgmstream->channels;
+            sample * pcmbuf = (sample *)buffer + count;
+
+            if (has_decode_f32(vgmstream)) {
+                render_vgmstream_flat_f32(buffer,sample_count,vgmstream);
+                break;
+            }
+
+            /* Other decoders output PCM16, so render into the upper half of the buffer (float buffer
+             * is twice as big) then expand forward: each float only overwrites PCM16 samples
+             * that were already read, so no extra buffer is needed. */
+            render_layout(pcmbuf, sample_count, vgmstream);
+
+            for (i = 0; i < count; i++) {
+                buffer[i] = pcmbuf[i] * (1.0f / 32768.0f);
+            }
+            break;
+        }
+    }
+
+    if (vgmstream->seek_index)
+        seek_index_update(vgmstream);
+
+    mix_vgmstream_f32(buffer, sample_count, vgmstream);
+}
+
+
+#define VGMSTREAM_RENDER_BUFFER_MAX 0x8000
+
+/* Render buffer: renders chunks of max_samples and serves smaller calls from them, so fixed costs of
+ * each render (layout/mixing setup, partial frames, etc) are paid once per chunk. Buffered samples
+ * were already rendered, so the VGMSTREAM is ahead of the caller until they are used. */
+typedef struct {
+    void* buffer;           /* rendered samples (PCM16 or float) */
+    int32_t max_samples;    /* samples per chunk */
+    int buffer_channels;    /* channels the buffer can hold */
+    int channels;           /* channels of buffered samples (after mixing) */
+    int is_f32;             /* format of buffered samples */
+    int32_t filled;         /* buffered samples */
+    int32_t consumed;       /* buffered samples already returned */
+} render_buffer_data;
+
+static void render_buffer_close(VGMSTREAM * vgmstream) {
+    render_buffer_data* data = vgmstream->render_buffer;
+    if (!data) return;
+
+    free(data->buffer);
+    free(data);
+    vgmstream->render_buffer = NULL;
+    ((VGMSTREAM*)vgmstream->start_vgmstream)->render_buffer = NULL;
+}
+
+static void render_buffer_reset(VGMSTREAM * vgmstream) {
+    render_buffer_data* data = vgmstream->render_buffer;
+    if (!data) return;
+
+    data->filled = 0;
+    data->consumed = 0;
+}
+
+/* Samples left until the stream stops (-1 if it loops forever), as layouts may not handle
+ * rendering past the end. */
+static int32_t get_samples_to_end(VGMSTREAM * vgmstream) {
+    int64_t samples;
+
+    if (!vgmstream->loop_flag)
+        return vgmstream->num_samples - vgmstream->current_sample;
+    if (!vgmstream->loop_target)
+        return -1;
+
+    /* rest of this pass + remaining loops + stream end after the last loop */
+    samples = (int64_t)(vgmstream->loop_end_sample - vgmstream->current_sample)
+            + (int64_t)(vgmstream->loop_target - vgmstream->loop_count - 1) * (vgmstream->loop_end_sample - vgmstream->loop_start_sample)
+            + (vgmstream->num_samples - vgmstream->loop_end_sample);
+    if (samples > 0x7FFFFFFF)
+        return -1;
+    return (int32_t)samples;
+}
+
+/* Render a full chunk into the buffer. Returns 0 if not possible (near stream end, etc). */
+static int render_buffer_fill(VGMSTREAM * vgmstream, render_buffer_data* data, int is_f32) {
+    int input_channels = vgmstream->channels, output_channels = vgmstream->channels;
+    int32_t samples_to_end = get_samples_to_end(vgmstream);
+
+    if (samples_to_end >= 0 && samples_to_end < data->max_samples)
+        return 0;
+
+    mixing_info(vgmstream, &input_channels, &output_channels);
+    if (input_channels > data->buffer_channels) {
+        void* buffer_re = realloc(data->buffer, data->max_samples * input_channels * sizeof(float));
+        if (!buffer_re) return 0;
+        data->buffer = buffer_re;
+        data->buffer_channels = input_channels;
+    }
+
+    /* chunks may be bigger than the caller's max for mixing */
+    if (!mixing_reserve(vgmstream, data->max_samples))
+        return 0;
+
+    if (is_f32)
+        render_unbuffered_f32(data->buffer, data->max_samples, vgmstream);
+    else
+        render_unbuffered(data->buffer, data->max_samples, vgmstream);
+
+    data->channels = mixing_output_channels(vgmstream);
+    data->is_f32 = is_f32;
+    data->filled = data->max_samples;
+    data->consumed = 0;
+    return 1;
+}
+
+/* Copy buffered samples, converting if the caller switched between PCM16 and float. */
+static void render_buffer_copy(render_buffer_data* data, void * buffer, int32_t samples_done, int32_t samples_to_do, int is_f32) {
+    int32_t i;
+    int32_t count = samples_to_do * data->channels;
+    int32_t src_pos = data->consumed * data->channels;
+    int32_t dst_pos = samples_done * data->channels;
+
+    if (is_f32 && data->is_f32) {
+        memcpy((float*)buffer + dst_pos, (float*)data->buffer + src_pos, count * sizeof(float));
+    }
+    else if (!is_f32 && !data->is_f32) {
+        memcpy((sample*)buffer + dst_pos, (sample*)data->buffer + src_pos, count * sizeof(sample));
+    }
+    else if (is_f32) {
+        float* dst = (float*)buffer + dst_pos;
+        sample* src = (sample*)data->buffer + src_pos;
+        for (i = 0; i < count; i++) {
+            dst[i] = src[i] * (1.0f / 32768.0f);
+        }
+    }
+    else {
+        sample* dst = (sample*)buffer + dst_pos;
+        float* src = (float*)data->buffer + src_pos;
+        for (i = 0; i < count; i++) {
+            dst[i] = clamp16((int32_t)(src[i] * 32768.0f));
+        }
+    }
+
+    data->consumed += samples_to_do;
+}
+
+static void render_buffered(void * buffer, int32_t sample_count, VGMSTREAM * vgmstream, int is_f32) {
+    render_buffer_data* data = vgmstream->render_buffer;
+    int32_t samples_done = 0;
+    int output_channels = mixing_output_channels(vgmstream);
+
+    /* mixing changed after buffering */
+    if (data->consumed < data->filled && data->channels != output_channels)
+        render_buffer_reset(vgmstream);
+
+    while (samples_done < sample_count) {
+        int32_t samples_to_do = sample_count - samples_done;
+
+        if (data->consumed == data->filled) {
+            /* big calls (or ones near the end) don't need the buffer */
+            if (samples_to_do >= data->max_samples || !render_buffer_fill(vgmstream, data, is_f32)) {
+                if (is_f32)
+                    render_unbuffered_f32((float*)buffer + samples_done * output_channels, samples_to_do, vgmstream);
+                else
+                    render_unbuffered((sample*)buffer + samples_done * output_channels, samples_to_do, vgmstream);
+                break;
+            }
+        }
+
+        if (samples_to_do > data->filled - data->consumed)
+            samples_to_do = data->filled - data->consumed;
+
+        render_buffer_copy(data, buffer, samples_done, samples_to_do, is_f32);
+        samples_done += samples_to_do;
+    }
+}
+
+/* Decode data into sample buffer */
+void render_vgmstream(sample * buffer, int32_t sample_count, VGMSTREAM * vgmstream) {
+    if (vgmstream->render_buffer) {
+        render_buffered(buffer, sample_count, vgmstream, 0);
+        return;
+    }
+
+    render_unbuffered(buffer, sample_count, vgmstream);
+}
+
+/* Decode data into float sample buffer */
+void render_vgmstream_f32(float * buffer, int32_t sample_count, VGMSTREAM * vgmstream) {
+    if (vgmstream->render_buffer) {
+        render_buffered(buffer, sample_count, vgmstream, 1);
+        return;
+    }
+
+    render_unbuffered_f32(buffer, sample_count, vgmstream);
+}
+
+int vgmstream_set_render_buffer(VGMSTREAM* vgmstream, int32_t samples) {
+    render_buffer_data* data = NULL;
+    if (!vgmstream) return 0;
+
+    render_buffer_close(vgmstream);
+    if (samples <= 0)
+        return 0;
+    if (samples > VGMSTREAM_RENDER_BUFFER_MAX)
+        samples = VGMSTREAM_RENDER_BUFFER_MAX;
+
+    data = calloc(1, sizeof(render_buffer_data));
+    if (!data) goto fail;
+
+    data->max_samples = samples;
+
+    vgmstream->render_buffer = data;
+    ((VGMSTREAM*)vgmstream->start_vgmstream)->render_buffer = data;
+    return 1;
+fail:
+    free(data);
+    return 0;
+}
+
+/* Get the number of samples of a single frame (smallest self-contained sample group, 1/N channels) */
+int get_vgmstream_samples_per_frame(VGMSTREAM * vgmstream) {
+    if (vgmstream->codec_info_set)
+        return vgmstream->codec_samples_per_frame;
+
+    switch (vgmstream->coding_type) {
+        case coding_CRI_ADX:
+        case coding_CRI_ADX_fixed:
+        case coding_CRI_ADX_exp:
+        case coding_CRI_ADX_enc_8:
+        case coding_CRI_ADX_enc_9:
+            return (vgmstream->interleave_block_size - 2) * 2;
+
+        case coding_NGC_DSP:
+        case coding_NGC_DSP_subint:
+            return 14;
+        case coding_NGC_AFC:
+            return 16;
+        case coding_NGC_DTK:
+            return 28;
+        case coding_G721:
+            return 1;
+
+        case coding_PCM16LE:
+        case coding_PCM16BE:
+        case coding_PCM16_int:
+        case coding_PCM8:
+        case coding_PCM8_int:
+        case coding_PCM8_U:
+        case coding_PCM8_U_int:
+        case coding_PCM8_SB:
+        case coding_ULAW:
+        case coding_ULAW_int:
+        case coding_ALAW:
+        case coding_PCMFLOAT:
+            return 1;
+#ifdef VGM_USE_VORBIS
+        case coding_OGG_VORBIS:
+        case coding_VORBIS_custom:
+#endif
+#ifdef VGM_USE_MPEG
+        case coding_MPEG_custom:
+        case coding_MPEG_ealayer3:
         case coding_MPEG_layer1:
         case coding_MPEG_layer2:
         case coding_MPEG_layer3:
@@ -1277,6 +1907,9 @@ int get_vgmstream_samples_per_frame(VGMSTREAM * vgmstream) {
 
 /* Get the number of bytes of a single frame (smallest self-contained byte group, 1/N channels) */
 int get_vgmstream_frame_size(VGMSTREAM * vgmstream) {
+    if (vgmstream->codec_info_set)
+        return vgmstream->codec_frame_size;
+
     switch (vgmstream->coding_type) {
         case coding_CRI_ADX:
         case coding_CRI_ADX_fixed:
@@ -1464,11 +2097,104 @@ int get_vgmstream_shortframe_size(VGMSTREAM * vgmstream) {
     }
 }
 
+/* Get the decoder of codecs that decode each channel the same way and need no other config
+ * (others are handled in decode_vgmstream). */
+static decode_channel_t get_vgmstream_decode_channel(VGMSTREAM * vgmstream) {
+    switch (vgmstream->coding_type) {
+        case coding_NGC_DSP:
+            return decode_ngc_dsp;
+        case coding_PCM16LE:
+            return decode_pcm16le;
+        case coding_PCM16BE:
+            return decode_pcm16be;
+        case coding_PCM8:
+            return decode_pcm8;
+        case coding_PCM8_int:
+            return decode_pcm8_int;
+        case coding_PCM8_U:
+            return decode_pcm8_unsigned;
+        case coding_PCM8_U_int:
+            return decode_pcm8_unsigned_int;
+        case coding_PCM8_SB:
+            return decode_pcm8_sb;
+        case coding_ULAW:
+            return decode_ulaw;
+        case coding_ULAW_int:
+            return decode_ulaw_int;
+        case coding_ALAW:
+            return decode_alaw;
+        case coding_NDS_IMA:
+            return decode_nds_ima;
+        case coding_DAT4_IMA:
+            return decode_dat4_ima;
+        case coding_RAD_IMA_mono:
+            return decode_rad_ima_mono;
+        case coding_G721:
+            return decode_g721;
+        case coding_NGC_AFC:
+            return decode_ngc_afc;
+        case coding_HEVAG:
+            return decode_hevag;
+        case coding_SDX2:
+            return decode_sdx2;
+        case coding_SDX2_int:
+            return decode_sdx2_int;
+        case coding_CBD2:
+            return decode_cbd2;
+        case coding_CBD2_int:
+            return decode_cbd2_int;
+        case coding_DERF:
+            return decode_derf;
+        case coding_CIRCUS_ADPCM:
+            return decode_circus_adpcm;
+        case coding_3DS_IMA:
+            return decode_3ds_ima;
+        case coding_WV6_IMA:
+            return decode_wv6_ima;
+        case coding_ALP_IMA:
+            return decode_alp_ima;
+        case coding_FFTA2_IMA:
+            return decode_ffta2_ima;
+        case coding_BLITZ_IMA:
+            return decode_blitz_ima;
+        case coding_APPLE_IMA4:
+            return decode_apple_ima4;
+        case coding_AWC_IMA:
+            return decode_awc_ima;
+        case coding_NXAP:
+            return decode_nxap;
+        case coding_NDS_PROCYON:
+            return decode_nds_procyon;
+        case coding_L5_555:
+            return decode_l5_555;
+        case coding_SASSC:
+            return decode_sassc;
+        case coding_LSF:
+            return decode_lsf;
+        case coding_FADPCM:
+            return decode_fadpcm;
+        case coding_ASF:
+            return decode_asf;
+        case coding_DSA:
+            return decode_dsa;
+        default:
+            return NULL;
+    }
+}
+
 /* Decode samples into the buffer. Assume that we have written samples_written into the
  * buffer already, and we have samples_to_do consecutive samples ahead of us. */
 void decode_vgmstream(VGMSTREAM * vgmstream, int samples_written, int samples_to_do, sample_t * buffer) {
     int ch;
 
+    if (vgmstream->codec_decode_channel) {
+        for (ch = 0; ch < vgmstream->channels; ch++) {
+            vgmstream->codec_decode_channel(&vgmstream->ch[ch],buffer+samples_written*vgmstream->channels+ch,
+                    vgmstream->channels,vgmstream->samples_into_block,samples_to_do);
+        }
+        return;
+    }
+
     switch (vgmstream->coding_type) {
         case coding_CRI_ADX:
             for (ch = 0; ch < vgmstream->channels; ch++) {
@@ -1502,12 +2228,6 @@ void decode_vgmstream(VGMSTREAM * vgmstream, int samples_written, int samples_to
                         vgmstream->interleave_block_size);
             }
 
-            break;
-        case coding_NGC_DSP:
-            for (ch = 0; ch < vgmstream->channels; ch++) {
-                decode_ngc_dsp(&vgmstream->ch[ch],buffer+samples_written*vgmstream->channels+ch,
-                        vgmstream->channels,vgmstream->samples_into_block,samples_to_do);
-            }
             break;
         case coding_NGC_DSP_subint:
             for (ch = 0; ch < vgmstream->channels; ch++) {
@@ -1517,18 +2237,6 @@ void decode_vgmstream(VGMSTREAM * vgmstream, int samples_written, int samples_to
             }
             break;
 
-        case coding_PCM16LE:
-            for (ch = 0; ch < vgmstream->channels; ch++) {
-                decode_pcm16le(&vgmstream->ch[ch],buffer+samples_written*vgmstream->channels+ch,
-                        vgmstream->channels,vgmstream->samples_into_block,samples_to_do);
-            }
-            break;
-        case coding_PCM16BE:
-            for (ch = 0; ch < vgmstream->channels; ch++) {
-                decode_pcm16be(&vgmstream->ch[ch],buffer+samples_written*vgmstream->channels+ch,
-                        vgmstream->channels,vgmstream->samples_into_block,samples_to_do);
-            }
-            break;
         case coding_PCM16_int:
             for (ch = 0; ch < vgmstream->channels; ch++) {
                 decode_pcm16_int(&vgmstream->ch[ch],buffer+samples_written*vgmstream->channels+ch,
@@ -1536,36 +2244,6 @@ void decode_vgmstream(VGMSTREAM * vgmstream, int samples_written, int samples_to
                         vgmstream->codec_endian);
             }
             break;
-        case coding_PCM8:
-            for (ch = 0; ch < vgmstream->channels; ch++) {
-                decode_pcm8(&vgmstream->ch[ch],buffer+samples_written*vgmstream->channels+ch,
-                        vgmstream->channels,vgmstream->samples_into_block,samples_to_do);
-            }
-            break;
-        case coding_PCM8_int:
-            for (ch = 0; ch < vgmstream->channels; ch++) {
-                decode_pcm8_int(&vgmstream->ch[ch],buffer+samples_written*vgmstream->channels+ch,
-                        vgmstream->channels,vgmstream->samples_into_block,samples_to_do);
-            }
-            break;
-        case coding_PCM8_U:
-            for (ch = 0; ch < vgmstream->channels; ch++) {
-                decode_pcm8_unsigned(&vgmstream->ch[ch],buffer+samples_written*vgmstream->channels+ch,
-                        vgmstream->channels,vgmstream->samples_into_block,samples_to_do);
-            }
-            break;
-        case coding_PCM8_U_int:
-            for (ch = 0; ch < vgmstream->channels; ch++) {
-                decode_pcm8_unsigned_int(&vgmstream->ch[ch],buffer+samples_written*vgmstream->channels+ch,
-                        vgmstream->channels,vgmstream->samples_into_block,samples_to_do);
-            }
-            break;
-        case coding_PCM8_SB:
-            for (ch = 0; ch < vgmstream->channels; ch++) {
-                decode_pcm8_sb(&vgmstream->ch[ch],buffer+samples_written*vgmstream->channels+ch,
-                        vgmstream->channels,vgmstream->samples_into_block,samples_to_do);
-            }
-            break;
         case coding_PCM4:
             for (ch = 0; ch < vgmstream->channels; ch++) {
                 decode_pcm4(vgmstream,&vgmstream->ch[ch],buffer+samples_written*vgmstream->channels+ch,
@@ -1579,24 +2257,6 @@ void decode_vgmstream(VGMSTREAM * vgmstream, int samples_written, int samples_to
             }
             break;
 
-        case coding_ULAW:
-            for (ch = 0; ch < vgmstream->channels; ch++) {
-                decode_ulaw(&vgmstream->ch[ch],buffer+samples_written*vgmstream->channels+ch,
-                        vgmstream->channels,vgmstream->samples_into_block,samples_to_do);
-            }
-            break;
-        case coding_ULAW_int:
-            for (ch = 0; ch < vgmstream->channels; ch++) {
-                decode_ulaw_int(&vgmstream->ch[ch],buffer+samples_written*vgmstream->channels+ch,
-                        vgmstream->channels,vgmstream->samples_into_block,samples_to_do);
-            }
-            break;
-        case coding_ALAW:
-            for (ch = 0; ch < vgmstream->channels; ch++) {
-                decode_alaw(&vgmstream->ch[ch],buffer+samples_written*vgmstream->channels+ch,
-                        vgmstream->channels,vgmstream->samples_into_block,samples_to_do);
-            }
-            break;
         case coding_PCMFLOAT:
             for (ch = 0; ch < vgmstream->channels; ch++) {
                 decode_pcmfloat(&vgmstream->ch[ch],buffer+samples_written*vgmstream->channels+ch,
@@ -1605,18 +2265,6 @@ void decode_vgmstream(VGMSTREAM * vgmstream, int samples_written, int samples_to
             }
             break;
 
-        case coding_NDS_IMA:
-            for (ch = 0; ch < vgmstream->channels; ch++) {
-                decode_nds_ima(&vgmstream->ch[ch],buffer+samples_written*vgmstream->channels+ch,
-                        vgmstream->channels,vgmstream->samples_into_block,samples_to_do);
-            }
-            break;
-        case coding_DAT4_IMA:
-            for (ch = 0; ch < vgmstream->channels; ch++) {
-                decode_dat4_ima(&vgmstream->ch[ch],buffer+samples_written*vgmstream->channels+ch,
-                        vgmstream->channels,vgmstream->samples_into_block,samples_to_do);
-            }
-            break;
         case coding_XBOX_IMA:
         case coding_XBOX_IMA_int:
             for (ch = 0; ch < vgmstream->channels; ch++) {
@@ -1644,30 +2292,12 @@ void decode_vgmstream(VGMSTREAM * vgmstream, int samples_written, int samples_to
                         vgmstream->channels,vgmstream->samples_into_block,samples_to_do, ch);
             }
             break;
-        case coding_RAD_IMA_mono:
-            for (ch = 0; ch < vgmstream->channels; ch++) {
-                decode_rad_ima_mono(&vgmstream->ch[ch],buffer+samples_written*vgmstream->channels+ch,
-                        vgmstream->channels,vgmstream->samples_into_block,samples_to_do);
-            }
-            break;
         case coding_NGC_DTK:
             for (ch = 0; ch < vgmstream->channels; ch++) {
                 decode_ngc_dtk(&vgmstream->ch[ch],buffer+samples_written*vgmstream->channels+ch,
                         vgmstream->channels,vgmstream->samples_into_block,samples_to_do, ch);
             }
             break;
-        case coding_G721:
-            for (ch = 0; ch < vgmstream->channels; ch++) {
-                decode_g721(&vgmstream->ch[ch],buffer+samples_written*vgmstream->channels+ch,
-                        vgmstream->channels,vgmstream->samples_into_block,samples_to_do);
-            }
-            break;
-        case coding_NGC_AFC:
-            for (ch = 0; ch < vgmstream->channels; ch++) {
-                decode_ngc_afc(&vgmstream->ch[ch],buffer+samples_written*vgmstream->channels+ch,
-                        vgmstream->channels,vgmstream->samples_into_block,samples_to_do);
-            }
-            break;
         case coding_PSX:
             for (ch = 0; ch < vgmstream->channels; ch++) {
                 decode_psx(&vgmstream->ch[ch],buffer+samples_written*vgmstream->channels+ch,
@@ -1686,12 +2316,6 @@ void decode_vgmstream(VGMSTREAM * vgmstream, int samples_written, int samples_to
                         vgmstream->channels,vgmstream->samples_into_block,samples_to_do, vgmstream->interleave_block_size);
             }
             break;
-        case coding_HEVAG:
-            for (ch = 0; ch < vgmstream->channels; ch++) {
-                decode_hevag(&vgmstream->ch[ch],buffer+samples_written*vgmstream->channels+ch,
-                        vgmstream->channels,vgmstream->samples_into_block,samples_to_do);
-            }
-            break;
         case coding_XA:
             for (ch = 0; ch < vgmstream->channels; ch++) {
                 decode_xa(&vgmstream->ch[ch],buffer+samples_written*vgmstream->channels+ch,
@@ -1761,43 +2385,6 @@ void decode_vgmstream(VGMSTREAM * vgmstream, int samples_written, int samples_to
                     samples_to_do,vgmstream->channels);
             break;
 #endif
-        case coding_SDX2:
-            for (ch = 0; ch < vgmstream->channels; ch++) {
-                decode_sdx2(&vgmstream->ch[ch],buffer+samples_written*vgmstream->channels+ch,
-                        vgmstream->channels,vgmstream->samples_into_block,samples_to_do);
-            }
-            break;
-        case coding_SDX2_int:
-            for (ch = 0; ch < vgmstream->channels; ch++) {
-                decode_sdx2_int(&vgmstream->ch[ch],buffer+samples_written*vgmstream->channels+ch,
-                        vgmstream->channels,vgmstream->samples_into_block,samples_to_do);
-            }
-            break;
-        case coding_CBD2:
-            for (ch = 0; ch < vgmstream->channels; ch++) {
-                decode_cbd2(&vgmstream->ch[ch],buffer+samples_written*vgmstream->channels+ch,
-                        vgmstream->channels,vgmstream->samples_into_block,samples_to_do);
-            }
-            break;
-        case coding_CBD2_int:
-            for (ch = 0; ch < vgmstream->channels; ch++) {
-                decode_cbd2_int(&vgmstream->ch[ch],buffer+samples_written*vgmstream->channels+ch,
-                        vgmstream->channels,vgmstream->samples_into_block,samples_to_do);
-            }
-            break;
-        case coding_DERF:
-            for (ch = 0; ch < vgmstream->channels; ch++) {
-                decode_derf(&vgmstream->ch[ch],buffer+samples_written*vgmstream->channels+ch,
-                        vgmstream->channels,vgmstream->samples_into_block,samples_to_do);
-            }
-            break;
-        case coding_CIRCUS_ADPCM:
-            for (ch = 0; ch < vgmstream->channels; ch++) {
-                decode_circus_adpcm(&vgmstream->ch[ch],buffer+samples_written*vgmstream->channels+ch,
-                        vgmstream->channels,vgmstream->samples_into_block,samples_to_do);
-            }
-            break;
-
         case coding_IMA:
         case coding_IMA_int:
         case coding_DVI_IMA:
@@ -1812,43 +2399,6 @@ void decode_vgmstream(VGMSTREAM * vgmstream, int samples_written, int samples_to
                         is_stereo, is_high_first);
             }
             break;
-        case coding_3DS_IMA:
-            for (ch = 0; ch < vgmstream->channels; ch++) {
-                decode_3ds_ima(&vgmstream->ch[ch],buffer+samples_written*vgmstream->channels+ch,
-                        vgmstream->channels,vgmstream->samples_into_block,samples_to_do);
-            }
-            break;
-        case coding_WV6_IMA:
-            for (ch = 0; ch < vgmstream->channels; ch++) {
-                decode_wv6_ima(&vgmstream->ch[ch],buffer+samples_written*vgmstream->channels+ch,
-                        vgmstream->channels,vgmstream->samples_into_block,samples_to_do);
-            }
-            break;
-        case coding_ALP_IMA:
-            for (ch = 0; ch < vgmstream->channels; ch++) {
-                decode_alp_ima(&vgmstream->ch[ch],buffer+samples_written*vgmstream->channels+ch,
-                        vgmstream->channels,vgmstream->samples_into_block,samples_to_do);
-            }
-            break;
-        case coding_FFTA2_IMA:
-            for (ch = 0; ch < vgmstream->channels; ch++) {
-                decode_ffta2_ima(&vgmstream->ch[ch],buffer+samples_written*vgmstream->channels+ch,
-                        vgmstream->channels,vgmstream->samples_into_block,samples_to_do);
-            }
-            break;
-        case coding_BLITZ_IMA:
-            for (ch = 0; ch < vgmstream->channels; ch++) {
-                decode_blitz_ima(&vgmstream->ch[ch],buffer+samples_written*vgmstream->channels+ch,
-                        vgmstream->channels,vgmstream->samples_into_block,samples_to_do);
-            }
-            break;
-
-        case coding_APPLE_IMA4:
-            for (ch = 0; ch < vgmstream->channels; ch++) {
-                decode_apple_ima4(&vgmstream->ch[ch],buffer+samples_written*vgmstream->channels+ch,
-                        vgmstream->channels,vgmstream->samples_into_block,samples_to_do);
-            }
-            break;
         case coding_SNDS_IMA:
             for (ch = 0; ch < vgmstream->channels; ch++) {
                 decode_snds_ima(&vgmstream->ch[ch],buffer+samples_written*vgmstream->channels+ch,
@@ -1879,12 +2429,6 @@ void decode_vgmstream(VGMSTREAM * vgmstream, int samples_written, int samples_to
                         vgmstream->channels,vgmstream->samples_into_block,samples_to_do, ch);
             }
             break;
-        case coding_AWC_IMA:
-            for (ch = 0; ch < vgmstream->channels; ch++) {
-                decode_awc_ima(&vgmstream->ch[ch],buffer+samples_written*vgmstream->channels+ch,
-                        vgmstream->channels,vgmstream->samples_into_block,samples_to_do);
-            }
-            break;
         case coding_UBI_IMA:
             for (ch = 0; ch < vgmstream->channels; ch++) {
                 decode_ubi_ima(&vgmstream->ch[ch],buffer+samples_written*vgmstream->channels+ch,
@@ -1997,37 +2541,6 @@ void decode_vgmstream(VGMSTREAM * vgmstream, int samples_written, int samples_to
                         vgmstream->channels,vgmstream->samples_into_block,samples_to_do, ch);
             }
             break;
-        case coding_NXAP:
-            for (ch = 0; ch < vgmstream->channels; ch++) {
-                decode_nxap(&vgmstream->ch[ch],buffer+samples_written*vgmstream->channels+ch,
-                        vgmstream->channels,vgmstream->samples_into_block,samples_to_do);
-            }
-            break;
-        case coding_NDS_PROCYON:
-            for (ch = 0; ch < vgmstream->channels; ch++) {
-                decode_nds_procyon(&vgmstream->ch[ch],buffer+samples_written*vgmstream->channels+ch,
-                        vgmstream->channels,vgmstream->samples_into_block,samples_to_do);
-            }
-            break;
-        case coding_L5_555:
-            for (ch = 0; ch < vgmstream->channels; ch++) {
-                decode_l5_555(&vgmstream->ch[ch],buffer+samples_written*vgmstream->channels+ch,
-                        vgmstream->channels,vgmstream->samples_into_block,samples_to_do);
-            }
-            break;
-        case coding_SASSC:
-            for (ch = 0; ch < vgmstream->channels; ch++) {
-                decode_sassc(&vgmstream->ch[ch],buffer+samples_written*vgmstream->channels+ch,
-                        vgmstream->channels,vgmstream->samples_into_block,samples_to_do);
-            }
-
-            break;
-        case coding_LSF:
-            for (ch = 0; ch < vgmstream->channels; ch++) {
-                decode_lsf(&vgmstream->ch[ch],buffer+samples_written*vgmstream->channels+ch,
-                        vgmstream->channels,vgmstream->samples_into_block,samples_to_do);
-            }
-            break;
         case coding_MTAF:
             for (ch = 0; ch < vgmstream->channels; ch++) {
                 decode_mtaf(&vgmstream->ch[ch],buffer+samples_written*vgmstream->channels+ch,
@@ -2046,24 +2559,6 @@ void decode_vgmstream(VGMSTREAM * vgmstream, int samples_written, int samples_to
                         vgmstream->channels, vgmstream->samples_into_block, samples_to_do, ch);
             }
             break;
-        case coding_FADPCM:
-            for (ch = 0; ch < vgmstream->channels; ch++) {
-                decode_fadpcm(&vgmstream->ch[ch],buffer+samples_written*vgmstream->channels+ch,
-                        vgmstream->channels,vgmstream->samples_into_block,samples_to_do);
-            }
-            break;
-        case coding_ASF:
-            for (ch = 0; ch < vgmstream->channels; ch++) {
-                decode_asf(&vgmstream->ch[ch],buffer+samples_written*vgmstream->channels+ch,
-                        vgmstream->channels,vgmstream->samples_into_block,samples_to_do);
-            }
-            break;
-        case coding_DSA:
-            for (ch = 0; ch < vgmstream->channels; ch++) {
-                decode_dsa(&vgmstream->ch[ch],buffer+samples_written*vgmstream->channels+ch,
-                        vgmstream->channels,vgmstream->samples_into_block,samples_to_do);
-            }
-            break;
         case coding_XMD:
             for (ch = 0; ch < vgmstream->channels; ch++) {
                 decode_xmd(&vgmstream->ch[ch],buffer+samples_written*vgmstream->channels+ch,
@@ -2090,7 +2585,77 @@ void decode_vgmstream(VGMSTREAM * vgmstream, int samples_written, int samples_to
                         vgmstream->channels, samples_to_do, ch);
             }
             break;
+        default: {
+            /* common per-channel decoders, normally resolved on setup */
+            decode_channel_t decode_channel = get_vgmstream_decode_channel(vgmstream);
+            if (!decode_channel)
+                break;
+            for (ch = 0; ch < vgmstream->channels; ch++) {
+                decode_channel(&vgmstream->ch[ch],buffer+samples_written*vgmstream->channels+ch,
+                        vgmstream->channels,vgmstream->samples_into_block,samples_to_do);
+            }
+            break;
+        }
+    }
+}
+
+/* Same as decode_vgmstream into a float buffer, for decoders in has_decode_f32. */
+void decode_vgmstream_f32(VGMSTREAM * vgmstream, int samples_written, int samples_to_do, float * buffer) {
+    switch (vgmstream->coding_type) {
+#ifdef VGM_USE_FFMPEG
+        case coding_FFmpeg:
+            decode_ffmpeg_f32(vgmstream,
+                          buffer+samples_written*vgmstream->channels,samples_to_do,vgmstream->channels);
+            break;
+#endif
+        default:
+            memset(buffer+samples_written*vgmstream->channels, 0, samples_to_do*vgmstream->channels*sizeof(float));
+            break;
+    }
+}
+
+/* Decoders that can be called with any number of samples in a block, reading frames as needed.
+ * Others get one frame per call at most. */
+static int decode_multiple_frames(VGMSTREAM * vgmstream) {
+    if (vgmstream->codec_info_set)
+        return vgmstream->codec_multiple_frames;
+
+    switch (vgmstream->coding_type) {
+        case coding_NGC_DSP:
+        case coding_NGC_DSP_subint:
+        case coding_PSX:
+        case coding_PSX_badflags:
+        case coding_PSX_cfg:
+        case coding_IMA_int:
+        case coding_DVI_IMA_int:
+        case coding_3DS_IMA:
+        case coding_WV6_IMA:
+        case coding_ALP_IMA:
+        case coding_FFTA2_IMA:
+        case coding_BLITZ_IMA:
+            return 1;
+        default:
+            return 0;
+    }
+}
+
+/* Saves codec values that would otherwise need a switch on coding_type for every decode/layout call */
+static void setup_vgmstream_codec(VGMSTREAM * vgmstream) {
+    vgmstream->codec_info_set = 0; /* getters below do the switches */
+
+    vgmstream->codec_frame_size = get_vgmstream_frame_size(vgmstream);
+    vgmstream->codec_samples_per_frame = get_vgmstream_samples_per_frame(vgmstream);
+    vgmstream->codec_multiple_frames = decode_multiple_frames(vgmstream);
+    vgmstream->codec_decode_channel = get_vgmstream_decode_channel(vgmstream);
+
+    switch (vgmstream->coding_type) {
+        case coding_WS: /* frames depend on the current block */
+#ifdef VGM_USE_MAIATRAC3PLUS
+        case coding_AT3plus: /* first frame varies after seeking */
+#endif
+            break;
         default:
+            vgmstream->codec_info_set = 1;
             break;
     }
 }
@@ -2120,13 +2685,105 @@ int vgmstream_samples_to_do(int samples_this_block, int samples_per_frame, VGMST
 
     }
 
-    /* if it's a framed encoding don't do more than one frame */
-    if (samples_per_frame > 1 && (vgmstream->samples_into_block % samples_per_frame) + samples_to_do > samples_per_frame)
+    /* if it's a framed encoding don't do more than one frame (unless the decoder handles many) */
+    if (samples_per_frame > 1 && !decode_multiple_frames(vgmstream) &&
+            (vgmstream->samples_into_block % samples_per_frame) + samples_to_do > samples_per_frame)
         samples_to_do = samples_per_frame - (vgmstream->samples_into_block % samples_per_frame);
 
     return samples_to_do;
 }
 
+/* Prepare codecs with internal state to play from some sample. Some also adjust loop_ch offsets,
+ * as they expect a loop restore (loop_ch copied into ch) right after. */
+static void seek_codec(VGMSTREAM * vgmstream, int32_t seek_sample) {
+    if (vgmstream->coding_type == coding_CRI_HCA) {
+        loop_hca(vgmstream->codec_data, seek_sample);
+    }
+
+    if (vgmstream->coding_type == coding_EA_MT) {
+        seek_ea_mt(vgmstream, seek_sample);
+    }
+
+#ifdef VGM_USE_VORBIS
+    if (vgmstream->coding_type == coding_OGG_VORBIS) {
+        seek_ogg_vorbis(vgmstream, seek_sample);
+    }
+
+    if (vgmstream->coding_type == coding_VORBIS_custom) {
+        seek_vorbis_custom(vgmstream, seek_sample);
+    }
+#endif
+
+#ifdef VGM_USE_FFMPEG
+    if (vgmstream->coding_type == coding_FFmpeg) {
+        seek_ffmpeg(vgmstream, seek_sample);
+    }
+#endif
+
+#if defined(VGM_USE_MP4V2) && defined(VGM_USE_FDKAAC)
+    if (vgmstream->coding_type == coding_MP4_AAC) {
+        seek_mp4_aac(vgmstream, seek_sample);
+    }
+#endif
+
+#ifdef VGM_USE_MAIATRAC3PLUS
+    if (vgmstream->coding_type == coding_AT3plus) {
+        seek_at3plus(vgmstream, seek_sample);
+    }
+#endif
+
+#ifdef VGM_USE_ATRAC9
+    if (vgmstream->coding_type == coding_ATRAC9) {
+        seek_atrac9(vgmstream, seek_sample);
+    }
+#endif
+
+#ifdef VGM_USE_CELT
+    if (vgmstream->coding_type == coding_CELT_FSB) {
+        seek_celt_fsb(vgmstream, seek_sample);
+    }
+#endif
+
+#ifdef VGM_USE_MPEG
+    if (vgmstream->coding_type == coding_MPEG_custom ||
+        vgmstream->coding_type == coding_MPEG_ealayer3 ||
+        vgmstream->coding_type == coding_MPEG_layer1 ||
+        vgmstream->coding_type == coding_MPEG_layer2 ||
+        vgmstream->coding_type == coding_MPEG_layer3) {
+        seek_mpeg(vgmstream, seek_sample);
+    }
+#endif
+
+    if (vgmstream->coding_type == coding_NWA) {
+        nwa_codec_data *data = vgmstream->codec_data;
+        if (data)
+            seek_nwa(data->nwa, seek_sample);
+    }
+}
+
+/* Types that keep ADPCM history from loop end rather than from loop start */
+int vgmstream_is_loop_history_kept(VGMSTREAM * vgmstream) {
+    return vgmstream->meta_type == meta_DSP_STD ||
+           vgmstream->meta_type == meta_DSP_RS03 ||
+           vgmstream->meta_type == meta_DSP_CSTR ||
+           vgmstream->coding_type == coding_PSX ||
+           vgmstream->coding_type == coding_PSX_badflags;
+}
+
+/* Go back to the saved loop start state */
+static void restore_loop(VGMSTREAM * vgmstream) {
+    /* prepare certain codecs' internal state for looping */
+    seek_codec(vgmstream, vgmstream->loop_sample);
+
+    memcpy(vgmstream->ch, vgmstream->loop_ch, sizeof(VGMSTREAMCHANNEL)*vgmstream->channels);
+    vgmstream->current_sample = vgmstream->loop_sample;
+    vgmstream->samples_into_block = vgmstream->loop_samples_into_block;
+    vgmstream->current_block_size = vgmstream->loop_block_size;
+    vgmstream->current_block_samples = vgmstream->loop_block_samples;
+    vgmstream->current_block_offset = vgmstream->loop_block_offset;
+    vgmstream->next_block_offset = vgmstream->loop_next_block_offset;
+}
+
 /* Detect loop start and save values, or detect loop end and restore (loop back). Returns 1 if loop was done. */
 int vgmstream_do_loop(VGMSTREAM * vgmstream) {
     /*if (!vgmstream->loop_flag) return 0;*/
@@ -2144,11 +2801,7 @@ int vgmstream_do_loop(VGMSTREAM * vgmstream) {
 
         /* against everything I hold sacred, preserve adpcm
          * history through loop for certain types */
-        if (vgmstream->meta_type == meta_DSP_STD ||
-            vgmstream->meta_type == meta_DSP_RS03 ||
-            vgmstream->meta_type == meta_DSP_CSTR ||
-            vgmstream->coding_type == coding_PSX ||
-            vgmstream->coding_type == coding_PSX_badflags) {
+        if (vgmstream_is_loop_history_kept(vgmstream)) {
             int i;
             for (i = 0; i < vgmstream->channels; i++) {
                 vgmstream->loop_ch[i].adpcm_history1_16 = vgmstream->ch[i].adpcm_history1_16;
@@ -2159,99 +2812,411 @@ int vgmstream_do_loop(VGMSTREAM * vgmstream) {
         }
 
 
-        /* prepare certain codecs' internal state for looping */
+        /* restore! */
+        restore_loop(vgmstream);
 
-        if (vgmstream->coding_type == coding_CRI_HCA) {
-            loop_hca(vgmstream->codec_data, vgmstream->loop_sample);
-        }
+        return 1; /* looped */
+    }
 
-        if (vgmstream->coding_type == coding_EA_MT) {
-            seek_ea_mt(vgmstream, vgmstream->loop_sample);
-        }
 
+    /* is this the loop start? */
+    if (!vgmstream->hit_loop && vgmstream->current_sample == vgmstream->loop_start_sample) {
+        /* save! */
+        memcpy(vgmstream->loop_ch, vgmstream->ch, sizeof(VGMSTREAMCHANNEL)*vgmstream->channels);
+        vgmstream->loop_sample = vgmstream->current_sample;
+        vgmstream->loop_samples_into_block = vgmstream->samples_into_block;
+        vgmstream->loop_block_size = vgmstream->current_block_size;
+        vgmstream->loop_block_samples = vgmstream->current_block_samples;
+        vgmstream->loop_block_offset = vgmstream->current_block_offset;
+        vgmstream->loop_next_block_offset = vgmstream->next_block_offset;
+        vgmstream->hit_loop = 1;
+    }
+
+    return 0; /* not looped */
+}
+
+/* ******************************************************************* */
+
+/* Codecs with their own seek that can move to any sample (rather than just loop start),
+ * as long as they were reset first. */
+static int is_codec_seekable(VGMSTREAM * vgmstream) {
+    if (vgmstream->layout_type != layout_none)
+        return 0;
+
+    switch (vgmstream->coding_type) {
 #ifdef VGM_USE_VORBIS
-        if (vgmstream->coding_type == coding_OGG_VORBIS) {
-            seek_ogg_vorbis(vgmstream, vgmstream->loop_sample);
-        }
+        case coding_OGG_VORBIS:
+        case coding_VORBIS_custom:
+#endif
+#ifdef VGM_USE_FFMPEG
+        case coding_FFmpeg:
+#endif
+#if defined(VGM_USE_MP4V2) && defined(VGM_USE_FDKAAC)
+        case coding_MP4_AAC:
+#endif
+#ifdef VGM_USE_MAIATRAC3PLUS
+        case coding_AT3plus:
+#endif
+#ifdef VGM_USE_ATRAC9
+        case coding_ATRAC9:
+#endif
+#ifdef VGM_USE_CELT
+        case coding_CELT_FSB:
+#endif
+#ifdef VGM_USE_MPEG
+        case coding_MPEG_custom:
+        case coding_MPEG_ealayer3:
+        case coding_MPEG_layer1:
+        case coding_MPEG_layer2:
+        case coding_MPEG_layer3:
+#endif
+        case coding_NWA:
+            return 1;
+        default: /* HCA and EA-MT only know how to go to loop start */
+            return 0;
+    }
+}
+
+/* Codecs that decode any frame without previous frames, reading from ch offsets + samples_into_block
+ * (decoders don't move offsets), so positioning is just setting those values. */
+static int is_codec_stateless(VGMSTREAM * vgmstream) {
+    switch (vgmstream->coding_type) {
+        case coding_PCM16LE:
+        case coding_PCM16BE:
+        case coding_PCM16_int:
+        case coding_PCM8:
+        case coding_PCM8_int:
+        case coding_PCM8_U:
+        case coding_PCM8_U_int:
+        case coding_PCM8_SB:
+        case coding_PCM4:
+        case coding_PCM4_U:
+        case coding_ULAW:
+        case coding_ULAW_int:
+        case coding_ALAW:
+        case coding_PCMFLOAT:
+        case coding_XBOX_IMA:
+        case coding_XBOX_IMA_int:
+        case coding_XBOX_IMA_mch:
+        case coding_APPLE_IMA4:
+        case coding_MSADPCM:
+        case coding_MSADPCM_int:
+        case coding_MSADPCM_ck:
+            return 1;
+        default:
+            return 0;
+    }
+}
+
+/* Decode and discard samples until reaching some play position (handles loops normally). */
+static void seek_decode(VGMSTREAM * vgmstream, int32_t samples_to_skip) {
+    sample_t* buf = NULL;
+    int input_channels = 0, output_channels = 0;
+    int buf_samples = 0x1000;
+
+    if (samples_to_skip <= 0)
+        return;
+
+    mixing_info(vgmstream, &input_channels, &output_channels);
+    if (output_channels < input_channels)
+        output_channels = input_channels;
+    if (output_channels < vgmstream->channels)
+        output_channels = vgmstream->channels;
+
+    buf = malloc(buf_samples * output_channels * sizeof(sample_t));
+    if (!buf) goto fail;
+
+    /* may be over the caller's max */
+    if (!mixing_reserve(vgmstream, buf_samples))
+        goto fail;
+
+    while (samples_to_skip > 0) {
+        int samples_to_do = buf_samples;
+        if (samples_to_do > samples_to_skip)
+            samples_to_do = samples_to_skip;
+
+        render_unbuffered(buf, samples_to_do, vgmstream);
+        samples_to_skip -= samples_to_do;
+    }
+
+fail:
+    free(buf);
+}
+
+/* Move interleaved channel offsets to the frame where seek_sample is. */
+static void seek_interleave(VGMSTREAM * vgmstream, int32_t seek_sample) {
+    int ch, samples_per_frame, samples_this_block;
+    int32_t block, skip_samples;
+    int has_interleave_last = vgmstream->interleave_last_block_size && vgmstream->channels > 1;
+
+    samples_per_frame = vgmstream->interleave_frame_samples;
+    samples_this_block = vgmstream->interleave_block_samples;
+
+    /* mono interleaved stream with no layout set, works like flat layout */
+    if (samples_this_block == 0 && vgmstream->channels == 1) {
+        vgmstream->current_sample = seek_sample - (seek_sample % samples_per_frame);
+        vgmstream->samples_into_block = vgmstream->current_sample;
+        return;
+    }
+    if (samples_this_block == 0)
+        return;
+
+    block = seek_sample / samples_this_block;
+
+    if (has_interleave_last && block * samples_this_block + samples_this_block > vgmstream->num_samples) {
+        /* last interleave block has a different size and per-channel offsets */
+        skip_samples = seek_sample - block * samples_this_block;
+        samples_per_frame = vgmstream->interleave_last_frame_samples;
+        skip_samples -= skip_samples % samples_per_frame;
 
-        if (vgmstream->coding_type == coding_VORBIS_custom) {
-            seek_vorbis_custom(vgmstream, vgmstream->loop_sample);
+        /* num_samples may go past the data in the (shorter) block, stay inside it and decode the rest */
+        if (skip_samples >= vgmstream->interleave_last_block_samples) {
+            skip_samples = vgmstream->interleave_last_block_samples - samples_per_frame;
+            if (skip_samples < 0)
+                skip_samples = 0;
         }
-#endif
 
-#ifdef VGM_USE_FFMPEG
-        if (vgmstream->coding_type == coding_FFmpeg) {
-            seek_ffmpeg(vgmstream, vgmstream->loop_sample);
+        for (ch = 0; ch < vgmstream->channels; ch++) {
+            vgmstream->ch[ch].offset = vgmstream->start_ch[ch].offset
+                    + vgmstream->interleave_block_size * vgmstream->channels * block
+                    - vgmstream->interleave_block_size * ch
+                    + vgmstream->interleave_last_block_size * ch;
         }
-#endif
+    }
+    else {
+        skip_samples = seek_sample - block * samples_this_block;
+        skip_samples -= skip_samples % samples_per_frame;
 
-#if defined(VGM_USE_MP4V2) && defined(VGM_USE_FDKAAC)
-        if (vgmstream->coding_type == coding_MP4_AAC) {
-            seek_mp4_aac(vgmstream, vgmstream->loop_sample);
+        for (ch = 0; ch < vgmstream->channels; ch++) {
+            vgmstream->ch[ch].offset = vgmstream->start_ch[ch].offset
+                    + vgmstream->interleave_block_size * vgmstream->channels * block;
         }
-#endif
+    }
 
-#ifdef VGM_USE_MAIATRAC3PLUS
-        if (vgmstream->coding_type == coding_AT3plus) {
-            seek_at3plus(vgmstream, vgmstream->loop_sample);
+    vgmstream->current_sample = block * samples_this_block + skip_samples;
+    vgmstream->samples_into_block = skip_samples;
+}
+
+/* Skip blocks by parsing their headers only (no decoding), up to the frame where seek_sample is.
+ * Starts from the closest block already known, if any. */
+static void seek_blocked(VGMSTREAM * vgmstream, int32_t seek_sample) {
+    int frame_size, samples_per_frame, samples_this_block;
+    int32_t block_sample, skip_samples;
+
+    block_index_seek(vgmstream, seek_sample);
+
+    while (1) {
+        frame_size = get_vgmstream_frame_size(vgmstream);
+        samples_per_frame = get_vgmstream_samples_per_frame(vgmstream);
+        if (vgmstream->current_block_samples) {
+            samples_this_block = vgmstream->current_block_samples;
+        } else if (frame_size == 0) { /* assume 4 bit */
+            samples_this_block = vgmstream->current_block_size * 2 * samples_per_frame;
+        } else {
+            samples_this_block = vgmstream->current_block_size / frame_size * samples_per_frame;
         }
-#endif
 
-#ifdef VGM_USE_ATRAC9
-        if (vgmstream->coding_type == coding_ATRAC9) {
-            seek_atrac9(vgmstream, vgmstream->loop_sample);
+        if (samples_this_block < 0 || vgmstream->current_block_offset < 0 || vgmstream->current_block_offset == 0xFFFFFFFF)
+            return; /* bad block, let the decoder handle it */
+
+        block_sample = vgmstream->current_sample - vgmstream->samples_into_block;
+        if (block_sample + samples_this_block > seek_sample)
+            break;
+
+        vgmstream->current_sample = block_sample + samples_this_block;
+        vgmstream->samples_into_block = 0;
+        block_update(vgmstream->next_block_offset, vgmstream);
+        block_index_add(vgmstream, vgmstream->current_sample);
+    }
+
+    skip_samples = seek_sample - block_sample;
+    skip_samples -= skip_samples % samples_per_frame;
+    if (skip_samples > vgmstream->samples_into_block) {
+        vgmstream->current_sample = block_sample + skip_samples;
+        vgmstream->samples_into_block = skip_samples;
+    }
+}
+
+/* Move forward (within the current loop pass) to seek_sample, positioning by codec/layout when
+ * possible and decoding the rest. */
+static void seek_forward(VGMSTREAM * vgmstream, int32_t seek_sample) {
+
+    if (is_codec_seekable(vgmstream)) {
+        /* codec seeks adjust loop_ch as if a loop restore followed, point them to current channels instead */
+        VGMSTREAMCHANNEL* loop_ch = vgmstream->loop_ch;
+        vgmstream->loop_ch = vgmstream->ch;
+        seek_codec(vgmstream, seek_sample);
+        vgmstream->loop_ch = loop_ch;
+
+        vgmstream->current_sample = seek_sample;
+        vgmstream->samples_into_block = seek_sample;
+        return;
+    }
+
+    if (is_codec_stateless(vgmstream)) {
+        switch (vgmstream->layout_type) {
+            case layout_none: {
+                int samples_per_frame = get_vgmstream_samples_per_frame(vgmstream);
+                int32_t frame_sample = seek_sample - (seek_sample % samples_per_frame);
+                if (frame_sample > vgmstream->current_sample) {
+                    vgmstream->current_sample = frame_sample;
+                    vgmstream->samples_into_block = frame_sample;
+                }
+                break;
+            }
+            case layout_interleave:
+                seek_interleave(vgmstream, seek_sample);
+                break;
+            case layout_segmented:
+            case layout_layered:
+                break;
+            default: /* layout_blocked_* */
+                seek_blocked(vgmstream, seek_sample);
+                break;
         }
-#endif
+    }
 
-#ifdef VGM_USE_CELT
-        if (vgmstream->coding_type == coding_CELT_FSB) {
-            seek_celt_fsb(vgmstream, vgmstream->loop_sample);
+    seek_decode(vgmstream, seek_sample - vgmstream->current_sample);
+}
+
+/* Move forward to seek_sample, saving loop start values on the way if needed (loop end will use them) */
+static void seek_stream(VGMSTREAM * vgmstream, int32_t seek_sample, int loop_region) {
+    if (loop_region && !vgmstream->hit_loop && vgmstream->current_sample <= vgmstream->loop_start_sample) {
+        seek_forward(vgmstream, vgmstream->loop_start_sample);
+        vgmstream_do_loop(vgmstream);
+    }
+
+    seek_forward(vgmstream, seek_sample);
+}
+
+/* Each layer seeks on its own (they have their own loops) */
+static void seek_layered(VGMSTREAM * vgmstream, int32_t seek_sample) {
+    int layer;
+    layered_layout_data *data = vgmstream->layout_data;
+
+    for (layer = 0; layer < data->layer_count; layer++) {
+        vgmstream_seek(data->layers[layer], seek_sample);
+    }
+
+    vgmstream->current_sample = data->layers[0]->current_sample;
+    vgmstream->loop_count = data->layers[0]->loop_count;
+    vgmstream->loop_flag = data->layers[0]->loop_flag;
+}
+
+void vgmstream_seek(VGMSTREAM * vgmstream, int32_t seek_sample) {
+    int32_t stream_sample, loop_samples;
+    int loop_count = 0, loop_flag, loop_region, hit_loop, same_pass, use_loop;
+
+    if (!vgmstream) return;
+    if (seek_sample < 0)
+        seek_sample = 0;
+
+    /* buffered samples are from the old position (the VGMSTREAM is past them) */
+    render_buffer_reset(vgmstream);
+
+    if (vgmstream->layout_type == layout_layered) {
+        seek_layered(vgmstream, seek_sample);
+        return;
+    }
+
+    /* convert play position into a position in the stream + loop pass, same as vgmstream_do_loop would
+     * (initial loop_flag may be disabled during play after reaching loop_target, but not on resets) */
+    loop_flag = ((VGMSTREAM*)vgmstream->start_vgmstream)->loop_flag;
+    loop_samples = vgmstream->loop_end_sample - vgmstream->loop_start_sample;
+    stream_sample = seek_sample;
+    if (loop_flag && loop_samples > 0 && seek_sample >= vgmstream->loop_end_sample) {
+        loop_count = (seek_sample - vgmstream->loop_end_sample) / loop_samples + 1;
+        if (vgmstream->loop_target && loop_count >= vgmstream->loop_target) {
+            loop_count = vgmstream->loop_target;
+            loop_flag = 0;
+            stream_sample = seek_sample - loop_samples * (loop_count - 1);
         }
-#endif
+        else {
+            stream_sample = vgmstream->loop_start_sample + (seek_sample - vgmstream->loop_end_sample) % loop_samples;
+        }
+    }
+    loop_region = loop_flag && loop_samples > 0 && stream_sample >= vgmstream->loop_start_sample;
 
-#ifdef VGM_USE_MPEG
-        if (vgmstream->coding_type == coding_MPEG_custom ||
-            vgmstream->coding_type == coding_MPEG_ealayer3 ||
-            vgmstream->coding_type == coding_MPEG_layer1 ||
-            vgmstream->coding_type == coding_MPEG_layer2 ||
-            vgmstream->coding_type == coding_MPEG_layer3) {
-            seek_mpeg(vgmstream, vgmstream->loop_sample);
+    if (vgmstream->layout_type == layout_segmented) {
+        seek_layout_segmented(vgmstream, stream_sample);
+        vgmstream->loop_count = loop_count;
+        vgmstream->loop_flag = loop_flag;
+        if (loop_region && !vgmstream->hit_loop) {
+            /* segmented restores use loop_sample only */
+            memcpy(vgmstream->loop_ch, vgmstream->ch, sizeof(VGMSTREAMCHANNEL)*vgmstream->channels);
+            vgmstream->loop_sample = vgmstream->loop_start_sample;
+            vgmstream->loop_samples_into_block = 0;
+            vgmstream->hit_loop = 1;
         }
-#endif
+        return;
+    }
+
+    same_pass = vgmstream->loop_count == loop_count && vgmstream->loop_flag == loop_flag &&
+            vgmstream->current_sample <= stream_sample;
+    hit_loop = vgmstream->hit_loop;
+    use_loop = loop_region && hit_loop && !vgmstream_is_loop_history_kept(vgmstream);
 
-        if (vgmstream->coding_type == coding_NWA) {
-            nwa_codec_data *data = vgmstream->codec_data;
-            if (data)
-                seek_nwa(data->nwa, vgmstream->loop_sample);
+    /* restart from a saved state if closer than other options */
+    if (vgmstream->seek_index && !is_codec_seekable(vgmstream) && !is_codec_stateless(vgmstream)) {
+        int32_t min_sample = 0;
+        if (same_pass)
+            min_sample = vgmstream->current_sample;
+        else if (use_loop)
+            min_sample = vgmstream->loop_sample;
+
+        if (seek_index_restore(vgmstream, stream_sample, min_sample, loop_count, loop_flag)) {
+            seek_stream(vgmstream, stream_sample, loop_region);
+            return;
         }
+    }
 
-        /* restore! */
-        memcpy(vgmstream->ch, vgmstream->loop_ch, sizeof(VGMSTREAMCHANNEL)*vgmstream->channels);
-        vgmstream->current_sample = vgmstream->loop_sample;
-        vgmstream->samples_into_block = vgmstream->loop_samples_into_block;
-        vgmstream->current_block_size = vgmstream->loop_block_size;
-        vgmstream->current_block_samples = vgmstream->loop_block_samples;
-        vgmstream->current_block_offset = vgmstream->loop_block_offset;
-        vgmstream->next_block_offset = vgmstream->loop_next_block_offset;
+    /* same loop pass and ahead: keep going (codec seeks expect a reset though) */
+    if (same_pass && !is_codec_seekable(vgmstream)) {
+        seek_stream(vgmstream, stream_sample, loop_region);
+        return;
+    }
 
-        return 1; /* looped */
+    /* loop start was saved: restart from there (unless it was altered at loop end) */
+    if (use_loop && !is_codec_seekable(vgmstream)) {
+        restore_loop(vgmstream);
+        vgmstream->loop_count = loop_count;
+        vgmstream->loop_flag = loop_flag;
+        seek_forward(vgmstream, stream_sample);
+        return;
     }
 
+    /* positioning needs native seek support, otherwise must decode from the start as usual */
+    if (!is_codec_seekable(vgmstream) && !is_codec_stateless(vgmstream)) {
+        reset_vgmstream(vgmstream);
+        seek_decode(vgmstream, seek_sample);
+        return;
+    }
 
-    /* is this the loop start? */
-    if (!vgmstream->hit_loop && vgmstream->current_sample == vgmstream->loop_start_sample) {
-        /* save! */
-        memcpy(vgmstream->loop_ch, vgmstream->ch, sizeof(VGMSTREAMCHANNEL)*vgmstream->channels);
-        vgmstream->loop_sample = vgmstream->current_sample;
-        vgmstream->loop_samples_into_block = vgmstream->samples_into_block;
-        vgmstream->loop_block_size = vgmstream->current_block_size;
-        vgmstream->loop_block_samples = vgmstream->current_block_samples;
-        vgmstream->loop_block_offset = vgmstream->current_block_offset;
-        vgmstream->loop_next_block_offset = vgmstream->next_block_offset;
-        vgmstream->hit_loop = 1;
+    /* restart, but keep saved loop start values (which are the same every pass) */
+    {
+        int32_t loop_sample = vgmstream->loop_sample;
+        int32_t loop_samples_into_block = vgmstream->loop_samples_into_block;
+        size_t loop_block_size = vgmstream->loop_block_size;
+        size_t loop_block_samples = vgmstream->loop_block_samples;
+        off_t loop_block_offset = vgmstream->loop_block_offset;
+        off_t loop_next_block_offset = vgmstream->loop_next_block_offset;
+
+        reset_vgmstream(vgmstream);
+
+        if (hit_loop) {
+            vgmstream->loop_sample = loop_sample;
+            vgmstream->loop_samples_into_block = loop_samples_into_block;
+            vgmstream->loop_block_size = loop_block_size;
+            vgmstream->loop_block_samples = loop_block_samples;
+            vgmstream->loop_block_offset = loop_block_offset;
+            vgmstream->loop_next_block_offset = loop_next_block_offset;
+            vgmstream->hit_loop = 1;
+        }
     }
 
-    return 0; /* not looped */
+    vgmstream->loop_count = loop_count;
+    vgmstream->loop_flag = loop_flag;
+    seek_stream(vgmstream, stream_sample, loop_region);
 }
 
 /* Write a description of the stream into array pointed by desc, which must be length bytes long.
@@ -2827,6 +3792,11 @@ int vgmstream_open_stream(VGMSTREAM * vgmstream, STREAMFILE *streamFile, off_t s
         use_streamfile_per_channel = 1;
     }
 
+    /* streams are only opened for metas that read data through channels, no need for more */
+    if (streamFile && streamFile->probe_only) {
+        use_streamfile_per_channel = 0;
+    }
+
     /* for mono or codecs like IMA (XBOX, MS IMA, MS ADPCM) where channels work with the same bytes */
     if (vgmstream->layout_type == layout_none) {
         use_same_offset_per_channel = 1;
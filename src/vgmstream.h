@@ -824,6 +824,9 @@ typedef struct {
 
 } VGMSTREAMCHANNEL;
 
+/* decoder for codecs that handle each channel the same way with no extra config */
+typedef void (*decode_channel_t)(VGMSTREAMCHANNEL * stream, sample_t * outbuf, int channelspacing, int32_t first_sample, int32_t samples_to_do);
+
 /* main vgmstream info */
 typedef struct {
     /* basic config */
@@ -842,6 +845,11 @@ typedef struct {
     /* layouts/block config */
     size_t interleave_block_size;   /* interleave, or block/frame size (depending on the codec) */
     size_t interleave_last_block_size; /* smaller interleave for last block */
+    /* interleave geometry (derived from the above on setup, as layouts need it every call) */
+    int interleave_frame_samples;   /* samples per frame in regular interleave blocks */
+    int interleave_last_frame_samples; /* samples per frame in the last interleave block */
+    int32_t interleave_block_samples; /* samples in a regular interleave block */
+    int32_t interleave_last_block_samples; /* samples in the last interleave block */
 
     /* subsong config */
     int num_streams;                /* for multi-stream formats (0=not set/one stream, 1=one stream) */
@@ -890,6 +898,12 @@ typedef struct {
     int codec_endian;               /* little/big endian marker; name is left vague but usually means big endian */
     int codec_config;               /* flags for codecs or layouts with minor variations; meaning is up to them */
     int32_t ws_output_size;         /* WS ADPCM: output bytes for this block */
+    /* codec values resolved on setup, so hot paths don't switch on coding_type every call */
+    int codec_info_set;             /* values below are valid (not for codecs where they change while playing) */
+    int codec_frame_size;           /* same as get_vgmstream_frame_size */
+    int codec_samples_per_frame;    /* same as get_vgmstream_samples_per_frame */
+    int codec_multiple_frames;      /* decoder handles many frames per call */
+    decode_channel_t codec_decode_channel; /* decoder for common per-channel codecs, or NULL */
 
 
     /* main state */
@@ -899,6 +913,9 @@ typedef struct {
     void* start_vgmstream;          /* shallow copy of the VGMSTREAM as it was at the beginning of the stream (for resets) */
 
     void * mixing_data;             /* state for mixing effects */
+    void * seek_index;              /* saved decoder states for seeking (optional) */
+    void * block_index;             /* known block positions for seeking (blocked layouts) */
+    void * render_buffer;           /* buffered rendering for small calls (optional) */
 
     /* Optional data the codec needs for the whole stream. This is for codecs too
      * different from vgmstream's structure to be reasonably shoehorned.
@@ -1141,9 +1158,12 @@ typedef struct {
     int segment_count;
     VGMSTREAM **segments;
     int current_segment;
+    int32_t *segment_starts; /* first sample of each segment, plus total samples at the end (for seeking) */
     sample_t *buffer;
+    float *buffer_f32;      /* internal buffer for float rendering */
     int input_channels;     /* internal buffer channels */
     int output_channels;    /* resulting channels (after mixing, if applied) */
+    struct segmented_prefetch_t *prefetch; /* optional background segment changes (see vgmstream_set_segment_prefetch) */
 } segmented_layout_data;
 
 /* for files made of "parallel" layers, one per group of channels (using a complete sub-VGMSTREAM) */
@@ -1151,8 +1171,10 @@ typedef struct {
     int layer_count;
     VGMSTREAM **layers;
     sample_t *buffer;
+    float *buffer_f32;      /* internal buffer for float rendering */
     int input_channels;     /* internal buffer channels */
     int output_channels;    /* resulting channels (after mixing, if applied) */
+    struct layered_threads_t *threads; /* optional parallel rendering (see vgmstream_set_layer_threads) */
 } layered_layout_data;
 
 /* for compressed NWA */
@@ -1262,6 +1284,45 @@ typedef struct {
 
 typedef struct ea_mt_codec_data ea_mt_codec_data;
 
+/* Stream info, as returned by probe_vgmstream (without decoder setup or opened streams). */
+typedef struct {
+    int channels;
+    int sample_rate;
+    int32_t num_samples;
+
+    int loop_flag;
+    int32_t loop_start_sample;
+    int32_t loop_end_sample;
+
+    int num_streams;
+    int stream_index;
+    char stream_name[STREAM_NAME_SIZE];
+    uint32_t channel_layout;
+
+    meta_t meta_type;
+    coding_t coding_type;
+    layout_t layout_type;
+} VGMSTREAM_INFO;
+
+/* Subsong info, as returned by get_vgmstream_subsongs */
+typedef struct {
+    VGMSTREAM_INFO info;        /* same as probing this subsong (zeroed if it can't be opened) */
+    off_t stream_offset;        /* start of the subsong's data in the bank (0 if not a single chunk) */
+    size_t stream_size;
+} VGMSTREAM_SUBSONG;
+
+/* All subsongs in a file, parsed once */
+typedef struct {
+    int num_subsongs;
+    VGMSTREAM_SUBSONG * subsongs;   /* subsong N is at N-1 */
+
+    /* internal (metas that can reopen a subsong from its saved header, otherwise opened by index) */
+    VGMSTREAM * (*init_header)(STREAMFILE *streamFile, void * header);
+    size_t header_size;
+    uint8_t * headers;              /* one meta header per subsong */
+    int max_subsongs;
+} VGMSTREAM_SUBSONGS;
+
 
 #if 0
 //possible future public/opaque API
@@ -1280,18 +1341,7 @@ typedef struct ea_mt_codec_data ea_mt_codec_data;
 
 //VGMSTREAM_API void VGMSTREAM_CALL vgmstream_function(void);
 
-//info for opaque VGMSTREAM
-typedef struct {
-    const int channels;
-    const int sample_rate;
-    const int num_samples;
-    const int loop_start_sample;
-    const int loop_end_sample;
-    const int loop_flag;
-    const int num_streams;
-    const int current_sample;
-    const int average_bitrate;
-} VGMSTREAM_INFO;
+//info for opaque VGMSTREAM (see VGMSTREAM_INFO)
 void vgmstream_get_info(VGMSTREAM* vgmstream, VGMSTREAM_INFO *vgmstream_info);
 
 //or maybe
@@ -1312,6 +1362,18 @@ VGMSTREAM * init_vgmstream(const char * const filename);
 /* init with custom IO via streamfile */
 VGMSTREAM * init_vgmstream_from_STREAMFILE(STREAMFILE *streamFile);
 
+/* Do format detection and fill basic stream info, for quick scans. Metas may skip setting up
+ * decoders, so a file that probes fine could still fail on init. Returns 0 on failure. */
+int probe_vgmstream(const char * const filename, VGMSTREAM_INFO * info);
+int probe_vgmstream_from_STREAMFILE(STREAMFILE *streamFile, VGMSTREAM_INFO * info);
+
+/* Parse all subsongs of a bank at once and return their info (for multi-stream formats that
+ * would otherwise reparse the whole bank per subsong). Any subsong can then be opened with
+ * open_vgmstream_subsong, passing the same streamfile. Returns NULL on failure. */
+VGMSTREAM_SUBSONGS * get_vgmstream_subsongs(STREAMFILE *streamFile);
+VGMSTREAM * open_vgmstream_subsong(STREAMFILE *streamFile, VGMSTREAM_SUBSONGS * subsongs, int subsong);
+void close_vgmstream_subsongs(VGMSTREAM_SUBSONGS * subsongs);
+
 /* reset a VGMSTREAM to start of stream */
 void reset_vgmstream(VGMSTREAM * vgmstream);
 
@@ -1324,6 +1386,43 @@ int32_t get_vgmstream_play_samples(double looptimes, double fadeseconds, double
 /* Decode data into sample buffer */
 void render_vgmstream(sample * buffer, int32_t sample_count, VGMSTREAM * vgmstream);
 
+/* Decode data into float sample buffer (-1.0..1.0), same as render_vgmstream otherwise.
+ * Samples stay as float through layers/segments and mixing, and aren't clamped after mixing. */
+void render_vgmstream_f32(float * buffer, int32_t sample_count, VGMSTREAM * vgmstream);
+
+/* Seek to a play position (same timeline as render_vgmstream, so past loop end it counts loops),
+ * using codec/layout positioning when possible and only decoding the remainder. */
+void vgmstream_seek(VGMSTREAM * vgmstream, int32_t seek_sample);
+
+/* Enable saving decoder state every interval samples (0 = disable), so seeking in codecs that can't
+ * position directly only needs to decode from the closest state. max_entries bounds memory per stream
+ * (0 = default), increasing the interval if needed. States are saved while rendering, or all at once
+ * with vgmstream_build_seek_index. Returns 0 if the stream doesn't support it. */
+int vgmstream_set_seek_index(VGMSTREAM * vgmstream, int32_t interval, int max_entries);
+
+/* Decode the stream once to fill the seek index, then reset. */
+void vgmstream_build_seek_index(VGMSTREAM * vgmstream);
+
+/* Render layers (of layered layouts, also inside segments) in parallel using up to threads
+ * at once (0/1 = disable), which is mainly useful for offline conversion of streams with many
+ * layers. Output is the same. Different STREAMFILEs must be readable from different threads
+ * (true for the stdio and mmap ones on POSIX). Returns 1 if enabled, or 0 if there are no
+ * layers or no thread support in this build. */
+int vgmstream_set_layer_threads(VGMSTREAM * vgmstream, int threads);
+
+/* Prepare the next segment of segmented layouts (also inside layers) in a background thread while
+ * the current one plays, so segment changes and loops don't stall rendering on codec resets or
+ * file reads. The first samples (up to 8192) of the next segment are also decoded in advance.
+ * Same STREAMFILE considerations as vgmstream_set_layer_threads apply. Returns 1 if enabled, or 0
+ * if there are no segments or no thread support in this build (samples 0 = disable). */
+int vgmstream_set_segment_prefetch(VGMSTREAM * vgmstream, int32_t samples);
+
+/* Render chunks of samples (up to 32768, 0 = disable) and serve render calls smaller than that from
+ * them, for callers that render few samples per call (real-time audio callbacks). Output is the same,
+ * but the VGMSTREAM is ahead of the caller by the unused samples, so current_sample/loop_count don't
+ * match the caller's position (seek and reset drop them). Returns 1 if enabled. */
+int vgmstream_set_render_buffer(VGMSTREAM * vgmstream, int32_t samples);
+
 /* Write a description of the stream into array pointed by desc, which must be length bytes long.
  * Will always be null-terminated if length > 0 */
 void describe_vgmstream(VGMSTREAM * vgmstream, char * desc, int length);
@@ -1349,6 +1448,11 @@ void vgmstream_set_loop_target(VGMSTREAM* vgmstream, int loop_target);
 /* Allocate initial memory for the VGMSTREAM */
 VGMSTREAM * allocate_vgmstream(int channel_count, int looped);
 
+/* Allocate a subsong list for a meta that saves one header per subsong, and add subsongs
+ * (copying the header) in order. Returns the new subsong to fill, or NULL on error. */
+VGMSTREAM_SUBSONGS * allocate_vgmstream_subsongs(size_t header_size, VGMSTREAM * (*init_header)(STREAMFILE *streamFile, void * header));
+VGMSTREAM_SUBSONG * add_vgmstream_subsong(VGMSTREAM_SUBSONGS * subsongs, const void * header);
+
 /* Prepare the VGMSTREAM's initial state once parsed and ready, but before playing. */
 void setup_vgmstream(VGMSTREAM * vgmstream);
 
@@ -1364,12 +1468,19 @@ int get_vgmstream_shortframe_size(VGMSTREAM * vgmstream);
  * buffer already, and we have samples_to_do consecutive samples ahead of us. */
 void decode_vgmstream(VGMSTREAM * vgmstream, int samples_written, int samples_to_do, sample_t * buffer);
 
+/* Same as decode_vgmstream but into a float buffer, for decoders that output float (only called
+ * by render_vgmstream_f32 for those). */
+void decode_vgmstream_f32(VGMSTREAM * vgmstream, int samples_written, int samples_to_do, float * buffer);
+
 /* Calculate number of consecutive samples to do (taking into account stopping for loop start and end) */
 int vgmstream_samples_to_do(int samples_this_block, int samples_per_frame, VGMSTREAM * vgmstream);
 
 /* Detect loop start and save values, or detect loop end and restore (loop back). Returns 1 if loop was done. */
 int vgmstream_do_loop(VGMSTREAM * vgmstream);
 
+/* Returns 1 if ADPCM history at loop end is kept when looping (so looped passes decode differently). */
+int vgmstream_is_loop_history_kept(VGMSTREAM * vgmstream);
+
 /* Open the stream for reading at offset (taking into account layouts, channels and so on).
  * Returns 0 on failure */
 int vgmstream_open_stream(VGMSTREAM * vgmstream, STREAMFILE *streamFile, off_t start_offset);
@@ -0,0 +1,120 @@
+#include <stdlib.h>
+#include "worker.h"
+
+#ifdef VGM_USE_PTHREADS
+#include <pthread.h>
+
+typedef enum { WORKER_IDLE, WORKER_RUNNING, WORKER_QUIT } worker_state_t;
+
+struct worker_t {
+    pthread_t thread;
+    pthread_mutex_t lock;
+    pthread_cond_t cond;        /* signals state changes, both ways */
+    worker_state_t state;
+
+    void (*job)(void* arg);
+    void* arg;
+};
+
+static void* worker_loop(void* arg) {
+    worker_t* worker = arg;
+
+    pthread_mutex_lock(&worker->lock);
+    while (1) {
+        while (worker->state == WORKER_IDLE) {
+            pthread_cond_wait(&worker->cond, &worker->lock);
+        }
+        if (worker->state == WORKER_QUIT)
+            break;
+
+        pthread_mutex_unlock(&worker->lock);
+        worker->job(worker->arg);
+        pthread_mutex_lock(&worker->lock);
+
+        worker->state = WORKER_IDLE;
+        pthread_cond_broadcast(&worker->cond);
+    }
+    pthread_mutex_unlock(&worker->lock);
+
+    return NULL;
+}
+
+worker_t* worker_init(void (*job)(void* arg), void* arg) {
+    worker_t* worker = NULL;
+
+    if (!job) goto fail;
+
+    worker = calloc(1, sizeof(worker_t));
+    if (!worker) goto fail;
+
+    worker->job = job;
+    worker->arg = arg;
+    worker->state = WORKER_IDLE;
+
+    if (pthread_mutex_init(&worker->lock, NULL) != 0)
+        goto fail;
+    if (pthread_cond_init(&worker->cond, NULL) != 0) {
+        pthread_mutex_destroy(&worker->lock);
+        goto fail;
+    }
+    if (pthread_create(&worker->thread, NULL, worker_loop, worker) != 0) {
+        pthread_cond_destroy(&worker->cond);
+        pthread_mutex_destroy(&worker->lock);
+        goto fail;
+    }
+
+    return worker;
+fail:
+    free(worker);
+    return NULL;
+}
+
+void worker_start(worker_t* worker) {
+    if (!worker) return;
+
+    pthread_mutex_lock(&worker->lock);
+    worker->state = WORKER_RUNNING;
+    pthread_cond_broadcast(&worker->cond);
+    pthread_mutex_unlock(&worker->lock);
+}
+
+void worker_wait(worker_t* worker) {
+    if (!worker) return;
+
+    pthread_mutex_lock(&worker->lock);
+    while (worker->state == WORKER_RUNNING) {
+        pthread_cond_wait(&worker->cond, &worker->lock);
+    }
+    pthread_mutex_unlock(&worker->lock);
+}
+
+void worker_close(worker_t* worker) {
+    if (!worker) return;
+
+    worker_wait(worker);
+
+    pthread_mutex_lock(&worker->lock);
+    worker->state = WORKER_QUIT;
+    pthread_cond_broadcast(&worker->cond);
+    pthread_mutex_unlock(&worker->lock);
+
+    pthread_join(worker->thread, NULL);
+    pthread_cond_destroy(&worker->cond);
+    pthread_mutex_destroy(&worker->lock);
+    free(worker);
+}
+
+#else
+
+/* no thread support */
+worker_t* worker_init(void (*job)(void* arg), void* arg) {
+    return NULL;
+}
+void worker_start(worker_t* worker) {
+}
+void worker_wait(worker_t* worker) {
+}
+void worker_close(worker_t* worker) {
+}
+
+#endif
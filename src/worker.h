@@ -0,0 +1,21 @@
+#ifndef _WORKER_H_
+#define _WORKER_H_
+
+/* Simple background thread that runs a job when started, so the caller may do other work
+ * meanwhile and wait for it later. Only available with thread support (VGM_USE_PTHREADS),
+ * otherwise worker_init returns NULL and callers are expected to do the job themselves. */
+typedef struct worker_t worker_t;
+
+/* creates a thread that will run job(arg) every time it's started */
+worker_t* worker_init(void (*job)(void* arg), void* arg);
+
+/* runs the job (must not be running already) */
+void worker_start(worker_t* worker);
+
+/* waits until a started job is done (returns right away if not started) */
+void worker_wait(worker_t* worker);
+
+/* waits for the job, then stops and frees the thread */
+void worker_close(worker_t* worker);
+
+#endif /* _WORKER_H_ */
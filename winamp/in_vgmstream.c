@@ -1134,10 +1134,19 @@ int winamp_Play(const in_char *fn) {
     set_config_defaults(&config);
     apply_config(vgmstream, &config);
 
+    /* fade near the end is done by the mixer, so it must be set before enabling it */
+    stream_length_samples = get_vgmstream_play_samples(config.song_loop_count,config.song_fade_time,config.song_fade_delay,vgmstream);
+    fade_samples = (int)(config.song_fade_time * vgmstream->sample_rate);
+    if (vgmstream->loop_flag && !settings.loop_forever)
+        vgmstream_mixing_fadeout(vgmstream, stream_length_samples - fade_samples, fade_samples);
+
     /* enable after all config but before outbuf (though ATM outbuf is not dynamic so no need to read input_channels) */
     vgmstream_mixing_autodownmix(vgmstream, settings.downmix_channels);
     vgmstream_mixing_enable(vgmstream, SAMPLE_BUFFER_SIZE, NULL /*&input_channels*/, &output_channels);
 
+    /* save decoder states while playing, so seeking back doesn't need to decode from the start */
+    vgmstream_set_seek_index(vgmstream, vgmstream->sample_rate, 0);
+
 
     /* save original name */
     wa_strncpy(lastfn,fn,PATH_LIMIT);
@@ -1163,8 +1172,6 @@ int winamp_Play(const in_char *fn) {
     decode_pos_ms = 0;
     decode_pos_samples = 0;
     paused = 0;
-    stream_length_samples = get_vgmstream_play_samples(config.song_loop_count,config.song_fade_time,config.song_fade_delay,vgmstream);
-    fade_samples = (int)(config.song_fade_time * vgmstream->sample_rate);
     volume = getAlbumGainVolume(fn);
 
     /* start */
@@ -1375,35 +1382,23 @@ DWORD WINAPI __stdcall decode(void *arg) {
         else
             samples_to_do = max_buffer_samples;
 
-        /* seek setup (max samples to skip if still seeking, mark done) */
+        /* seek setup (done at once, vgmstream positions directly or decodes from the closest point) */
         if (seek_needed_samples != -1) {
-            /* reset if we need to seek backwards */
-            if (seek_needed_samples < decode_pos_samples) {
-                reset_vgmstream(vgmstream);
-                apply_config(vgmstream, &config); /* config is undone by reset */
-
-                decode_pos_samples = 0;
-                decode_pos_ms = 0;
-            }
-
             /* adjust seeking past file, can happen using the right (->) key
              * (should be done here and not in SetOutputTime due to threads/race conditions) */
             if (seek_needed_samples > max_samples && !settings.loop_forever) {
                 seek_needed_samples = max_samples;
             }
 
-            /* adjust max samples to seek */
-            if (decode_pos_samples < seek_needed_samples) {
-                samples_to_do = seek_needed_samples - decode_pos_samples;
-                if (samples_to_do > max_buffer_samples)
-                    samples_to_do = max_buffer_samples;
-            }
-            else {
-                seek_needed_samples = -1;
-            }
+            vgmstream_seek(vgmstream, seek_needed_samples);
+
+            decode_pos_samples = seek_needed_samples;
+            decode_pos_ms = decode_pos_samples * 1000LL / vgmstream->sample_rate;
+            seek_needed_samples = -1;
 
             /* flush Winamp buffers */
             input_module.outMod->Flush((int)decode_pos_ms);
+            continue;
         }
 
         output_bytes = (samples_to_do * output_channels * sizeof(short));
@@ -1418,13 +1413,6 @@ DWORD WINAPI __stdcall decode(void *arg) {
             }
             Sleep(10);
         }
-        else if (seek_needed_samples != -1) { /* seek */
-            render_vgmstream(sample_buffer,samples_to_do,vgmstream);
-
-            /* discard decoded samples and keep seeking */
-            decode_pos_samples += samples_to_do;
-            decode_pos_ms = decode_pos_samples * 1000LL / vgmstream->sample_rate;
-        }
         else if (input_module.outMod->CanWrite() >= output_bytes) { /* decode */
             render_vgmstream(sample_buffer,samples_to_do,vgmstream);
 
@@ -1439,24 +1427,6 @@ DWORD WINAPI __stdcall decode(void *arg) {
                 }
             }
 
-            /* fade near the end */
-            if (vgmstream->loop_flag && fade_samples > 0 && !settings.loop_forever) {
-                int fade_channels = output_channels;
-                int samples_into_fade = decode_pos_samples - (stream_length_samples - fade_samples);
-                if (samples_into_fade + samples_to_do > 0) {
-                    int j, k;
-                    for (j = 0; j < samples_to_do; j++, samples_into_fade++) {
-                        if (samples_into_fade > 0) {
-                            const double fadedness = (double)(fade_samples-samples_into_fade)/fade_samples;
-                            for (k = 0; k < fade_channels; k++) {
-                                sample_buffer[j*fade_channels+k] =
-                                    (short)(sample_buffer[j*fade_channels+k]*fadedness);
-                            }
-                        }
-                    }
-                }
-            }
-
             /* output samples */
             input_module.SAAddPCMData((char*)sample_buffer,output_channels,16,decode_pos_ms);
             input_module.VSAAddPCMData((char*)sample_buffer,output_channels,16,decode_pos_ms);
@@ -1749,15 +1719,22 @@ static void *winampGetExtendedRead_open_common(in_char *fn, int *size, int *bps,
     set_config_defaults(&ext_config);
     apply_config(ext_vgmstream, &ext_config);
 
+    /* fade near the end is done by the mixer, so it must be set before enabling it */
+    ext_stream_length_samples = get_vgmstream_play_samples(ext_config.song_loop_count, ext_config.song_fade_time, ext_config.song_fade_delay, ext_vgmstream);
+    ext_fade_samples = (int)(ext_config.song_fade_time * ext_vgmstream->sample_rate);
+    if (ext_vgmstream->loop_flag && !settings.loop_forever)
+        vgmstream_mixing_fadeout(ext_vgmstream, ext_stream_length_samples - ext_fade_samples, ext_fade_samples);
+
     /* enable after all config but before outbuf (though ATM outbuf is not dynamic so no need to read input_channels) */
     vgmstream_mixing_autodownmix(ext_vgmstream, settings.downmix_channels);
     vgmstream_mixing_enable(ext_vgmstream, SAMPLE_BUFFER_SIZE, NULL /*&input_channels*/, &ext_output_channels);
 
+    /* save decoder states while playing, so seeking back doesn't need to decode from the start */
+    vgmstream_set_seek_index(ext_vgmstream, ext_vgmstream->sample_rate, 0);
+
     /* reset internals */
     ext_seek_needed_samples = -1;
     ext_decode_pos_samples = 0;
-    ext_stream_length_samples = get_vgmstream_play_samples(ext_config.song_loop_count, ext_config.song_fade_time, ext_config.song_fade_delay, ext_vgmstream);
-    ext_fade_samples = (int)(ext_config.song_fade_time * ext_vgmstream->sample_rate);
 
     if (size) {
         *size = ext_stream_length_samples * ext_output_channels * 2;
@@ -1812,63 +1789,27 @@ __declspec(dllexport) size_t winampGetExtendedRead_getData(void *handle, char *d
         else
             samples_to_do = max_buffer_samples;
 
-        /* seek setup (max samples to skip if still seeking, mark done) */
+        /* seek setup (done at once, vgmstream positions directly or decodes from the closest point) */
         if (ext_seek_needed_samples != -1) {
-            /* reset if we need to seek backwards */
-            if (ext_seek_needed_samples < ext_decode_pos_samples) {
-                reset_vgmstream(ext_vgmstream);
-                apply_config(ext_vgmstream, &ext_config); /* config is undone by reset */
-
-                ext_decode_pos_samples = 0;
-            }
-
             /* adjust seeking past file, can happen using the right (->) key
              * (should be done here and not in SetOutputTime due to threads/race conditions) */
             if (ext_seek_needed_samples > max_samples && !settings.loop_forever) {
                 ext_seek_needed_samples = max_samples;
             }
 
-            /* adjust max samples to seek */
-            if (ext_decode_pos_samples < ext_seek_needed_samples) {
-                samples_to_do = ext_seek_needed_samples - ext_decode_pos_samples;
-                if (samples_to_do > max_buffer_samples)
-                    samples_to_do = max_buffer_samples;
-            }
-            else {
-                ext_seek_needed_samples = -1;
-            }
+            vgmstream_seek(ext_vgmstream, ext_seek_needed_samples);
+
+            ext_decode_pos_samples = ext_seek_needed_samples;
+            ext_seek_needed_samples = -1;
+            continue;
         }
 
         if (!samples_to_do) { /* track finished */
             break;
         }
-        else if (ext_seek_needed_samples != -1) { /* seek */
-            render_vgmstream(ext_sample_buffer, samples_to_do, ext_vgmstream);
-
-            /* discard decoded samples and keep seeking */
-            ext_decode_pos_samples += samples_to_do;
-        }
         else { /* decode */
             render_vgmstream(ext_sample_buffer, samples_to_do, ext_vgmstream);
 
-            /* fade near the end */
-            if (ext_vgmstream->loop_flag && ext_fade_samples > 0 && !settings.loop_forever) {
-                int fade_channels = ext_output_channels;
-                int samples_into_fade = ext_decode_pos_samples - (ext_stream_length_samples - ext_fade_samples);
-                if (samples_into_fade + ext_decode_pos_samples > 0) {
-                    int j, k;
-                    for (j = 0; j < samples_to_do; j++, samples_into_fade++) {
-                        if (samples_into_fade > 0) {
-                            const double fadedness = (double)(ext_fade_samples-samples_into_fade)/ext_fade_samples;
-                            for (k = 0; k < fade_channels; k++) {
-                                ext_sample_buffer[j*fade_channels+k] =
-                                    (short)(ext_sample_buffer[j*fade_channels+k]*fadedness);
-                            }
-                        }
-                    }
-                }
-            }
-
             /* output samples */
             memcpy(&dest[copied], ext_sample_buffer, samples_to_do * ext_output_channels * 2);
             copied += samples_to_do * ext_output_channels * 2;